@@ -22,6 +22,7 @@
 #include <nlohmann/json.hpp>
 
 #include <sparrow/array.hpp>
+#include <sparrow/buffer/tracking_allocator.hpp>
 #include <sparrow/record_batch.hpp>
 
 #include "sparrow/json_reader/comparison.hpp"
@@ -155,5 +156,6 @@ external_CDataIntegration_ImportBatchAndCompareToJson(const char* json_path, int
 
 int64_t external_BytesAllocated()
 {
-    return 0;
+    // Requires sparrow to be built with TRACK_ALLOCATIONS, which ENABLE_INTEGRATION_TEST sets
+    return sparrow::global_allocation_tracker().live_bytes();
 }
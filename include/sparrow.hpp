@@ -16,3 +16,15 @@
 
 #include "sparrow/array.hpp"
 #include "sparrow/c_interface.hpp"
+#include "sparrow/compute/aggregation.hpp"
+#include "sparrow/compute/arithmetic.hpp"
+#include "sparrow/compute/comparison.hpp"
+#include "sparrow/compute/dictionary.hpp"
+#include "sparrow/compute/hash.hpp"
+#include "sparrow/compute/selection.hpp"
+#include "sparrow/compute/sort.hpp"
+#include "sparrow/concatenate.hpp"
+#include "sparrow/ipc/ipc_reader.hpp"
+#include "sparrow/ipc/ipc_writer.hpp"
+#include "sparrow/ipc/memory_map.hpp"
+#include "sparrow/typed_visit.hpp"
@@ -14,7 +14,9 @@
 
 #pragma once
 
+#include <cstddef>
 #include <iterator>
+#include <optional>
 #include <ranges>
 #include <stdexcept>
 
@@ -254,6 +256,9 @@ namespace sparrow
         /**
          * @returns a constant reference to the element at specified \c index.
          *
+         * \note The actual layout is resolved on each call. Prefer \ref for_each_typed or
+         *       \ref visit_chunks (sparrow/typed_visit.hpp) to scan the whole array.
+         *
          * @param index The position of the element in the \ref array. Must be less than \ref size.
          */
         SPARROW_API const_reference operator[](size_type index) const;
@@ -467,6 +472,26 @@ namespace sparrow
     SPARROW_API
     bool operator==(const array& lhs, const array& rhs);
 
+    /**
+     * Returns the index of the first element that differs between two arrays,
+     * or \c std::nullopt if the arrays are equal in the sense of \c operator==.
+     *
+     * Primitive, boolean, string and binary arrays of the same format are compared
+     * on their buffers: arrays sharing their buffers are equal without reading them,
+     * validity and boolean bitmaps are compared 64 bits at a time, and fixed width
+     * values as well as string data whose offsets line up are compared with memcmp.
+     * Floating point values are compared as values, so that a NaN is not equal to
+     * itself as with \c operator==. The other layouts are compared element by element.
+     *
+     * @param lhs the first \ref array to compare
+     * @param rhs the second \ref array to compare
+     * @return The index of the first differing element. It is 0 if the arrays have
+     * different types, and the size of the shortest array if it is a prefix of the
+     * other one.
+     */
+    SPARROW_API
+    std::optional<std::size_t> first_difference(const array& lhs, const array& rhs);
+
     template <class A>
     concept layout_or_array = layout<A> or std::same_as<A, array>;
 
@@ -211,6 +211,30 @@ namespace sparrow
         return target;
     }
 
+    /**
+     * Fill the target ArrowArray with a copy of the source ArrowArray that shares the
+     * buffers of the source when possible. The buffers of the ArrowArray created by
+     * sparrow are reference counted and only copied when one of the arrays sharing them
+     * modifies them (copy-on-write). The buffers of other ArrowArray are deep copied.
+     * Children and dictionary are handled recursively.
+     * @param source_array The source ArrowArray to copy from.
+     * @param source_schema The schema of the source ArrowArray.
+     * @param target The target ArrowArray to copy to.
+     */
+    SPARROW_API void
+    share_array(const ArrowArray& source_array, const ArrowSchema& source_schema, ArrowArray& target);
+
+    /**
+     * Create a copy of the source ArrowArray sharing its buffers when possible.
+     * @see share_array(const ArrowArray&, const ArrowSchema&, ArrowArray&)
+     */
+    [[nodiscard]] inline ArrowArray share_array(const ArrowArray& source_array, const ArrowSchema& source_schema)
+    {
+        ArrowArray target{};
+        share_array(source_array, source_schema, target);
+        return target;
+    }
+
     /**
      * Moves the content of source into a stack-allocated array, and
      * reset the source to an empty ArrowArray.
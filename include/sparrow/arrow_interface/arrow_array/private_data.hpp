@@ -14,6 +14,7 @@
 
 #pragma once
 
+#include <memory>
 #include <vector>
 
 #include "sparrow/arrow_interface/arrow_array_schema_utils.hpp"
@@ -31,6 +32,12 @@ namespace sparrow
      *
      * Holds and own buffers, children, and dictionary.
      * It is used in the Sparrow library.
+     *
+     * The buffers are reference counted and can be shared between several
+     * private data instances (see \ref share_buffers). Shared buffers are
+     * copied the first time they are accessed through a non-const method
+     * (copy-on-write), so that a modification never leaks into other
+     * instances.
      */
 
     class arrow_array_private_data : public children_ownership,
@@ -48,21 +55,61 @@ namespace sparrow
             bool dictionary_ownership
         );
 
-        [[nodiscard]] constexpr BufferType& buffers() noexcept;
-        [[nodiscard]] constexpr const BufferType& buffers() const noexcept;
+        /**
+         * Constructs a private data sharing the given buffers. The buffers are
+         * copied only when they are accessed through a non-const method while
+         * still being shared.
+         */
+        template <std::ranges::input_range CHILDREN_OWNERSHIP>
+            requires std::is_same_v<std::ranges::range_value_t<CHILDREN_OWNERSHIP>, bool>
+        explicit arrow_array_private_data(
+            std::shared_ptr<BufferType> buffers,
+            const CHILDREN_OWNERSHIP& children_ownership,
+            bool dictionary_ownership
+        );
 
-        SPARROW_CONSTEXPR_GCC_11 void resize_buffers(std::size_t size);
+        /**
+         * Returns the buffers, copying them first if they are shared with
+         * another instance.
+         */
+        [[nodiscard]] BufferType& buffers();
+        [[nodiscard]] const BufferType& buffers() const noexcept;
+
+        /**
+         * Returns a handle on the buffers that can be given to another private
+         * data instance. The buffers stay shared until one of the instances
+         * accesses them through a non-const method.
+         */
+        [[nodiscard]] std::shared_ptr<BufferType> share_buffers() const noexcept;
+
+        /**
+         * @return true if the buffers are shared with another instance.
+         */
+        [[nodiscard]] bool buffers_shared() const noexcept;
+
+        /**
+         * Copies the buffers if they are shared with another instance, so that
+         * this instance becomes their sole owner.
+         * @return true if a copy was made.
+         */
+        bool unshare_buffers();
+
+        void resize_buffers(std::size_t size);
         void set_buffer(std::size_t index, buffer<std::uint8_t>&& buffer);
         void set_buffer(std::size_t index, const buffer_view<std::uint8_t>& buffer);
-        SPARROW_CONSTEXPR_GCC_11 void resize_buffer(std::size_t index, std::size_t size, std::uint8_t value);
-        SPARROW_CONSTEXPR_GCC_11 void update_buffers_ptrs();
+        void resize_buffer(std::size_t index, std::size_t size, std::uint8_t value);
+        void update_buffers_ptrs();
 
         template <class T>
         [[nodiscard]] constexpr const T** buffers_ptrs() noexcept;
 
     private:
 
-        BufferType m_buffers;
+        // Replaces the shared buffers with a copy owned by this instance. The buffer
+        // at skipped_index is not copied since it is about to be overwritten.
+        void copy_shared_buffers(std::size_t skipped_index);
+
+        std::shared_ptr<BufferType> m_buffers;
         std::vector<std::uint8_t*> m_buffers_pointers;
     };
 
@@ -72,51 +119,124 @@ namespace sparrow
         BufferType buffers,
         const CHILDREN_OWNERSHIP& children_ownership_range,
         bool dictionary_ownership_value
+    )
+        : children_ownership(children_ownership_range)
+        , dictionary_ownership(dictionary_ownership_value)
+        , m_buffers(std::make_shared<BufferType>(std::move(buffers)))
+        , m_buffers_pointers(to_raw_ptr_vec<std::uint8_t>(*m_buffers))
+    {
+    }
+
+    template <std::ranges::input_range CHILDREN_OWNERSHIP>
+        requires std::is_same_v<std::ranges::range_value_t<CHILDREN_OWNERSHIP>, bool>
+    arrow_array_private_data::arrow_array_private_data(
+        std::shared_ptr<BufferType> buffers,
+        const CHILDREN_OWNERSHIP& children_ownership_range,
+        bool dictionary_ownership_value
     )
         : children_ownership(children_ownership_range)
         , dictionary_ownership(dictionary_ownership_value)
         , m_buffers(std::move(buffers))
-        , m_buffers_pointers(to_raw_ptr_vec<std::uint8_t>(m_buffers))
+        , m_buffers_pointers(to_raw_ptr_vec<std::uint8_t>(*m_buffers))
     {
+        SPARROW_ASSERT_TRUE(m_buffers != nullptr);
     }
 
-    [[nodiscard]] constexpr std::vector<buffer<std::uint8_t>>& arrow_array_private_data::buffers() noexcept
+    [[nodiscard]] inline std::vector<buffer<std::uint8_t>>& arrow_array_private_data::buffers()
     {
-        return m_buffers;
+        unshare_buffers();
+        return *m_buffers;
     }
 
-    [[nodiscard]] constexpr const std::vector<buffer<std::uint8_t>>&
+    [[nodiscard]] inline const std::vector<buffer<std::uint8_t>>&
     arrow_array_private_data::buffers() const noexcept
+    {
+        return *m_buffers;
+    }
+
+    [[nodiscard]] inline std::shared_ptr<arrow_array_private_data::BufferType>
+    arrow_array_private_data::share_buffers() const noexcept
     {
         return m_buffers;
     }
 
-    SPARROW_CONSTEXPR_GCC_11 void arrow_array_private_data::resize_buffers(std::size_t size)
+    [[nodiscard]] inline bool arrow_array_private_data::buffers_shared() const noexcept
+    {
+        return m_buffers.use_count() > 1;
+    }
+
+    inline bool arrow_array_private_data::unshare_buffers()
+    {
+        if (!buffers_shared())
+        {
+            return false;
+        }
+        copy_shared_buffers(m_buffers->size());
+        return true;
+    }
+
+    inline void arrow_array_private_data::copy_shared_buffers(std::size_t skipped_index)
+    {
+        auto copy = std::make_shared<BufferType>();
+        copy->reserve(m_buffers->size());
+        for (std::size_t i = 0; i < m_buffers->size(); ++i)
+        {
+            const auto& buf = (*m_buffers)[i];
+            if (i == skipped_index)
+            {
+                copy->emplace_back(buf.get_allocator());
+            }
+            else
+            {
+                // The copy constructor keeps the data of an empty buffer null
+                copy->emplace_back(buf, buf.get_allocator());
+            }
+        }
+        m_buffers = std::move(copy);
+        // The pointers are updated in place so that the ArrowArray::buffers
+        // member referencing them stays valid.
+        for (std::size_t i = 0; i < m_buffers->size(); ++i)
+        {
+            m_buffers_pointers[i] = (*m_buffers)[i].data();
+        }
+    }
+
+    inline void arrow_array_private_data::resize_buffers(std::size_t size)
     {
-        m_buffers.resize(size);
+        unshare_buffers();
+        m_buffers->resize(size);
         update_buffers_ptrs();
     }
 
     inline void arrow_array_private_data::set_buffer(std::size_t index, buffer<std::uint8_t>&& buffer)
     {
-        SPARROW_ASSERT_TRUE(index < m_buffers.size());
-        m_buffers[index] = std::move(buffer);
-        m_buffers_pointers[index] = m_buffers[index].data();
+        SPARROW_ASSERT_TRUE(index < m_buffers->size());
+        if (buffers_shared())
+        {
+            copy_shared_buffers(index);
+        }
+        (*m_buffers)[index] = std::move(buffer);
+        m_buffers_pointers[index] = (*m_buffers)[index].data();
     }
 
     inline void arrow_array_private_data::set_buffer(std::size_t index, const buffer_view<std::uint8_t>& buffer)
     {
-        SPARROW_ASSERT_TRUE(index < m_buffers.size());
-        m_buffers[index] = buffer;
-        m_buffers_pointers[index] = m_buffers[index].data();
+        SPARROW_ASSERT_TRUE(index < m_buffers->size());
+        if (buffers_shared())
+        {
+            copy_shared_buffers(index);
+        }
+        (*m_buffers)[index] = buffer;
+        m_buffers_pointers[index] = (*m_buffers)[index].data();
     }
 
-    SPARROW_CONSTEXPR_GCC_11 void
+    inline void
     arrow_array_private_data::resize_buffer(std::size_t index, std::size_t size, std::uint8_t value)
     {
-        SPARROW_ASSERT_TRUE(index < m_buffers.size());
-        m_buffers[index].resize(size, value);
-        m_buffers_pointers[index] = m_buffers[index].data();
+        SPARROW_ASSERT_TRUE(index < m_buffers->size());
+        unshare_buffers();
+        (*m_buffers)[index].resize(size, value);
+        m_buffers_pointers[index] = (*m_buffers)[index].data();
     }
 
     template <class T>
@@ -125,8 +245,8 @@ namespace sparrow
         return const_cast<const T**>(reinterpret_cast<T**>(m_buffers_pointers.data()));
     }
 
-    SPARROW_CONSTEXPR_GCC_11 void arrow_array_private_data::update_buffers_ptrs()
+    inline void arrow_array_private_data::update_buffers_ptrs()
     {
-        m_buffers_pointers = to_raw_ptr_vec<std::uint8_t>(m_buffers);
+        m_buffers_pointers = to_raw_ptr_vec<std::uint8_t>(*m_buffers);
     }
 }
@@ -18,6 +18,7 @@
 #include <iterator>
 #include <optional>
 #include <ranges>
+#include <span>
 #include <string>
 #include <string_view>
 #include <unordered_set>
@@ -195,11 +196,16 @@ namespace sparrow
          *
          * @param other Source arrow_proxy to copy from
          *
+         * The buffers of the arrays created by sparrow are not copied: they are shared
+         * between both proxies and copied the first time one of them accesses them through
+         * a non-const method (buffers(), bitmap(), get_array_private_data(), set_buffer, ...).
+         * The buffers of arrays created outside of sparrow are deep copied.
+         *
          * @pre other must be in a valid state
          * @post This proxy is an independent copy of other
          * @post If other owns structures, this proxy owns copies
          * @post If other references external structures, this proxy references the same
-         * @post Deep copy of all children and dictionary (if owned)
+         * @post Copy of all children and dictionary (if owned), sharing their buffers
          */
         SPARROW_API arrow_proxy(const arrow_proxy& other);
 
@@ -212,7 +218,7 @@ namespace sparrow
          * @pre other must be in a valid state
          * @post This proxy is an independent copy of other
          * @post Previous structures are properly released (if owned)
-         * @post Deep copy of all children and dictionary (if owned)
+         * @post Copy of all children and dictionary (if owned), sharing their buffers
          */
         SPARROW_API arrow_proxy& operator=(const arrow_proxy& other);
 
@@ -516,6 +522,7 @@ namespace sparrow
          *
          * @return Mutable reference to vector of buffer views
          *
+         * @post The buffers are not shared with another proxy anymore
          * @post Buffer views can be modified through the returned reference
          * @post Changes to buffers may require calling update_buffers()
          * @post Buffer modifications should maintain data type consistency
@@ -646,6 +653,25 @@ namespace sparrow
          */
         SPARROW_API size_t erase_bitmap(size_t index, size_t count = 1);
 
+        /**
+         * @brief Applies a batch of insertions, erasures and assignments to the validity bitmap.
+         *
+         * The bitmap is rewritten once for the whole batch and the null count is updated
+         * from the edited bits only, which is much cheaper than a sequence of insert_bitmap
+         * and erase_bitmap calls.
+         *
+         * @param edits The edits to apply, see dynamic_bitset_base::apply_edits for their semantic.
+         *
+         * @pre ArrowArray must be created with sparrow (owned by this proxy)
+         * @pre Data type must support validity bitmap
+         * @pre edits must be sorted by position, with non overlapping erased and assigned ranges
+         * @post The null count of the array is updated
+         *
+         * @throws arrow_proxy_exception if array is not owned by sparrow
+         * @throws arrow_proxy_exception if data type doesn't support validity bitmap
+         */
+        SPARROW_API void apply_bitmap_edits(std::span<const bitset_edit> edits);
+
         /**
          * @brief Appends a validity bit at the end of the bitmap.
          *
@@ -880,6 +906,8 @@ namespace sparrow
          * and the reference returned from this method should not outlive the proxy.
          * @details The schema flags can be updated by adding sparrow::ArrowFlag::NULLABLE, if null_count is
          * greater than 0.
+         * @warning The buffers may be shared with copies of this proxy: they must not be written
+         * through the returned `ArrowArray`, use buffers() or get_array_private_data() instead.
          * @return The `ArrowArray`.
          */
         [[nodiscard]] SPARROW_API ArrowArray& array();
@@ -927,16 +955,21 @@ namespace sparrow
         [[nodiscard]] SPARROW_API const ArrowSchema& schema() const;
 
         [[nodiscard]] SPARROW_API arrow_schema_private_data* get_schema_private_data();
+        /**
+         * Get the private data of the `ArrowArray`. If its buffers are shared with other proxies,
+         * they are copied first so that they can be safely modified.
+         */
         [[nodiscard]] SPARROW_API arrow_array_private_data* get_array_private_data();
 
         /**
-         * Returns a deep-copy of this proxy restricted to the half-open range [\p start, \p end).
+         * Returns a copy of this proxy restricted to the half-open range [\p start, \p end).
          *
-         * A full copy of the underlying Arrow buffers is made. The new ArrowArray.offset and
-         * ArrowArray.length are updated to represent the requested range. The returned proxy owns
-         * its data independently of \c *this.
+         * The copy shares the buffers of \c *this until one of them is modified (see the copy
+         * constructor). The new ArrowArray.offset and ArrowArray.length are updated to represent
+         * the requested range. The returned proxy owns its data independently of \c *this.
          *
-         * \note Prefer \ref slice_view when read-only access is sufficient, to avoid copying buffers.
+         * \note Prefer \ref slice_view when read-only access is sufficient, to avoid copying the
+         *       ArrowArray and ArrowSchema structures.
          *       Prefer \ref slice_inplace when you want to restrict \c *this in place.
          *
          * @param start Index of the first element to keep. Must satisfy \p start <= \p end.
@@ -1034,6 +1067,8 @@ namespace sparrow
         void remove_dictionary();
         void remove_child(size_t index);
         void create_bitmap_view(std::optional<size_t> null_count = std::nullopt);
+        // Copies the buffers if they are shared with another proxy and refreshes the views on them.
+        SPARROW_API void unshare_buffers();
 
         [[nodiscard]] bool array_created_with_sparrow() const;
         [[nodiscard]] SPARROW_API bool schema_created_with_sparrow() const;
@@ -1114,6 +1149,7 @@ namespace sparrow
     {
         static constexpr const char function_name[] = "insert_bitmap";
         throw_if_immutable<function_name, true, false>();
+        unshare_buffers();
         SPARROW_ASSERT_TRUE(m_null_bitmap.has_value())
         const auto it = m_null_bitmap->insert(
             sparrow::next(m_null_bitmap->cbegin(), index),
@@ -33,6 +33,8 @@
 
 #pragma once
 
+#include <cstddef>
+
 #include "sparrow/arrow_interface/arrow_array_stream/private_data.hpp"
 #include "sparrow/c_interface.hpp"
 #include "sparrow/c_stream_interface.hpp"
@@ -128,6 +130,19 @@ namespace sparrow
 
     SPARROW_API void fill_arrow_array_stream(ArrowArrayStream& stream);
 
+    /**
+     * @brief Fills \c stream with the callbacks and the private data of a concurrent stream.
+     *
+     * Arrays can be added to the stream from producer threads while a consumer thread
+     * calls get_next. At most \c capacity arrays are queued: adding an array blocks while
+     * the queue is full, and get_next blocks until an array is available or the stream is
+     * closed.
+     *
+     * @param stream The stream to fill.
+     * @param capacity The maximum number of queued arrays, must be greater than 0.
+     */
+    SPARROW_API void fill_arrow_array_stream(ArrowArrayStream& stream, std::size_t capacity);
+
     /**
      * @brief Move an ArrowArrayStream by transferring ownership of its resources.
      *
@@ -14,35 +14,121 @@
 
 #pragma once
 
+#include <cerrno>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
 #include <memory>
+#include <mutex>
+#include <optional>
 #include <queue>
 #include <ranges>
+#include <stdexcept>
 #include <string>
 
 #include <sparrow/arrow_interface/arrow_array.hpp>
 #include <sparrow/arrow_interface/arrow_schema.hpp>
 #include <sparrow/c_interface.hpp>
+#include <sparrow/utils/contracts.hpp>
 
 namespace sparrow
 {
+    /**
+     * Private data of the ArrowArrayStream created by sparrow.
+     *
+     * By default, the stream is meant to be used from a single thread. A concurrent
+     * stream can be created by giving a capacity to the constructor: arrays can then
+     * be imported by producer threads while a consumer thread exports them. At most
+     * \c capacity arrays are queued, importing an array blocks while the queue is
+     * full and exporting one blocks while it is empty and the stream is not closed.
+     */
     class arrow_array_stream_private_data
     {
     public:
 
         arrow_array_stream_private_data() = default;
 
+        /**
+         * Creates the private data of a concurrent stream holding at most \c capacity
+         * arrays at a time.
+         */
+        explicit arrow_array_stream_private_data(std::size_t capacity)
+            : m_sync(std::make_unique<sync_state>(capacity))
+        {
+            SPARROW_ASSERT_TRUE(capacity > 0);
+        }
+
+        [[nodiscard]] bool is_concurrent() const noexcept
+        {
+            return m_sync != nullptr;
+        }
+
         void import_schema(schema_unique_ptr&& out_schema)
         {
+            auto lock = make_lock();
             m_schema = std::move(out_schema);
+            m_schema_fingerprint = m_schema == nullptr ? 0 : sparrow::schema_fingerprint(*m_schema);
+            notify_all();
+        }
+
+        /**
+         * Imports a copy of \c schema if the stream does not have a schema yet.
+         * @return The schema of the stream.
+         */
+        const ArrowSchema& import_schema_if_absent(const ArrowSchema& schema)
+        {
+            auto lock = make_lock();
+            if (m_schema == nullptr)
+            {
+                schema_unique_ptr copy{new ArrowSchema(), arrow_schema_deleter{}};
+                copy_schema(schema, *copy);
+                m_schema = std::move(copy);
+                m_schema_fingerprint = sparrow::schema_fingerprint(*m_schema);
+                notify_all();
+            }
+            return *m_schema;
+        }
+
+        /**
+         * Returns the fingerprint of the schema of the stream, computed once when the
+         * schema is imported.
+         */
+        [[nodiscard]] std::uint64_t schema_fingerprint() const
+        {
+            auto lock = make_lock();
+            return m_schema_fingerprint;
         }
 
         [[nodiscard]] ArrowSchema* schema()
         {
+            auto lock = make_lock();
             return m_schema.get();
         }
 
         [[nodiscard]] const ArrowSchema* schema() const
         {
+            auto lock = make_lock();
+            return m_schema.get();
+        }
+
+        /**
+         * Returns the schema of the stream. A concurrent stream waits until the schema
+         * is imported or the stream is closed.
+         */
+        [[nodiscard]] const ArrowSchema* wait_for_schema()
+        {
+            auto lock = make_lock();
+            if (is_concurrent())
+            {
+                m_sync->changed.wait(
+                    lock,
+                    [this]
+                    {
+                        return m_schema != nullptr || m_closed;
+                    }
+                );
+            }
             return m_schema.get();
         }
 
@@ -52,41 +138,218 @@ namespace sparrow
         {
             for (auto&& array : arrays)
             {
-                m_arrays.push(array_ptr(array));
+                import_array(array_ptr(array));
             }
         }
 
+        /**
+         * Queues \c array. A concurrent stream waits while its queue is full.
+         * @throws std::runtime_error if the stream is closed.
+         */
         void import_array(array_unique_ptr&& array)
         {
+            auto lock = make_lock();
+            if (is_concurrent())
+            {
+                m_sync->changed.wait(
+                    lock,
+                    [this]
+                    {
+                        return m_arrays.size() < m_sync->capacity || m_closed;
+                    }
+                );
+            }
+            if (m_closed)
+            {
+                throw std::runtime_error("Cannot add array to a closed ArrowArrayStream");
+            }
             m_arrays.push(std::move(array));
+            notify_all();
         }
 
+        /**
+         * Dequeues the next array. A concurrent stream waits until an array is
+         * available or the stream is closed.
+         *
+         * @return The next array, a released array at the end of the stream, or
+         *         nullptr if the stream has been closed with an error and all the
+         *         arrays queued before have been exported.
+         */
         [[nodiscard]] ArrowArray* export_next_array()
         {
-            if (m_arrays.empty())
+            auto lock = make_lock();
+            if (is_concurrent())
             {
-                return new ArrowArray{};
+                m_sync->changed.wait(
+                    lock,
+                    [this]
+                    {
+                        return !m_arrays.empty() || m_closed;
+                    }
+                );
             }
+            return pop_array();
+        }
 
-            ArrowArray* array = m_arrays.front().release();
-            m_arrays.pop();
-            return array;
+        /**
+         * Same as export_next_array, but waits at most \c timeout.
+         * @return std::nullopt if no array was available before the timeout.
+         */
+        template <class Rep, class Period>
+        [[nodiscard]] std::optional<ArrowArray*>
+        export_next_array_for(const std::chrono::duration<Rep, Period>& timeout)
+        {
+            auto lock = make_lock();
+            if (is_concurrent())
+            {
+                const bool ready = m_sync->changed.wait_for(
+                    lock,
+                    timeout,
+                    [this]
+                    {
+                        return !m_arrays.empty() || m_closed;
+                    }
+                );
+                if (!ready)
+                {
+                    return std::nullopt;
+                }
+            }
+            return pop_array();
+        }
+
+        /**
+         * Marks the end of the stream: the arrays already queued can still be exported,
+         * then the consumer gets the end of stream. Importing arrays is not possible anymore.
+         */
+        void close()
+        {
+            auto lock = make_lock();
+            m_closed = true;
+            notify_all();
+        }
+
+        /**
+         * Closes the stream with an error: once the arrays already queued are exported,
+         * the consumer gets \c error_code and \c message.
+         */
+        void close(int error_code, std::string_view message)
+        {
+            SPARROW_ASSERT_TRUE(error_code != 0);
+            auto lock = make_lock();
+            m_closed = true;
+            m_error_code = error_code;
+            m_last_error_message = message;
+            notify_all();
+        }
+
+        [[nodiscard]] bool is_closed() const
+        {
+            auto lock = make_lock();
+            return m_closed;
+        }
+
+        /**
+         * @return true if the stream is closed and all its arrays have been exported.
+         */
+        [[nodiscard]] bool is_exhausted() const
+        {
+            auto lock = make_lock();
+            return m_closed && m_arrays.empty();
+        }
+
+        /**
+         * @return The error code given to close, or 0.
+         */
+        [[nodiscard]] int error_code() const
+        {
+            auto lock = make_lock();
+            return m_error_code;
         }
 
-        [[nodiscard]] const std::string& get_last_error_message() const
+        /**
+         * @return A copy of the last error message: the message can be replaced
+         *         concurrently by a producer calling close or set_last_error_message.
+         */
+        [[nodiscard]] std::string get_last_error_message() const
         {
+            auto lock = make_lock();
             return m_last_error_message;
         }
 
+        /**
+         * Copies the last error message into a buffer owned by the private data, for
+         * the \c get_last_error callback of the C interface.
+         *
+         * @return The message, valid until the next call, or nullptr if there is no error.
+         */
+        [[nodiscard]] const char* export_last_error_message()
+        {
+            auto lock = make_lock();
+            if (m_last_error_message.empty())
+            {
+                return nullptr;
+            }
+            m_exported_error_message = m_last_error_message;
+            return m_exported_error_message.c_str();
+        }
+
         void set_last_error_message(std::string_view message)
         {
+            auto lock = make_lock();
             m_last_error_message = message;
         }
 
     private:
 
+        struct sync_state
+        {
+            explicit sync_state(std::size_t cap)
+                : capacity(cap)
+            {
+            }
+
+            std::size_t capacity;
+            mutable std::mutex mutex;
+            // Notified when an array is queued or dequeued, the schema is
+            // imported or the stream is closed.
+            std::condition_variable changed;
+        };
+
+        [[nodiscard]] std::unique_lock<std::mutex> make_lock() const
+        {
+            return m_sync != nullptr ? std::unique_lock<std::mutex>(m_sync->mutex)
+                                     : std::unique_lock<std::mutex>();
+        }
+
+        void notify_all()
+        {
+            if (m_sync != nullptr)
+            {
+                m_sync->changed.notify_all();
+            }
+        }
+
+        ArrowArray* pop_array()
+        {
+            if (m_arrays.empty())
+            {
+                return m_error_code != 0 ? nullptr : new ArrowArray{};
+            }
+
+            ArrowArray* array = m_arrays.front().release();
+            m_arrays.pop();
+            notify_all();
+            return array;
+        }
+
         schema_unique_ptr m_schema;
+        std::uint64_t m_schema_fingerprint = 0;
         std::queue<array_unique_ptr> m_arrays{};
         std::string m_last_error_message{};
+        std::string m_exported_error_message{};
+        int m_error_code = 0;
+        bool m_closed = false;
+        std::unique_ptr<sync_state> m_sync;
     };
 }
@@ -14,7 +14,13 @@
 
 #pragma once
 
+#include <cerrno>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
 #include <ranges>
+#include <string_view>
 
 #include "sparrow/array.hpp"
 #include "sparrow/array_api.hpp"
@@ -26,6 +32,15 @@
 
 namespace sparrow
 {
+    /**
+     * @brief Options of a concurrent arrow_array_stream_proxy.
+     */
+    struct concurrent_stream_options
+    {
+        /// Maximum number of arrays queued in the stream.
+        std::size_t capacity = 16;
+    };
+
     /**
      * @brief C++ proxy class for managing ArrowArrayStream objects.
      *
@@ -46,6 +61,10 @@ namespace sparrow
      * Thread safety:
      * - The stream is not thread-safe by design (per specification)
      * - Concurrent calls to get_next or pop must be externally synchronized
+     * - A concurrent stream (see concurrent_stream_options) can be fed by producer
+     *   threads calling push while a consumer thread calls pop or get_next. Its
+     *   queue is bounded: push blocks while it is full and pop blocks until an
+     *   array is available or the producers call close.
      *
      * @note This class implements the producer side of the Arrow C Stream Interface.
      *       It creates streams that can be consumed by other libraries that understand
@@ -68,6 +87,18 @@ namespace sparrow
          */
         SPARROW_API arrow_array_stream_proxy();
 
+        /**
+         * @brief Constructs a new concurrent ArrowArrayStream producer.
+         *
+         * Arrays can be pushed from producer threads while a consumer thread pops them.
+         * At most \c options.capacity arrays are queued, which provides backpressure on
+         * the producers. The producers must call close() once they are done, so that the
+         * consumer gets the end of the stream.
+         *
+         * @param options The options of the stream, the capacity must be greater than 0.
+         */
+        SPARROW_API explicit arrow_array_stream_proxy(concurrent_stream_options options);
+
         /**
          * @brief Constructs from an existing ArrowArrayStream by taking ownership.
          *
@@ -135,6 +166,11 @@ namespace sparrow
          */
         [[nodiscard]] SPARROW_API ArrowArrayStream* export_stream();
 
+        /**
+         * Check whether the stream has been created as a concurrent stream.
+         */
+        [[nodiscard]] SPARROW_API bool is_concurrent() const;
+
         /**
          * @brief Adds a range of arrays to the stream.
          *
@@ -146,6 +182,9 @@ namespace sparrow
          *
          * @throws std::runtime_error If any array has an incompatible schema.
          * @throws std::runtime_error If the stream is immutable (released or not initialized).
+         * @throws std::runtime_error If the stream has been closed.
+         *
+         * @note On a concurrent stream, waits while the queue is full.
          */
         template <std::ranges::input_range R>
             requires layout_or_array<std::ranges::range_value_t<R>>
@@ -153,18 +192,15 @@ namespace sparrow
         {
             arrow_array_stream_private_data& private_data = get_private_data();
 
-            // Check if we need to create schema from first array
-            if (private_data.schema() == nullptr)
-            {
-                schema_unique_ptr schema{new ArrowSchema(), arrow_schema_deleter{}};
-                copy_schema(*get_arrow_schema(*std::ranges::begin(arrays)), *schema);
-                private_data.import_schema(std::move(schema));
-            }
+            // The schema of the stream is created from the first array
+            private_data.import_schema_if_absent(*get_arrow_schema(*std::ranges::begin(arrays)));
 
-            // Validate schema compatibility for all arrays
+            // Validate schema compatibility for all arrays by comparing their fingerprints,
+            // which are cached in the schemas created by sparrow and in their copies
+            const std::uint64_t stream_fingerprint = private_data.schema_fingerprint();
             for (const auto& array : arrays)
             {
-                if (!check_compatible_schema(*private_data.schema(), *get_arrow_schema(array)))
+                if (schema_fingerprint(*get_arrow_schema(array)) != stream_fingerprint)
                 {
                     throw std::runtime_error("Incompatible schema when adding array to ArrowArrayStream");
                 }
@@ -213,6 +249,59 @@ namespace sparrow
          */
         SPARROW_API std::optional<array> pop();
 
+        /**
+         * @brief Retrieves the next array from the stream, waiting at most \c timeout.
+         *
+         * On a concurrent stream, waits until an array is available, the stream is closed
+         * or \c timeout expires. On other streams, returns immediately like pop.
+         *
+         * @return The next array, or std::nullopt if \c timeout expired or the end of the
+         *         stream is reached. Both cases can be told apart with is_exhausted().
+         *
+         * @throws std::system_error If the stream has been closed with an error.
+         * @throws std::runtime_error If the stream is immutable.
+         */
+        template <class Rep, class Period>
+        std::optional<array> pop_for(const std::chrono::duration<Rep, Period>& timeout)
+        {
+            std::optional<ArrowArray*> next = get_private_data().export_next_array_for(timeout);
+            if (!next.has_value())
+            {
+                return std::nullopt;
+            }
+            return import_next_array(*next);
+        }
+
+        /**
+         * @brief Marks the end of the stream.
+         *
+         * The arrays already pushed can still be popped, then the consumer gets the end of
+         * the stream. Pushing arrays after this call throws.
+         *
+         * @throws std::runtime_error If the stream is immutable.
+         */
+        SPARROW_API void close();
+
+        /**
+         * @brief Closes the stream with an error.
+         *
+         * Once the arrays already pushed are popped, get_next returns \c error_code and
+         * get_last_error returns \c message, and pop throws a std::system_error.
+         *
+         * @param message The description of the error.
+         * @param error_code The errno-compatible error code, must not be 0.
+         *
+         * @throws std::runtime_error If the stream is immutable.
+         */
+        SPARROW_API void close(std::string_view message, int error_code = EIO);
+
+        /**
+         * Check whether the stream has been closed and all its arrays popped.
+         *
+         * @throws std::runtime_error If the stream is immutable.
+         */
+        [[nodiscard]] SPARROW_API bool is_exhausted() const;
+
     private:
 
         std::variant<ArrowArrayStream*, ArrowArrayStream> m_stream;
@@ -248,5 +337,21 @@ namespace sparrow
          * @return Reference to the stream's private data.
          */
         [[nodiscard]] SPARROW_API arrow_array_stream_private_data& get_private_data();
+
+        /**
+         * @brief Gets the private data (const version).
+         *
+         * @return Const reference to the stream's private data.
+         */
+        [[nodiscard]] const arrow_array_stream_private_data& get_private_data() const;
+
+        /**
+         * @brief Builds an array from the result of arrow_array_stream_private_data::export_next_array.
+         *
+         * @return The array, or std::nullopt at the end of the stream.
+         *
+         * @throws std::system_error If the stream has been closed with an error.
+         */
+        [[nodiscard]] SPARROW_API std::optional<array> import_next_array(ArrowArray* next);
     };
 }
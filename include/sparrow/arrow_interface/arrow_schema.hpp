@@ -255,6 +255,29 @@ namespace sparrow
 
     bool SPARROW_API check_compatible_schema(const ArrowSchema& schema1, const ArrowSchema& schema2);
 
+    /**
+     * Computes a 64-bit fingerprint of a schema, over its format, name, flags,
+     * metadata, dictionary and children. Compatible schemas, in the sense of
+     * check_compatible_schema, have the same fingerprint, so that schemas with
+     * different fingerprints are known to be incompatible without comparing them.
+     * Schemas with the same fingerprint are only very likely to be compatible.
+     *
+     * The fingerprint is not stable across versions of sparrow and must not be persisted.
+     *
+     * The fingerprint of a schema created by sparrow is cached in its private data, and
+     * copy_schema copies it, so that it is computed once for a schema and its copies.
+     * arrow_proxy resets the cached fingerprints whenever it modifies a schema, through
+     * invalidate_schema_fingerprints; a schema modified by writing to its ArrowSchema
+     * fields directly must not have been fingerprinted before.
+     */
+    [[nodiscard]] SPARROW_API std::uint64_t schema_fingerprint(const ArrowSchema& schema);
+
+    /**
+     * Resets the fingerprints cached by schema_fingerprint. The cache does not track
+     * the parents of a schema, so modifying any schema resets all of them.
+     */
+    SPARROW_API void invalidate_schema_fingerprints() noexcept;
+
     struct arrow_schema_deleter
     {
         SPARROW_API void operator()(ArrowSchema* schema) const;
@@ -14,6 +14,8 @@
 
 #pragma once
 
+#include <atomic>
+#include <cstdint>
 #include <optional>
 #include <string>
 #include <type_traits>
@@ -74,11 +76,21 @@ namespace sparrow
         [[nodiscard]] const char* metadata_ptr() const noexcept;
         [[nodiscard]] MetadataType& metadata() noexcept;
 
+        /**
+         * @return The fingerprint cached by schema_fingerprint, or 0 if it is not
+         *         cached or if it was computed before \c generation.
+         */
+        [[nodiscard]] std::uint64_t cached_fingerprint(std::uint64_t generation) const noexcept;
+        void set_cached_fingerprint(std::uint64_t fingerprint, std::uint64_t generation) noexcept;
+
     private:
 
         FormatType m_format;
         NameType m_name;
         MetadataType m_metadata;
+        // Written by concurrent readers of the schema, which all compute the same value
+        std::atomic<std::uint64_t> m_fingerprint = 0;
+        std::atomic<std::uint64_t> m_fingerprint_generation = 0;
     };
 
     template <class T>
@@ -196,4 +208,21 @@ namespace sparrow
         return m_metadata;
     }
 
+    [[nodiscard]] inline std::uint64_t
+    arrow_schema_private_data::cached_fingerprint(std::uint64_t generation) const noexcept
+    {
+        if (m_fingerprint_generation.load(std::memory_order_acquire) != generation)
+        {
+            return 0;
+        }
+        return m_fingerprint.load(std::memory_order_relaxed);
+    }
+
+    inline void
+    arrow_schema_private_data::set_cached_fingerprint(std::uint64_t fingerprint, std::uint64_t generation) noexcept
+    {
+        m_fingerprint.store(fingerprint, std::memory_order_relaxed);
+        m_fingerprint_generation.store(generation, std::memory_order_release);
+    }
+
 }
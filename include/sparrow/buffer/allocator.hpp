@@ -20,6 +20,8 @@
 #include <typeindex>
 #include <variant>
 
+#include "sparrow/buffer/arena.hpp"
+#include "sparrow/buffer/tracking_allocator.hpp"
 #include "sparrow/details/3rdparty/xsimd_aligned_allocator.hpp"
 #include "sparrow/utils/variant_visitor.hpp"
 
@@ -54,12 +56,46 @@ namespace sparrow
     concept can_any_allocator_sbo = allocator<A>
                                     && (std::same_as<std::remove_cvref_t<A>, std::allocator<T>>
                                         || std::same_as<std::remove_cvref_t<A>, std::pmr::polymorphic_allocator<T>>
-                                        || std::same_as<std::remove_cvref_t<A>, xsimd::aligned_allocator<T>>);
+                                        || std::same_as<std::remove_cvref_t<A>, xsimd::aligned_allocator<T>>
+                                        || std::same_as<std::remove_cvref_t<A>, tracking_allocator<T>>);
+
+    /*
+     * Allocator used by default by sparrow buffers. When sparrow is built with
+     * SPARROW_TRACK_ALLOCATIONS, the allocations are recorded in the global
+     * allocation tracker.
+     */
+#if defined(SPARROW_TRACK_ALLOCATIONS)
+    template <class T>
+    using default_allocator_t = tracking_allocator<T>;
+#else
+    template <class T>
+    using default_allocator_t = xsimd::aligned_allocator<T>;
+#endif
+
+    /*
+     * Returns the default allocator for a buffer of role \c role. The role is only
+     * recorded when sparrow is built with SPARROW_TRACK_ALLOCATIONS.
+     */
+    template <class T>
+    [[nodiscard]] constexpr default_allocator_t<T> make_default_allocator([[maybe_unused]] buffer_role role) noexcept
+    {
+#if defined(SPARROW_TRACK_ALLOCATIONS)
+        return default_allocator_t<T>(role);
+#else
+        return default_allocator_t<T>();
+#endif
+    }
 
     /*
      * Type erasure class for allocators. This allows to use any kind of allocator
      * (standard, polymorphic) without having to expose it as a template parameter.
      *
+     * When an arena_scope is active on the current thread, an any_allocator built
+     * from the default allocator (or default constructed) allocates from the arena
+     * of the scope instead. Copies of containers allocated from an arena do not
+     * keep using it: select_on_container_copy_construction returns a default
+     * constructed any_allocator.
+     *
      * @tparam T value_type of the allocator
      */
     template <class T>
@@ -94,6 +130,11 @@ namespace sparrow
 
         [[nodiscard]] constexpr any_allocator select_on_container_copy_construction() const;
 
+        /**
+         * @return true if the allocator allocates from an arena.
+         */
+        [[nodiscard]] bool allocates_from_arena() const noexcept;
+
         [[nodiscard]] constexpr bool equal(const any_allocator& rhs) const;
 
     private:
@@ -146,6 +187,7 @@ namespace sparrow
             std::allocator<T>,
             std::pmr::polymorphic_allocator<T>,
             xsimd::aligned_allocator<T>,
+            tracking_allocator<T>,
             std::unique_ptr<interface>>;
 
         template <class A>
@@ -161,6 +203,17 @@ namespace sparrow
             return std::forward<A>(alloc);
         }
 
+        template <class A>
+            requires can_any_allocator_sbo<A, T> && std::same_as<std::remove_cvref_t<A>, default_allocator_t<T>>
+        [[nodiscard]] constexpr storage_type make_storage(A&& alloc) const
+        {
+            if (arena* a = current_arena(); a != nullptr)
+            {
+                return std::pmr::polymorphic_allocator<T>(a);
+            }
+            return std::forward<A>(alloc);
+        }
+
         [[nodiscard]] constexpr storage_type copy_storage(const storage_type& rhs) const
         {
             return std::visit(
@@ -207,7 +260,7 @@ namespace sparrow
 
     template <class T>
     constexpr any_allocator<T>::any_allocator()
-        : m_storage(make_storage(xsimd::aligned_allocator<T>()))
+        : m_storage(make_storage(default_allocator_t<T>()))
     {
     }
 
@@ -275,9 +328,22 @@ namespace sparrow
     template <class T>
     constexpr any_allocator<T> any_allocator<T>::select_on_container_copy_construction() const
     {
+        // A copy may outlive the arena of the original, it is allocated with
+        // a fresh default allocator instead
+        if (allocates_from_arena())
+        {
+            return any_allocator();
+        }
         return any_allocator(*this);
     }
 
+    template <class T>
+    bool any_allocator<T>::allocates_from_arena() const noexcept
+    {
+        const auto* alloc = std::get_if<std::pmr::polymorphic_allocator<T>>(&m_storage);
+        return alloc != nullptr && dynamic_cast<const arena*>(alloc->resource()) != nullptr;
+    }
+
     template <class T>
     constexpr bool any_allocator<T>::equal(const any_allocator& rhs) const
     {
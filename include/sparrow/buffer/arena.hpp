@@ -0,0 +1,120 @@
+// Copyright 2024 Man Group Operations Limited
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <cstddef>
+#include <memory_resource>
+
+#include "sparrow/config/config.hpp"
+
+namespace sparrow
+{
+    /**
+     * @brief Monotonic memory resource for building arrays and record batches.
+     *
+     * Memory is taken from large chunks and is never given back individually:
+     * deallocating is a no-op, and the whole memory is released at once when the
+     * arena is destroyed or release() is called. This avoids a malloc / free pair
+     * for each buffer when building many small arrays.
+     *
+     * Allocations are aligned on 64 bytes, like the default allocator of buffers.
+     *
+     * The arena can be given explicitly to buffers through
+     * std::pmr::polymorphic_allocator, or made the default allocator of the buffers
+     * created by the current thread with an arena_scope.
+     *
+     * @warning The arena is not thread-safe, and must outlive all the buffers
+     *          allocated from it.
+     *
+     * @code{.cpp}
+     * sparrow::arena arena;
+     * {
+     *     sparrow::arena_scope scope(arena);
+     *     sparrow::record_batch batch = build_batch();
+     *     // ...
+     * }   // batch is destroyed before the arena
+     * @endcode
+     */
+    class SPARROW_API arena final : public std::pmr::memory_resource
+    {
+    public:
+
+        static constexpr std::size_t alignment = 64;
+
+        /**
+         * @param initial_size The size of the first chunk of memory.
+         * @param upstream The resource the chunks are allocated from.
+         */
+        SPARROW_API explicit arena(
+            std::size_t initial_size = 64 * 1024,
+            std::pmr::memory_resource* upstream = std::pmr::new_delete_resource()
+        );
+
+        arena(const arena&) = delete;
+        arena& operator=(const arena&) = delete;
+
+        ~arena() override = default;
+
+        /**
+         * Releases all the memory allocated from the arena.
+         *
+         * @pre No buffer allocated from the arena is alive.
+         */
+        SPARROW_API void release();
+
+        /**
+         * @return The number of bytes allocated from the arena since its creation or
+         *         the last call to release.
+         */
+        [[nodiscard]] SPARROW_API std::size_t allocated_bytes() const noexcept;
+
+    private:
+
+        void* do_allocate(std::size_t bytes, std::size_t align) override;
+        void do_deallocate(void* p, std::size_t bytes, std::size_t align) override;
+        [[nodiscard]] bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override;
+
+        std::pmr::monotonic_buffer_resource m_resource;
+        std::size_t m_allocated_bytes = 0;
+    };
+
+    /**
+     * @brief Makes an arena the default memory resource of the buffers created by
+     * the current thread, for the lifetime of the scope.
+     *
+     * While the scope is alive, the buffers, bitmaps and arrays created without an
+     * explicit allocator allocate from the arena. Scopes can be nested, the previous
+     * arena is restored when a scope is destroyed.
+     */
+    class arena_scope
+    {
+    public:
+
+        SPARROW_API explicit arena_scope(arena& a) noexcept;
+        SPARROW_API ~arena_scope();
+
+        arena_scope(const arena_scope&) = delete;
+        arena_scope& operator=(const arena_scope&) = delete;
+
+    private:
+
+        arena* p_previous;
+    };
+
+    /**
+     * @return The arena of the innermost arena_scope of the current thread, or nullptr.
+     */
+    [[nodiscard]] SPARROW_API arena* current_arena() noexcept;
+}
@@ -141,7 +141,7 @@ namespace sparrow
     public:
 
         using allocator_type = typename base_type::allocator_type;
-        using default_allocator = xsimd::aligned_allocator<T>;
+        using default_allocator = default_allocator_t<T>;
         using value_type = T;
         using reference = value_type&;
         using const_reference = const value_type&;
@@ -501,7 +501,9 @@ namespace sparrow
 
     template <class T>
     constexpr buffer<T>::buffer(const buffer& rhs)
-        : base_type(rhs.get_allocator())
+        : base_type(
+              std::allocator_traits<allocator_type>::select_on_container_copy_construction(rhs.get_allocator())
+          )
     {
         if (rhs.get_data().p_begin != nullptr)
         {
@@ -256,13 +256,14 @@ namespace sparrow
         [[nodiscard]] constexpr dynamic_bitset slice(size_type start) const;
 
         // Inherit container-like operations from base class
-        using base_type::clear;      ///< Remove all bits from the bitset
-        using base_type::emplace;    ///< Emplace a bit at a specific position
-        using base_type::erase;      ///< Remove bits from the bitset
-        using base_type::insert;     ///< Insert bits into the bitset
-        using base_type::pop_back;   ///< Remove the last bit
-        using base_type::push_back;  ///< Add a bit to the end
-        using base_type::resize;     ///< Change the size of the bitset
+        using base_type::apply_edits;  ///< Apply a batch of insertions, erasures and assignments
+        using base_type::clear;        ///< Remove all bits from the bitset
+        using base_type::emplace;      ///< Emplace a bit at a specific position
+        using base_type::erase;        ///< Remove bits from the bitset
+        using base_type::insert;       ///< Insert bits into the bitset
+        using base_type::pop_back;     ///< Remove the last bit
+        using base_type::push_back;    ///< Add a bit to the end
+        using base_type::resize;       ///< Change the size of the bitset
     };
 
     template <std::integral T>
@@ -415,7 +416,7 @@ namespace sparrow
         validity_bitmap ensure_validity_bitmap_impl(std::size_t size, R&& range)
         {
             SPARROW_ASSERT_TRUE(size == range_size(range) || range_size(range) == 0);
-            validity_bitmap bitmap(size, true, validity_bitmap::default_allocator{});
+            validity_bitmap bitmap(size, true, make_default_allocator<std::uint8_t>(buffer_role::validity));
             std::size_t i = 0;
             for (auto value : range)
             {
@@ -437,7 +438,7 @@ namespace sparrow
             )
         validity_bitmap ensure_validity_bitmap_impl(std::size_t size, R&& range_of_indices)
         {
-            validity_bitmap bitmap(size, true, validity_bitmap::default_allocator{});
+            validity_bitmap bitmap(size, true, make_default_allocator<std::uint8_t>(buffer_role::validity));
             for (auto index : range_of_indices)
             {
                 bitmap.set(index, false);
@@ -17,9 +17,12 @@
 
 #include <algorithm>
 #include <climits>
+#include <cstdint>
+#include <span>
 #include <stdexcept>
 #include <string>
 #include <type_traits>
+#include <vector>
 
 #include "sparrow/buffer/dynamic_bitset/bitset_iterator.hpp"
 #include "sparrow/buffer/dynamic_bitset/bitset_reference.hpp"
@@ -28,6 +31,29 @@
 
 namespace sparrow
 {
+    /**
+     * @brief Kind of modification described by a bitset_edit.
+     */
+    enum class bitset_edit_kind : std::uint8_t
+    {
+        insert,  ///< Inserts count bits set to value before the bit at position
+        erase,   ///< Removes the count bits starting at position
+        assign   ///< Sets the count bits starting at position to value
+    };
+
+    /**
+     * @brief A modification of a bitset, applied with dynamic_bitset_base::apply_edits.
+     *
+     * The position refers to the bitset before any edit of the batch is applied.
+     */
+    struct bitset_edit
+    {
+        bitset_edit_kind kind;  ///< The kind of modification
+        std::size_t position;   ///< The position of the first bit modified, or of the insertion
+        std::size_t count;      ///< The number of bits inserted, erased or assigned
+        bool value = false;     ///< The value of the inserted or assigned bits
+    };
+
     /**
      * @class dynamic_bitset_base
      *
@@ -95,6 +121,12 @@ namespace sparrow
          */
         [[nodiscard]] constexpr size_type size() const noexcept;
 
+        /**
+         * @brief Sets the number of bits, without changing the buffer.
+         * @param new_size The new number of bits
+         * @post size() == new_size
+         * @note The null count is left unchanged; the next resize recomputes it.
+         */
         constexpr void set_size(size_type new_size) noexcept;
 
         /**
@@ -112,6 +144,7 @@ namespace sparrow
          *       resize the buffer if needed to accommodate size() + offset bits.
          * @note For non-resizable buffers, ensure the buffer has capacity >=
          *       compute_block_count(size() + offset) before accessing bits.
+         * @note The null count is left unchanged; the next resize recomputes it.
          */
         constexpr void set_offset(size_type offset) noexcept;
 
@@ -413,6 +446,8 @@ namespace sparrow
          * @post New bits (if any) are set to value b
          * @note May allocate additional storage blocks if needed
          * @note Preserves existing bits when growing
+         * @note The null count is updated from the added or removed bits only, unless
+         *       set_size or set_offset was called, in which case it is recomputed
          */
         constexpr void resize(size_type n, value_type b = false);
 
@@ -506,6 +541,27 @@ namespace sparrow
          */
         constexpr iterator erase(const_iterator first, const_iterator last);
 
+        /**
+         * @brief Applies a batch of insertions, erasures and assignments at once.
+         *
+         * The bits following the first edit are moved only once, whatever the number of
+         * edits, and the null count is updated from the bits of the edited ranges only.
+         * This is much cheaper than calling insert or erase for each edit.
+         *
+         * The blocks from the first edit to the end are copied to a temporary buffer
+         * before being moved: a batch of edits near the end of the bitset is cheap, while
+         * a batch starting near its beginning costs a copy of the whole bitset.
+         *
+         * @param edits The edits to apply. Their positions refer to the bitset before the
+         *              call. They must be sorted by position; at the same position, insertions
+         *              are applied first, in their order in \c edits.
+         * @pre The erased and assigned ranges do not overlap and are within [0, size())
+         * @pre Insertion positions are within [0, size()]
+         * @post size() increases by the number of inserted bits and decreases by the number of
+         *       erased bits
+         */
+        constexpr void apply_edits(std::span<const bitset_edit> edits);
+
         /**
          * @brief Adds a bit to the end of the bitset.
          * @param value The value of the bit to add
@@ -577,9 +633,35 @@ namespace sparrow
          */
         constexpr void fill_bits(size_type start, size_type count, value_type value);
 
+        /**
+         * @brief Copies a range of bits from a block array to the storage.
+         * @param src The blocks to copy from
+         * @param src_start The starting bit position in src
+         * @param dst_start The starting bit position in the storage (absolute, including offset)
+         * @param count The number of bits to copy
+         * @pre src does not alias the storage
+         */
+        constexpr void copy_bits(const block_type* src, size_type src_start, size_type dst_start, size_type count);
+
+        /**
+         * @brief Counts the bits set to false in a range of a block array.
+         * @param blocks The blocks to count in (nullptr means all bits are set)
+         * @param block_count The number of blocks
+         * @param start The starting bit position in blocks
+         * @param count The number of bits to count
+         */
+        [[nodiscard]] static size_type
+        count_unset_bits(const block_type* blocks, size_type block_count, size_type start, size_type count);
+
+        /**
+         * @brief Adjusts the null count by the number of nulls added and removed.
+         */
+        constexpr void adjust_null_count(size_type added, size_type removed) noexcept;
+
         storage_type m_buffer;  ///< The underlying storage for bit data
         size_type m_size;       ///< The number of bits in the bitset
         size_type m_offset;     ///< The offset in bits from the start of the buffer
+        bool m_null_count_stale = false;  ///< set_size or set_offset changed the bits in range
 
         friend class bitset_iterator<self_type, true>;   ///< Const iterator needs access to internals
         friend class bitset_iterator<self_type, false>;  ///< Mutable iterator needs access to internals
@@ -598,6 +680,7 @@ namespace sparrow
     constexpr void dynamic_bitset_base<B, NCP>::set_size(size_type new_size) noexcept
     {
         m_size = new_size;
+        m_null_count_stale = true;
     }
 
     template <typename B, null_count_policy NCP>
@@ -619,6 +702,7 @@ namespace sparrow
     constexpr void dynamic_bitset_base<B, NCP>::set_offset(size_type offset) noexcept
     {
         m_offset = offset;
+        m_null_count_stale = true;
     }
 
     template <typename B, null_count_policy NCP>
@@ -759,6 +843,7 @@ namespace sparrow
         swap(m_buffer, rhs.m_buffer);
         swap(m_size, rhs.m_size);
         swap(m_offset, rhs.m_offset);
+        swap(m_null_count_stale, rhs.m_null_count_stale);
         this->swap_null_count(rhs);
     }
 
@@ -974,6 +1059,22 @@ namespace sparrow
         const size_type new_block_count = compute_block_count(n + m_offset);
         const block_type value = b ? block_type(~block_type(0)) : block_type(0);
 
+        // The null count is adjusted by the bits added or removed only, so that
+        // growing the bitset one bit at a time is not quadratic
+        size_type added_nulls = 0;
+        size_type removed_nulls = 0;
+        if constexpr (NCP::track_null_count)
+        {
+            if (n > old_size && !b)
+            {
+                added_nulls = n - old_size;
+            }
+            else if (n < old_size)
+            {
+                removed_nulls = count_unset_bits(data(), buffer.size(), n + m_offset, old_size - n);
+            }
+        }
+
         if (new_block_count != old_block_count)
         {
             if (data() == nullptr)
@@ -1016,7 +1117,15 @@ namespace sparrow
 
         m_size = n;
         zero_unused_bits();
-        this->recompute_null_count(data(), m_size, buffer.size(), m_offset);
+        if (m_null_count_stale)
+        {
+            this->recompute_null_count(data(), m_size, buffer.size(), m_offset);
+            m_null_count_stale = false;
+        }
+        else
+        {
+            adjust_null_count(added_nulls, removed_nulls);
+        }
     }
 
     template <typename B, null_count_policy NCP>
@@ -1053,6 +1162,7 @@ namespace sparrow
             const size_type old_size = size();
             const size_type new_size = old_size + count;
 
+            // resize counts the new bits as nulls, without recounting the others
             resize(new_size);
 
             // Shift existing bits to make room for new ones
@@ -1064,9 +1174,10 @@ namespace sparrow
 
             // Fill the inserted region with the specified value
             fill_bits(index + m_offset, count, value);
-
-            // Recompute null count after all bit manipulations are complete
-            this->recompute_null_count(data(), m_size, buffer().size(), m_offset);
+            if (value)
+            {
+                adjust_null_count(0, count);
+            }
         }
 
         return iterator(this, index);
@@ -1080,19 +1191,17 @@ namespace sparrow
     {
         const auto index = static_cast<size_type>(std::distance(cbegin(), pos));
         const auto count = static_cast<size_type>(std::distance(first, last));
-        if (data() == nullptr)
+        if (data() == nullptr
+            && std::all_of(
+                first,
+                last,
+                [](auto v)
+                {
+                    return bool(v);
+                }
+            ))
         {
-            if (std::all_of(
-                    first,
-                    last,
-                    [](auto v)
-                    {
-                        return bool(v);
-                    }
-                ))
-            {
-                m_size += count;
-            }
+            m_size += count;
             return iterator(this, index);
         }
         SPARROW_ASSERT_TRUE(cbegin() <= pos);
@@ -1101,6 +1210,7 @@ namespace sparrow
         const size_type old_size = size();
         const size_type new_size = old_size + count;
 
+        // resize counts the new bits as nulls
         resize(new_size);
 
         // Shift existing bits to make room for new ones
@@ -1110,15 +1220,14 @@ namespace sparrow
             shift_bits_right(index + m_offset, bits_to_shift, count);
         }
 
-        // Insert bits from the iterator range
+        // Insert bits from the iterator range; the inserted region is cleared
+        // first so that set only accounts for the bits set to true
+        fill_bits(index + m_offset, count, false);
         for (size_type i = 0; i < count; ++i)
         {
             set(index + i, *first++);
         }
 
-        // Recompute null count after all bit manipulations are complete
-        this->recompute_null_count(data(), m_size, buffer().size(), m_offset);
-
         return iterator(this, index);
     }
 
@@ -1165,21 +1274,128 @@ namespace sparrow
                 return end();
             }
 
-            // Shift bits left using block-level operations
-            const size_type bits_to_move = size() - last_index;
-            if (bits_to_move > 0)
+            if (count != 0)
+            {
+                const bitset_edit edit{bitset_edit_kind::erase, first_index, count};
+                apply_edits(std::span<const bitset_edit>(&edit, 1));
+            }
+        }
+        return iterator(this, first_index);
+    }
+
+    template <typename B, null_count_policy NCP>
+        requires std::ranges::random_access_range<std::remove_pointer_t<B>>
+    constexpr void dynamic_bitset_base<B, NCP>::apply_edits(std::span<const bitset_edit> edits)
+    {
+        if (edits.empty())
+        {
+            return;
+        }
+
+        size_type new_size = m_size;
+        bool all_set = true;
+        for (std::size_t i = 0; i < edits.size(); ++i)
+        {
+            const bitset_edit& edit = edits[i];
+            SPARROW_ASSERT_TRUE(i == 0 || edits[i - 1].position <= edit.position);
+            if (edit.kind == bitset_edit_kind::insert)
+            {
+                SPARROW_ASSERT_TRUE(edit.position <= m_size);
+                new_size += edit.count;
+                all_set = all_set && edit.value;
+            }
+            else
             {
-                // Copy bits from [last_index, end) to [first_index, ...)
-                for (size_type i = 0; i < bits_to_move; ++i)
+                SPARROW_ASSERT_TRUE(edit.position + edit.count <= m_size);
+                SPARROW_ASSERT_TRUE(
+                    i == 0 || edits[i - 1].kind == bitset_edit_kind::insert
+                    || edits[i - 1].position + edits[i - 1].count <= edit.position
+                );
+                if (edit.kind == bitset_edit_kind::erase)
+                {
+                    new_size -= edit.count;
+                }
+                else
                 {
-                    const bool bit_value = test(last_index + i);
-                    set(first_index + i, bit_value);
+                    all_set = all_set && edit.value;
                 }
             }
+        }
 
-            resize(size() - count);
+        // Without buffer all the bits are set; it only needs to be allocated
+        // if a bit set to false is inserted or assigned.
+        if (data() == nullptr && all_set)
+        {
+            m_size = new_size;
+            return;
         }
-        return iterator(this, first_index);
+
+        // The bits before the first edit are left in place; the following ones
+        // are copied once from a snapshot of their blocks.
+        const size_type first_position = edits.front().position;
+        const size_type first_block = block_index(first_position + m_offset);
+        const size_type old_block_count = compute_block_count(m_size + m_offset);
+        const size_type snapshot_origin = first_block * s_bits_per_block;
+        std::vector<block_type> snapshot;
+        if (data() == nullptr)
+        {
+            snapshot.assign(old_block_count - first_block, block_type(~block_type(0)));
+        }
+        else
+        {
+            snapshot.assign(data() + first_block, data() + old_block_count);
+        }
+        const size_type snapshot_size = static_cast<size_type>(snapshot.size());
+
+        size_type added_nulls = 0;
+        size_type removed_nulls = 0;
+        for (const bitset_edit& edit : edits)
+        {
+            if (edit.kind != bitset_edit_kind::insert)
+            {
+                removed_nulls += count_unset_bits(
+                    snapshot.data(),
+                    snapshot_size,
+                    edit.position + m_offset - snapshot_origin,
+                    edit.count
+                );
+            }
+            if (edit.kind != bitset_edit_kind::erase && !edit.value)
+            {
+                added_nulls += edit.count;
+            }
+        }
+
+        if (data() == nullptr)
+        {
+            // Materializes the bits before the first edit, all set
+            buffer().resize(old_block_count, block_type(~block_type(0)));
+        }
+        buffer().resize(compute_block_count(new_size + m_offset), block_type(0));
+
+        size_type src = first_position;
+        size_type dst = first_position;
+        for (const bitset_edit& edit : edits)
+        {
+            const size_type unchanged = edit.position - src;
+            copy_bits(snapshot.data(), src + m_offset - snapshot_origin, dst + m_offset, unchanged);
+            src += unchanged;
+            dst += unchanged;
+            if (edit.kind != bitset_edit_kind::insert)
+            {
+                src += edit.count;
+            }
+            if (edit.kind != bitset_edit_kind::erase)
+            {
+                fill_bits(dst + m_offset, edit.count, edit.value);
+                dst += edit.count;
+            }
+        }
+        copy_bits(snapshot.data(), src + m_offset - snapshot_origin, dst + m_offset, m_size - src);
+
+        m_size = new_size;
+        zero_unused_bits();
+        adjust_null_count(added_nulls, removed_nulls);
     }
 
     template <typename B, null_count_policy NCP>
@@ -1322,4 +1538,80 @@ namespace sparrow
         }
     }
 
+    template <typename B, null_count_policy NCP>
+        requires std::ranges::random_access_range<std::remove_pointer_t<B>>
+    constexpr void dynamic_bitset_base<B, NCP>::copy_bits(
+        const block_type* src,
+        size_type src_start,
+        size_type dst_start,
+        size_type count
+    )
+    {
+        auto* blocks = data();
+        while (count > 0)
+        {
+            // Each iteration fills the current destination block as much as possible,
+            // reading the bits from at most two source blocks.
+            const size_type dst_bit_offset = bit_index(dst_start);
+            const size_type bits_this_iter = std::min(count, s_bits_per_block - dst_bit_offset);
+
+            const size_type src_block_idx = block_index(src_start);
+            const size_type src_bit_offset = bit_index(src_start);
+            auto src_bits = static_cast<block_type>(src[src_block_idx] >> src_bit_offset);
+            if (src_bit_offset + bits_this_iter > s_bits_per_block)
+            {
+                src_bits = static_cast<block_type>(
+                    src_bits | (src[src_block_idx + 1] << (s_bits_per_block - src_bit_offset))
+                );
+            }
+
+            const block_type low_mask = bits_this_iter == s_bits_per_block
+                                            ? block_type(~block_type(0))
+                                            : static_cast<block_type>((block_type(1) << bits_this_iter) - 1);
+            const auto dst_mask = static_cast<block_type>(low_mask << dst_bit_offset);
+            block_type& dst_block = blocks[block_index(dst_start)];
+            dst_block = static_cast<block_type>(
+                (dst_block & ~dst_mask) | ((src_bits << dst_bit_offset) & dst_mask)
+            );
+
+            src_start += bits_this_iter;
+            dst_start += bits_this_iter;
+            count -= bits_this_iter;
+        }
+    }
+
+    template <typename B, null_count_policy NCP>
+        requires std::ranges::random_access_range<std::remove_pointer_t<B>>
+    auto dynamic_bitset_base<B, NCP>::count_unset_bits(
+        const block_type* blocks,
+        size_type block_count,
+        size_type start,
+        size_type count
+    ) -> size_type
+    {
+        if (blocks == nullptr || count == 0)
+        {
+            return 0;
+        }
+        const auto* byte_data = reinterpret_cast<const std::uint8_t*>(blocks);
+        const std::size_t byte_size = static_cast<std::size_t>(block_count) * sizeof(block_type);
+        return count
+               - static_cast<size_type>(count_non_null(
+                   byte_data,
+                   static_cast<std::size_t>(count),
+                   byte_size,
+                   static_cast<std::size_t>(start)
+               ));
+    }
+
+    template <typename B, null_count_policy NCP>
+        requires std::ranges::random_access_range<std::remove_pointer_t<B>>
+    constexpr void dynamic_bitset_base<B, NCP>::adjust_null_count(size_type added, size_type removed) noexcept
+    {
+        if constexpr (NCP::track_null_count)
+        {
+            this->set_null_count(this->null_count() + added - removed);
+        }
+    }
+
 }
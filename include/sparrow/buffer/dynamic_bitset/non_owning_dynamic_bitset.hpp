@@ -43,6 +43,7 @@ namespace sparrow
         constexpr non_owning_dynamic_bitset& operator=(const non_owning_dynamic_bitset&) = default;
         constexpr non_owning_dynamic_bitset& operator=(non_owning_dynamic_bitset&&) noexcept = default;
 
+        using base_type::apply_edits;
         using base_type::clear;
         using base_type::emplace;
         using base_type::erase;
@@ -38,6 +38,31 @@ namespace sparrow
         std::size_t offset = 0
     ) noexcept;
 
+    /**
+     * @brief Settings of the multi-threaded bit count of \ref count_non_null.
+     *
+     * Bitmaps spanning at least \c min_byte_size bytes are split into chunks counted by
+     * several threads. A value of 0 for \c min_byte_size disables the multi-threaded
+     * count, which is the default. A value of 0 for \c num_threads means
+     * std::thread::hardware_concurrency() threads.
+     */
+    struct parallel_count_settings
+    {
+        std::size_t min_byte_size = 0;
+        std::size_t num_threads = 0;
+    };
+
+    /**
+     * @brief Sets the settings of the multi-threaded bit count, for all the threads.
+     * @param settings The new settings
+     */
+    SPARROW_API void set_parallel_count_settings(parallel_count_settings settings) noexcept;
+
+    /**
+     * @brief Returns the current settings of the multi-threaded bit count.
+     */
+    [[nodiscard]] SPARROW_API parallel_count_settings get_parallel_count_settings() noexcept;
+
     /**
      * @class tracking_null_count
      *
@@ -0,0 +1,264 @@
+// Copyright 2024 Man Group Operations Limited
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+#include "sparrow/config/config.hpp"
+#include "sparrow/details/3rdparty/xsimd_aligned_allocator.hpp"
+
+namespace sparrow
+{
+    /**
+     * @brief Role of the buffers allocated by a tracking_allocator.
+     *
+     * Used to break down the statistics of an allocation_tracker.
+     */
+    enum class buffer_role : std::uint8_t
+    {
+        unspecified,
+        validity,
+        offsets,
+        data
+    };
+
+    inline constexpr std::size_t buffer_role_count = 4;
+
+    /**
+     * @brief Counters of the memory allocated through tracking_allocator.
+     *
+     * The counters are atomic, so that a tracker can be shared by allocators
+     * used from different threads.
+     */
+    class allocation_tracker
+    {
+    public:
+
+        allocation_tracker() = default;
+        allocation_tracker(const allocation_tracker&) = delete;
+        allocation_tracker& operator=(const allocation_tracker&) = delete;
+
+        /**
+         * Records the allocation of \c bytes bytes for a buffer of role \c role.
+         */
+        void on_allocate(std::size_t bytes, buffer_role role) noexcept;
+
+        /**
+         * Records the deallocation of \c bytes bytes for a buffer of role \c role.
+         */
+        void on_deallocate(std::size_t bytes, buffer_role role) noexcept;
+
+        /**
+         * @return The number of bytes currently allocated.
+         */
+        [[nodiscard]] std::int64_t live_bytes() const noexcept;
+
+        /**
+         * @return The number of bytes currently allocated for buffers of role \c role.
+         */
+        [[nodiscard]] std::int64_t live_bytes(buffer_role role) const noexcept;
+
+        /**
+         * @return The maximum number of bytes allocated at the same time since the
+         *         creation of the tracker or the last call to reset_peak.
+         */
+        [[nodiscard]] std::int64_t peak_bytes() const noexcept;
+
+        /**
+         * @return The number of allocations performed since the creation of the tracker.
+         */
+        [[nodiscard]] std::int64_t allocation_count() const noexcept;
+
+        /**
+         * Sets the peak to the number of bytes currently allocated.
+         */
+        void reset_peak() noexcept;
+
+    private:
+
+        std::atomic<std::int64_t> m_live_bytes = 0;
+        std::atomic<std::int64_t> m_peak_bytes = 0;
+        std::atomic<std::int64_t> m_allocation_count = 0;
+        std::array<std::atomic<std::int64_t>, buffer_role_count> m_role_live_bytes = {};
+    };
+
+    /**
+     * @return The tracker used by default by tracking_allocator.
+     */
+    [[nodiscard]] SPARROW_API allocation_tracker& global_allocation_tracker();
+
+    /**
+     * @brief Allocator recording its allocations in an allocation_tracker.
+     *
+     * The memory is allocated with the same alignment as the default allocator
+     * of sparrow buffers. The allocator can be given to any buffer, and is stored
+     * without extra allocation by any_allocator.
+     *
+     * @tparam T The value type of the allocator.
+     */
+    template <class T>
+    class tracking_allocator
+    {
+    public:
+
+        using value_type = T;
+
+        /**
+         * Creates an allocator recording its allocations in the global tracker.
+         */
+        tracking_allocator() noexcept;
+
+        explicit tracking_allocator(buffer_role role) noexcept;
+        explicit tracking_allocator(allocation_tracker& tracker, buffer_role role = buffer_role::unspecified) noexcept;
+
+        template <class U>
+        tracking_allocator(const tracking_allocator<U>& rhs) noexcept;
+
+        [[nodiscard]] T* allocate(std::size_t n);
+        void deallocate(T* p, std::size_t n);
+
+        [[nodiscard]] allocation_tracker& tracker() const noexcept;
+        [[nodiscard]] buffer_role role() const noexcept;
+
+    private:
+
+        xsimd::aligned_allocator<T> m_alloc;
+        allocation_tracker* p_tracker;
+        buffer_role m_role;
+    };
+
+    template <class T, class U>
+    bool operator==(const tracking_allocator<T>& lhs, const tracking_allocator<U>& rhs) noexcept;
+
+    /*************************************
+     * allocation_tracker implementation *
+     *************************************/
+
+    inline void allocation_tracker::on_allocate(std::size_t bytes, buffer_role role) noexcept
+    {
+        const auto signed_bytes = static_cast<std::int64_t>(bytes);
+        const std::int64_t live = m_live_bytes.fetch_add(signed_bytes, std::memory_order_relaxed) + signed_bytes;
+        m_role_live_bytes[static_cast<std::size_t>(role)].fetch_add(signed_bytes, std::memory_order_relaxed);
+        m_allocation_count.fetch_add(1, std::memory_order_relaxed);
+
+        std::int64_t peak = m_peak_bytes.load(std::memory_order_relaxed);
+        while (peak < live && !m_peak_bytes.compare_exchange_weak(peak, live, std::memory_order_relaxed))
+        {
+        }
+    }
+
+    inline void allocation_tracker::on_deallocate(std::size_t bytes, buffer_role role) noexcept
+    {
+        const auto signed_bytes = static_cast<std::int64_t>(bytes);
+        m_live_bytes.fetch_sub(signed_bytes, std::memory_order_relaxed);
+        m_role_live_bytes[static_cast<std::size_t>(role)].fetch_sub(signed_bytes, std::memory_order_relaxed);
+    }
+
+    inline std::int64_t allocation_tracker::live_bytes() const noexcept
+    {
+        return m_live_bytes.load(std::memory_order_relaxed);
+    }
+
+    inline std::int64_t allocation_tracker::live_bytes(buffer_role role) const noexcept
+    {
+        return m_role_live_bytes[static_cast<std::size_t>(role)].load(std::memory_order_relaxed);
+    }
+
+    inline std::int64_t allocation_tracker::peak_bytes() const noexcept
+    {
+        return m_peak_bytes.load(std::memory_order_relaxed);
+    }
+
+    inline std::int64_t allocation_tracker::allocation_count() const noexcept
+    {
+        return m_allocation_count.load(std::memory_order_relaxed);
+    }
+
+    inline void allocation_tracker::reset_peak() noexcept
+    {
+        m_peak_bytes.store(live_bytes(), std::memory_order_relaxed);
+    }
+
+    /*************************************
+     * tracking_allocator implementation *
+     *************************************/
+
+    template <class T>
+    tracking_allocator<T>::tracking_allocator() noexcept
+        : tracking_allocator(global_allocation_tracker())
+    {
+    }
+
+    template <class T>
+    tracking_allocator<T>::tracking_allocator(buffer_role role) noexcept
+        : tracking_allocator(global_allocation_tracker(), role)
+    {
+    }
+
+    template <class T>
+    tracking_allocator<T>::tracking_allocator(allocation_tracker& tracker, buffer_role role) noexcept
+        : p_tracker(&tracker)
+        , m_role(role)
+    {
+    }
+
+    template <class T>
+    template <class U>
+    tracking_allocator<T>::tracking_allocator(const tracking_allocator<U>& rhs) noexcept
+        : p_tracker(&rhs.tracker())
+        , m_role(rhs.role())
+    {
+    }
+
+    template <class T>
+    T* tracking_allocator<T>::allocate(std::size_t n)
+    {
+        T* p = m_alloc.allocate(n);
+        p_tracker->on_allocate(n * sizeof(T), m_role);
+        return p;
+    }
+
+    template <class T>
+    void tracking_allocator<T>::deallocate(T* p, std::size_t n)
+    {
+        if (p == nullptr)
+        {
+            return;
+        }
+        m_alloc.deallocate(p, n);
+        p_tracker->on_deallocate(n * sizeof(T), m_role);
+    }
+
+    template <class T>
+    allocation_tracker& tracking_allocator<T>::tracker() const noexcept
+    {
+        return *p_tracker;
+    }
+
+    template <class T>
+    buffer_role tracking_allocator<T>::role() const noexcept
+    {
+        return m_role;
+    }
+
+    template <class T, class U>
+    bool operator==(const tracking_allocator<T>& lhs, const tracking_allocator<U>& rhs) noexcept
+    {
+        return &lhs.tracker() == &rhs.tracker() && lhs.role() == rhs.role();
+    }
+}
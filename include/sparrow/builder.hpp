@@ -15,6 +15,7 @@
 
 #pragma once
 
+#include <limits>
 #include <map>
 #include <ranges>
 #include <tuple>
@@ -26,7 +27,9 @@
 #include "sparrow/array.hpp"
 #include "sparrow/builder/builder_utils.hpp"
 #include "sparrow/builder/nested_eq.hpp"
+#include "sparrow/builder/nested_hash.hpp"
 #include "sparrow/builder/nested_less.hpp"
+#include "sparrow/builder/variable_size_binary_builder.hpp"
 #include "sparrow/date_array.hpp"
 #include "sparrow/dictionary_encoded_array.hpp"
 #include "sparrow/fixed_width_binary_array.hpp"
@@ -554,27 +557,65 @@ namespace sparrow
             [[nodiscard]] static type create(U&& t)
             {
                 const auto input_size = range_size(t);
-                key_type key = 0;
-                std::map<raw_range_value_type, key_type, nested_less<raw_range_value_type>> value_map;
                 std::vector<raw_range_value_type> values;
                 std::vector<key_type> keys;
 
                 values.reserve(input_size);
                 keys.reserve(input_size);
 
+                // open addressing table of the indices of the distinct values, with
+                // linear probing; a slot holds the hash of its value to skip most of
+                // the nested comparisons on collisions
+                static constexpr key_type empty_slot = std::numeric_limits<key_type>::max();
+                struct slot
+                {
+                    std::size_t hash;
+                    key_type index;
+                };
+                std::size_t capacity = 16;
+                while (capacity < input_size)
+                {
+                    capacity <<= 1;
+                }
+                std::vector<slot> slots(capacity, slot{0, empty_slot});
+                const nested_hash<raw_range_value_type> hasher{};
+                const nested_eq<raw_range_value_type> eq{};
+
                 for (const auto& v : t)
                 {
-                    auto find_res = value_map.find(v);
-                    if (find_res == value_map.end())
+                    const std::size_t h = hasher(v);
+                    std::size_t pos = h & (slots.size() - 1);
+                    while (slots[pos].index != empty_slot
+                           && (slots[pos].hash != h || !eq(values[slots[pos].index], v)))
                     {
-                        value_map.insert({v, key});
-                        values.push_back(v);
-                        keys.push_back(key);
-                        ++key;
+                        pos = (pos + 1) & (slots.size() - 1);
                     }
-                    else
+                    if (slots[pos].index != empty_slot)
+                    {
+                        keys.push_back(slots[pos].index);
+                        continue;
+                    }
+                    const auto key = static_cast<key_type>(values.size());
+                    slots[pos] = slot{h, key};
+                    values.push_back(v);
+                    keys.push_back(key);
+                    // keep the load factor under one half
+                    if (2 * values.size() > slots.size())
                     {
-                        keys.push_back(find_res->second);
+                        std::vector<slot> grown(2 * slots.size(), slot{0, empty_slot});
+                        for (const slot& s : slots)
+                        {
+                            if (s.index != empty_slot)
+                            {
+                                std::size_t p = s.hash & (grown.size() - 1);
+                                while (grown[p].index != empty_slot)
+                                {
+                                    p = (p + 1) & (grown.size() - 1);
+                                }
+                                grown[p] = s;
+                            }
+                        }
+                        slots = std::move(grown);
                     }
                 }
                 auto keys_buffer = sparrow::u8_buffer<key_type>(keys);
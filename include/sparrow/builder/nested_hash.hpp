@@ -0,0 +1,155 @@
+// Copyright 2024 Man Group Operations Limited
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string_view>
+
+#include <sparrow/builder/builder_utils.hpp>
+#include <sparrow/utils/ranges.hpp>
+
+namespace sparrow
+{
+    namespace detail
+    {
+        // Hash consistent with nested_eq: values equal for nested_eq have equal hashes
+        template <class T>
+        struct nested_hash;
+
+        [[nodiscard]] constexpr std::size_t nested_hash_mix(std::uint64_t h) noexcept
+        {
+            h ^= h >> 32;
+            h *= 0xd6e8feb86659fd93ULL;
+            h ^= h >> 32;
+            return static_cast<std::size_t>(h);
+        }
+
+        [[nodiscard]] constexpr std::size_t nested_hash_combine(std::size_t seed, std::size_t h) noexcept
+        {
+            return nested_hash_mix(seed ^ (h + 0x9e3779b97f4a7c15ULL + (seed << 6) + (seed >> 2)));
+        }
+
+        // scalars
+        template <class T>
+            requires std::is_scalar_v<T>
+        struct nested_hash<T>
+        {
+            [[nodiscard]] std::size_t operator()(const T& a) const noexcept
+            {
+                // std::hash is the identity for integers on common implementations
+                return nested_hash_mix(std::hash<T>{}(a));
+            }
+        };
+
+        template <is_express_layout_desire T>
+        struct nested_hash<T>
+        {
+            [[nodiscard]] std::size_t operator()(const T& a) const
+            {
+                return nested_hash<typename T::value_type>{}(a.get());
+            }
+        };
+
+        // nullables
+        template <class T>
+            requires is_nullable_like<T>
+        struct nested_hash<T>
+        {
+            [[nodiscard]] std::size_t operator()(const T& a) const
+            {
+                // all the nulls are equal
+                if (!a.has_value())
+                {
+                    return 0;
+                }
+                return nested_hash_combine(1, nested_hash<typename T::value_type>{}(a.value()));
+            }
+        };
+
+        // tuple like
+        template <class T>
+            requires tuple_like<T>
+        struct nested_hash<T>
+        {
+            [[nodiscard]] std::size_t operator()(const T& a) const
+            {
+                constexpr std::size_t N = std::tuple_size_v<T>;
+                std::size_t seed = N;
+                for_each_index<N>(
+                    [&](auto i)
+                    {
+                        using tuple_element_type = std::decay_t<std::tuple_element_t<decltype(i)::value, T>>;
+                        seed = nested_hash_combine(
+                            seed,
+                            nested_hash<tuple_element_type>{}(std::get<decltype(i)::value>(a))
+                        );
+                    }
+                );
+                return seed;
+            }
+        };
+
+        // ranges (and not tuple like)
+        template <class T>
+            requires(std::ranges::input_range<T> && !tuple_like<T>)
+        struct nested_hash<T>
+        {
+            [[nodiscard]] std::size_t operator()(const T& a) const
+            {
+                using value_type = std::ranges::range_value_t<T>;
+                if constexpr (std::ranges::contiguous_range<T> && std::is_integral_v<value_type>
+                              && sizeof(value_type) == 1)
+                {
+                    // strings and byte sequences are hashed as a whole
+                    const std::string_view bytes(
+                        reinterpret_cast<const char*>(std::ranges::data(a)),
+                        static_cast<std::size_t>(std::ranges::size(a))
+                    );
+                    return nested_hash_mix(std::hash<std::string_view>{}(bytes));
+                }
+                else
+                {
+                    std::size_t seed = 0x2545f4914f6cdd1dULL;
+                    for (const auto& v : a)
+                    {
+                        seed = nested_hash_combine(seed, nested_hash<value_type>{}(v));
+                    }
+                    return seed;
+                }
+            }
+        };
+
+        // variants
+        template <class T>
+            requires variant_like<T>
+        struct nested_hash<T>
+        {
+            [[nodiscard]] std::size_t operator()(const T& a) const
+            {
+                return std::visit(
+                    [&](const auto& a_val)
+                    {
+                        using value_type = std::decay_t<decltype(a_val)>;
+                        return nested_hash_combine(a.index(), nested_hash<value_type>{}(a_val));
+                    },
+                    a
+                );
+            }
+        };
+    }  // namespace detail
+}  // namespace sparrow
@@ -0,0 +1,469 @@
+// Copyright 2024 Man Group Operations Limited
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <optional>
+#include <ranges>
+#include <stdexcept>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+#include "sparrow/buffer/dynamic_bitset/dynamic_bitset.hpp"
+#include "sparrow/u8_buffer.hpp"
+#include "sparrow/utils/contracts.hpp"
+#include "sparrow/utils/metadata.hpp"
+#include "sparrow/utils/mp_utils.hpp"
+#include "sparrow/variable_size_binary_array.hpp"
+#include "sparrow/variable_size_binary_view_array.hpp"
+
+namespace sparrow
+{
+    /**
+     * Matches the contiguous ranges of characters or bytes that can be appended to a builder.
+     */
+    template <class R>
+    concept binary_value = std::ranges::contiguous_range<R> && std::ranges::sized_range<R>
+                           && mpl::char_like<std::remove_cv_t<std::ranges::range_value_t<R>>>;
+
+    namespace detail
+    {
+        // Resizes the buffer to new_size, growing its capacity geometrically so that
+        // appending n elements one at a time only reallocates O(log(n)) times
+        template <class B>
+        constexpr void grow_to(B& buf, std::size_t new_size)
+        {
+            if (new_size > buf.capacity())
+            {
+                buf.reserve(std::max(new_size, 2 * buf.capacity()));
+            }
+            buf.resize(new_size);
+        }
+
+        /**
+         * Validity bitmap of a builder. The bitmap is not allocated until the first null
+         * is appended, so that building an array without nulls does not write any bit.
+         */
+        class builder_validity
+        {
+        public:
+
+            constexpr void reserve(std::size_t rows)
+            {
+                if (!m_bits.empty())
+                {
+                    m_bits.reserve((rows + 7) / 8);
+                }
+            }
+
+            // Must be called after the size of the builder was incremented
+            constexpr void append_valid(std::size_t new_size)
+            {
+                if (!m_bits.empty() && (new_size - 1) % 8 == 0)
+                {
+                    m_bits.push_back(std::uint8_t(0xFF));
+                }
+            }
+
+            constexpr void append_null(std::size_t new_size)
+            {
+                if (m_bits.empty())
+                {
+                    grow_to(m_bits, (new_size + 7) / 8);
+                    std::fill(m_bits.begin(), m_bits.end(), std::uint8_t(0xFF));
+                }
+                else if ((new_size - 1) % 8 == 0)
+                {
+                    m_bits.push_back(std::uint8_t(0xFF));
+                }
+                const std::size_t index = new_size - 1;
+                m_bits[index / 8] &= static_cast<std::uint8_t>(~(1u << (index % 8)));
+                ++m_null_count;
+            }
+
+            [[nodiscard]] constexpr std::size_t null_count() const noexcept
+            {
+                return m_null_count;
+            }
+
+            // Hands the bits to a validity bitmap of size bits and resets the validity
+            [[nodiscard]] validity_bitmap finish(std::size_t size)
+            {
+                if (m_bits.empty())
+                {
+                    return validity_bitmap{validity_bitmap::default_allocator()};
+                }
+                if (size % 8 != 0)
+                {
+                    m_bits.back() &= static_cast<std::uint8_t>((1u << (size % 8)) - 1);
+                }
+                validity_bitmap result(std::move(m_bits), size, 0, m_null_count);
+                m_bits = buffer<std::uint8_t>(0, buffer<std::uint8_t>::default_allocator());
+                m_null_count = 0;
+                return result;
+            }
+
+        private:
+
+            buffer<std::uint8_t> m_bits = buffer<std::uint8_t>(0, buffer<std::uint8_t>::default_allocator());
+            std::size_t m_null_count = 0;
+        };
+    }
+
+    /**
+     * @brief Append-only builder for \ref variable_size_binary_array_impl arrays
+     * (\ref string_array, \ref big_string_array, \ref binary_array and \ref big_binary_array).
+     *
+     * Values are appended at the end of the offsets and data buffers, whose capacity grows
+     * geometrically; the validity bitmap is allocated on the first null only. \ref finish
+     * moves the buffers into the built array without copying them, and leaves the builder
+     * empty and ready to build another array.
+     *
+     * @tparam ARRAY The type of the array to build.
+     */
+    template <class ARRAY>
+    class variable_size_binary_builder
+    {
+    public:
+
+        using array_type = ARRAY;
+        using offset_type = std::remove_const_t<typename ARRAY::offset_type>;
+        using size_type = std::size_t;
+
+        variable_size_binary_builder()
+        {
+            m_offsets.push_back(offset_type(0));
+        }
+
+        /**
+         * Reserves storage for \c rows values totalling \c bytes bytes.
+         */
+        void reserve(size_type rows, size_type bytes)
+        {
+            m_offsets.reserve(rows + 1);
+            m_data.reserve(bytes);
+            m_validity.reserve(rows);
+        }
+
+        /**
+         * Appends the value \c value.
+         *
+         * @throws std::overflow_error if the total size of the values does not fit in
+         *         the offset type of the array.
+         */
+        template <binary_value R>
+            requires(!std::is_array_v<R>)
+        void append(const R& value)
+        {
+            const size_type length = std::ranges::size(value);
+            const size_type data_size = m_data.size();
+            if (length > static_cast<size_type>(std::numeric_limits<offset_type>::max()) - data_size)
+            {
+                throw std::overflow_error("variable_size_binary_builder: the values do not fit in the offsets");
+            }
+            if (length != 0)
+            {
+                detail::grow_to(m_data, data_size + length);
+                std::memcpy(m_data.data() + data_size, std::ranges::data(value), length);
+            }
+            append_offset(data_size + length);
+            m_validity.append_valid(size());
+        }
+
+        /**
+         * Appends the string \c value.
+         */
+        void append(std::string_view value)
+        {
+            append<std::string_view>(value);
+        }
+
+        /**
+         * Appends a null value. The value takes no data, only its validity bit and its
+         * offset are written.
+         */
+        void append_null()
+        {
+            append_offset(m_data.size());
+            m_validity.append_null(size());
+        }
+
+        /**
+         * Returns the number of values appended since the last call to \ref finish.
+         */
+        [[nodiscard]] size_type size() const noexcept
+        {
+            return m_offsets.size() - 1;
+        }
+
+        [[nodiscard]] size_type null_count() const noexcept
+        {
+            return m_validity.null_count();
+        }
+
+        /**
+         * Returns the total size in bytes of the values appended so far.
+         */
+        [[nodiscard]] size_type data_size() const noexcept
+        {
+            return m_data.size();
+        }
+
+        /**
+         * Builds the array from the appended values and resets the builder.
+         *
+         * @param name The name of the array.
+         * @param metadata The metadata of the array.
+         * @return The built array, owning the buffers of the builder.
+         */
+        template <input_metadata_container METADATA_RANGE = std::vector<metadata_pair>>
+        [[nodiscard]] array_type
+        finish(std::optional<std::string_view> name = std::nullopt, std::optional<METADATA_RANGE> metadata = std::nullopt)
+        {
+            const size_type length = size();
+            array_type result(
+                std::move(m_data),
+                std::move(m_offsets),
+                m_validity.finish(length),
+                std::move(name),
+                std::move(metadata)
+            );
+            // The buffers moved into the array are left empty
+            m_data.clear();
+            m_offsets.clear();
+            m_offsets.push_back(offset_type(0));
+            return result;
+        }
+
+    private:
+
+        void append_offset(size_type offset)
+        {
+            const size_type n = m_offsets.size();
+            detail::grow_to(m_offsets, n + 1);
+            m_offsets[n] = static_cast<offset_type>(offset);
+        }
+
+        u8_buffer<char> m_data = u8_buffer<char>(size_type(0));
+        u8_buffer<offset_type> m_offsets = u8_buffer<offset_type>(size_type(0));
+        detail::builder_validity m_validity;
+    };
+
+    using string_builder = variable_size_binary_builder<string_array>;
+    using big_string_builder = variable_size_binary_builder<big_string_array>;
+    using binary_builder = variable_size_binary_builder<binary_array>;
+    using big_binary_builder = variable_size_binary_builder<big_binary_array>;
+
+    /**
+     * @brief Append-only builder for \ref variable_size_binary_view_array_impl arrays
+     * (\ref string_view_array and \ref binary_view_array).
+     *
+     * Each value is written in place in its 16-byte view structure. Values longer than
+     * 12 bytes are appended to the current variadic buffer, a new variadic buffer being
+     * started when the current one would exceed the buffer size given at construction.
+     * Since the variadic buffers are allocated with their final capacity, appending a
+     * long value never moves the values already appended. \ref finish moves the buffers
+     * into the built array without copying them, and leaves the builder empty.
+     *
+     * @tparam ARRAY The type of the array to build.
+     */
+    template <class ARRAY>
+    class variable_size_binary_view_builder
+    {
+    public:
+
+        using array_type = ARRAY;
+        using size_type = std::size_t;
+
+        static constexpr size_type view_size = 16;
+        static constexpr size_type inline_size = 12;
+        static constexpr size_type default_variadic_buffer_size = size_type(1) << 20;
+
+        /**
+         * @param variadic_buffer_size The size above which a new variadic buffer is started.
+         *
+         * @pre variadic_buffer_size must fit in a 32-bit signed integer.
+         */
+        explicit variable_size_binary_view_builder(size_type variadic_buffer_size = default_variadic_buffer_size)
+            : m_variadic_buffer_size(variadic_buffer_size)
+        {
+            SPARROW_ASSERT_TRUE(
+                variadic_buffer_size > 0
+                && variadic_buffer_size <= static_cast<size_type>(std::numeric_limits<std::int32_t>::max())
+            );
+        }
+
+        /**
+         * Reserves storage for \c rows values totalling \c bytes bytes. Only the bytes
+         * of the values longer than 12 bytes are stored in the variadic buffers, \c bytes
+         * is an upper bound of the storage they need.
+         */
+        void reserve(size_type rows, size_type bytes)
+        {
+            m_views.reserve(rows * view_size);
+            m_validity.reserve(rows);
+            if (m_buffers.empty() && bytes != 0)
+            {
+                start_buffer(std::min(bytes, m_variadic_buffer_size));
+            }
+        }
+
+        /**
+         * Appends the value \c value.
+         *
+         * @throws std::overflow_error if the value is longer than 2^31 - 1 bytes.
+         */
+        template <binary_value R>
+            requires(!std::is_array_v<R>)
+        void append(const R& value)
+        {
+            const size_type length = std::ranges::size(value);
+            if (length > static_cast<size_type>(std::numeric_limits<std::int32_t>::max()))
+            {
+                throw std::overflow_error("variable_size_binary_view_builder: the value is too long");
+            }
+            const auto* bytes = reinterpret_cast<const std::uint8_t*>(std::ranges::data(value));
+            std::uint8_t* view = append_view();
+            write_int32(view, length);
+            if (length <= inline_size)
+            {
+                if (length != 0)
+                {
+                    std::memcpy(view + 4, bytes, length);
+                }
+            }
+            else
+            {
+                if (m_buffers.empty() || m_buffers.back().size() + length > m_buffers.back().capacity())
+                {
+                    start_buffer(std::max(length, m_variadic_buffer_size));
+                }
+                u8_buffer<std::uint8_t>& current = m_buffers.back();
+                const size_type offset = current.size();
+                current.resize(offset + length);
+                std::memcpy(current.data() + offset, bytes, length);
+                std::memcpy(view + 4, bytes, 4);
+                write_int32(view + 8, m_buffers.size() - 1);
+                write_int32(view + 12, offset);
+            }
+            m_validity.append_valid(size());
+        }
+
+        /**
+         * Appends the string \c value.
+         */
+        void append(std::string_view value)
+        {
+            append<std::string_view>(value);
+        }
+
+        /**
+         * Appends a null value, its view structure is zeroed.
+         */
+        void append_null()
+        {
+            append_view();
+            m_validity.append_null(size());
+        }
+
+        /**
+         * Returns the number of values appended since the last call to \ref finish.
+         */
+        [[nodiscard]] size_type size() const noexcept
+        {
+            return m_views.size() / view_size;
+        }
+
+        [[nodiscard]] size_type null_count() const noexcept
+        {
+            return m_validity.null_count();
+        }
+
+        /**
+         * Returns the number of variadic buffers used so far.
+         */
+        [[nodiscard]] size_type variadic_buffer_count() const noexcept
+        {
+            return m_buffers.size();
+        }
+
+        /**
+         * Builds the array from the appended values and resets the builder.
+         *
+         * @param name The name of the array.
+         * @param metadata The metadata of the array.
+         * @return The built array, owning the buffers of the builder.
+         */
+        template <input_metadata_container METADATA_RANGE = std::vector<metadata_pair>>
+        [[nodiscard]] array_type
+        finish(std::optional<std::string_view> name = std::nullopt, std::optional<METADATA_RANGE> metadata = std::nullopt)
+        {
+            const size_type length = size();
+            if (m_buffers.empty())
+            {
+                start_buffer(0);
+            }
+            array_type result(
+                length,
+                std::move(m_views),
+                std::move(m_buffers),
+                m_validity.finish(length),
+                std::move(name),
+                std::move(metadata)
+            );
+            // The buffers moved into the array are left empty
+            m_views.clear();
+            m_buffers.clear();
+            return result;
+        }
+
+    private:
+
+        static void write_int32(std::uint8_t* dst, size_type value)
+        {
+            const auto v = static_cast<std::int32_t>(value);
+            std::memcpy(dst, &v, sizeof(std::int32_t));
+        }
+
+        // Appends a zeroed view structure and returns a pointer to it
+        std::uint8_t* append_view()
+        {
+            const size_type n = m_views.size();
+            detail::grow_to(m_views, n + view_size);
+            std::uint8_t* view = m_views.data() + n;
+            std::memset(view, 0, view_size);
+            return view;
+        }
+
+        void start_buffer(size_type capacity)
+        {
+            m_buffers.emplace_back(size_type(0));
+            m_buffers.back().reserve(capacity);
+        }
+
+        u8_buffer<std::uint8_t> m_views = u8_buffer<std::uint8_t>(size_type(0));
+        std::vector<u8_buffer<std::uint8_t>> m_buffers;
+        detail::builder_validity m_validity;
+        size_type m_variadic_buffer_size;
+    };
+
+    using string_view_builder = variable_size_binary_view_builder<string_view_array>;
+    using binary_view_builder = variable_size_binary_view_builder<binary_view_array>;
+}
@@ -0,0 +1,173 @@
+// Copyright 2024 Man Group Operations Limited
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <optional>
+#include <type_traits>
+
+#include "sparrow/compute/kernel_utils.hpp"
+#include "sparrow/primitive_array.hpp"
+
+namespace sparrow::compute
+{
+    /**
+     * Type of the result of \ref sum: \c std::int64_t for signed integers,
+     * \c std::uint64_t for unsigned integers and \c double for floating point types.
+     */
+    template <numeric_type T>
+    using sum_type_t = std::conditional_t<
+        std::signed_integral<T>,
+        std::int64_t,
+        std::conditional_t<std::unsigned_integral<T>, std::uint64_t, double>>;
+
+    /**
+     * Returns the sum of the valid elements of \c ar, or 0 if it has no valid element.
+     * Integer sums wrap around on overflow.
+     */
+    template <numeric_type T>
+    [[nodiscard]] sum_type_t<T> sum(const primitive_array<T>& ar);
+
+    /**
+     * Returns the arithmetic mean of the valid elements of \c ar, or an empty optional
+     * if it has no valid element.
+     */
+    template <numeric_type T>
+    [[nodiscard]] std::optional<double> mean(const primitive_array<T>& ar);
+
+    /**
+     * Returns the minimum of the valid elements of \c ar, or an empty optional if it
+     * has no valid element. NaN values are ignored.
+     */
+    template <numeric_type T>
+    [[nodiscard]] std::optional<T> min(const primitive_array<T>& ar);
+
+    /**
+     * Returns the maximum of the valid elements of \c ar, or an empty optional if it
+     * has no valid element. NaN values are ignored.
+     */
+    template <numeric_type T>
+    [[nodiscard]] std::optional<T> max(const primitive_array<T>& ar);
+
+    /******************
+     * Implementation *
+     ******************/
+
+    namespace detail
+    {
+        template <numeric_type T>
+        [[nodiscard]] constexpr bool is_nan(T value) noexcept
+        {
+            if constexpr (std::integral<T>)
+            {
+                return false;
+            }
+            else
+            {
+                return !(value == value);
+            }
+        }
+
+        // The aggregations only read the values of the valid ranges of the bitmap,
+        // which are processed as contiguous spans.
+        template <class Cmp, numeric_type T>
+        [[nodiscard]] std::optional<T> extremum(const primitive_array<T>& ar)
+        {
+            const auto chunk = make_chunk(ar);
+            const T* data = chunk.values.data();
+            std::optional<T> res;
+            for_each_valid_range(
+                chunk.validity,
+                chunk.size(),
+                [&](std::size_t begin, std::size_t end)
+                {
+                    std::size_t i = begin;
+                    if (!res.has_value())
+                    {
+                        while (i < end && is_nan(data[i]))
+                        {
+                            ++i;
+                        }
+                        if (i == end)
+                        {
+                            return;
+                        }
+                        res = data[i++];
+                    }
+                    T acc = *res;
+                    for (; i < end; ++i)
+                    {
+                        // NaN never compares true, so it is skipped
+                        acc = Cmp{}(data[i], acc) ? data[i] : acc;
+                    }
+                    res = acc;
+                }
+            );
+            return res;
+        }
+    }
+
+    template <numeric_type T>
+    sum_type_t<T> sum(const primitive_array<T>& ar)
+    {
+        using result_type = sum_type_t<T>;
+        // Signed integers are summed as unsigned so that overflows wrap around
+        using acc_type = std::conditional_t<std::integral<T>, std::uint64_t, double>;
+        const auto chunk = detail::make_chunk(ar);
+        const T* data = chunk.values.data();
+        acc_type acc = 0;
+        detail::for_each_valid_range(
+            chunk.validity,
+            chunk.size(),
+            [&](std::size_t begin, std::size_t end)
+            {
+                acc_type range_acc = 0;
+                for (std::size_t i = begin; i < end; ++i)
+                {
+                    range_acc += static_cast<acc_type>(data[i]);
+                }
+                acc += range_acc;
+            }
+        );
+        return static_cast<result_type>(acc);
+    }
+
+    template <numeric_type T>
+    std::optional<double> mean(const primitive_array<T>& ar)
+    {
+        const auto chunk = detail::make_chunk(ar);
+        const std::size_t valid_count = chunk.size() - (detail::all_valid(chunk.validity) ? 0 : chunk.null_count());
+        if (valid_count == 0)
+        {
+            return std::nullopt;
+        }
+        return static_cast<double>(sum(ar)) / static_cast<double>(valid_count);
+    }
+
+    template <numeric_type T>
+    std::optional<T> min(const primitive_array<T>& ar)
+    {
+        return detail::extremum<std::less<>>(ar);
+    }
+
+    template <numeric_type T>
+    std::optional<T> max(const primitive_array<T>& ar)
+    {
+        return detail::extremum<std::greater<>>(ar);
+    }
+}
@@ -0,0 +1,356 @@
+// Copyright 2024 Man Group Operations Limited
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <algorithm>
+#include <concepts>
+#include <cstddef>
+#include <optional>
+#include <stdexcept>
+#include <type_traits>
+
+#include "sparrow/compute/kernel_utils.hpp"
+#include "sparrow/primitive_array.hpp"
+
+namespace sparrow::compute
+{
+    /**
+     * @name Element-wise arithmetic kernels
+     *
+     * These kernels compute a new primitive array from two primitive arrays of
+     * the same size, or from a primitive array and a scalar. The i-th element of
+     * the result is null if any of the operands is null at position i.
+     *
+     * The kernels read the data buffers directly (no nullable proxies are involved)
+     * in tight loops that the compiler can vectorize; validity bitmaps are combined
+     * a byte at a time. Integer arithmetic wraps around on overflow.
+     *
+     * @throws std::invalid_argument if the arrays do not have the same size.
+     * @{
+     */
+    template <numeric_type T>
+    [[nodiscard]] primitive_array<T> add(const primitive_array<T>& lhs, const primitive_array<T>& rhs);
+    template <numeric_type T>
+    [[nodiscard]] primitive_array<T> add(const primitive_array<T>& lhs, std::type_identity_t<T> rhs);
+    template <numeric_type T>
+    [[nodiscard]] primitive_array<T> add(std::type_identity_t<T> lhs, const primitive_array<T>& rhs);
+
+    template <numeric_type T>
+    [[nodiscard]] primitive_array<T> subtract(const primitive_array<T>& lhs, const primitive_array<T>& rhs);
+    template <numeric_type T>
+    [[nodiscard]] primitive_array<T> subtract(const primitive_array<T>& lhs, std::type_identity_t<T> rhs);
+    template <numeric_type T>
+    [[nodiscard]] primitive_array<T> subtract(std::type_identity_t<T> lhs, const primitive_array<T>& rhs);
+
+    template <numeric_type T>
+    [[nodiscard]] primitive_array<T> multiply(const primitive_array<T>& lhs, const primitive_array<T>& rhs);
+    template <numeric_type T>
+    [[nodiscard]] primitive_array<T> multiply(const primitive_array<T>& lhs, std::type_identity_t<T> rhs);
+    template <numeric_type T>
+    [[nodiscard]] primitive_array<T> multiply(std::type_identity_t<T> lhs, const primitive_array<T>& rhs);
+    /** @} */
+
+    /**
+     * @name Element-wise division kernels
+     *
+     * Same as the other arithmetic kernels. Floating point division follows IEEE 754.
+     * Integer division truncates toward zero; null elements of the result are set to 0
+     * in the data buffer.
+     *
+     * @throws std::invalid_argument if the arrays do not have the same size.
+     * @throws std::domain_error for an integer division by zero at a position where
+     *         both operands are valid.
+     * @{
+     */
+    template <numeric_type T>
+    [[nodiscard]] primitive_array<T> divide(const primitive_array<T>& lhs, const primitive_array<T>& rhs);
+    template <numeric_type T>
+    [[nodiscard]] primitive_array<T> divide(const primitive_array<T>& lhs, std::type_identity_t<T> rhs);
+    template <numeric_type T>
+    [[nodiscard]] primitive_array<T> divide(std::type_identity_t<T> lhs, const primitive_array<T>& rhs);
+    /** @} */
+
+    /******************
+     * Implementation *
+     ******************/
+
+    namespace detail
+    {
+        // Integers are computed in an unsigned type at least as wide as unsigned int
+        // so that overflows wrap around instead of being undefined behavior.
+        template <class T>
+        using wrapping_type = std::conditional_t<(sizeof(T) < sizeof(unsigned)), unsigned, std::make_unsigned_t<T>>;
+
+        struct add_op
+        {
+            static constexpr bool checks_divisor = false;
+
+            template <class T>
+            [[nodiscard]] static constexpr T apply(T a, T b) noexcept
+            {
+                if constexpr (std::integral<T>)
+                {
+                    using W = wrapping_type<T>;
+                    return static_cast<T>(static_cast<W>(a) + static_cast<W>(b));
+                }
+                else
+                {
+                    return static_cast<T>(a + b);
+                }
+            }
+        };
+
+        struct subtract_op
+        {
+            static constexpr bool checks_divisor = false;
+
+            template <class T>
+            [[nodiscard]] static constexpr T apply(T a, T b) noexcept
+            {
+                if constexpr (std::integral<T>)
+                {
+                    using W = wrapping_type<T>;
+                    return static_cast<T>(static_cast<W>(a) - static_cast<W>(b));
+                }
+                else
+                {
+                    return static_cast<T>(a - b);
+                }
+            }
+        };
+
+        struct multiply_op
+        {
+            static constexpr bool checks_divisor = false;
+
+            template <class T>
+            [[nodiscard]] static constexpr T apply(T a, T b) noexcept
+            {
+                if constexpr (std::integral<T>)
+                {
+                    using W = wrapping_type<T>;
+                    return static_cast<T>(static_cast<W>(a) * static_cast<W>(b));
+                }
+                else
+                {
+                    return static_cast<T>(a * b);
+                }
+            }
+        };
+
+        struct divide_op
+        {
+            // Only integer division needs to check its divisor
+            static constexpr bool checks_divisor = true;
+
+            template <class T>
+            [[nodiscard]] static constexpr T apply(T a, T b) noexcept
+            {
+                if constexpr (std::signed_integral<T>)
+                {
+                    // min / -1 overflows, it wraps around to min like the other kernels
+                    using W = wrapping_type<T>;
+                    return b == T(-1) ? static_cast<T>(W(0) - static_cast<W>(a)) : static_cast<T>(a / b);
+                }
+                else
+                {
+                    return static_cast<T>(a / b);
+                }
+            }
+        };
+
+        template <class T>
+        struct array_operand
+        {
+            [[nodiscard]] constexpr T operator[](std::size_t i) const noexcept
+            {
+                return data[i];
+            }
+
+            const T* data;
+        };
+
+        template <class T>
+        struct scalar_operand
+        {
+            [[nodiscard]] constexpr T operator[](std::size_t) const noexcept
+            {
+                return value;
+            }
+
+            T value;
+        };
+
+        template <class Op, numeric_type T, class L, class R>
+        [[nodiscard]] primitive_array<T>
+        arithmetic_kernel(std::size_t size, L lhs, R rhs, const validity_view& lhs_validity, const validity_view& rhs_validity)
+        {
+            u8_buffer<T> data(size);
+            T* out = data.data();
+            if constexpr (Op::checks_divisor && std::integral<T>)
+            {
+                // The divisor must be checked on valid positions only: null slots
+                // may hold any value, including 0.
+                const bool valid = all_valid(lhs_validity) && all_valid(rhs_validity);
+                std::optional<validity_bitmap> validity;
+                if (!valid)
+                {
+                    validity = combine_validity(lhs_validity, rhs_validity, size);
+                }
+                const validity_view view = valid ? scalar_validity(size)
+                                                 : validity_view(validity->data(), size, 0, validity->null_count());
+                std::fill(out, out + size, T(0));
+                for_each_valid_range(
+                    view,
+                    size,
+                    [&](std::size_t begin, std::size_t end)
+                    {
+                        for (std::size_t i = begin; i < end; ++i)
+                        {
+                            if (rhs[i] == T(0))
+                            {
+                                throw std::domain_error("compute::divide: integer division by zero");
+                            }
+                            out[i] = Op::apply(lhs[i], rhs[i]);
+                        }
+                    }
+                );
+                return valid ? primitive_array<T>(std::move(data), size, true)
+                             : primitive_array<T>(std::move(data), size, std::move(*validity));
+            }
+            else
+            {
+                for (std::size_t i = 0; i < size; ++i)
+                {
+                    out[i] = Op::apply(lhs[i], rhs[i]);
+                }
+                return make_result_array(std::move(data), size, lhs_validity, rhs_validity);
+            }
+        }
+
+        template <class Op, numeric_type T>
+        [[nodiscard]] primitive_array<T> arithmetic_kernel(const primitive_array<T>& lhs, const primitive_array<T>& rhs)
+        {
+            check_same_size(lhs.size(), rhs.size());
+            const auto lhs_chunk = make_chunk(lhs);
+            const auto rhs_chunk = make_chunk(rhs);
+            return arithmetic_kernel<Op, T>(
+                lhs_chunk.size(),
+                array_operand<T>{lhs_chunk.values.data()},
+                array_operand<T>{rhs_chunk.values.data()},
+                lhs_chunk.validity,
+                rhs_chunk.validity
+            );
+        }
+
+        template <class Op, numeric_type T>
+        [[nodiscard]] primitive_array<T> arithmetic_kernel(const primitive_array<T>& lhs, T rhs)
+        {
+            const auto lhs_chunk = make_chunk(lhs);
+            return arithmetic_kernel<Op, T>(
+                lhs_chunk.size(),
+                array_operand<T>{lhs_chunk.values.data()},
+                scalar_operand<T>{rhs},
+                lhs_chunk.validity,
+                scalar_validity(lhs_chunk.size())
+            );
+        }
+
+        template <class Op, numeric_type T>
+        [[nodiscard]] primitive_array<T> arithmetic_kernel(T lhs, const primitive_array<T>& rhs)
+        {
+            const auto rhs_chunk = make_chunk(rhs);
+            return arithmetic_kernel<Op, T>(
+                rhs_chunk.size(),
+                scalar_operand<T>{lhs},
+                array_operand<T>{rhs_chunk.values.data()},
+                scalar_validity(rhs_chunk.size()),
+                rhs_chunk.validity
+            );
+        }
+    }
+
+    template <numeric_type T>
+    primitive_array<T> add(const primitive_array<T>& lhs, const primitive_array<T>& rhs)
+    {
+        return detail::arithmetic_kernel<detail::add_op>(lhs, rhs);
+    }
+
+    template <numeric_type T>
+    primitive_array<T> add(const primitive_array<T>& lhs, std::type_identity_t<T> rhs)
+    {
+        return detail::arithmetic_kernel<detail::add_op, T>(lhs, rhs);
+    }
+
+    template <numeric_type T>
+    primitive_array<T> add(std::type_identity_t<T> lhs, const primitive_array<T>& rhs)
+    {
+        return detail::arithmetic_kernel<detail::add_op, T>(lhs, rhs);
+    }
+
+    template <numeric_type T>
+    primitive_array<T> subtract(const primitive_array<T>& lhs, const primitive_array<T>& rhs)
+    {
+        return detail::arithmetic_kernel<detail::subtract_op>(lhs, rhs);
+    }
+
+    template <numeric_type T>
+    primitive_array<T> subtract(const primitive_array<T>& lhs, std::type_identity_t<T> rhs)
+    {
+        return detail::arithmetic_kernel<detail::subtract_op, T>(lhs, rhs);
+    }
+
+    template <numeric_type T>
+    primitive_array<T> subtract(std::type_identity_t<T> lhs, const primitive_array<T>& rhs)
+    {
+        return detail::arithmetic_kernel<detail::subtract_op, T>(lhs, rhs);
+    }
+
+    template <numeric_type T>
+    primitive_array<T> multiply(const primitive_array<T>& lhs, const primitive_array<T>& rhs)
+    {
+        return detail::arithmetic_kernel<detail::multiply_op>(lhs, rhs);
+    }
+
+    template <numeric_type T>
+    primitive_array<T> multiply(const primitive_array<T>& lhs, std::type_identity_t<T> rhs)
+    {
+        return detail::arithmetic_kernel<detail::multiply_op, T>(lhs, rhs);
+    }
+
+    template <numeric_type T>
+    primitive_array<T> multiply(std::type_identity_t<T> lhs, const primitive_array<T>& rhs)
+    {
+        return detail::arithmetic_kernel<detail::multiply_op, T>(lhs, rhs);
+    }
+
+    template <numeric_type T>
+    primitive_array<T> divide(const primitive_array<T>& lhs, const primitive_array<T>& rhs)
+    {
+        return detail::arithmetic_kernel<detail::divide_op>(lhs, rhs);
+    }
+
+    template <numeric_type T>
+    primitive_array<T> divide(const primitive_array<T>& lhs, std::type_identity_t<T> rhs)
+    {
+        return detail::arithmetic_kernel<detail::divide_op, T>(lhs, rhs);
+    }
+
+    template <numeric_type T>
+    primitive_array<T> divide(std::type_identity_t<T> lhs, const primitive_array<T>& rhs)
+    {
+        return detail::arithmetic_kernel<detail::divide_op, T>(lhs, rhs);
+    }
+}
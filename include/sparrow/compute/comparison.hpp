@@ -0,0 +1,191 @@
+// Copyright 2024 Man Group Operations Limited
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <type_traits>
+
+#include "sparrow/buffer/dynamic_bitset/dynamic_bitset.hpp"
+#include "sparrow/compute/kernel_utils.hpp"
+#include "sparrow/primitive_array.hpp"
+
+namespace sparrow::compute
+{
+    /**
+     * @name Element-wise comparison kernels
+     *
+     * These kernels compare two primitive arrays of the same size, or a primitive
+     * array and a scalar, and return the result as a mask: the i-th bit is set if
+     * and only if both operands are valid at position i and the comparison holds.
+     * The mask can be used directly as the validity bitmap of a new array.
+     *
+     * Floating point values are compared according to IEEE 754, i.e. a comparison
+     * involving NaN is false, except for \c not_equal.
+     *
+     * @throws std::invalid_argument if the arrays do not have the same size.
+     * @{
+     */
+    template <numeric_type T>
+    [[nodiscard]] dynamic_bitset<std::uint8_t> equal(const primitive_array<T>& lhs, const primitive_array<T>& rhs);
+    template <numeric_type T>
+    [[nodiscard]] dynamic_bitset<std::uint8_t> equal(const primitive_array<T>& lhs, std::type_identity_t<T> rhs);
+
+    template <numeric_type T>
+    [[nodiscard]] dynamic_bitset<std::uint8_t>
+    not_equal(const primitive_array<T>& lhs, const primitive_array<T>& rhs);
+    template <numeric_type T>
+    [[nodiscard]] dynamic_bitset<std::uint8_t> not_equal(const primitive_array<T>& lhs, std::type_identity_t<T> rhs);
+
+    template <numeric_type T>
+    [[nodiscard]] dynamic_bitset<std::uint8_t> less(const primitive_array<T>& lhs, const primitive_array<T>& rhs);
+    template <numeric_type T>
+    [[nodiscard]] dynamic_bitset<std::uint8_t> less(const primitive_array<T>& lhs, std::type_identity_t<T> rhs);
+
+    template <numeric_type T>
+    [[nodiscard]] dynamic_bitset<std::uint8_t>
+    less_equal(const primitive_array<T>& lhs, const primitive_array<T>& rhs);
+    template <numeric_type T>
+    [[nodiscard]] dynamic_bitset<std::uint8_t> less_equal(const primitive_array<T>& lhs, std::type_identity_t<T> rhs);
+
+    template <numeric_type T>
+    [[nodiscard]] dynamic_bitset<std::uint8_t> greater(const primitive_array<T>& lhs, const primitive_array<T>& rhs);
+    template <numeric_type T>
+    [[nodiscard]] dynamic_bitset<std::uint8_t> greater(const primitive_array<T>& lhs, std::type_identity_t<T> rhs);
+
+    template <numeric_type T>
+    [[nodiscard]] dynamic_bitset<std::uint8_t>
+    greater_equal(const primitive_array<T>& lhs, const primitive_array<T>& rhs);
+    template <numeric_type T>
+    [[nodiscard]] dynamic_bitset<std::uint8_t>
+    greater_equal(const primitive_array<T>& lhs, std::type_identity_t<T> rhs);
+    /** @} */
+
+    /******************
+     * Implementation *
+     ******************/
+
+    namespace detail
+    {
+        template <class Cmp, numeric_type T>
+        [[nodiscard]] dynamic_bitset<std::uint8_t>
+        comparison_kernel(const primitive_array<T>& lhs, const primitive_array<T>& rhs)
+        {
+            check_same_size(lhs.size(), rhs.size());
+            const auto lhs_chunk = make_chunk(lhs);
+            const auto rhs_chunk = make_chunk(rhs);
+            const T* lhs_data = lhs_chunk.values.data();
+            const T* rhs_data = rhs_chunk.values.data();
+            return make_mask(
+                lhs_chunk.validity,
+                rhs_chunk.validity,
+                lhs_chunk.size(),
+                [lhs_data, rhs_data](std::size_t i)
+                {
+                    return Cmp{}(lhs_data[i], rhs_data[i]);
+                }
+            );
+        }
+
+        template <class Cmp, numeric_type T>
+        [[nodiscard]] dynamic_bitset<std::uint8_t> comparison_kernel(const primitive_array<T>& lhs, T rhs)
+        {
+            const auto lhs_chunk = make_chunk(lhs);
+            const T* lhs_data = lhs_chunk.values.data();
+            return make_mask(
+                lhs_chunk.validity,
+                scalar_validity(lhs_chunk.size()),
+                lhs_chunk.size(),
+                [lhs_data, rhs](std::size_t i)
+                {
+                    return Cmp{}(lhs_data[i], rhs);
+                }
+            );
+        }
+    }
+
+    template <numeric_type T>
+    dynamic_bitset<std::uint8_t> equal(const primitive_array<T>& lhs, const primitive_array<T>& rhs)
+    {
+        return detail::comparison_kernel<std::equal_to<>>(lhs, rhs);
+    }
+
+    template <numeric_type T>
+    dynamic_bitset<std::uint8_t> equal(const primitive_array<T>& lhs, std::type_identity_t<T> rhs)
+    {
+        return detail::comparison_kernel<std::equal_to<>, T>(lhs, rhs);
+    }
+
+    template <numeric_type T>
+    dynamic_bitset<std::uint8_t> not_equal(const primitive_array<T>& lhs, const primitive_array<T>& rhs)
+    {
+        return detail::comparison_kernel<std::not_equal_to<>>(lhs, rhs);
+    }
+
+    template <numeric_type T>
+    dynamic_bitset<std::uint8_t> not_equal(const primitive_array<T>& lhs, std::type_identity_t<T> rhs)
+    {
+        return detail::comparison_kernel<std::not_equal_to<>, T>(lhs, rhs);
+    }
+
+    template <numeric_type T>
+    dynamic_bitset<std::uint8_t> less(const primitive_array<T>& lhs, const primitive_array<T>& rhs)
+    {
+        return detail::comparison_kernel<std::less<>>(lhs, rhs);
+    }
+
+    template <numeric_type T>
+    dynamic_bitset<std::uint8_t> less(const primitive_array<T>& lhs, std::type_identity_t<T> rhs)
+    {
+        return detail::comparison_kernel<std::less<>, T>(lhs, rhs);
+    }
+
+    template <numeric_type T>
+    dynamic_bitset<std::uint8_t> less_equal(const primitive_array<T>& lhs, const primitive_array<T>& rhs)
+    {
+        return detail::comparison_kernel<std::less_equal<>>(lhs, rhs);
+    }
+
+    template <numeric_type T>
+    dynamic_bitset<std::uint8_t> less_equal(const primitive_array<T>& lhs, std::type_identity_t<T> rhs)
+    {
+        return detail::comparison_kernel<std::less_equal<>, T>(lhs, rhs);
+    }
+
+    template <numeric_type T>
+    dynamic_bitset<std::uint8_t> greater(const primitive_array<T>& lhs, const primitive_array<T>& rhs)
+    {
+        return detail::comparison_kernel<std::greater<>>(lhs, rhs);
+    }
+
+    template <numeric_type T>
+    dynamic_bitset<std::uint8_t> greater(const primitive_array<T>& lhs, std::type_identity_t<T> rhs)
+    {
+        return detail::comparison_kernel<std::greater<>, T>(lhs, rhs);
+    }
+
+    template <numeric_type T>
+    dynamic_bitset<std::uint8_t> greater_equal(const primitive_array<T>& lhs, const primitive_array<T>& rhs)
+    {
+        return detail::comparison_kernel<std::greater_equal<>>(lhs, rhs);
+    }
+
+    template <numeric_type T>
+    dynamic_bitset<std::uint8_t> greater_equal(const primitive_array<T>& lhs, std::type_identity_t<T> rhs)
+    {
+        return detail::comparison_kernel<std::greater_equal<>, T>(lhs, rhs);
+    }
+}
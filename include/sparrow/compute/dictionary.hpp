@@ -0,0 +1,82 @@
+// Copyright 2024 Man Group Operations Limited
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <span>
+#include <vector>
+
+#include "sparrow/array.hpp"
+#include "sparrow/config/config.hpp"
+
+namespace sparrow::compute
+{
+    /**
+     * @brief Dictionary encodes an array.
+     *
+     * The dictionary is built in a single pass over the values: each value is looked up
+     * by its raw bytes in an open-addressing hash table, and appended to the dictionary
+     * the first time it is seen. The values of the dictionary are therefore in order of
+     * first appearance. Null values are encoded as null keys and do not appear in the
+     * dictionary.
+     *
+     * The keys use the narrowest signed integer type able to index the dictionary.
+     *
+     * Supported layouts: primitive (except bool), temporal, decimal, interval, fixed
+     * width binary, string, binary, large string and large binary.
+     *
+     * @param ar The array to encode.
+     * @return A dictionary encoded array with the same logical values as \c ar.
+     *
+     * @throws std::invalid_argument if the layout of \c ar is not supported.
+     */
+    [[nodiscard]] SPARROW_API array dictionary_encode(const array& ar);
+
+    /**
+     * @brief Decodes a dictionary encoded array into a dense array of the dictionary type.
+     *
+     * The values are gathered from the dictionary buffers with one copy per element, fixed
+     * width values of 1, 2, 4, 8 and 16 bytes being copied with typed loads and stores.
+     * An element is null if its key is null or if it refers to a null dictionary value.
+     *
+     * The dictionary must have one of the layouts supported by \ref dictionary_encode.
+     *
+     * @param ar The dictionary encoded array to decode.
+     * @return A new array owning its buffers.
+     *
+     * @throws std::invalid_argument if \c ar is not dictionary encoded or if the layout of
+     *         its dictionary is not supported.
+     * @throws std::out_of_range if a non null key does not index the dictionary.
+     */
+    [[nodiscard]] SPARROW_API array dictionary_decode(const array& ar);
+
+    /**
+     * @brief Re-encodes dictionary encoded arrays against a common dictionary.
+     *
+     * The unified dictionary contains the values of the dictionary of \c arrays[0], followed
+     * by the values of the next dictionaries that were not seen before. The keys of each
+     * array are transposed to the unified dictionary, and use the narrowest signed integer
+     * type able to index it. All the returned arrays share the buffers of the unified
+     * dictionary.
+     *
+     * @param arrays The dictionary encoded arrays to unify, their dictionaries must have
+     *               the same format.
+     * @return The arrays encoded against the unified dictionary, in the same order as \c arrays.
+     *
+     * @throws std::invalid_argument if an array is not dictionary encoded, if the dictionaries
+     *         do not have the same format or if their layout is not supported.
+     * @throws std::out_of_range if a non null key does not index its dictionary.
+     */
+    [[nodiscard]] SPARROW_API std::vector<array> unify_dictionaries(std::span<const array> arrays);
+}
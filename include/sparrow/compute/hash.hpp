@@ -0,0 +1,142 @@
+// Copyright 2024 Man Group Operations Limited
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "sparrow/array.hpp"
+#include "sparrow/buffer/dynamic_bitset/dynamic_bitset.hpp"
+#include "sparrow/config/config.hpp"
+#include "sparrow/primitive_array.hpp"
+#include "sparrow/record_batch.hpp"
+
+namespace sparrow::compute
+{
+    /**
+     * @brief Hashes each element of an array.
+     *
+     * Fixed width values and strings are hashed from their raw bytes, a word at a time.
+     * A dictionary encoded array hashes its dictionary once and gathers the hashes of its
+     * keys, so that it gets the same hashes as its decoded array. Structs combine the
+     * hashes of their fields, and lists the hashes of their elements. All the null
+     * elements have the same hash.
+     *
+     * Equal elements, in the sense of \ref equals, have equal hashes. The hashes are not
+     * stable across versions of sparrow and must not be persisted.
+     *
+     * Supported layouts: null, bool, primitive, temporal, decimal, interval, fixed width
+     * binary, string, binary, large string, large binary, list, large list, fixed size list,
+     * struct and dictionary encoded arrays of these layouts.
+     *
+     * @param ar The array to hash.
+     * @return An array without nulls of \c ar.size() hashes.
+     *
+     * @throws std::invalid_argument if the layout of \c ar is not supported.
+     */
+    [[nodiscard]] SPARROW_API primitive_array<std::uint64_t> hash(const array& ar);
+
+    /**
+     * @brief Hashes the rows of a record batch on some of its columns.
+     *
+     * The hashes of the columns are computed with \ref hash and combined in the order
+     * of \c columns.
+     *
+     * @param rb The record batch to hash.
+     * @param columns The names of the columns to hash.
+     * @return An array without nulls of \c rb.nb_rows() hashes.
+     *
+     * @throws std::out_of_range if a column does not exist.
+     * @throws std::invalid_argument if the layout of a column is not supported.
+     */
+    [[nodiscard]] SPARROW_API primitive_array<std::uint64_t>
+    hash(const record_batch& rb, std::span<const std::string> columns);
+
+    /**
+     * @brief Compares two arrays element by element.
+     *
+     * Unlike \ref equal, two null elements are considered equal, so that this kernel can
+     * be used to find duplicate values. Non null values are compared by their raw bytes:
+     * for floating point numbers, a NaN is equal to a NaN with the same bits, and 0.0 is
+     * not equal to -0.0. When neither array has nulls, fixed width values are compared
+     * a block of memory at a time. A dictionary encoded array is compared through its
+     * dictionary and must be compared with a dictionary encoded array.
+     *
+     * Supported layouts: the layouts supported by \ref hash.
+     *
+     * @param lhs The first array.
+     * @param rhs The second array.
+     * @return A bitmap whose bit i is set if the elements i of \c lhs and \c rhs are equal.
+     *
+     * @throws std::invalid_argument if the arrays do not have the same size or the same
+     *         format, or if their layout is not supported.
+     */
+    [[nodiscard]] SPARROW_API dynamic_bitset<std::uint8_t> equals(const array& lhs, const array& rhs);
+
+    /**
+     * Result of \ref group_by: the group of each row, and the first row of each group.
+     */
+    struct grouping
+    {
+        std::vector<std::size_t> group_ids;
+        std::vector<std::size_t> first_rows;
+    };
+
+    /**
+     * @brief Groups the rows of a record batch with equal values of key columns.
+     *
+     * The groups are numbered in order of first appearance. Rows whose keys are null are
+     * grouped together, as \ref equals considers null values equal. Taking the first rows
+     * of the groups removes the duplicate rows: <tt>take(rb, group_by(rb, keys).first_rows)</tt>.
+     *
+     * @param rb The record batch whose rows are grouped.
+     * @param keys The names of the key columns.
+     * @return The group of each row of \c rb and the first row of each group.
+     *
+     * @throws std::out_of_range if a key column does not exist.
+     * @throws std::invalid_argument if the layout of a key column is not supported.
+     */
+    [[nodiscard]] SPARROW_API grouping group_by(const record_batch& rb, std::span<const std::string> keys);
+
+    /**
+     * @brief Computes the inner join of two record batches on equal key columns.
+     *
+     * A hash table is built on the keys of \c right, and probed with the keys of \c left.
+     * As in SQL, rows with a null key do not match any row. The result can be used with
+     * \ref take to gather the joined columns of both record batches.
+     *
+     * @param left The probe side of the join.
+     * @param left_keys The names of the key columns of \c left.
+     * @param right The build side of the join.
+     * @param right_keys The names of the key columns of \c right, the key columns are
+     *                   matched by position with \c left_keys.
+     * @return The pairs of matching rows (left row, right row), ordered by left row, and
+     *         by right row for a given left row.
+     *
+     * @throws std::out_of_range if a key column does not exist.
+     * @throws std::invalid_argument if the numbers of keys differ, if matching key columns
+     *         do not have the same format, or if the layout of a key column is not supported.
+     */
+    [[nodiscard]] SPARROW_API std::vector<std::pair<std::size_t, std::size_t>> hash_join(
+        const record_batch& left,
+        std::span<const std::string> left_keys,
+        const record_batch& right,
+        std::span<const std::string> right_keys
+    );
+}
@@ -0,0 +1,400 @@
+// Copyright 2024 Man Group Operations Limited
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <type_traits>
+
+#include "sparrow/arrow_interface/arrow_array_schema_proxy.hpp"
+#include "sparrow/buffer/buffer.hpp"
+#include "sparrow/buffer/dynamic_bitset/dynamic_bitset.hpp"
+#include "sparrow/buffer/dynamic_bitset/dynamic_bitset_view.hpp"
+#include "sparrow/concatenate.hpp"
+#include "sparrow/details/3rdparty/float16_t.hpp"
+#include "sparrow/primitive_array.hpp"
+#include "sparrow/types/data_type.hpp"
+#include "sparrow/typed_visit.hpp"
+#include "sparrow/u8_buffer.hpp"
+
+namespace sparrow::compute
+{
+    /**
+     * Matches the value types supported by the numeric compute kernels:
+     * integers (except bool), floating point numbers and float16_t.
+     */
+    template <class T>
+    concept numeric_type = (std::integral<T> && !std::same_as<T, bool>) || std::floating_point<T>
+                           || std::same_as<T, float16_t>;
+
+    namespace detail
+    {
+        using validity_view = dynamic_bitset_view<const std::uint8_t>;
+
+        template <numeric_type T>
+        [[nodiscard]] values_chunk<T> make_chunk(const primitive_array<T>& ar)
+        {
+            return sparrow::detail::make_values_chunk(ar);
+        }
+
+        [[nodiscard]] inline bool all_valid(const validity_view& validity) noexcept
+        {
+            return validity.data() == nullptr || validity.null_count() == 0;
+        }
+
+        // Validity of a scalar operand broadcast to the size of the array operand
+        [[nodiscard]] inline validity_view scalar_validity(std::size_t size) noexcept
+        {
+            return validity_view(nullptr, size, 0, 0);
+        }
+
+        /**
+         * Returns the 8 validity bits of \c validity starting at the element 8 * \c byte_index,
+         * regardless of the bit offset of the view. The 8 bits must be in the range of the view.
+         */
+        [[nodiscard]] inline std::uint8_t load_validity_byte(const validity_view& validity, std::size_t byte_index) noexcept
+        {
+            const std::uint8_t* data = validity.data();
+            const std::size_t bit = validity.offset() + byte_index * 8;
+            const std::size_t shift = bit % 8;
+            if (shift == 0)
+            {
+                return data[bit / 8];
+            }
+            return static_cast<std::uint8_t>((data[bit / 8] >> shift) | (data[bit / 8 + 1] << (8 - shift)));
+        }
+
+        /**
+         * Calls \c func(begin, end) for each maximal range of consecutive valid elements
+         * in the first \c size elements of \c validity. The bitmap is scanned a byte at a
+         * time so that fully valid or fully null bytes do not require per-bit work.
+         */
+        template <class F>
+        void for_each_valid_range(const validity_view& validity, std::size_t size, F&& func)
+        {
+            if (all_valid(validity))
+            {
+                if (size != 0)
+                {
+                    func(std::size_t(0), size);
+                }
+                return;
+            }
+
+            std::size_t run_start = 0;
+            bool in_run = false;
+            auto open_run = [&](std::size_t i)
+            {
+                if (!in_run)
+                {
+                    run_start = i;
+                    in_run = true;
+                }
+            };
+            auto close_run = [&](std::size_t i)
+            {
+                if (in_run)
+                {
+                    func(run_start, i);
+                    in_run = false;
+                }
+            };
+
+            const std::size_t full_bytes = size / 8;
+            for (std::size_t k = 0; k < full_bytes; ++k)
+            {
+                const std::uint8_t bits = load_validity_byte(validity, k);
+                const std::size_t base = k * 8;
+                if (bits == 0xFF)
+                {
+                    open_run(base);
+                }
+                else if (bits == 0)
+                {
+                    close_run(base);
+                }
+                else
+                {
+                    for (std::size_t j = 0; j < 8; ++j)
+                    {
+                        if ((bits >> j) & 1u)
+                        {
+                            open_run(base + j);
+                        }
+                        else
+                        {
+                            close_run(base + j);
+                        }
+                    }
+                }
+            }
+            for (std::size_t i = full_bytes * 8; i < size; ++i)
+            {
+                if (validity.test(i))
+                {
+                    open_run(i);
+                }
+                else
+                {
+                    close_run(i);
+                }
+            }
+            close_run(size);
+        }
+
+        /**
+         * Builds a bitmap of \c size bits whose bit i is set if \c predicate(i) holds
+         * and both \c lhs and \c rhs are valid at i. The output is filled a byte at a time.
+         */
+        template <class P>
+        [[nodiscard]] dynamic_bitset<std::uint8_t>
+        make_mask(const validity_view& lhs, const validity_view& rhs, std::size_t size, P&& predicate)
+        {
+            using storage_type = dynamic_bitset<std::uint8_t>::storage_type;
+            const std::size_t byte_count = (size + 7) / 8;
+            const std::size_t full_bytes = size / 8;
+            const bool lhs_all_valid = all_valid(lhs);
+            const bool rhs_all_valid = all_valid(rhs);
+            storage_type storage(byte_count, std::uint8_t(0), validity_bitmap::default_allocator());
+            std::uint8_t* out = storage.data();
+            for (std::size_t k = 0; k < full_bytes; ++k)
+            {
+                std::uint8_t bits = 0;
+                for (std::size_t j = 0; j < 8; ++j)
+                {
+                    bits |= static_cast<std::uint8_t>(static_cast<std::uint8_t>(predicate(k * 8 + j)) << j);
+                }
+                if (!lhs_all_valid)
+                {
+                    bits &= load_validity_byte(lhs, k);
+                }
+                if (!rhs_all_valid)
+                {
+                    bits &= load_validity_byte(rhs, k);
+                }
+                out[k] = bits;
+            }
+            for (std::size_t i = full_bytes * 8; i < size; ++i)
+            {
+                const bool valid = (lhs_all_valid || lhs.test(i)) && (rhs_all_valid || rhs.test(i));
+                if (valid && predicate(i))
+                {
+                    out[i / 8] |= static_cast<std::uint8_t>(1u << (i % 8));
+                }
+            }
+            return dynamic_bitset<std::uint8_t>(std::move(storage), size, 0);
+        }
+
+        /**
+         * Returns the validity bitmap of the result of an element-wise operation on
+         * two inputs: an element is valid if it is valid in both inputs.
+         */
+        [[nodiscard]] inline validity_bitmap
+        combine_validity(const validity_view& lhs, const validity_view& rhs, std::size_t size)
+        {
+            return make_mask(
+                lhs,
+                rhs,
+                size,
+                [](std::size_t)
+                {
+                    return true;
+                }
+            );
+        }
+
+        inline void check_same_size(std::size_t lhs_size, std::size_t rhs_size)
+        {
+            if (lhs_size != rhs_size)
+            {
+                throw std::invalid_argument(
+                    "compute: arrays must have the same size, got " + std::to_string(lhs_size) + " and "
+                    + std::to_string(rhs_size)
+                );
+            }
+        }
+
+        using bytes_view = std::span<const std::uint8_t>;
+
+        [[nodiscard]] constexpr std::uint64_t mix(std::uint64_t h) noexcept
+        {
+            h ^= h >> 32;
+            h *= 0xd6e8feb86659fd93ULL;
+            h ^= h >> 32;
+            return h;
+        }
+
+        // Hashes the bytes a word at a time
+        [[nodiscard]] inline std::uint64_t hash_bytes(bytes_view bytes) noexcept
+        {
+            std::uint64_t h = mix(bytes.size() * 0x9e3779b97f4a7c15ULL);
+            std::size_t i = 0;
+            for (; i + 8 <= bytes.size(); i += 8)
+            {
+                std::uint64_t word = 0;
+                std::memcpy(&word, bytes.data() + i, 8);
+                h = mix(h ^ word);
+            }
+            if (i < bytes.size())
+            {
+                std::uint64_t word = 0;
+                std::memcpy(&word, bytes.data() + i, bytes.size() - i);
+                h = mix(h ^ word);
+            }
+            return h;
+        }
+
+        // Validity of the elements of an array, all the elements are valid when the
+        // array has no validity bitmap
+        class validity_reader
+        {
+        public:
+
+            explicit validity_reader(const arrow_proxy& proxy)
+                : m_offset(proxy.offset())
+            {
+                const auto& buffers = proxy.buffers();
+                if (proxy.null_count() != 0 && !buffers.empty() && buffers[0].size() != 0)
+                {
+                    p_validity = buffers[0].data();
+                }
+            }
+
+            [[nodiscard]] bool has_validity() const noexcept
+            {
+                return p_validity != nullptr;
+            }
+
+            [[nodiscard]] bool is_valid(std::size_t i) const noexcept
+            {
+                const std::size_t bit = m_offset + i;
+                return p_validity == nullptr || ((p_validity[bit / 8] >> (bit % 8)) & 1) != 0;
+            }
+
+        private:
+
+            const std::uint8_t* p_validity = nullptr;
+            std::size_t m_offset;
+        };
+
+        // Read access to the raw bytes of the values of a fixed width or variable size
+        // binary layout
+        class value_reader : public validity_reader
+        {
+        public:
+
+            value_reader(const arrow_proxy& proxy, const char* caller)
+                : validity_reader(proxy)
+                , m_offset(proxy.offset())
+                , m_size(proxy.length())
+                , m_width(sparrow::detail::fixed_width_byte_size(proxy))
+            {
+                const data_type dt = proxy.data_type();
+                if (proxy.dictionary() != nullptr
+                    || (m_width == 0 && dt != data_type::STRING && dt != data_type::BINARY
+                        && dt != data_type::LARGE_STRING && dt != data_type::LARGE_BINARY))
+                {
+                    throw std::invalid_argument(
+                        std::string(caller) + ": arrays of format '" + std::string(proxy.format())
+                        + "' are not supported"
+                    );
+                }
+                const auto& buffers = proxy.buffers();
+                if (m_width != 0)
+                {
+                    p_data = buffers[1].data();
+                }
+                else
+                {
+                    p_offsets = buffers[1].data();
+                    p_data = buffers[2].data();
+                    m_large_offsets = dt == data_type::LARGE_STRING || dt == data_type::LARGE_BINARY;
+                }
+            }
+
+            [[nodiscard]] std::size_t size() const noexcept
+            {
+                return m_size;
+            }
+
+            // Byte width of the values, 0 for variable size layouts
+            [[nodiscard]] std::size_t width() const noexcept
+            {
+                return m_width;
+            }
+
+            [[nodiscard]] bool large_offsets() const noexcept
+            {
+                return m_large_offsets;
+            }
+
+            // Raw bytes of the values, starting at the first element of the array
+            [[nodiscard]] const std::uint8_t* fixed_width_data() const noexcept
+            {
+                return p_data + m_offset * m_width;
+            }
+
+            [[nodiscard]] bytes_view operator[](std::size_t i) const noexcept
+            {
+                if (m_width != 0)
+                {
+                    return {p_data + (m_offset + i) * m_width, m_width};
+                }
+                const std::size_t index = m_offset + i;
+                std::size_t first = 0;
+                std::size_t last = 0;
+                if (m_large_offsets)
+                {
+                    const auto* offsets = reinterpret_cast<const std::int64_t*>(p_offsets);
+                    first = static_cast<std::size_t>(offsets[index]);
+                    last = static_cast<std::size_t>(offsets[index + 1]);
+                }
+                else
+                {
+                    const auto* offsets = reinterpret_cast<const std::int32_t*>(p_offsets);
+                    first = static_cast<std::size_t>(offsets[index]);
+                    last = static_cast<std::size_t>(offsets[index + 1]);
+                }
+                return {p_data + first, last - first};
+            }
+
+        private:
+
+            const std::uint8_t* p_offsets = nullptr;
+            const std::uint8_t* p_data = nullptr;
+            std::size_t m_offset;
+            std::size_t m_size;
+            std::size_t m_width;
+            bool m_large_offsets = false;
+        };
+
+        template <numeric_type T>
+        [[nodiscard]] primitive_array<T>
+        make_result_array(u8_buffer<T>&& data, std::size_t size, const validity_view& lhs, const validity_view& rhs)
+        {
+            if (all_valid(lhs) && all_valid(rhs))
+            {
+                return primitive_array<T>(std::move(data), size, true);
+            }
+            return primitive_array<T>(std::move(data), size, combine_validity(lhs, rhs, size));
+        }
+    }
+}
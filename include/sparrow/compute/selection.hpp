@@ -0,0 +1,99 @@
+// Copyright 2024 Man Group Operations Limited
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+
+#include "sparrow/array.hpp"
+#include "sparrow/buffer/dynamic_bitset/dynamic_bitset.hpp"
+#include "sparrow/config/config.hpp"
+#include "sparrow/record_batch.hpp"
+
+namespace sparrow::compute
+{
+    /**
+     * @brief Gathers the elements of an array at the given indices.
+     *
+     * The output buffers are allocated once, with their final size, and filled directly
+     * from the buffers of \c ar: fixed width values are copied with typed loads and stores,
+     * validity and boolean bits are gathered into whole bytes, and the children of nested
+     * arrays are gathered recursively. A dictionary encoded array gathers its keys and
+     * keeps its dictionary.
+     *
+     * A string view or binary view array copies the values that are not inlined in their
+     * view to new variadic buffers. A run-end encoded array merges the consecutive output
+     * elements coming from the same run.
+     *
+     * Supported layouts: null, bool, primitive, temporal, decimal, interval, fixed width
+     * binary, string, binary, large string, large binary, string view, binary view, list,
+     * large list, list view, large list view, fixed size list, map, struct, sparse union,
+     * dense union, run-end encoded and dictionary encoded arrays of these layouts.
+     *
+     * @param ar The array to gather from.
+     * @param indices The indices of the elements to gather, in output order. An index can
+     *                appear several times.
+     * @return A new array of \c indices.size() elements, owning its buffers.
+     *
+     * @throws std::out_of_range if an index is not less than the size of \c ar.
+     * @throws std::invalid_argument if the layout of \c ar is not supported.
+     */
+    [[nodiscard]] SPARROW_API array take(const array& ar, std::span<const std::size_t> indices);
+
+    /**
+     * @brief Gathers the rows of a record batch at the given indices.
+     *
+     * Each column is gathered with \ref take, the result has the names, name and metadata
+     * of \c rb.
+     *
+     * @param rb The record batch to gather from.
+     * @param indices The indices of the rows to gather, in output order.
+     * @return A new record batch owning its columns.
+     *
+     * @throws std::out_of_range if an index is not less than the number of rows of \c rb.
+     * @throws std::invalid_argument if the layout of a column is not supported.
+     */
+    [[nodiscard]] SPARROW_API record_batch take(const record_batch& rb, std::span<const std::size_t> indices);
+
+    /**
+     * @brief Selects the elements of an array for which a mask is set.
+     *
+     * The positions of the set bits are found a 64-bit word of the mask at a time. Fixed
+     * width values are then copied a run of consecutive selected elements at a time, the
+     * other layouts are gathered as with \ref take. The output is allocated once, sized
+     * from the number of set bits of \c mask.
+     *
+     * @param ar The array to filter.
+     * @param mask The selection mask, for instance the result of a comparison kernel.
+     * @return A new array of the elements of \c ar whose bit is set in \c mask, in order.
+     *
+     * @throws std::invalid_argument if the size of \c mask is not the size of \c ar, or if
+     *         the layout of \c ar is not supported by \ref take.
+     */
+    [[nodiscard]] SPARROW_API array filter(const array& ar, const dynamic_bitset<std::uint8_t>& mask);
+
+    /**
+     * @brief Selects the rows of a record batch for which a mask is set.
+     *
+     * @param rb The record batch to filter.
+     * @param mask The selection mask, of one bit per row.
+     * @return A new record batch owning its columns.
+     *
+     * @throws std::invalid_argument if the size of \c mask is not the number of rows of
+     *         \c rb, or if the layout of a column is not supported by \ref take.
+     */
+    [[nodiscard]] SPARROW_API record_batch filter(const record_batch& rb, const dynamic_bitset<std::uint8_t>& mask);
+}
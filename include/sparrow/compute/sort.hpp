@@ -0,0 +1,96 @@
+// Copyright 2024 Man Group Operations Limited
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <cstddef>
+#include <span>
+#include <string>
+#include <vector>
+
+#include "sparrow/array.hpp"
+#include "sparrow/config/config.hpp"
+#include "sparrow/record_batch.hpp"
+
+namespace sparrow::compute
+{
+    enum class sort_order
+    {
+        ascending,
+        descending
+    };
+
+    enum class null_placement
+    {
+        at_start,
+        at_end
+    };
+
+    /**
+     * Sort key of a record batch: the column to sort on and how to order its values.
+     */
+    struct sort_key
+    {
+        std::string column;
+        sort_order order = sort_order::ascending;
+        null_placement nulls = null_placement::at_end;
+    };
+
+    /**
+     * @brief Returns the permutation that sorts an array.
+     *
+     * The sort is stable: equal values keep their relative order, and so do null values,
+     * which are all placed before or after the non null values according to \c nulls.
+     *
+     * Integers, floating point numbers, decimals, temporal types and fixed width binary
+     * values are sorted with an LSD radix sort on normalized keys: the bytes of each value
+     * are transformed so that their unsigned order is the order of the values, and the
+     * passes on bytes that are the same for all the values are skipped. Floating point
+     * NaN values are greater than any other value. Strings and binary values are radix
+     * sorted on their first 8 bytes, and only the ranges of values sharing the same prefix
+     * are sorted with full comparisons.
+     *
+     * Supported layouts: bool, primitive, temporal, decimal, fixed width binary, string,
+     * binary, large string and large binary.
+     *
+     * @param ar The array to sort.
+     * @param order The order of the non null values.
+     * @param nulls The placement of the null values.
+     * @return The indices of the elements of \c ar in sorted order.
+     *
+     * @throws std::invalid_argument if the layout of \c ar is not supported.
+     */
+    [[nodiscard]] SPARROW_API std::vector<std::size_t> sort_indices(
+        const array& ar,
+        sort_order order = sort_order::ascending,
+        null_placement nulls = null_placement::at_end
+    );
+
+    /**
+     * @brief Returns the permutation that sorts the rows of a record batch.
+     *
+     * The rows are ordered by the first key, then by the second key for the rows with
+     * equal values of the first key, and so on. This is computed with one stable sort per
+     * key, from the last key to the first one.
+     *
+     * @param rb The record batch to sort.
+     * @param keys The sort keys, by decreasing priority.
+     * @return The indices of the rows of \c rb in sorted order.
+     *
+     * @throws std::out_of_range if a key refers to a column that does not exist.
+     * @throws std::invalid_argument if the layout of a key column is not supported.
+     */
+    [[nodiscard]] SPARROW_API std::vector<std::size_t>
+    sort_indices(const record_batch& rb, std::span<const sort_key> keys);
+}
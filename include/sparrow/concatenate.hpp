@@ -0,0 +1,76 @@
+// Copyright 2024 Man Group Operations Limited
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <concepts>
+#include <cstddef>
+#include <ranges>
+#include <span>
+#include <vector>
+
+#include "sparrow/array.hpp"
+#include "sparrow/arrow_interface/arrow_array_schema_proxy.hpp"
+#include "sparrow/config/config.hpp"
+#include "sparrow/layout/array_access.hpp"
+
+namespace sparrow
+{
+    namespace detail
+    {
+        /**
+         * Returns the byte width of the values of the fixed width layout held by \c proxy,
+         * or 0 if its layout is not fixed width (bool, variable size and nested layouts).
+         */
+        [[nodiscard]] SPARROW_API std::size_t fixed_width_byte_size(const arrow_proxy& proxy);
+
+        /**
+         * Concatenates the arrays held by \c proxies into a new arrow_proxy owning its buffers.
+         *
+         * @see concatenate
+         */
+        [[nodiscard]] SPARROW_API arrow_proxy concatenate_proxies(std::span<const arrow_proxy* const> proxies);
+    }
+
+    /**
+     * @brief Concatenates arrays of the same type into a new array.
+     *
+     * The sizes of the output buffers are computed before anything is copied, so that
+     * each output buffer is allocated once. The values of each input are copied with a
+     * single memcpy per buffer, the offsets of string, binary and list arrays are rebased,
+     * and the validity bitmaps are stitched a word at a time whatever the offsets of the
+     * inputs. The children of nested arrays are concatenated recursively.
+     *
+     * Supported layouts: null, primitive, temporal, decimal, interval, fixed width binary,
+     * string, binary, list, large list, fixed size list, map and struct.
+     *
+     * @param arrays The arrays to concatenate, they must all have the same format.
+     * @return A new array, owning its buffers, whose size is the sum of the sizes of \c arrays.
+     *
+     * @throws std::invalid_argument if \c arrays is empty, if the arrays do not have the same
+     *         format or if their layout is not supported.
+     * @throws std::overflow_error if the offsets of the result do not fit in their type.
+     */
+    template <std::ranges::input_range R>
+        requires std::same_as<std::ranges::range_value_t<R>, array>
+    [[nodiscard]] array concatenate(R&& arrays)
+    {
+        std::vector<const arrow_proxy*> proxies;
+        for (const array& ar : arrays)
+        {
+            proxies.push_back(&detail::array_access::get_arrow_proxy(ar));
+        }
+        return array(detail::concatenate_proxies(proxies));
+    }
+}
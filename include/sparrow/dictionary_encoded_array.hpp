@@ -254,6 +254,20 @@ namespace sparrow
          */
         [[nodiscard]] SPARROW_CONSTEXPR_CLANG const_reference operator[](size_type i) const;
 
+        /**
+         * Gets read-only access to the keys of the array.
+         *
+         * @return Constant reference to the keys layout.
+         */
+        [[nodiscard]] constexpr const primitive_array<IT>& raw_keys_array() const;
+
+        /**
+         * Gets read-only access to the dictionary values.
+         *
+         * @return Constant pointer to the values array.
+         */
+        [[nodiscard]] constexpr const array_wrapper* raw_values_array() const;
+
         /**
          * Gets an iterator to the beginning of the array.
          *
@@ -817,6 +831,18 @@ namespace sparrow
         }
     }
 
+    template <std::integral IT>
+    constexpr auto dictionary_encoded_array<IT>::raw_keys_array() const -> const primitive_array<IT>&
+    {
+        return m_keys_layout;
+    }
+
+    template <std::integral IT>
+    constexpr auto dictionary_encoded_array<IT>::raw_values_array() const -> const array_wrapper*
+    {
+        return p_values_layout.get();
+    }
+
     template <std::integral IT>
     constexpr auto dictionary_encoded_array<IT>::begin() -> iterator
     {
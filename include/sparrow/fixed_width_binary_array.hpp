@@ -761,7 +761,10 @@ namespace sparrow
         SPARROW_ASSERT_TRUE(all_same_size(values));
         const size_t element_size = std::ranges::empty(values) ? 0 : std::ranges::size(*values.begin());
 
-        auto data_buffer = u8_buffer<values_inner_value_type>(std::ranges::views::join(values));
+        auto data_buffer = u8_buffer<values_inner_value_type>(
+            std::ranges::views::join(values),
+            make_default_allocator<std::uint8_t>(buffer_role::data)
+        );
         return create_proxy(
             std::move(data_buffer),
             values.size(),
@@ -802,7 +805,10 @@ namespace sparrow
 
             SPARROW_ASSERT_TRUE(all_same_size(values));
             const size_t element_size = std::ranges::empty(values) ? 0 : std::ranges::size(*values.begin());
-            auto data_buffer = u8_buffer<values_inner_value_type>(std::ranges::views::join(values));
+            auto data_buffer = u8_buffer<values_inner_value_type>(
+                std::ranges::views::join(values),
+                make_default_allocator<std::uint8_t>(buffer_role::data)
+            );
             return create_proxy_impl(
                 std::move(data_buffer),
                 values.size(),  // element count
@@ -0,0 +1,515 @@
+// Copyright 2024 Man Group Operations Limited
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <optional>
+#include <span>
+#include <stdexcept>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+/**
+ * Minimal reader and writer of the FlatBuffers binary format, limited to what
+ * the Arrow IPC metadata uses: tables made of scalars, strings, tables, vectors
+ * of scalars or structs, and vectors of tables.
+ *
+ * A flatbuffer starts with the offset of its root table. A table starts with the
+ * signed offset of its vtable, which lists the position of each field in the table
+ * (0 for the absent fields), indexed by field id. Strings, vectors and tables are
+ * referenced by unsigned offsets relative to the position of the field that holds them.
+ */
+namespace sparrow::ipc::detail
+{
+    /**
+     * A table under construction. Fields are added by id, in any order, and the
+     * table is serialized by finish(). The objects referenced by a table are written
+     * after it, so that every offset points forward.
+     */
+    class flatbuffer_table
+    {
+    public:
+
+        template <class T>
+            requires std::is_arithmetic_v<T>
+        flatbuffer_table& add_scalar(std::uint16_t id, T value)
+        {
+            field& f = add_field(id, field_kind::scalar, sizeof(T), sizeof(T));
+            f.bytes.resize(sizeof(T));
+            std::memcpy(f.bytes.data(), &value, sizeof(T));
+            return *this;
+        }
+
+        flatbuffer_table& add_string(std::uint16_t id, std::string_view str)
+        {
+            field& f = add_field(id, field_kind::string, 1, 1);
+            f.bytes.assign(str.begin(), str.end());
+            return *this;
+        }
+
+        flatbuffer_table& add_table(std::uint16_t id, flatbuffer_table table)
+        {
+            field& f = add_field(id, field_kind::table, 0, 0);
+            f.tables.push_back(std::move(table));
+            return *this;
+        }
+
+        flatbuffer_table& add_tables(std::uint16_t id, std::vector<flatbuffer_table> tables)
+        {
+            field& f = add_field(id, field_kind::table_vector, 0, 0);
+            f.tables = std::move(tables);
+            return *this;
+        }
+
+        /**
+         * Adds a table serialized beforehand by finish(). Offsets being relative, the
+         * serialized table can be copied as it is.
+         */
+        flatbuffer_table& add_flatbuffer(std::uint16_t id, std::span<const std::uint8_t> flatbuffer)
+        {
+            field& f = add_field(id, field_kind::flatbuffer, 1, 8);
+            f.bytes.assign(flatbuffer.begin(), flatbuffer.end());
+            return *this;
+        }
+
+        /**
+         * Adds a vector of scalars or of structs. Structs are given as the bytes of
+         * their elements, \c element_size bytes each, aligned on \c alignment.
+         */
+        flatbuffer_table& add_vector(
+            std::uint16_t id,
+            std::span<const std::uint8_t> bytes,
+            std::size_t element_size,
+            std::size_t alignment
+        )
+        {
+            field& f = add_field(id, field_kind::vector, element_size, alignment);
+            f.bytes.assign(bytes.begin(), bytes.end());
+            return *this;
+        }
+
+        template <class T>
+            requires std::is_arithmetic_v<T>
+        flatbuffer_table& add_vector(std::uint16_t id, std::span<const T> values)
+        {
+            return add_vector(
+                id,
+                {reinterpret_cast<const std::uint8_t*>(values.data()), values.size_bytes()},
+                sizeof(T),
+                sizeof(T)
+            );
+        }
+
+        /**
+         * @return The flatbuffer whose root is this table, padded to 8 bytes.
+         */
+        [[nodiscard]] std::vector<std::uint8_t> finish() const
+        {
+            std::vector<std::uint8_t> buffer(sizeof(std::uint32_t), 0);
+            const std::size_t root = write_table(buffer, *this);
+            write_at(buffer, 0, static_cast<std::uint32_t>(root));
+            buffer.resize(align(buffer.size(), 8), 0);
+            return buffer;
+        }
+
+    private:
+
+        enum class field_kind : std::uint8_t
+        {
+            scalar,
+            string,
+            table,
+            table_vector,
+            vector,
+            flatbuffer
+        };
+
+        struct field
+        {
+            std::uint16_t id;
+            field_kind kind;
+            std::size_t element_size;
+            std::size_t alignment;
+            std::vector<std::uint8_t> bytes;
+            std::vector<flatbuffer_table> tables;
+        };
+
+        field& add_field(std::uint16_t id, field_kind kind, std::size_t element_size, std::size_t alignment)
+        {
+            return m_fields.emplace_back(field{id, kind, element_size, alignment, {}, {}});
+        }
+
+        [[nodiscard]] static constexpr std::size_t align(std::size_t size, std::size_t alignment) noexcept
+        {
+            return (size + alignment - 1) / alignment * alignment;
+        }
+
+        template <class T>
+        static void write_at(std::vector<std::uint8_t>& buffer, std::size_t position, T value)
+        {
+            std::memcpy(buffer.data() + position, &value, sizeof(T));
+        }
+
+        static void write_offset(std::vector<std::uint8_t>& buffer, std::size_t position, std::size_t target)
+        {
+            write_at(buffer, position, static_cast<std::uint32_t>(target - position));
+        }
+
+        // Returns the position of the table. Its vtable is written right before it.
+        static std::size_t write_table(std::vector<std::uint8_t>& buffer, const flatbuffer_table& table)
+        {
+            // Layout of the inline part: the vtable offset, then the fields
+            std::vector<std::size_t> positions(table.m_fields.size());
+            std::size_t size = sizeof(std::int32_t);
+            std::size_t alignment = sizeof(std::int32_t);
+            std::uint16_t max_id = 0;
+            for (std::size_t i = 0; i < table.m_fields.size(); ++i)
+            {
+                const field& f = table.m_fields[i];
+                const std::size_t field_size = f.kind == field_kind::scalar ? f.bytes.size()
+                                                                            : sizeof(std::uint32_t);
+                size = align(size, field_size);
+                positions[i] = size;
+                size += field_size;
+                alignment = std::max(alignment, field_size);
+                max_id = std::max(max_id, f.id);
+            }
+            const std::size_t vtable_size = sizeof(std::uint16_t) * (2 + (table.m_fields.empty() ? 0 : max_id + 1u));
+
+            const std::size_t vtable = align(buffer.size(), sizeof(std::uint16_t));
+            const std::size_t position = align(vtable + vtable_size, alignment);
+            buffer.resize(position + size, 0);
+            write_at(buffer, vtable, static_cast<std::uint16_t>(vtable_size));
+            write_at(buffer, vtable + sizeof(std::uint16_t), static_cast<std::uint16_t>(size));
+            write_at(buffer, position, static_cast<std::int32_t>(position - vtable));
+            for (std::size_t i = 0; i < table.m_fields.size(); ++i)
+            {
+                const field& f = table.m_fields[i];
+                write_at(
+                    buffer,
+                    vtable + sizeof(std::uint16_t) * (2u + f.id),
+                    static_cast<std::uint16_t>(positions[i])
+                );
+                if (f.kind == field_kind::scalar)
+                {
+                    std::ranges::copy(f.bytes, buffer.begin() + static_cast<std::ptrdiff_t>(position + positions[i]));
+                }
+            }
+
+            // Then the objects referenced by the table
+            for (std::size_t i = 0; i < table.m_fields.size(); ++i)
+            {
+                const field& f = table.m_fields[i];
+                const std::size_t field_position = position + positions[i];
+                switch (f.kind)
+                {
+                    case field_kind::scalar:
+                        break;
+                    case field_kind::string:
+                        write_offset(buffer, field_position, write_vector(buffer, f.bytes, 1, 1, true));
+                        break;
+                    case field_kind::vector:
+                        write_offset(
+                            buffer,
+                            field_position,
+                            write_vector(buffer, f.bytes, f.element_size, f.alignment, false)
+                        );
+                        break;
+                    case field_kind::table:
+                        write_offset(buffer, field_position, write_table(buffer, f.tables.front()));
+                        break;
+                    case field_kind::table_vector:
+                        write_offset(buffer, field_position, write_table_vector(buffer, f.tables));
+                        break;
+                    case field_kind::flatbuffer:
+                        write_offset(buffer, field_position, write_flatbuffer(buffer, f.bytes));
+                        break;
+                }
+            }
+            return position;
+        }
+
+        // Returns the position of the length prefix; the elements follow it, aligned
+        static std::size_t write_vector(
+            std::vector<std::uint8_t>& buffer,
+            const std::vector<std::uint8_t>& bytes,
+            std::size_t element_size,
+            std::size_t alignment,
+            bool null_terminated
+        )
+        {
+            const std::size_t elements = align(
+                buffer.size() + sizeof(std::uint32_t),
+                std::max(alignment, sizeof(std::uint32_t))
+            );
+            const std::size_t position = elements - sizeof(std::uint32_t);
+            buffer.resize(elements + bytes.size() + (null_terminated ? 1 : 0), 0);
+            write_at(buffer, position, static_cast<std::uint32_t>(bytes.size() / element_size));
+            std::ranges::copy(bytes, buffer.begin() + static_cast<std::ptrdiff_t>(elements));
+            return position;
+        }
+
+        // Returns the position of the root table of the copied flatbuffer
+        static std::size_t write_flatbuffer(std::vector<std::uint8_t>& buffer, const std::vector<std::uint8_t>& bytes)
+        {
+            const std::size_t position = align(buffer.size(), 8);
+            buffer.resize(position, 0);
+            buffer.insert(buffer.end(), bytes.begin(), bytes.end());
+            std::uint32_t root = 0;
+            std::memcpy(&root, bytes.data(), sizeof(root));
+            return position + root;
+        }
+
+        static std::size_t
+        write_table_vector(std::vector<std::uint8_t>& buffer, const std::vector<flatbuffer_table>& tables)
+        {
+            const std::size_t position = align(buffer.size(), sizeof(std::uint32_t));
+            buffer.resize(position + sizeof(std::uint32_t) * (1 + tables.size()), 0);
+            write_at(buffer, position, static_cast<std::uint32_t>(tables.size()));
+            for (std::size_t i = 0; i < tables.size(); ++i)
+            {
+                const std::size_t slot = position + sizeof(std::uint32_t) * (1 + i);
+                write_offset(buffer, slot, write_table(buffer, tables[i]));
+            }
+            return position;
+        }
+
+        std::vector<field> m_fields;
+    };
+
+    [[noreturn]] inline void throw_invalid_flatbuffer()
+    {
+        throw std::runtime_error("Invalid IPC metadata");
+    }
+
+    /**
+     * Bounds-checked little-endian read of a \c T at \c position in \c data.
+     *
+     * @throws std::runtime_error if the value does not fit in \c data.
+     */
+    template <class T>
+        requires std::is_arithmetic_v<T>
+    [[nodiscard]] T read_scalar(std::span<const std::uint8_t> data, std::size_t position)
+    {
+        if (position > data.size() || sizeof(T) > data.size() - position)
+        {
+            throw_invalid_flatbuffer();
+        }
+        T value;
+        std::memcpy(&value, data.data() + position, sizeof(T));
+        return value;
+    }
+
+    class flatbuffer_table_view;
+
+    /**
+     * A vector of a flatbuffer, whose elements are \c element_size bytes each:
+     * scalars, structs or offsets to tables.
+     */
+    class flatbuffer_vector_view
+    {
+    public:
+
+        flatbuffer_vector_view(std::span<const std::uint8_t> data, std::size_t position, std::size_t element_size)
+            : m_data(data)
+            , m_position(position + sizeof(std::uint32_t))
+            , m_size(read_scalar<std::uint32_t>(data, position))
+            , m_element_size(element_size)
+        {
+            if (m_size > (data.size() - m_position) / element_size)
+            {
+                throw_invalid_flatbuffer();
+            }
+        }
+
+        [[nodiscard]] std::size_t size() const noexcept
+        {
+            return m_size;
+        }
+
+        /**
+         * @return The member of element \c i at \c offset bytes from the start of the element.
+         */
+        template <class T>
+            requires std::is_arithmetic_v<T>
+        [[nodiscard]] T get(std::size_t i, std::size_t offset = 0) const
+        {
+            if (i >= m_size || offset + sizeof(T) > m_element_size)
+            {
+                throw_invalid_flatbuffer();
+            }
+            return read_scalar<T>(m_data, m_position + i * m_element_size + offset);
+        }
+
+        [[nodiscard]] flatbuffer_table_view table(std::size_t i) const;
+
+    private:
+
+        std::span<const std::uint8_t> m_data;
+        std::size_t m_position;
+        std::size_t m_size;
+        std::size_t m_element_size;
+    };
+
+    /**
+     * Read access to a table of a flatbuffer. Every access is bounds-checked and throws
+     * a std::runtime_error if the flatbuffer is malformed.
+     */
+    class flatbuffer_table_view
+    {
+    public:
+
+        /**
+         * @return The root table of the flatbuffer \c data.
+         */
+        [[nodiscard]] static flatbuffer_table_view root(std::span<const std::uint8_t> data)
+        {
+            return {data, read_scalar<std::uint32_t>(data, 0)};
+        }
+
+        flatbuffer_table_view(std::span<const std::uint8_t> data, std::size_t position)
+            : m_data(data)
+            , m_position(position)
+        {
+            const auto vtable_offset = static_cast<std::int64_t>(read_scalar<std::int32_t>(data, position));
+            const auto vtable = static_cast<std::int64_t>(position) - vtable_offset;
+            if (vtable < 0 || static_cast<std::uint64_t>(vtable) >= data.size())
+            {
+                throw_invalid_flatbuffer();
+            }
+            m_vtable = static_cast<std::size_t>(vtable);
+            m_vtable_size = read_scalar<std::uint16_t>(data, m_vtable);
+            m_table_size = read_scalar<std::uint16_t>(data, m_vtable + sizeof(std::uint16_t));
+            if (m_vtable_size < 2 * sizeof(std::uint16_t) || m_vtable_size % 2 != 0
+                || m_vtable + m_vtable_size > data.size() || m_table_size > data.size() - position)
+            {
+                throw_invalid_flatbuffer();
+            }
+        }
+
+        [[nodiscard]] bool has(std::uint16_t id) const
+        {
+            return field_position(id, 0).has_value();
+        }
+
+        template <class T>
+            requires std::is_arithmetic_v<T>
+        [[nodiscard]] T scalar(std::uint16_t id, T default_value) const
+        {
+            const auto position = field_position(id, sizeof(T));
+            return position.has_value() ? read_scalar<T>(m_data, *position) : default_value;
+        }
+
+        [[nodiscard]] std::optional<flatbuffer_table_view> table(std::uint16_t id) const
+        {
+            const auto position = target(id);
+            if (!position.has_value())
+            {
+                return std::nullopt;
+            }
+            return flatbuffer_table_view(m_data, *position);
+        }
+
+        [[nodiscard]] std::optional<std::string_view> string(std::uint16_t id) const
+        {
+            const auto position = target(id);
+            if (!position.has_value())
+            {
+                return std::nullopt;
+            }
+            const flatbuffer_vector_view chars(m_data, *position, 1);
+            return std::string_view(
+                reinterpret_cast<const char*>(m_data.data() + *position + sizeof(std::uint32_t)),
+                chars.size()
+            );
+        }
+
+        /**
+         * @return The vector of field \c id, whose elements are \c element_size bytes
+         *         each (4 bytes for a vector of tables).
+         */
+        [[nodiscard]] std::optional<flatbuffer_vector_view> vector(std::uint16_t id, std::size_t element_size) const
+        {
+            const auto position = target(id);
+            if (!position.has_value())
+            {
+                return std::nullopt;
+            }
+            return flatbuffer_vector_view(m_data, *position, element_size);
+        }
+
+    private:
+
+        [[nodiscard]] std::optional<std::size_t> field_position(std::uint16_t id, std::size_t size) const
+        {
+            const std::size_t entry = sizeof(std::uint16_t) * (2u + id);
+            if (entry >= m_vtable_size)
+            {
+                return std::nullopt;
+            }
+            const auto offset = read_scalar<std::uint16_t>(m_data, m_vtable + entry);
+            if (offset == 0)
+            {
+                return std::nullopt;
+            }
+            if (offset < sizeof(std::int32_t) || offset + size > m_table_size)
+            {
+                throw_invalid_flatbuffer();
+            }
+            return m_position + offset;
+        }
+
+        // Position of the object referenced by the offset field \c id
+        [[nodiscard]] std::optional<std::size_t> target(std::uint16_t id) const
+        {
+            const auto position = field_position(id, sizeof(std::uint32_t));
+            if (!position.has_value())
+            {
+                return std::nullopt;
+            }
+            const std::size_t res = *position + read_scalar<std::uint32_t>(m_data, *position);
+            if (res >= m_data.size())
+            {
+                throw_invalid_flatbuffer();
+            }
+            return res;
+        }
+
+        std::span<const std::uint8_t> m_data;
+        std::size_t m_position;
+        std::size_t m_vtable = 0;
+        std::size_t m_vtable_size = 0;
+        std::size_t m_table_size = 0;
+    };
+
+    inline flatbuffer_table_view flatbuffer_vector_view::table(std::size_t i) const
+    {
+        const std::size_t slot = m_position + i * m_element_size;
+        if (i >= m_size)
+        {
+            throw_invalid_flatbuffer();
+        }
+        const std::size_t position = slot + read_scalar<std::uint32_t>(m_data, slot);
+        if (position >= m_data.size())
+        {
+            throw_invalid_flatbuffer();
+        }
+        return {m_data, position};
+    }
+}
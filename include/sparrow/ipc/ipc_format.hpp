@@ -0,0 +1,331 @@
+// Copyright 2024 Man Group Operations Limited
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <array>
+#include <charconv>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <optional>
+#include <span>
+#include <stdexcept>
+#include <string_view>
+#include <type_traits>
+
+#include "sparrow/types/data_type.hpp"
+
+/**
+ * Constants of the Arrow IPC format.
+ *
+ * A stream is a sequence of encapsulated messages:
+ *
+ *   <continuation: 0xFFFFFFFF> <metadata size: int32> <metadata> <body>
+ *
+ * The metadata is a Message flatbuffer (see format/Message.fbs in the Arrow
+ * repository), padded so that the body starts on an 8-byte boundary. The body
+ * holds the buffers of a record batch or of a dictionary batch, each one padded
+ * to 8 bytes, so that they can be used in place by the reader. The first message
+ * holds the Schema, followed by dictionary batches and record batches. The stream
+ * ends with a continuation marker followed by a metadata size of 0.
+ *
+ * A file starts with the "ARROW1" magic padded to 8 bytes, followed by a stream,
+ * a Footer flatbuffer (see format/File.fbs) holding the position of each dictionary
+ * batch and record batch, the size of the footer as an int32 and the "ARROW1"
+ * magic again.
+ *
+ * The body of a message is not compressed: compressed bodies are rejected.
+ */
+namespace sparrow::ipc
+{
+    /**
+     * Type of the header of a message, in the order of the MessageHeader union.
+     */
+    enum class message_type : std::uint8_t
+    {
+        schema = 1,
+        dictionary_batch = 2,
+        record_batch = 3
+    };
+
+    namespace detail
+    {
+        inline constexpr std::uint32_t continuation_marker = 0xFFFFFFFF;
+        inline constexpr std::size_t message_alignment = 8;
+        inline constexpr std::size_t buffer_alignment = 8;
+        inline constexpr std::array<char, 6> file_magic = {'A', 'R', 'R', 'O', 'W', '1'};
+        inline constexpr std::size_t file_header_size = 8;
+
+        // MetadataVersion::V5
+        inline constexpr std::int16_t metadata_version = 4;
+
+        // Ids of the fields of the flatbuffer tables, in declaration order of the Arrow schemas
+        namespace fb_message
+        {
+            inline constexpr std::uint16_t version = 0;
+            inline constexpr std::uint16_t header_type = 1;
+            inline constexpr std::uint16_t header = 2;
+            inline constexpr std::uint16_t body_length = 3;
+        }
+
+        namespace fb_schema
+        {
+            inline constexpr std::uint16_t endianness = 0;
+            inline constexpr std::uint16_t fields = 1;
+            inline constexpr std::uint16_t custom_metadata = 2;
+        }
+
+        namespace fb_field
+        {
+            inline constexpr std::uint16_t name = 0;
+            inline constexpr std::uint16_t nullable = 1;
+            inline constexpr std::uint16_t type_type = 2;
+            inline constexpr std::uint16_t type = 3;
+            inline constexpr std::uint16_t dictionary = 4;
+            inline constexpr std::uint16_t children = 5;
+            inline constexpr std::uint16_t custom_metadata = 6;
+        }
+
+        namespace fb_key_value
+        {
+            inline constexpr std::uint16_t key = 0;
+            inline constexpr std::uint16_t value = 1;
+        }
+
+        namespace fb_dictionary_encoding
+        {
+            inline constexpr std::uint16_t id = 0;
+            inline constexpr std::uint16_t index_type = 1;
+            inline constexpr std::uint16_t is_ordered = 2;
+        }
+
+        namespace fb_record_batch
+        {
+            inline constexpr std::uint16_t length = 0;
+            inline constexpr std::uint16_t nodes = 1;
+            inline constexpr std::uint16_t buffers = 2;
+            inline constexpr std::uint16_t compression = 3;
+            inline constexpr std::uint16_t variadic_buffer_counts = 4;
+
+            // FieldNode and Buffer structs: two int64 each
+            inline constexpr std::size_t node_size = 16;
+            inline constexpr std::size_t buffer_size = 16;
+        }
+
+        namespace fb_dictionary_batch
+        {
+            inline constexpr std::uint16_t id = 0;
+            inline constexpr std::uint16_t data = 1;
+            inline constexpr std::uint16_t is_delta = 2;
+        }
+
+        namespace fb_footer
+        {
+            inline constexpr std::uint16_t version = 0;
+            inline constexpr std::uint16_t schema = 1;
+            inline constexpr std::uint16_t dictionaries = 2;
+            inline constexpr std::uint16_t record_batches = 3;
+
+            // Block struct: offset (int64), metadata length (int32, padded), body length (int64)
+            inline constexpr std::size_t block_size = 24;
+        }
+
+        // Fields of the tables of the Type union
+        namespace fb_int
+        {
+            inline constexpr std::uint16_t bit_width = 0;
+            inline constexpr std::uint16_t is_signed = 1;
+        }
+
+        namespace fb_decimal
+        {
+            inline constexpr std::uint16_t precision = 0;
+            inline constexpr std::uint16_t scale = 1;
+            inline constexpr std::uint16_t bit_width = 2;
+        }
+
+        namespace fb_time
+        {
+            inline constexpr std::uint16_t unit = 0;
+            inline constexpr std::uint16_t bit_width = 1;
+        }
+
+        namespace fb_timestamp
+        {
+            inline constexpr std::uint16_t unit = 0;
+            inline constexpr std::uint16_t timezone = 1;
+        }
+
+        namespace fb_union
+        {
+            inline constexpr std::uint16_t mode = 0;
+            inline constexpr std::uint16_t type_ids = 1;
+        }
+
+        // Single field of FloatingPoint (precision), Date, Interval and Duration (unit),
+        // FixedSizeBinary (byteWidth), FixedSizeList (listSize) and Map (keysSorted)
+        inline constexpr std::uint16_t fb_single_field = 0;
+
+        /**
+         * Values of the Type union of Schema.fbs.
+         */
+        enum class fb_type : std::uint8_t
+        {
+            null = 1,
+            int_ = 2,
+            floating_point = 3,
+            binary = 4,
+            utf8 = 5,
+            bool_ = 6,
+            decimal = 7,
+            date = 8,
+            time = 9,
+            timestamp = 10,
+            interval = 11,
+            list = 12,
+            struct_ = 13,
+            union_ = 14,
+            fixed_size_binary = 15,
+            fixed_size_list = 16,
+            map = 17,
+            duration = 18,
+            large_binary = 19,
+            large_utf8 = 20,
+            large_list = 21,
+            run_end_encoded = 22,
+            binary_view = 23,
+            utf8_view = 24,
+            list_view = 25,
+            large_list_view = 26
+        };
+
+        [[nodiscard]] constexpr std::size_t padded_size(std::size_t size, std::size_t alignment) noexcept
+        {
+            return (size + alignment - 1) / alignment * alignment;
+        }
+
+        /**
+         * @return The size in bytes of the elements of the fixed-width layouts, or
+         *         std::nullopt for the other layouts and for invalid formats.
+         */
+        [[nodiscard]] constexpr std::optional<std::size_t> fixed_width(data_type dt, std::string_view format)
+        {
+            switch (dt)
+            {
+                case data_type::UINT8:
+                case data_type::INT8:
+                    return 1;
+                case data_type::UINT16:
+                case data_type::INT16:
+                case data_type::HALF_FLOAT:
+                    return 2;
+                case data_type::UINT32:
+                case data_type::INT32:
+                case data_type::FLOAT:
+                case data_type::DATE_DAYS:
+                case data_type::TIME_SECONDS:
+                case data_type::TIME_MILLISECONDS:
+                case data_type::INTERVAL_MONTHS:
+                case data_type::DECIMAL32:
+                    return 4;
+                case data_type::UINT64:
+                case data_type::INT64:
+                case data_type::DOUBLE:
+                case data_type::DATE_MILLISECONDS:
+                case data_type::TIME_MICROSECONDS:
+                case data_type::TIME_NANOSECONDS:
+                case data_type::TIMESTAMP_SECONDS:
+                case data_type::TIMESTAMP_MILLISECONDS:
+                case data_type::TIMESTAMP_MICROSECONDS:
+                case data_type::TIMESTAMP_NANOSECONDS:
+                case data_type::DURATION_SECONDS:
+                case data_type::DURATION_MILLISECONDS:
+                case data_type::DURATION_MICROSECONDS:
+                case data_type::DURATION_NANOSECONDS:
+                case data_type::INTERVAL_DAYS_TIME:
+                case data_type::DECIMAL64:
+                    return 8;
+                case data_type::INTERVAL_MONTHS_DAYS_NANOSECONDS:
+                case data_type::DECIMAL128:
+                    return 16;
+                case data_type::DECIMAL256:
+                    return 32;
+                case data_type::FIXED_WIDTH_BINARY:
+                {
+                    // The format is "w:<byte width>"
+                    std::int32_t width = 0;
+                    const auto digits = format.substr(2);
+                    const auto [ptr, ec] = std::from_chars(digits.data(), digits.data() + digits.size(), width);
+                    if (ec != std::errc{} || ptr != digits.data() + digits.size() || width < 0)
+                    {
+                        return std::nullopt;
+                    }
+                    return static_cast<std::size_t>(width);
+                }
+                default:
+                    return std::nullopt;
+            }
+        }
+
+        /**
+         * Reads little-endian values from a byte range. Reading past the end of
+         * the range throws a std::runtime_error.
+         */
+        class message_decoder
+        {
+        public:
+
+            explicit message_decoder(std::span<const std::uint8_t> data) noexcept
+                : m_data(data)
+            {
+            }
+
+            template <class T>
+                requires std::is_arithmetic_v<T>
+            [[nodiscard]] T read()
+            {
+                T value;
+                std::memcpy(&value, take(sizeof(T)).data(), sizeof(T));
+                return value;
+            }
+
+            [[nodiscard]] std::span<const std::uint8_t> read_bytes(std::size_t size)
+            {
+                return take(size);
+            }
+
+            [[nodiscard]] std::size_t position() const noexcept
+            {
+                return m_position;
+            }
+
+        private:
+
+            std::span<const std::uint8_t> take(std::size_t size)
+            {
+                if (size > m_data.size() - m_position)
+                {
+                    throw std::runtime_error("Truncated IPC message");
+                }
+                auto res = m_data.subspan(m_position, size);
+                m_position += size;
+                return res;
+            }
+
+            std::span<const std::uint8_t> m_data;
+            std::size_t m_position = 0;
+        };
+    }
+}
@@ -0,0 +1,178 @@
+// Copyright 2024 Man Group Operations Limited
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <istream>
+#include <memory>
+#include <optional>
+#include <span>
+#include <vector>
+
+#include "sparrow/arrow_interface/arrow_array_stream_proxy.hpp"
+#include "sparrow/arrow_interface/arrow_schema.hpp"
+#include "sparrow/config/config.hpp"
+#include "sparrow/record_batch.hpp"
+
+namespace sparrow::ipc
+{
+    namespace detail
+    {
+        struct dictionary_memo;
+    }
+
+    /**
+     * @brief Reads record batches from the Arrow IPC streaming format.
+     *
+     * Reading is zero-copy: the buffers of the returned arrays point into the
+     * input region (or, when reading from a std::istream, into the block holding
+     * the body of the message), and they keep it alive through the \c owner
+     * handle. The arrays are not created by sparrow, so copying them makes a deep
+     * copy of their buffers.
+     *
+     * Every message is validated before its buffers are exposed: the nodes and
+     * buffers must match the layout of the schema, the buffers must lie within the
+     * body, be aligned and be large enough for the length of the arrays, and the
+     * offsets, union type ids, run ends, views and dictionary indices must stay in
+     * bounds. Dictionary batches are applied as they come; delta dictionary batches
+     * and compressed bodies are not supported.
+     *
+     * @see ipc_format.hpp for the description of the format.
+     */
+    class stream_reader
+    {
+    public:
+
+        /**
+         * Reads from a memory region, starting with the schema message.
+         *
+         * @param data The memory region holding the stream.
+         * @param owner Handle keeping \c data alive, shared with the arrays read from
+         *        the stream. If it is null, the caller must keep \c data alive as long as
+         *        the arrays are used.
+         * @throws std::runtime_error if the schema message is invalid.
+         */
+        SPARROW_API explicit stream_reader(
+            std::span<const std::uint8_t> data,
+            std::shared_ptr<const void> owner = nullptr
+        );
+
+        /**
+         * Reads from an input stream, starting with the schema message. Each message
+         * body is read in a single block, shared by the arrays of the record batch.
+         *
+         * @param input The stream to read from. It must outlive the reader.
+         * @throws std::runtime_error if the schema message is invalid.
+         */
+        SPARROW_API explicit stream_reader(std::istream& input);
+
+        /**
+         * @return The schema of the record batches, as a struct schema whose children
+         *         are the columns, or nullptr if the stream does not hold any record batch.
+         */
+        [[nodiscard]] SPARROW_API const ArrowSchema* schema() const noexcept;
+
+        /**
+         * Reads the dictionary batches up to the next record batch, and returns it.
+         *
+         * @return The next record batch, or std::nullopt at the end of the stream.
+         * @throws std::runtime_error if a message is invalid.
+         */
+        [[nodiscard]] SPARROW_API std::optional<record_batch> next();
+
+        /**
+         * Reads the remaining record batches and pushes them to \c stream as
+         * struct arrays.
+         */
+        SPARROW_API void read_all(arrow_array_stream_proxy& stream);
+
+    private:
+
+        struct message
+        {
+            std::span<const std::uint8_t> metadata;
+            std::span<const std::uint8_t> body;
+            std::shared_ptr<const void> owner;
+        };
+
+        [[nodiscard]] std::optional<ArrowArray> next_arrow_array();
+        [[nodiscard]] std::optional<message> next_message();
+        [[nodiscard]] std::optional<message> next_message_from_stream();
+
+        std::span<const std::uint8_t> m_data;
+        std::size_t m_position = 0;
+        std::shared_ptr<const void> m_owner;
+        std::istream* p_input = nullptr;
+        std::vector<std::uint8_t> m_metadata;
+        schema_unique_ptr m_schema;
+        std::shared_ptr<detail::dictionary_memo> m_dictionaries;
+        bool m_done = false;
+    };
+
+    /**
+     * @brief Reads record batches from the Arrow IPC file format, in any order.
+     *
+     * Like stream_reader, reading is zero-copy and validates the messages. The
+     * dictionaries are read when the file is opened.
+     *
+     * @see open_file to read a memory-mapped file.
+     */
+    class file_reader
+    {
+    public:
+
+        /**
+         * @param data The memory region holding the file.
+         * @param owner Handle keeping \c data alive, see stream_reader.
+         * @throws std::runtime_error if the header, the footer, the schema or the
+         *         dictionaries are invalid.
+         */
+        SPARROW_API explicit file_reader(
+            std::span<const std::uint8_t> data,
+            std::shared_ptr<const void> owner = nullptr
+        );
+
+        /**
+         * @copydoc stream_reader::schema
+         */
+        [[nodiscard]] SPARROW_API const ArrowSchema* schema() const noexcept;
+
+        [[nodiscard]] SPARROW_API std::size_t nb_record_batches() const noexcept;
+
+        /**
+         * @return The record batch at position \c index.
+         * @throws std::out_of_range if \c index is greater than or equal to nb_record_batches().
+         * @throws std::runtime_error if the message is invalid.
+         */
+        [[nodiscard]] SPARROW_API record_batch read(std::size_t index) const;
+
+        /**
+         * Pushes all the record batches to \c stream as struct arrays.
+         */
+        SPARROW_API void read_all(arrow_array_stream_proxy& stream) const;
+
+    private:
+
+        [[nodiscard]] ArrowArray read_arrow_array(std::size_t index) const;
+
+        std::span<const std::uint8_t> m_data;
+        std::shared_ptr<const void> m_owner;
+        // Positions of the record batch messages
+        std::vector<std::int64_t> m_record_batch_offsets;
+        schema_unique_ptr m_schema;
+        std::shared_ptr<detail::dictionary_memo> m_dictionaries;
+    };
+}
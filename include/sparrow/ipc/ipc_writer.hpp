@@ -0,0 +1,154 @@
+// Copyright 2024 Man Group Operations Limited
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include <span>
+#include <vector>
+
+#include "sparrow/arrow_interface/arrow_array_stream_proxy.hpp"
+#include "sparrow/config/config.hpp"
+#include "sparrow/record_batch.hpp"
+
+namespace sparrow::ipc
+{
+    /**
+     * @brief Writes record batches to an output stream in the Arrow IPC streaming format.
+     *
+     * The buffers of the record batches are written as they are, straight from the
+     * `ArrowArray::buffers` pointers, without any per-element work; only the bitmaps
+     * of arrays sliced at an offset that is not a multiple of 8 are copied. The schema
+     * is written before the first record batch; all the record batches written
+     * afterwards must have the same schema. The dictionaries of dictionary-encoded
+     * columns are written before the record batches that use them, and written again
+     * only when they change.
+     *
+     * @see ipc_format.hpp for the description of the format.
+     */
+    class file_writer;
+
+    class stream_writer
+    {
+    public:
+
+        /**
+         * @param output The stream to write to. It must outlive the writer.
+         */
+        SPARROW_API explicit stream_writer(std::ostream& output);
+
+        /**
+         * Writes a record batch, preceded by the schema message if it is the
+         * first one.
+         *
+         * @throws std::invalid_argument if the schema of \c batch differs from the
+         *         schema of the previous batches, or if it holds an array that Arrow
+         *         IPC cannot represent.
+         * @throws std::runtime_error if the writer is closed.
+         */
+        SPARROW_API void write(const record_batch& batch);
+
+        /**
+         * Pops all the arrays of \c stream and writes them as record batches.
+         * The arrays must be struct arrays.
+         */
+        SPARROW_API void write(arrow_array_stream_proxy& stream);
+
+        /**
+         * Writes the end-of-stream marker. Nothing can be written afterwards.
+         */
+        SPARROW_API void close();
+
+        [[nodiscard]] SPARROW_API bool is_closed() const noexcept;
+
+        /**
+         * @return The number of bytes written so far.
+         */
+        [[nodiscard]] SPARROW_API std::size_t written_bytes() const noexcept;
+
+    private:
+
+        /**
+         * Position of a message in the stream, as recorded in the footer of Arrow IPC files.
+         */
+        struct block
+        {
+            std::int64_t offset;
+            std::int32_t metadata_length;
+            std::int64_t body_length;
+        };
+
+        void write_bytes(const void* data, std::size_t size);
+        void write_padding(std::size_t size);
+        block
+        write_message(const std::vector<std::uint8_t>& metadata, std::span<const std::span<const std::uint8_t>> body);
+
+        std::ostream* p_output;
+        // The Schema flatbuffer, compared with the schema of each new batch
+        std::vector<std::uint8_t> m_schema;
+        // Fingerprints of the last dictionaries written, indexed by dictionary id
+        std::vector<std::uint64_t> m_dictionary_fingerprints;
+        std::vector<block> m_dictionary_blocks;
+        std::vector<block> m_record_batch_blocks;
+        std::size_t m_written_bytes = 0;
+        bool m_file = false;
+        bool m_closed = false;
+
+        friend class file_writer;
+    };
+
+    /**
+     * @brief Writes record batches to an output stream in the Arrow IPC file format.
+     *
+     * The file format wraps the stream format with a footer holding the position of
+     * each dictionary and record batch, so that a file_reader can access them in any
+     * order. Since the format does not allow replacing dictionaries, writing a batch
+     * whose dictionaries differ from the ones already written throws
+     * std::invalid_argument.
+     */
+    class file_writer
+    {
+    public:
+
+        /**
+         * Writes the file header.
+         *
+         * @param output The stream to write to. It must outlive the writer.
+         */
+        SPARROW_API explicit file_writer(std::ostream& output);
+
+        /**
+         * @copydoc stream_writer::write(const record_batch&)
+         */
+        SPARROW_API void write(const record_batch& batch);
+
+        /**
+         * @copydoc stream_writer::write(arrow_array_stream_proxy&)
+         */
+        SPARROW_API void write(arrow_array_stream_proxy& stream);
+
+        /**
+         * Writes the end-of-stream marker and the footer. Nothing can be written
+         * afterwards.
+         */
+        SPARROW_API void close();
+
+    private:
+
+        std::ostream* p_output;
+        stream_writer m_writer;
+    };
+}
@@ -0,0 +1,89 @@
+// Copyright 2024 Man Group Operations Limited
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <span>
+
+#include "sparrow/config/config.hpp"
+#include "sparrow/ipc/ipc_reader.hpp"
+
+namespace sparrow::ipc
+{
+    /**
+     * @brief Read-only memory mapping of a whole file.
+     *
+     * The mapping is shared by the arrays read from it: the readers below
+     * give a std::shared_ptr to the memory_map as the owner of the buffers,
+     * so that the file stays mapped until the last array using it is released.
+     * Only the pages that are accessed are loaded, and they are shared through
+     * the page cache with the other processes mapping the same file.
+     */
+    class memory_map
+    {
+    public:
+
+        /**
+         * Maps the file at \c path in memory.
+         *
+         * @throws std::runtime_error if the file cannot be opened or mapped.
+         */
+        [[nodiscard]] SPARROW_API static std::shared_ptr<const memory_map>
+        open(const std::filesystem::path& path);
+
+        SPARROW_API ~memory_map();
+
+        memory_map(const memory_map&) = delete;
+        memory_map& operator=(const memory_map&) = delete;
+        memory_map(memory_map&&) = delete;
+        memory_map& operator=(memory_map&&) = delete;
+
+        /**
+         * @return The mapped bytes. The region is empty for an empty file.
+         */
+        [[nodiscard]] SPARROW_API std::span<const std::uint8_t> data() const noexcept;
+
+    private:
+
+        memory_map() = default;
+
+        const std::uint8_t* p_data = nullptr;
+        std::size_t m_size = 0;
+#if defined(_WIN32)
+        void* m_mapping_handle = nullptr;
+#endif
+    };
+
+    /**
+     * Maps the Arrow IPC file (".arrow", "ARROW1" magic) at \c path in memory
+     * and returns a reader over it. The file can be written by any Arrow
+     * implementation. The record batches read from it do not copy any buffer
+     * and keep the mapping alive.
+     *
+     * @throws std::runtime_error if the file cannot be mapped or is not a
+     *         valid Arrow IPC file.
+     */
+    [[nodiscard]] SPARROW_API file_reader open_file(const std::filesystem::path& path);
+
+    /**
+     * Maps the Arrow IPC stream (".arrows") at \c path in memory and returns
+     * a reader over it.
+     * @see open_file
+     */
+    [[nodiscard]] SPARROW_API stream_reader open_stream(const std::filesystem::path& path);
+}
@@ -15,9 +15,14 @@
 #pragma once
 
 #include <array>
+#include <atomic>
 #include <functional>
 #include <limits>
+#include <memory>
+#include <mutex>
+#include <optional>
 #include <stdexcept>
+#include <string>
 #include <string_view>
 #include <type_traits>
 #include <unordered_map>
@@ -227,6 +232,13 @@ namespace sparrow
      *
      * Extension types are identified by the "ARROW:extension:name" metadata key.
      *
+     * The registry is thread-safe: arrays can be created from several threads while
+     * other threads register extensions. A registration copies the registered
+     * factories and publishes the copy atomically, so that creating an array never
+     * waits for a lock; the creations that already started use the former factories.
+     * The former copies are released by the next registration that happens while no
+     * array is being created.
+     *
      * @example
      * // Register a custom extension
      * auto& registry = array_registry::instance();
@@ -295,6 +307,8 @@ namespace sparrow
          *
          * Extension types are checked before base types. An extension is selected
          * when its base_type matches and its predicate returns true for the proxy.
+         * Extensions registered by name are indexed by name, so that resolving them
+         * reads the metadata of the proxy once, whatever the number of extensions.
          *
          * @param base_type The underlying base data_type
          * @param extension_name The value of "ARROW:extension:name" metadata
@@ -435,6 +449,15 @@ namespace sparrow
             {
             }
 
+            extension_entry(std::string ext_name, extension_predicate pred, factory_func fact)
+                : name(std::move(ext_name))
+                , predicate(std::move(pred))
+                , factory(std::move(fact))
+            {
+            }
+
+            // Empty for the extensions registered with a custom predicate
+            std::string name;
             extension_predicate predicate;
             factory_func factory;
 
@@ -442,16 +465,66 @@ namespace sparrow
             [[nodiscard]] bool matches(const array_wrapper& wrapper) const;
         };
 
-        // Base type factories indexed by data_type
-        std::unordered_map<data_type, factory_func> m_base_factories;
+        struct string_hash
+        {
+            using is_transparent = void;
+
+            [[nodiscard]] std::size_t operator()(std::string_view str) const noexcept
+            {
+                return std::hash<std::string_view>{}(str);
+            }
+        };
+
+        // Extensions of a base data_type, in registration order. The extensions
+        // registered by name are also indexed by name, so that they are resolved
+        // with a single read of the metadata and a hash lookup; only the custom
+        // predicates are evaluated one by one.
+        struct extension_set
+        {
+            std::vector<extension_entry> entries;
+            std::unordered_map<std::string, std::size_t, string_hash, std::equal_to<>> by_name;
+            std::vector<std::size_t> predicate_entries;
+
+            [[nodiscard]] const extension_entry* resolve(const arrow_proxy& proxy) const;
+        };
+
+        // Immutable snapshot of the registered factories
+        struct registry_state
+        {
+            // Base type factories indexed by data_type
+            std::unordered_map<data_type, factory_func> base_factories;
+
+            // Extensions indexed by base data_type
+            std::unordered_map<data_type, extension_set> extensions;
+        };
+
+        // Copies the current state, applies f to the copy and publishes it
+        template <class F>
+        void update(F&& f);
 
-        // Extensions indexed by base data_type
-        std::unordered_map<data_type, std::vector<extension_entry>> m_extensions;
+        // The state read by create; loaded without locking
+        std::atomic<const registry_state*> m_state = nullptr;
+
+        // Number of calls to create in progress, each of them may use any published state
+        mutable std::atomic<std::size_t> m_readers = 0;
+
+        // Serializes the registrations
+        std::mutex m_update_mutex;
+
+        // The published states that a call to create may still use. A registration
+        // releases the former states when no call is in progress, so they accumulate
+        // only while arrays are being created continuously.
+        std::vector<std::unique_ptr<const registry_state>> m_states;
 
         /**
          * @brief Helper to check if proxy has a specific extension name.
          */
         [[nodiscard]] static bool has_extension_name(const arrow_proxy& proxy, std::string_view extension_name);
+
+        /**
+         * @brief Helper to read the "ARROW:extension:name" metadata of a proxy.
+         */
+        [[nodiscard]] static std::optional<std::string_view> get_extension_name(const arrow_proxy& proxy);
     };
 
 
@@ -78,7 +78,10 @@ namespace sparrow::detail
         requires(std::unsigned_integral<std::ranges::range_value_t<SIZES_RANGE>>)
     [[nodiscard]] constexpr sparrow::u8_buffer<OFFSET_TYPE> offset_buffer_from_sizes(SIZES_RANGE&& sizes)
     {
-        sparrow::u8_buffer<OFFSET_TYPE> buffer(range_size(sizes) + 1);
+        sparrow::u8_buffer<OFFSET_TYPE> buffer(
+            range_size(sizes) + 1,
+            make_default_allocator<std::uint8_t>(buffer_role::offsets)
+        );
 
         OFFSET_TYPE offset = 0;
         auto it = buffer.begin();
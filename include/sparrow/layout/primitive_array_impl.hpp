@@ -576,7 +576,8 @@ namespace sparrow
     )
     {
         // create data_buffer
-        u8_buffer<T2> data_buffer(n, value);
+        u8_buffer<T2> data_buffer(n, make_default_allocator<std::uint8_t>(buffer_role::data));
+        std::fill(data_buffer.begin(), data_buffer.end(), static_cast<T2>(value));
 
         return create_proxy_impl(
             std::move(data_buffer),
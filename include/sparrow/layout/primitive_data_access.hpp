@@ -15,6 +15,7 @@
 #pragma once
 
 #include <type_traits>
+#include <utility>
 
 #include "sparrow/arrow_interface/arrow_array_schema_proxy.hpp"
 #include "sparrow/buffer/buffer_adaptor.hpp"
@@ -216,6 +217,7 @@ namespace sparrow
             [[nodiscard]] bitset_adaptor get_data_adaptor();
 
             void update_data_view();
+            void unshare_data_view();
 
             arrow_proxy* p_proxy;
             size_t m_data_buffer_index;
@@ -387,14 +389,16 @@ namespace sparrow
         template <std::ranges::input_range RANGE>
         [[nodiscard]] constexpr u8_buffer<T2> primitive_data_access<T, T2>::make_data_buffer(RANGE&& r)
         {
-            return u8_buffer<T2>(std::forward<RANGE>(r));
+            return u8_buffer<T2>(std::forward<RANGE>(r), make_default_allocator<std::uint8_t>(buffer_role::data));
         }
 
         template <trivial_copyable_type T, trivial_copyable_type T2>
         [[nodiscard]] constexpr u8_buffer<T2>
         primitive_data_access<T, T2>::make_data_buffer(size_t size, const T2& value)
         {
-            return u8_buffer<T2>(size, value);
+            u8_buffer<T2> res(size, make_default_allocator<std::uint8_t>(buffer_role::data));
+            std::fill(res.begin(), res.end(), value);
+            return res;
         }
 
         template <trivial_copyable_type T, trivial_copyable_type T2>
@@ -426,12 +430,13 @@ namespace sparrow
             , m_data_buffer_index(data_buffer_index)
             , m_view(get_data_view())
             , m_dummy_buffer()
-            , m_adaptor(get_data_adaptor())
+            , m_adaptor(&m_dummy_buffer, 0u)
         {
         }
 
         [[nodiscard]] inline auto primitive_data_access<bool>::value(size_t i) -> inner_reference
         {
+            unshare_data_view();
             return m_view[get_offset(i)];
         }
 
@@ -442,11 +447,13 @@ namespace sparrow
 
         [[nodiscard]] inline auto primitive_data_access<bool>::value_begin() -> value_iterator
         {
+            unshare_data_view();
             return sparrow::next(m_view.begin(), get_offset(0u));
         }
 
         [[nodiscard]] inline auto primitive_data_access<bool>::value_end() -> value_iterator
         {
+            unshare_data_view();
             return m_view.end();
         }
 
@@ -462,6 +469,7 @@ namespace sparrow
 
         inline void primitive_data_access<bool>::resize_values(size_t new_length, bool value)
         {
+            m_adaptor = get_data_adaptor();
             m_adaptor.resize(get_offset(new_length), value);
             update_data_view();
         }
@@ -470,7 +478,9 @@ namespace sparrow
         primitive_data_access<bool>::insert_value(const_value_iterator pos, bool value, size_t count)
             -> value_iterator
         {
-            auto ins_iter = sparrow::next(adaptor_cbegin(), std::distance(value_cbegin(), pos));
+            const auto idx = std::distance(value_cbegin(), pos);
+            m_adaptor = get_data_adaptor();
+            auto ins_iter = sparrow::next(adaptor_cbegin(), idx);
             auto res = m_adaptor.insert(ins_iter, count, value);
             update_data_view();
             return sparrow::next(value_begin(), std::distance(adaptor_begin(), res));
@@ -479,6 +489,7 @@ namespace sparrow
         inline auto primitive_data_access<bool>::insert_value(size_t idx, bool value, size_t count)
             -> value_iterator
         {
+            m_adaptor = get_data_adaptor();
             auto iter = sparrow::next(adaptor_cbegin(), static_cast<difference_type>(idx));
             auto res = m_adaptor.insert(iter, count, value);
             update_data_view();
@@ -491,7 +502,9 @@ namespace sparrow
         primitive_data_access<bool>::insert_values(const_value_iterator pos, InputIt first, InputIt last)
             -> value_iterator
         {
-            auto ins_iter = sparrow::next(adaptor_cbegin(), std::distance(value_cbegin(), pos));
+            const auto idx = std::distance(value_cbegin(), pos);
+            m_adaptor = get_data_adaptor();
+            auto ins_iter = sparrow::next(adaptor_cbegin(), idx);
             auto res = m_adaptor.insert(ins_iter, first, last);
             update_data_view();
             return sparrow::next(value_begin(), std::distance(adaptor_begin(), res));
@@ -501,6 +514,7 @@ namespace sparrow
         constexpr auto primitive_data_access<bool>::insert_values(size_t idx, InputIt first, InputIt last)
             -> value_iterator
         {
+            m_adaptor = get_data_adaptor();
             auto iter = sparrow::next(adaptor_cbegin(), static_cast<difference_type>(idx));
             auto res = m_adaptor.insert(iter, first, last);
             update_data_view();
@@ -510,7 +524,9 @@ namespace sparrow
         inline auto primitive_data_access<bool>::erase_values(const_value_iterator pos, size_t count)
             -> value_iterator
         {
-            auto iter = sparrow::next(adaptor_cbegin(), std::distance(value_cbegin(), pos));
+            const auto idx = std::distance(value_cbegin(), pos);
+            m_adaptor = get_data_adaptor();
+            auto iter = sparrow::next(adaptor_cbegin(), idx);
             auto iter_end = sparrow::next(iter, count);
             auto res = m_adaptor.erase(iter, iter_end);
             update_data_view();
@@ -519,6 +535,7 @@ namespace sparrow
 
         inline auto primitive_data_access<bool>::erase_values(size_t idx, size_t count) -> value_iterator
         {
+            m_adaptor = get_data_adaptor();
             auto iter = sparrow::next(adaptor_cbegin(), idx);
             auto iter_end = sparrow::next(iter, count);
             auto res = m_adaptor.erase(iter, iter_end);
@@ -530,7 +547,7 @@ namespace sparrow
         {
             p_proxy = &proxy;
             m_view = get_data_view();
-            m_adaptor = get_data_adaptor();
+            m_adaptor = bitset_adaptor(&m_dummy_buffer, 0u);
         }
 
         template <std::ranges::input_range RANGE>
@@ -563,7 +580,7 @@ namespace sparrow
             {
                 ++block_nb;
             }
-            u8_buffer<bool> res(block_nb);
+            u8_buffer<bool> res(block_nb, make_default_allocator<std::uint8_t>(buffer_role::data));
             std::uint8_t* buffer = reinterpret_cast<std::uint8_t*>(res.data());
             bitset_view v(buffer, size);
             init_func(v);
@@ -605,20 +622,25 @@ namespace sparrow
             return *p_proxy;
         }
 
+        // The view is built from the const buffers so that reading the array does not copy
+        // the buffers it shares with its copies; the writing methods call unshare_data_view
+        // or get_data_adaptor first.
         [[nodiscard]] inline auto primitive_data_access<bool>::get_data_view() -> bitset_view
         {
-            auto& proxy = get_proxy();
+            const auto& proxy = std::as_const(get_proxy());
             const size_t size = proxy.length() + proxy.offset();
-            return {proxy.buffers()[m_data_buffer_index].data(), size};
+            return {const_cast<std::uint8_t*>(proxy.buffers()[m_data_buffer_index].data()), size};
         }
 
+        // Copies the data buffer if it is shared with a copy of the array, and updates the view
         [[nodiscard]] inline auto primitive_data_access<bool>::get_data_adaptor() -> bitset_adaptor
         {
             auto& proxy = get_proxy();
             if (proxy.is_created_with_sparrow())
             {
-                size_t size = proxy.length() + proxy.offset();
-                return bitset_adaptor(&(proxy.get_array_private_data()->buffers()[m_data_buffer_index]), size);
+                auto& data_buffer = proxy.get_array_private_data()->buffers()[m_data_buffer_index];
+                m_view = bitset_view(data_buffer.data(), m_view.size());
+                return bitset_adaptor(&data_buffer, m_view.size());
             }
             else
             {
@@ -630,5 +652,11 @@ namespace sparrow
         {
             m_view = bitset_view(get_proxy().buffers()[m_data_buffer_index].data(), m_adaptor.size());
         }
+
+        inline void primitive_data_access<bool>::unshare_data_view()
+        {
+            // The non-const buffers() copies the buffers if they are shared
+            m_view = bitset_view(get_proxy().buffers()[m_data_buffer_index].data(), m_view.size());
+        }
     }
 }
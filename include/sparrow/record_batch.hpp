@@ -15,9 +15,12 @@
 #pragma once
 
 #include <algorithm>
+#include <functional>
 #include <initializer_list>
+#include <memory>
 #include <optional>
 #include <ranges>
+#include <span>
 #include <string>
 #include <unordered_map>
 #include <vector>
@@ -25,6 +28,7 @@
 #include "sparrow/array.hpp"
 #include "sparrow/struct_array.hpp"
 #include "sparrow/utils/contracts.hpp"
+#include "sparrow/utils/parallel.hpp"
 
 #if defined(__cpp_lib_format)
 #    include "sparrow/utils/format.hpp"
@@ -32,6 +36,49 @@
 
 namespace sparrow
 {
+    /**
+     * @brief Options of the construction of a record_batch from Arrow C structures.
+     *
+     * By default, the columns are imported one after the other by the calling thread.
+     * Importing a column validates its Arrow structures, creates its typed array and
+     * its buffer views; for batches with thousands of columns, spreading this work over
+     * several threads reduces the import time. The columns keep the order of the children
+     * of the Arrow structures whatever the number of threads.
+     *
+     * A lazy import keeps the columns as Arrow C structures, and imports each column the
+     * first time it is accessed, so that the columns which are never read are never
+     * imported. Accessing the columns of a lazily imported batch is thread-safe. When the
+     * \ref record_batch references Arrow C structures instead of owning them, they must
+     * outlive it.
+     */
+    struct record_batch_import_options
+    {
+        /// Maximum number of threads importing the columns, 0 means std::thread::hardware_concurrency().
+        std::size_t num_threads = 1;
+        /// Minimum number of columns imported by each thread. Batches with fewer columns are
+        /// imported by fewer threads, down to the calling thread only.
+        std::size_t min_columns_per_thread = 64;
+        /// Imports each column when it is first accessed instead of in the constructor.
+        /// The threads options are ignored by a lazy import.
+        bool lazy = false;
+    };
+
+    class record_batch;
+
+    /**
+     * @brief Concatenates the rows of record batches with the same columns.
+     *
+     * Each column is concatenated with sparrow::concatenate, and the result has the
+     * names, name and metadata of the first batch.
+     *
+     * @param batches The record batches to concatenate.
+     * @return A new record batch owning its columns.
+     *
+     * @throws std::invalid_argument if \c batches is empty, if the batches do not have the
+     *         same column names or if their columns cannot be concatenated.
+     */
+    [[nodiscard]] SPARROW_API record_batch concatenate(std::span<const record_batch* const> batches);
+
     /**
      * @brief Table-like data structure for storing columnar data with named fields.
      *
@@ -182,8 +229,13 @@ namespace sparrow
          *
          * @param array The ArrowArray structure to transfer into the \ref record_batch.
          * @param schema The ArrowSchema structure to transfer into the \ref record_batch.
+         * @param options The options of the import of the columns.
          */
-        SPARROW_API record_batch(ArrowArray&& array, ArrowSchema&& schema);
+        SPARROW_API record_batch(
+            ArrowArray&& array,
+            ArrowSchema&& schema,
+            const record_batch_import_options& options = {}
+        );
 
         /**
          * Constructs an \ref record_batch from the given Arrow C structures. The
@@ -193,8 +245,13 @@ namespace sparrow
          *
          * @param array The ArrowArray structure to transfer into the \ref record_batch.
          * @param schema The ArrowSchema to reference in the \ref record_batch.
+         * @param options The options of the import of the columns.
          */
-        SPARROW_API record_batch(ArrowArray&& array, ArrowSchema* schema);
+        SPARROW_API record_batch(
+            ArrowArray&& array,
+            ArrowSchema* schema,
+            const record_batch_import_options& options = {}
+        );
 
         /**
          * Constructs an \ref record_batch from the given Arrow C structures. The
@@ -204,8 +261,13 @@ namespace sparrow
          *
          * @param array The ArrowArray structure to transfer into the \ref record_batch.
          * @param schema The const ArrowSchema to reference in the \ref record_batch.
+         * @param options The options of the import of the columns.
          */
-        SPARROW_API record_batch(ArrowArray&& array, const ArrowSchema* schema);
+        SPARROW_API record_batch(
+            ArrowArray&& array,
+            const ArrowSchema* schema,
+            const record_batch_import_options& options = {}
+        );
 
         /**
          * Constructs an record_batch from the given Arrow C structures. Both structures
@@ -214,8 +276,13 @@ namespace sparrow
          *
          * @param array The ArrowArray structure to reference in the \ref record_batch.
          * @param schema The ArrowSchema to reference in the \ref record_batch.
+         * @param options The options of the import of the columns.
          */
-        SPARROW_API record_batch(ArrowArray* array, ArrowSchema* schema);
+        SPARROW_API record_batch(
+            ArrowArray* array,
+            ArrowSchema* schema,
+            const record_batch_import_options& options = {}
+        );
 
         /**
          * Constructs an record_batch from the given Arrow C structures. Both structures
@@ -224,8 +291,13 @@ namespace sparrow
          *
          * @param array The const ArrowArray structure to reference in the \ref record_batch.
          * @param schema The const ArrowSchema to reference in the \ref record_batch.
+         * @param options The options of the import of the columns.
          */
-        SPARROW_API record_batch(const ArrowArray* array, const ArrowSchema* schema);
+        SPARROW_API record_batch(
+            const ArrowArray* array,
+            const ArrowSchema* schema,
+            const record_batch_import_options& options = {}
+        );
 
         /**
          * @brief Constructs a record_batch from a struct_array.
@@ -415,6 +487,39 @@ namespace sparrow
                    );
         }
 
+        /**
+         * @brief Gets a copy of the rows in the range [\p start, \p end).
+         *
+         * The columns of the returned record batch share their buffers with the columns
+         * of \c *this until one of them is modified; only their offsets and lengths differ.
+         *
+         * @param start Index of the first row to keep.
+         * @param end Index one past the last row to keep.
+         * @return A record batch owning its columns, with the same names, name and metadata.
+         *
+         * @pre start <= end
+         * @pre end <= nb_rows()
+         */
+        [[nodiscard]] SPARROW_API record_batch slice(size_type start, size_type end) const;
+
+        /**
+         * @brief Gets a zero-copy view of the rows in the range [\p start, \p end).
+         *
+         * Neither the buffers nor the Arrow structures of the columns are copied. This is the
+         * cheapest way to split a batch into morsels processed independently.
+         *
+         * @warning The returned record batch is valid only as long as \c *this is alive
+         *          and its columns are not modified.
+         *
+         * @param start Index of the first row to keep.
+         * @param end Index one past the last row to keep.
+         * @return A record batch of column views, with the same names, name and metadata.
+         *
+         * @pre start <= end
+         * @pre end <= nb_rows()
+         */
+        [[nodiscard]] SPARROW_API record_batch slice_view(size_type start, size_type end) const;
+
         /**
          * @brief Moves the internal columns into a struct_array and empties the record batch.
          *
@@ -511,16 +616,66 @@ namespace sparrow
          */
         SPARROW_API void add_column_reference(array& column);
 
+        /**
+         * @brief Builds a record batch with the same names, name and metadata as \c *this,
+         * whose columns are the results of \c func applied to the columns of \c *this.
+         *
+         * @tparam F Callable taking a const array& and returning an array
+         * @param func The function applied to each column
+         * @return A new record batch owning the transformed columns
+         *
+         * @pre All the arrays returned by \c func must have the same size
+         */
+        template <class F>
+        [[nodiscard]] record_batch transform_columns(F&& func) const;
+
     private:
 
         template <class AS>
-        void init(ArrowArray&& arr, AS* sch);
+        void init(ArrowArray&& arr, AS* sch, const record_batch_import_options& options);
 
         template <class AA, class AS>
-        void init(AA* arr, AS* sch);
+        void init(AA* arr, AS* sch, const record_batch_import_options& options);
 
         SPARROW_API void partial_init_from_schema(const ArrowSchema& sch);
 
+        /**
+         * @brief Imports the columns of the record batch.
+         *
+         * Calls \c make_column(i) for each column index \c i, possibly from several
+         * threads, and stores the results in the order of the indices. A lazy import
+         * keeps \c make_column and calls it when the column is first accessed, so it
+         * must own, or reference, the Arrow structures of the columns. It is destroyed
+         * once every column is imported.
+         *
+         * @param arr The array of the record batch, whose children give the column sizes.
+         * @param sch The schema of the record batch, whose children give the column names.
+         * @param make_column Function returning the array of the column at the given index.
+         * @param options The options of the import.
+         */
+        SPARROW_API void import_columns(
+            const ArrowArray& arr,
+            const ArrowSchema& sch,
+            std::function<array(std::size_t)> make_column,
+            const record_batch_import_options& options
+        );
+
+        /**
+         * @brief Imports the column at \c index if it has not been imported yet by a
+         * lazy import.
+         */
+        SPARROW_API void materialize(size_type index) const;
+
+        /**
+         * @brief Imports all the columns which have not been imported yet by a lazy import.
+         */
+        SPARROW_API void materialize_all() const;
+
+        /**
+         * @brief Returns the size of the column at \c index without importing it.
+         */
+        [[nodiscard]] SPARROW_API size_type column_size(size_type index) const;
+
         /**
          * @brief Converts a range to a vector of the specified type.
          *
@@ -561,17 +716,23 @@ namespace sparrow
          */
         SPARROW_API void check_consistency() const;
 
+        friend record_batch concatenate(std::span<const record_batch* const> batches);
+
         using metadata_type = std::vector<metadata_pair>;
         using array_storage_type = std::variant<array, std::reference_wrapper<array>>;
 
         std::optional<name_type> m_name = std::nullopt;          ///< Optional name of the record batch
         std::optional<metadata_type> m_metadata = std::nullopt;  ///< Optional metadata for the record batch
         std::vector<name_type> m_name_list;                      ///< Ordered list of column names
-        std::vector<array_storage_type> m_array_list;            ///< Ordered list of column arrays (owned or
-                                                                 ///< referenced)
-        mutable std::unordered_map<name_type, array*> m_array_map;  ///< Cache for fast name-based
-                                                                    ///< lookup
-        mutable bool m_dirty_map = true;                            ///< Flag indicating cache needs update
+        mutable std::vector<array_storage_type> m_array_list;    ///< Ordered list of column arrays (owned or
+                                                                 ///< referenced), mutable for the
+                                                                 ///< columns imported on first access
+        mutable std::unordered_map<name_type, size_type> m_array_map;  ///< Cache for fast name-based
+                                                                       ///< lookup of column indices
+        mutable bool m_dirty_map = true;                               ///< Flag indicating cache needs update
+
+        struct lazy_columns;
+        std::shared_ptr<lazy_columns> m_lazy;  ///< Columns not imported yet by a lazy import
 
         /**
          * @brief Helper to get array pointer from storage variant.
@@ -599,8 +760,48 @@ namespace sparrow
     SPARROW_API
     bool operator==(const record_batch& lhs, const record_batch& rhs);
 
+    /**
+     * @brief Position of the first difference between two record batches.
+     */
+    struct record_batch_difference
+    {
+        std::size_t column;
+        std::size_t row;
+    };
+
+    /**
+     * @brief Finds the first difference between two record batches, for diagnostics.
+     *
+     * The columns are compared in order with \ref first_difference(const array&, const array&),
+     * and the first column that differs is reported, with its first differing row.
+     * When the column names differ, the row is 0.
+     *
+     * @param lhs First record batch to compare
+     * @param rhs Second record batch to compare
+     * @return The position of the first difference, or std::nullopt if \c lhs == \c rhs.
+     */
+    [[nodiscard]] SPARROW_API std::optional<record_batch_difference>
+    first_difference(const record_batch& lhs, const record_batch& rhs);
+
     SPARROW_API std::pair<ArrowArray, ArrowSchema> extract_arrow_structures(sparrow::record_batch&& rb);
 
+    /**
+     * @brief Concatenates the rows of a range of record batches with the same columns.
+     *
+     * @see concatenate(std::span<const record_batch* const>)
+     */
+    template <std::ranges::input_range R>
+        requires std::same_as<std::ranges::range_value_t<R>, record_batch>
+    [[nodiscard]] record_batch concatenate(R&& batches)
+    {
+        std::vector<const record_batch*> batch_ptrs;
+        for (const record_batch& rb : batches)
+        {
+            batch_ptrs.push_back(&rb);
+        }
+        return concatenate(std::span<const record_batch* const>(batch_ptrs));
+    }
+
     /*******************************
      * record_batch implementation *
      *******************************/
@@ -670,32 +871,48 @@ namespace sparrow
         update_array_map_cache();
     }
 
-    template <class AS>
-    void record_batch::init(ArrowArray&& arr, AS* sch)
+    template <class F>
+    record_batch record_batch::transform_columns(F&& func) const
     {
-        partial_init_from_schema(*sch);
-        std::size_t column_size = m_name_list.capacity();
-        for (std::size_t i = 0; i < column_size; ++i)
+        std::vector<array> columns;
+        columns.reserve(m_array_list.size());
+        for (size_type i = 0; i < m_array_list.size(); ++i)
         {
-            m_name_list.emplace_back(sch->children[i]->name);
-            m_array_list.emplace_back(array(std::move(*(arr.children[i])), sch->children[i]));
-            *(arr.children[i]) = make_empty_arrow_array();
+            columns.push_back(func(get_column(i)));
         }
-        arr.release(&arr);
-        update_array_map_cache();
+        return record_batch(m_name_list, std::move(columns), m_name, m_metadata);
+    }
+
+    template <class AS>
+    void record_batch::init(ArrowArray&& arr, AS* sch, const record_batch_import_options& options)
+    {
+        // The array is released once all its columns are imported
+        std::shared_ptr<ArrowArray> owned_arr(new ArrowArray(move_array(std::move(arr))), arrow_array_deleter{});
+        import_columns(
+            *owned_arr,
+            *sch,
+            [owned_arr, sch](std::size_t i)
+            {
+                array col(std::move(*(owned_arr->children[i])), sch->children[i]);
+                *(owned_arr->children[i]) = make_empty_arrow_array();
+                return col;
+            },
+            options
+        );
     }
 
     template <class AA, class AS>
-    void record_batch::init(AA* arr, AS* sch)
+    void record_batch::init(AA* arr, AS* sch, const record_batch_import_options& options)
     {
-        partial_init_from_schema(*sch);
-        std::size_t column_size = m_name_list.capacity();
-        for (std::size_t i = 0; i < column_size; ++i)
-        {
-            m_name_list.emplace_back(sch->children[i]->name);
-            m_array_list.emplace_back(array(arr->children[i], sch->children[i]));
-        }
-        update_array_map_cache();
+        import_columns(
+            *arr,
+            *sch,
+            [arr, sch](std::size_t i)
+            {
+                return array(arr->children[i], sch->children[i]);
+            },
+            options
+        );
     }
 
     template <class U, class R>
@@ -14,6 +14,9 @@
 
 #pragma once
 
+#include <span>
+#include <vector>
+
 #include "sparrow/array_api.hpp"
 #include "sparrow/config/config.hpp"
 #include "sparrow/layout/array_access.hpp"
@@ -86,7 +89,10 @@ namespace sparrow
      * length and a value. Compresses data by storing run lengths for consecutive identical values.
      *
      * Performance notes:
-     * - Random access is $O(\log R)$ where $R$ is the number of encoded runs.
+     * - Random access is $O(\log R)$ where $R$ is the number of encoded runs. Arrays with many runs
+     *   keep a sampled index of the run ends so that the binary search starts on a small table.
+     * - take() locates the runs of a batch of indices with a galloping cursor: sorted or clustered
+     *   indices cost amortized $O(1)$ each.
      * - Iterator increment is amortized $O(1)$ because iterators cache the current run.
      * - Mutating operations work on the encoded run representation rather than the full logical length.
      *   Inserting repeated copies of a single value and erasing a contiguous logical range both run in
@@ -398,6 +404,32 @@ namespace sparrow
          */
         [[nodiscard]] std::optional<key_value_view> metadata() const;
 
+        /**
+         * Gets the values at the given logical indices.
+         *
+         * The run of each index is searched from the run of the previous index with a
+         * galloping search, so that sorted or clustered indices do not pay a binary search
+         * over all the runs.
+         *
+         * @param indices The logical indices, in any order.
+         * @return The values at the given indices.
+         *
+         * @pre All the indices must be less than size()
+         */
+        [[nodiscard]] SPARROW_API std::vector<array_traits::const_reference>
+        take(std::span<const size_type> indices) const;
+
+        /**
+         * Expands the array into a dense array of the type of the encoded values.
+         *
+         * Each run is written at once, without looking up the run of each element.
+         * Supported encoded values are primitive, string and binary arrays.
+         *
+         * @return The decoded array, of size size().
+         * @throws std::invalid_argument if the type of the encoded values is not supported.
+         */
+        [[nodiscard]] SPARROW_API array decode() const;
+
     private:
 
         /**
@@ -463,6 +495,22 @@ namespace sparrow
 
         [[nodiscard]] SPARROW_API size_type find_run_index(std::uint64_t logical_index) const;
 
+        /**
+         * Finds the run of each logical index, starting the search of each index from
+         * the run of the previous one.
+         *
+         * @param indices The logical indices.
+         * @return The run indices, in the order of \c indices.
+         */
+        [[nodiscard]] SPARROW_API std::vector<size_type>
+        find_run_indices(std::span<const size_type> indices) const;
+
+        /**
+         * Rebuilds the sampled run-end index, or clears it if the array has
+         * too few runs to benefit from it.
+         */
+        SPARROW_API void build_run_end_samples();
+
         [[nodiscard]] SPARROW_API std::uint64_t run_start(size_type run_index) const;
 
         [[nodiscard]] SPARROW_API std::uint64_t run_end(size_type run_index) const;
@@ -525,6 +573,13 @@ namespace sparrow
         array p_encoded_values_array;
         /** A pointer to the run-end child data buffer **/
         acc_length_ptr_variant_type m_acc_lengths;
+        /** The last run end of each block of run_end_sample_stride runs, empty for small arrays **/
+        std::vector<std::uint64_t> m_run_end_samples;
+
+        /** Number of runs per block of the sampled run-end index **/
+        static constexpr size_type run_end_sample_stride = 64;
+        /** Minimal number of runs for building the sampled run-end index **/
+        static constexpr size_type run_end_samples_min_runs = 4096;
 
         // friend classes
         friend class run_encoded_array_iterator<false>;
@@ -0,0 +1,296 @@
+// Copyright 2024 Man Group Operations Limited
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <memory>
+#include <span>
+#include <type_traits>
+
+#include "sparrow/array.hpp"
+#include "sparrow/buffer/dynamic_bitset/dynamic_bitset_view.hpp"
+#include "sparrow/dictionary_encoded_array.hpp"
+#include "sparrow/layout/array_access.hpp"
+#include "sparrow/layout/array_wrapper.hpp"
+#include "sparrow/utils/mp_utils.hpp"
+#include "sparrow/utils/nullable.hpp"
+
+namespace sparrow
+{
+    /**
+     * Contiguous values of a fixed-width layout along with their validity bitmap.
+     *
+     * The values and the bitmap are already adjusted to the offset of the array,
+     * i.e. \c values[i] and \c validity.test(i) describe the i-th element of the array.
+     * Values at null positions are accessible but semantically invalid.
+     *
+     * @tparam T The type of the values as stored in the data buffer.
+     */
+    template <class T>
+    struct values_chunk
+    {
+        using value_type = T;
+        using validity_type = dynamic_bitset_view<const std::uint8_t>;
+
+        std::span<const T> values;
+        validity_type validity;
+
+        [[nodiscard]] constexpr std::size_t size() const noexcept
+        {
+            return values.size();
+        }
+
+        [[nodiscard]] constexpr std::size_t null_count() const noexcept
+        {
+            return validity.null_count();
+        }
+    };
+
+    /**
+     * Typed content of a dictionary-encoded array: the keys as a contiguous chunk
+     * and the dictionary values as their actual layout.
+     *
+     * @tparam K The integral type of the keys.
+     * @tparam V The layout type of the dictionary values.
+     */
+    template <std::integral K, class V>
+    struct dictionary_chunk
+    {
+        using key_type = K;
+        using values_layout_type = V;
+
+        values_chunk<K> keys;
+        const V& values;
+
+        [[nodiscard]] constexpr std::size_t size() const noexcept
+        {
+            return keys.size();
+        }
+    };
+
+    namespace detail
+    {
+        template <class L>
+        concept contiguous_values_layout = requires(const L& l) {
+            typename L::const_value_iterator;
+            l.values();
+        } && std::contiguous_iterator<typename L::const_value_iterator>;
+
+        template <class L>
+            requires contiguous_values_layout<L>
+        [[nodiscard]] auto make_values_chunk(const L& layout)
+        {
+            using value_type = std::iter_value_t<typename L::const_value_iterator>;
+            const auto values = layout.values();
+            const auto& proxy = array_access::get_arrow_proxy(layout);
+            SPARROW_ASSERT_TRUE(proxy.const_bitmap().has_value());
+            return values_chunk<value_type>{
+                std::span<const value_type>(std::to_address(values.begin()), layout.size()),
+                *proxy.const_bitmap()
+            };
+        }
+
+        // Element type of the layout when it is a nullable, void otherwise
+        template <class L>
+        struct nullable_element
+        {
+            using type = void;
+        };
+
+        template <class L>
+            requires mpl::is_type_instance_of_v<std::remove_cvref_t<typename L::const_reference>, nullable>
+        struct nullable_element<L>
+        {
+            using type = typename std::remove_cvref_t<typename L::const_reference>::stored_value_type;
+        };
+
+        // The elements of a dictionary can be decoded to a typed nullable if the values layout
+        // returns nullable elements that can be default constructed (for null keys).
+        template <class V>
+        concept typed_dictionary_values = !std::is_void_v<typename nullable_element<V>::type>
+                                          && std::is_default_constructible_v<
+                                              std::remove_cvref_t<typename nullable_element<V>::type>>;
+
+        template <class F>
+        struct chunk_visitor
+        {
+            template <class L>
+            decltype(auto) operator()(const L& layout) const
+            {
+                if constexpr (mpl::is_type_instance_of_v<L, dictionary_encoded_array>)
+                {
+                    auto keys = make_values_chunk(layout.raw_keys_array());
+                    return visit(
+                        [this, &keys]<class V>(const V& values) -> decltype(auto)
+                        {
+                            using key_type = typename decltype(keys)::value_type;
+                            return func(dictionary_chunk<key_type, V>{keys, values});
+                        },
+                        *layout.raw_values_array()
+                    );
+                }
+                else if constexpr (contiguous_values_layout<L>)
+                {
+                    return func(make_values_chunk(layout));
+                }
+                else
+                {
+                    return func(layout);
+                }
+            }
+
+            F& func;
+        };
+
+        template <class F>
+        struct element_visitor
+        {
+            template <class L>
+            void operator()(const L& layout) const
+            {
+                if constexpr (mpl::is_type_instance_of_v<L, dictionary_encoded_array>)
+                {
+                    visit(
+                        [this, &layout]<class V>(const V& values)
+                        {
+                            decode_dictionary(layout, values);
+                        },
+                        *layout.raw_values_array()
+                    );
+                }
+                else
+                {
+                    for (auto it = layout.cbegin(); it != layout.cend(); ++it)
+                    {
+                        func(*it);
+                    }
+                }
+            }
+
+            template <class L, class V>
+            void decode_dictionary(const L& layout, const V& values) const
+            {
+                if constexpr (typed_dictionary_values<V>)
+                {
+                    using element_type = typename nullable_element<V>::type;
+                    using result_type = nullable<element_type>;
+                    static const std::remove_cvref_t<element_type> null_value{};
+                    for (const auto key : layout.raw_keys_array())
+                    {
+                        if (key.has_value())
+                        {
+                            const auto value = values[static_cast<std::size_t>(key.get())];
+                            func(result_type(value.get(), value.has_value()));
+                        }
+                        else
+                        {
+                            func(result_type(null_value, false));
+                        }
+                    }
+                }
+                else
+                {
+                    // Values that are not nullable (union, run-end encoded or dictionary arrays)
+                    // are already returned as variants
+                    for (std::size_t i = 0; i < layout.size(); ++i)
+                    {
+                        func(layout[i]);
+                    }
+                }
+            }
+
+            F& func;
+        };
+    }
+
+    /**
+     * Dispatches once on the actual type of the layout held by \c ar and calls
+     * \c func with the most direct typed representation of its data:
+     * - a \ref values_chunk for the layouts storing their values in a contiguous
+     *   buffer (primitive, temporal and decimal types, except booleans);
+     * - a \ref dictionary_chunk for dictionary-encoded arrays, whose values layout
+     *   is resolved only once;
+     * - the typed layout itself for the other layouts (booleans, binary, nested,
+     *   run-end encoded, union and null arrays). The children of nested layouts
+     *   can be visited recursively with \c visit_chunks.
+     *
+     * As with \ref array::visit, \c func must accept all the possible arguments
+     * and return the same type for all of them.
+     *
+     * @param ar The array to visit.
+     * @param func The functor to call.
+     * @return The result of calling \c func.
+     */
+    template <class F>
+    decltype(auto) visit_chunks(const array_wrapper& ar, F&& func);
+
+    /**
+     * @copydoc visit_chunks(const array_wrapper&, F&&)
+     */
+    template <class F>
+    decltype(auto) visit_chunks(const array& ar, F&& func);
+
+    /**
+     * Dispatches once on the actual type of the layout held by \c ar and calls
+     * \c func on each element of the array, in order, with the typed const reference
+     * of that layout (e.g. a \c nullable<const T&> for a primitive array) instead of
+     * the variant returned by \c array::operator[].
+     *
+     * The elements of dictionary-encoded arrays are decoded: \c func receives a
+     * \c nullable wrapping the const reference of the dictionary values layout, which
+     * is null when either the key or the referenced value is null.
+     *
+     * @param ar The array to iterate over.
+     * @param func The functor to call on each element.
+     */
+    template <class F>
+    void for_each_typed(const array_wrapper& ar, F&& func);
+
+    /**
+     * @copydoc for_each_typed(const array_wrapper&, F&&)
+     */
+    template <class F>
+    void for_each_typed(const array& ar, F&& func);
+
+    /******************
+     * Implementation *
+     ******************/
+
+    template <class F>
+    decltype(auto) visit_chunks(const array_wrapper& ar, F&& func)
+    {
+        return visit(detail::chunk_visitor<F>{func}, ar);
+    }
+
+    template <class F>
+    decltype(auto) visit_chunks(const array& ar, F&& func)
+    {
+        return ar.visit(detail::chunk_visitor<F>{func});
+    }
+
+    template <class F>
+    void for_each_typed(const array_wrapper& ar, F&& func)
+    {
+        visit(detail::element_visitor<F>{func}, ar);
+    }
+
+    template <class F>
+    void for_each_typed(const array& ar, F&& func)
+    {
+        ar.visit(detail::element_visitor<F>{func});
+    }
+}
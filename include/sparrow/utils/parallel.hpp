@@ -0,0 +1,46 @@
+// Copyright 2024 Man Group Operations Limited
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <cstddef>
+#include <functional>
+
+#include "sparrow/config/config.hpp"
+
+namespace sparrow
+{
+    /**
+     * @return The number of threads to use when \c num_threads threads are requested:
+     *         \c num_threads, or std::thread::hardware_concurrency() if \c num_threads is 0.
+     *         The returned value is never 0.
+     */
+    [[nodiscard]] SPARROW_API std::size_t resolve_num_threads(std::size_t num_threads) noexcept;
+
+    /**
+     * Calls \c f(i) for each \c i in [0, \c count), spreading the calls over at most
+     * \c num_threads threads. Each thread processes a contiguous range of indices, the
+     * first range being processed by the calling thread.
+     *
+     * If calls to \c f throw, the remaining indices of the throwing range are skipped,
+     * the other ranges are processed, and the exception thrown for the smallest index
+     * is rethrown once all the threads have been joined.
+     *
+     * @param count The number of indices.
+     * @param num_threads The maximum number of threads, 0 means std::thread::hardware_concurrency().
+     * @param f The function to call, must be safe to call concurrently for different indices.
+     */
+    SPARROW_API void
+    parallel_for(std::size_t count, std::size_t num_threads, const std::function<void(std::size_t)>& f);
+}
@@ -1029,7 +1029,10 @@ namespace sparrow
                               }
                           );
         auto offset_buffer = offset_from_sizes(size_range);
-        auto data_buffer = u8_buffer<values_inner_value_type>(std::ranges::views::join(values));
+        auto data_buffer = u8_buffer<values_inner_value_type>(
+            std::ranges::views::join(values),
+            make_default_allocator<std::uint8_t>(buffer_role::data)
+        );
         return create_proxy(
             std::move(data_buffer),
             std::move(offset_buffer),
@@ -1079,7 +1082,10 @@ namespace sparrow
     {
         using values_inner_value_type = std::ranges::range_value_t<std::ranges::range_value_t<R>>;
         const size_t size = std::ranges::size(values);
-        u8_buffer<values_inner_value_type> data_buffer(std::ranges::views::join(values));
+        u8_buffer<values_inner_value_type> data_buffer(
+            std::ranges::views::join(values),
+            make_default_allocator<std::uint8_t>(buffer_role::data)
+        );
         auto size_range = values
                           | std::views::transform(
                               [](const auto& v)
@@ -14,6 +14,8 @@
 
 #pragma once
 
+#include <cstddef>
+#include <istream>
 #include <vector>
 
 #if defined(__GNUC__)
@@ -32,6 +34,17 @@
 
 namespace sparrow::json_reader
 {
+    /**
+     * Options of the functions building several record batches at once.
+     */
+    struct json_reader_options
+    {
+        /// Number of threads building the arrays, 0 means std::thread::hardware_concurrency().
+        std::size_t num_threads = 0;
+        /// Maximum number of batches being built at the same time, 0 means twice the number of threads.
+        std::size_t max_pending_batches = 0;
+    };
+
     SPARROW_JSON_READER_API sparrow::array build_array_from_json(
         const nlohmann::json& array,
         const nlohmann::json& schema,
@@ -50,6 +63,36 @@ namespace sparrow::json_reader
 
     SPARROW_JSON_READER_API sparrow::record_batch
     build_record_batch_from_json(const nlohmann::json& root, size_t num_batches);
+
+    /**
+     * Builds all the record batches of an integration JSON document.
+     *
+     * The columns of the batches are built in parallel. If the document has no batch,
+     * a single batch with empty columns is returned, as build_record_batch_from_json does.
+     *
+     * @param root The parsed JSON document.
+     * @param options The options of the reader.
+     * @return The record batches, in the order of the document.
+     */
+    SPARROW_JSON_READER_API std::vector<sparrow::record_batch>
+    build_record_batches_from_json(const nlohmann::json& root, const json_reader_options& options = {});
+
+    /**
+     * Reads all the record batches of an integration JSON document from \c input.
+     *
+     * Unlike parsing the whole document and calling build_record_batches_from_json,
+     * each batch is handed to the threads building its columns as soon as it has been
+     * parsed, and its JSON representation is released once built. At most
+     * \c options.max_pending_batches batches are held in memory at the same time.
+     *
+     * @param input The stream to read the document from.
+     * @param options The options of the reader.
+     * @return The record batches, in the order of the document.
+     * @throws nlohmann::json::parse_error if the document is not valid JSON.
+     * @throws std::runtime_error if the document is not a valid integration JSON document.
+     */
+    SPARROW_JSON_READER_API std::vector<sparrow::record_batch>
+    read_record_batches_from_json(std::istream& input, const json_reader_options& options = {});
 }
 
 // namespace sparrow::json_reader::json_parser
\ No newline at end of file
@@ -14,6 +14,17 @@
 
 #include "sparrow/json_reader/json_parser.hpp"
 
+#include <algorithm>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <tuple>
+
 #include <sparrow/layout/array_access.hpp>
 
 #include "sparrow/json_reader/binary_parser.hpp"
@@ -233,66 +244,374 @@ namespace sparrow::json_reader
         return batch;
     }
 
-    sparrow::record_batch build_record_batch_from_json(const nlohmann::json& root, size_t num_batches)
+    namespace
     {
-        const auto& schemas = root.at("schema").at("fields");
-        std::vector<std::pair<std::string, nlohmann::json>> schema_map;
-        for (const auto& schema : schemas)
+        // Fixed-size pool of worker threads. Without worker, the tasks are run by the thread
+        // submitting them.
+        class task_pool
         {
-            const std::string name = schema.at("name").get<std::string>();
-            schema_map.emplace_back(name, schema);
+        public:
+
+            explicit task_pool(std::size_t num_threads)
+            {
+                m_workers.reserve(num_threads);
+                for (std::size_t i = 0; i < num_threads; ++i)
+                {
+                    m_workers.emplace_back(
+                        [this]
+                        {
+                            run();
+                        }
+                    );
+                }
+            }
+
+            task_pool(const task_pool&) = delete;
+            task_pool& operator=(const task_pool&) = delete;
+
+            ~task_pool()
+            {
+                {
+                    std::lock_guard lock(m_mutex);
+                    m_stopping = true;
+                }
+                m_task_available.notify_all();
+                for (auto& worker : m_workers)
+                {
+                    worker.join();
+                }
+            }
+
+            template <class F>
+            std::future<std::invoke_result_t<F>> submit(F&& f)
+            {
+                using result_type = std::invoke_result_t<F>;
+                auto task = std::make_shared<std::packaged_task<result_type()>>(std::forward<F>(f));
+                std::future<result_type> result = task->get_future();
+                if (m_workers.empty())
+                {
+                    (*task)();
+                    return result;
+                }
+                {
+                    std::lock_guard lock(m_mutex);
+                    m_tasks.emplace(
+                        [task]
+                        {
+                            (*task)();
+                        }
+                    );
+                }
+                m_task_available.notify_one();
+                return result;
+            }
+
+        private:
+
+            void run()
+            {
+                while (true)
+                {
+                    std::function<void()> task;
+                    {
+                        std::unique_lock lock(m_mutex);
+                        m_task_available.wait(
+                            lock,
+                            [this]
+                            {
+                                return m_stopping || !m_tasks.empty();
+                            }
+                        );
+                        if (m_tasks.empty())
+                        {
+                            return;
+                        }
+                        task = std::move(m_tasks.front());
+                        m_tasks.pop();
+                    }
+                    task();
+                }
+            }
+
+            std::mutex m_mutex;
+            std::condition_variable m_task_available;
+            std::queue<std::function<void()>> m_tasks;
+            bool m_stopping = false;
+            std::vector<std::thread> m_workers;
+        };
+
+        // Batch whose columns are being built by a task_pool.
+        struct pending_batch
+        {
+            // Owns the JSON of the batch when it does not belong to a document.
+            std::unique_ptr<const nlohmann::json> owner;
+            const nlohmann::json* batch;
+            std::vector<std::future<sparrow::array>> columns;
+        };
+
+        pending_batch submit_batch(
+            const nlohmann::json& batch,
+            std::unique_ptr<const nlohmann::json> owner,
+            const nlohmann::json& root,
+            task_pool& pool
+        )
+        {
+            // Several fields can have the same name, each column is matched with the first
+            // field of the schema not matched yet.
+            std::vector<const nlohmann::json*> fields;
+            for (const auto& field : root.at("schema").at("fields"))
+            {
+                fields.push_back(&field);
+            }
+
+            pending_batch pending{.owner = std::move(owner), .batch = &batch, .columns = {}};
+            const auto& columns = batch.at("columns");
+            pending.columns.reserve(columns.size());
+            for (const auto& column : columns)
+            {
+                const auto column_name = column.at("name").get<std::string>();
+                auto field_it = std::ranges::find_if(
+                    fields,
+                    [&column_name](const nlohmann::json* field)
+                    {
+                        return field->at("name").get<std::string>() == column_name;
+                    }
+                );
+                if (field_it == fields.end())
+                {
+                    throw std::runtime_error("Column '" + column_name + "' not found in schema");
+                }
+                const nlohmann::json* field = *field_it;
+                fields.erase(field_it);  // Remove processed schema
+
+                pending.columns.push_back(pool.submit(
+                    [&column, field, &root]
+                    {
+                        return build_array_from_json(column, *field, root);
+                    }
+                ));
+            }
+            return pending;
         }
-        auto batches = root.at("batches");
-        if (batches.empty())
+
+        sparrow::record_batch finish_batch(pending_batch&& pending, const nlohmann::json& root)
+        {
+            std::vector<sparrow::array> arrays;
+            arrays.reserve(pending.columns.size());
+            for (auto& column : pending.columns)
+            {
+                arrays.push_back(column.get());
+            }
+
+            const auto names = pending.batch->at("columns")
+                               | std::views::transform(
+                                   [](const nlohmann::json& column)
+                                   {
+                                       return column.at("name").get<std::string>();
+                                   }
+                               );
+            std::optional<std::vector<sparrow::metadata_pair>> metadata;
+            if (root.at("schema").contains("metadata"))
+            {
+                metadata = utils::get_metadata(root.at("schema"));
+            }
+            return sparrow::record_batch{names, std::move(arrays), "", std::move(metadata)};
+        }
+
+        nlohmann::json generate_empty_batch(const nlohmann::json& root)
+        {
+            std::vector<std::pair<std::string, nlohmann::json>> schema_map;
+            for (const auto& schema : root.at("schema").at("fields"))
+            {
+                schema_map.emplace_back(schema.at("name").get<std::string>(), schema);
+            }
+            return generate_empty_columns_batch(schema_map);
+        }
+
+        bool uses_dictionaries(const nlohmann::json& fields)
+        {
+            return std::ranges::any_of(
+                fields,
+                [](const nlohmann::json& field)
+                {
+                    return field.contains("dictionary")
+                           || (field.contains("children") && uses_dictionaries(field.at("children")));
+                }
+            );
+        }
+
+        std::size_t get_num_threads(const json_reader_options& options)
         {
-            auto empty_columns = generate_empty_columns_batch(schema_map);
-            batches.push_back(empty_columns);
+            if (options.num_threads != 0)
+            {
+                return options.num_threads;
+            }
+            return std::max(std::thread::hardware_concurrency(), 1u);
         }
-        if (num_batches >= batches.size())
+
+        std::size_t get_max_pending_batches(const json_reader_options& options)
+        {
+            if (options.max_pending_batches != 0)
+            {
+                return options.max_pending_batches;
+            }
+            return 2 * get_num_threads(options);
+        }
+    }
+
+    sparrow::record_batch build_record_batch_from_json(const nlohmann::json& root, size_t num_batches)
+    {
+        const auto& batches = root.at("batches");
+        const size_t batch_count = std::max<size_t>(batches.size(), 1);
+        if (num_batches >= batch_count)
         {
             throw std::runtime_error(
                 "Invalid batch number: index " + std::to_string(num_batches) + " out of "
-                + std::to_string(batches.size()) + " batches"
+                + std::to_string(batch_count) + " batches"
             );
         }
-        const auto& batch = batches.at(num_batches);
 
-        const auto& columns = batch.at("columns");
-        std::vector<sparrow::array> arrays;
-        arrays.reserve(columns.size());
-        for (const auto& column : columns)
+        task_pool pool(0);
+        if (batches.empty())
+        {
+            auto empty_batch = std::make_unique<const nlohmann::json>(generate_empty_batch(root));
+            const nlohmann::json& batch = *empty_batch;
+            return finish_batch(submit_batch(batch, std::move(empty_batch), root, pool), root);
+        }
+        return finish_batch(submit_batch(batches.at(num_batches), nullptr, root, pool), root);
+    }
+
+    std::vector<sparrow::record_batch>
+    build_record_batches_from_json(const nlohmann::json& root, const json_reader_options& options)
+    {
+        const auto& batches = root.at("batches");
+        if (batches.empty())
+        {
+            return {build_record_batch_from_json(root, 0)};
+        }
+
+        const std::size_t max_pending_batches = get_max_pending_batches(options);
+        std::vector<sparrow::record_batch> result;
+        result.reserve(batches.size());
+        std::deque<pending_batch> pending;
+        task_pool pool(get_num_threads(options));
+        for (const auto& batch : batches)
         {
-            const auto column_name = column.at("name").get<std::string>();
-            auto schema_with_name_it = std::ranges::find_if(
-                schema_map,
-                [&column_name](const auto& pair)
+            pending.push_back(submit_batch(batch, nullptr, root, pool));
+            if (pending.size() >= max_pending_batches)
+            {
+                result.push_back(finish_batch(std::move(pending.front()), root));
+                pending.pop_front();
+            }
+        }
+        for (auto& batch : pending)
+        {
+            result.push_back(finish_batch(std::move(batch), root));
+        }
+        return result;
+    }
+
+    std::vector<sparrow::record_batch>
+    read_record_batches_from_json(std::istream& input, const json_reader_options& options)
+    {
+        // Holds the schema and the dictionaries of the document, the batches are built
+        // and released as soon as they are parsed.
+        nlohmann::json context = nlohmann::json::object();
+        bool needs_dictionaries = false;
+
+        const std::size_t max_pending_batches = get_max_pending_batches(options);
+        std::vector<sparrow::record_batch> result;
+        std::deque<pending_batch> pending;
+        // Batches parsed before the schema or the dictionaries they depend on
+        std::vector<std::unique_ptr<const nlohmann::json>> deferred;
+        task_pool pool(get_num_threads(options));
+
+        const auto finish_pending = [&](std::size_t max_size)
+        {
+            while (pending.size() > max_size)
+            {
+                result.push_back(finish_batch(std::move(pending.front()), context));
+                pending.pop_front();
+            }
+        };
+
+        const auto can_build = [&]
+        {
+            return context.contains("schema") && (!needs_dictionaries || context.contains("dictionaries"));
+        };
+
+        const auto submit = [&](std::unique_ptr<const nlohmann::json> batch)
+        {
+            const nlohmann::json& batch_ref = *batch;
+            pending.push_back(submit_batch(batch_ref, std::move(batch), context, pool));
+            finish_pending(max_pending_batches - 1);
+        };
+
+        const auto submit_deferred = [&]
+        {
+            for (auto& batch : deferred)
+            {
+                submit(std::move(batch));
+            }
+            deferred.clear();
+        };
+
+        std::string top_level_key;
+        const nlohmann::json::parser_callback_t callback =
+            [&](int depth, nlohmann::json::parse_event_t event, nlohmann::json& parsed)
+        {
+            using event_t = nlohmann::json::parse_event_t;
+            if (depth == 1 && event == event_t::key)
+            {
+                top_level_key = parsed.get<std::string>();
+            }
+            else if (depth == 2 && event == event_t::object_end && top_level_key == "batches")
+            {
+                auto batch = std::make_unique<const nlohmann::json>(std::move(parsed));
+                if (can_build())
                 {
-                    return pair.first == column_name;
+                    submit_deferred();
+                    submit(std::move(batch));
                 }
-            );
-            if (schema_with_name_it == schema_map.end())
+                else
+                {
+                    deferred.push_back(std::move(batch));
+                }
+                return false;
+            }
+            else if (depth == 1 && (event == event_t::object_end || event == event_t::array_end)
+                     && (top_level_key == "schema" || top_level_key == "dictionaries"))
             {
-                throw std::runtime_error("Column '" + column_name + "' not found in schema");
+                // The batches being built read the context
+                finish_pending(0);
+                if (top_level_key == "schema")
+                {
+                    needs_dictionaries = uses_dictionaries(parsed.at("fields"));
+                }
+                context[top_level_key] = std::move(parsed);
+                if (can_build())
+                {
+                    submit_deferred();
+                }
+                return false;
             }
-            const auto& schema = schema_with_name_it->second;
+            return true;
+        };
+        // The batches, the schema and the dictionaries have been removed from the document
+        std::ignore = nlohmann::json::parse(input, callback);
 
-            arrays.emplace_back(build_array_from_json(column, schema, root));
-            schema_map.erase(schema_with_name_it);  // Remove processed schema
+        if (!context.contains("schema"))
+        {
+            throw std::runtime_error("JSON document does not have a schema");
         }
-
-        const auto names = columns
-                           | std::views::transform(
-                               [](const nlohmann::json& column)
-                               {
-                                   return column.at("name").get<std::string>();
-                               }
-                           );
-        std::optional<std::vector<sparrow::metadata_pair>> metadata;
-        if (root.at("schema").contains("metadata"))
+        submit_deferred();
+        finish_pending(0);
+        if (result.empty())
         {
-            metadata = utils::get_metadata(root.at("schema"));
+            context["batches"] = nlohmann::json::array();
+            result.push_back(build_record_batch_from_json(context, 0));
         }
-        return sparrow::record_batch{names, std::move(arrays), "", std::move(metadata)};
+        return result;
     }
 
 }  // namespace sparrow::json_reader::json_parser
\ No newline at end of file
@@ -14,10 +14,12 @@
 
 #define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
 
+#include <algorithm>
 #include <cstdint>
 #include <filesystem>
 #include <fstream>
 #include <optional>
+#include <sstream>
 #include <stdexcept>
 #include <string>
 #include <vector>
@@ -91,6 +93,37 @@ nlohmann::json load_json_file(const std::filesystem::path& json_path)
     return nlohmann::json::parse(json_file);
 }
 
+void check_same_record_batch(
+    const std::string& prefix,
+    sparrow::record_batch&& expected,
+    sparrow::record_batch&& actual
+)
+{
+    auto [expected_array, expected_schema] = sparrow::extract_arrow_structures(
+        expected.extract_struct_array()
+    );
+    auto [actual_array, actual_schema] = sparrow::extract_arrow_structures(actual.extract_struct_array());
+
+    const std::optional<std::string> schema_result = sparrow::json_reader::compare_schemas(
+        prefix,
+        &actual_schema,
+        &expected_schema
+    );
+    CHECK_FALSE(schema_result.has_value());
+    const std::optional<std::string> array_result = sparrow::json_reader::compare_arrays(
+        prefix,
+        &actual_array,
+        &expected_array,
+        &expected_schema
+    );
+    CHECK_FALSE(array_result.has_value());
+
+    expected_array.release(&expected_array);
+    expected_schema.release(&expected_schema);
+    actual_array.release(&actual_array);
+    actual_schema.release(&actual_schema);
+}
+
 TEST_SUITE("json_reader_parser")
 {
     TEST_CASE("build_record_batch_from_json")
@@ -915,4 +948,69 @@ namespace sparrow::json_reader::utils
             }
         }
     }
-}
\ No newline at end of file
+
+    TEST_CASE("read_all_record_batches")
+    {
+        const sparrow::json_reader::json_reader_options options{.num_threads = 4, .max_pending_batches = 2};
+        for (const auto& json_path : jsons_to_test)
+        {
+            SUBCASE(json_path.filename().string().c_str())
+            {
+                const auto json_data = load_json_file(json_path);
+                const size_t num_batches = std::max<size_t>(get_number_of_batches(json_path), 1);
+
+                SUBCASE("build_record_batches_from_json")
+                {
+                    auto record_batches = sparrow::json_reader::build_record_batches_from_json(json_data, options);
+                    REQUIRE_EQ(record_batches.size(), num_batches);
+                    for (size_t batch_idx = 0; batch_idx < num_batches; ++batch_idx)
+                    {
+                        check_same_record_batch(
+                            "Batch " + std::to_string(batch_idx),
+                            sparrow::json_reader::build_record_batch_from_json(json_data, batch_idx),
+                            std::move(record_batches[batch_idx])
+                        );
+                    }
+                }
+
+                SUBCASE("read_record_batches_from_json")
+                {
+                    std::ifstream json_file(json_path);
+                    REQUIRE(json_file.is_open());
+                    auto record_batches = sparrow::json_reader::read_record_batches_from_json(json_file, options);
+                    REQUIRE_EQ(record_batches.size(), num_batches);
+                    for (size_t batch_idx = 0; batch_idx < num_batches; ++batch_idx)
+                    {
+                        check_same_record_batch(
+                            "Batch " + std::to_string(batch_idx),
+                            sparrow::json_reader::build_record_batch_from_json(json_data, batch_idx),
+                            std::move(record_batches[batch_idx])
+                        );
+                    }
+                }
+            }
+        }
+    }
+
+    TEST_CASE("read_record_batches_from_json with batches before dictionaries")
+    {
+        auto json_data = load_json_file(json_files_path / "dictionary.json");
+        // Serializes the batches first
+        nlohmann::ordered_json reordered;
+        reordered["batches"] = json_data.at("batches");
+        reordered["schema"] = json_data.at("schema");
+        reordered["dictionaries"] = json_data.at("dictionaries");
+        std::istringstream input(reordered.dump());
+
+        auto record_batches = sparrow::json_reader::read_record_batches_from_json(input, {.num_threads = 2});
+        REQUIRE_EQ(record_batches.size(), json_data.at("batches").size());
+        for (size_t batch_idx = 0; batch_idx < record_batches.size(); ++batch_idx)
+        {
+            check_same_record_batch(
+                "Batch " + std::to_string(batch_idx),
+                sparrow::json_reader::build_record_batch_from_json(json_data, batch_idx),
+                std::move(record_batches[batch_idx])
+            );
+        }
+    }
+}
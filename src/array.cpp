@@ -14,6 +14,11 @@
 
 #include "sparrow/array.hpp"
 
+#include <algorithm>
+#include <bit>
+#include <cstdint>
+#include <cstring>
+#include <optional>
 #include <stdexcept>
 #include <type_traits>
 #include <vector>
@@ -21,8 +26,11 @@
 #include "sparrow/arrow_interface/arrow_array.hpp"
 #include "sparrow/arrow_interface/arrow_array_schema_proxy.hpp"
 #include "sparrow/arrow_interface/arrow_schema.hpp"
+#include "sparrow/concatenate.hpp"
+#include "sparrow/details/3rdparty/float16_t.hpp"
 #include "sparrow/layout/array_factory.hpp"
 #include "sparrow/layout/array_helper.hpp"
+#include "sparrow/types/data_type.hpp"
 #include "sparrow/utils/contracts.hpp"
 
 namespace sparrow
@@ -358,21 +366,290 @@ namespace sparrow
         return {this, size()};
     }
 
+    namespace
+    {
+        constexpr std::size_t block_size = 64;
+
+        // Validity bitmap of an array, nullptr if all its elements are valid
+        [[nodiscard]] const std::uint8_t* validity_bits(const arrow_proxy& proxy)
+        {
+            const auto& buffers = proxy.buffers();
+            if (proxy.null_count() == 0 || buffers.empty() || buffers[0].size() == 0)
+            {
+                return nullptr;
+            }
+            return buffers[0].data();
+        }
+
+        /**
+         * Loads \c count <= 64 bits of \c bits starting at the bit \c first, which does
+         * not need to be aligned. A null bitmap has all its bits set.
+         */
+        [[nodiscard]] std::uint64_t load_bits(const std::uint8_t* bits, std::size_t first, std::size_t count) noexcept
+        {
+            const std::uint64_t mask = count == block_size ? ~std::uint64_t(0) : (std::uint64_t(1) << count) - 1;
+            if (bits == nullptr)
+            {
+                return mask;
+            }
+            const std::uint8_t* data = bits + first / 8;
+            const std::size_t shift = first % 8;
+            const std::size_t byte_count = (shift + count + 7) / 8;
+            std::uint64_t word = 0;
+            for (std::size_t k = 0; k < std::min<std::size_t>(byte_count, 8); ++k)
+            {
+                word |= static_cast<std::uint64_t>(data[k]) << (8 * k);
+            }
+            word >>= shift;
+            if (byte_count > 8)
+            {
+                word |= static_cast<std::uint64_t>(data[8]) << (64 - shift);
+            }
+            return word & mask;
+        }
+
+        /**
+         * Scans two arrays of the same format a block of 64 elements at a time. An
+         * element differs if its validity differs, or if it is valid in both arrays and
+         * its bit is set in \c value_diff(first, count), the mask of the elements of the
+         * block whose values differ.
+         */
+        template <class F>
+        [[nodiscard]] std::optional<std::size_t>
+        scan_blocks(const arrow_proxy& lhs, const arrow_proxy& rhs, std::size_t size, F&& value_diff)
+        {
+            const std::uint8_t* lhs_validity = validity_bits(lhs);
+            const std::uint8_t* rhs_validity = validity_bits(rhs);
+            for (std::size_t first = 0; first < size; first += block_size)
+            {
+                const std::size_t count = std::min(block_size, size - first);
+                const std::uint64_t lhs_valid = load_bits(lhs_validity, lhs.offset() + first, count);
+                const std::uint64_t rhs_valid = load_bits(rhs_validity, rhs.offset() + first, count);
+                std::uint64_t diff = lhs_valid ^ rhs_valid;
+                if (const std::uint64_t both_valid = lhs_valid & rhs_valid; both_valid != 0)
+                {
+                    diff |= value_diff(first, count) & both_valid;
+                }
+                if (diff != 0)
+                {
+                    return first + static_cast<std::size_t>(std::countr_zero(diff));
+                }
+            }
+            return std::nullopt;
+        }
+
+        [[nodiscard]] auto fixed_width_diff(const arrow_proxy& lhs, const arrow_proxy& rhs, std::size_t width)
+        {
+            const std::uint8_t* lhs_data = lhs.buffers()[1].data() + lhs.offset() * width;
+            const std::uint8_t* rhs_data = rhs.buffers()[1].data() + rhs.offset() * width;
+            return [=](std::size_t first, std::size_t count)
+            {
+                const std::uint8_t* lhs_block = lhs_data + first * width;
+                const std::uint8_t* rhs_block = rhs_data + first * width;
+                std::uint64_t diff = 0;
+                if (std::memcmp(lhs_block, rhs_block, count * width) != 0)
+                {
+                    for (std::size_t i = 0; i < count; ++i)
+                    {
+                        const bool differ = std::memcmp(lhs_block + i * width, rhs_block + i * width, width) != 0;
+                        diff |= static_cast<std::uint64_t>(differ) << i;
+                    }
+                }
+                return diff;
+            };
+        }
+
+        // Floating point values are compared as values, as operator== does
+        template <class T>
+        [[nodiscard]] auto floating_point_diff(const arrow_proxy& lhs, const arrow_proxy& rhs)
+        {
+            const T* lhs_data = reinterpret_cast<const T*>(lhs.buffers()[1].data()) + lhs.offset();
+            const T* rhs_data = reinterpret_cast<const T*>(rhs.buffers()[1].data()) + rhs.offset();
+            return [=](std::size_t first, std::size_t count)
+            {
+                std::uint64_t diff = 0;
+                for (std::size_t i = 0; i < count; ++i)
+                {
+                    const bool differ = !(lhs_data[first + i] == rhs_data[first + i]);
+                    diff |= static_cast<std::uint64_t>(differ) << i;
+                }
+                return diff;
+            };
+        }
+
+        [[nodiscard]] auto bool_diff(const arrow_proxy& lhs, const arrow_proxy& rhs)
+        {
+            const std::uint8_t* lhs_bits = lhs.buffers()[1].data();
+            const std::uint8_t* rhs_bits = rhs.buffers()[1].data();
+            return [=, lhs_offset = lhs.offset(), rhs_offset = rhs.offset()](std::size_t first, std::size_t count)
+            {
+                return load_bits(lhs_bits, lhs_offset + first, count) ^ load_bits(rhs_bits, rhs_offset + first, count);
+            };
+        }
+
+        /**
+         * The data of a block of strings is compared with a single memcmp when the
+         * lengths of the strings of the block are the same in both arrays.
+         */
+        template <class OT>
+        [[nodiscard]] auto binary_diff(const arrow_proxy& lhs, const arrow_proxy& rhs)
+        {
+            const OT* lhs_offsets = reinterpret_cast<const OT*>(lhs.buffers()[1].data()) + lhs.offset();
+            const OT* rhs_offsets = reinterpret_cast<const OT*>(rhs.buffers()[1].data()) + rhs.offset();
+            const std::uint8_t* lhs_data = lhs.buffers()[2].data();
+            const std::uint8_t* rhs_data = rhs.buffers()[2].data();
+            return [=](std::size_t first, std::size_t count)
+            {
+                const OT lhs_base = lhs_offsets[first];
+                const OT rhs_base = rhs_offsets[first];
+                bool aligned = true;
+                for (std::size_t i = first + 1; i <= first + count && aligned; ++i)
+                {
+                    aligned = lhs_offsets[i] - lhs_base == rhs_offsets[i] - rhs_base;
+                }
+                const auto byte_count = static_cast<std::size_t>(lhs_offsets[first + count] - lhs_base);
+                if (aligned
+                    && (byte_count == 0 || std::memcmp(lhs_data + lhs_base, rhs_data + rhs_base, byte_count) == 0))
+                {
+                    return std::uint64_t(0);
+                }
+                std::uint64_t diff = 0;
+                for (std::size_t i = 0; i < count; ++i)
+                {
+                    const std::size_t k = first + i;
+                    const auto length = static_cast<std::size_t>(lhs_offsets[k + 1] - lhs_offsets[k]);
+                    const bool differ = length != static_cast<std::size_t>(rhs_offsets[k + 1] - rhs_offsets[k])
+                                        || (length != 0
+                                            && std::memcmp(lhs_data + lhs_offsets[k], rhs_data + rhs_offsets[k], length)
+                                                   != 0);
+                    diff |= static_cast<std::uint64_t>(differ) << i;
+                }
+                return diff;
+            };
+        }
+
+        [[nodiscard]] bool same_buffers(const arrow_proxy& lhs, const arrow_proxy& rhs)
+        {
+            if (lhs.offset() != rhs.offset() || lhs.buffers().size() != rhs.buffers().size())
+            {
+                return false;
+            }
+            for (std::size_t i = 0; i < lhs.buffers().size(); ++i)
+            {
+                if (lhs.buffers()[i].data() != rhs.buffers()[i].data())
+                {
+                    return false;
+                }
+            }
+            return true;
+        }
+
+        /**
+         * Compares the buffers of two arrays of the same format, returns std::nullopt
+         * if their layout cannot be compared on its buffers.
+         */
+        [[nodiscard]] std::optional<std::optional<std::size_t>>
+        buffers_first_difference(const arrow_proxy& lhs, const arrow_proxy& rhs)
+        {
+            if (lhs.format() != rhs.format() || lhs.dictionary() != nullptr || rhs.dictionary() != nullptr)
+            {
+                return std::nullopt;
+            }
+            const std::size_t size = std::min(lhs.length(), rhs.length());
+            auto with_size_check = [&](std::optional<std::size_t> diff) -> std::optional<std::size_t>
+            {
+                if (!diff.has_value() && lhs.length() != rhs.length())
+                {
+                    return size;
+                }
+                return diff;
+            };
+
+            switch (lhs.data_type())
+            {
+                case data_type::NA:
+                    return with_size_check(std::nullopt);
+                case data_type::HALF_FLOAT:
+                    return with_size_check(scan_blocks(lhs, rhs, size, floating_point_diff<float16_t>(lhs, rhs)));
+                case data_type::FLOAT:
+                    return with_size_check(scan_blocks(lhs, rhs, size, floating_point_diff<float>(lhs, rhs)));
+                case data_type::DOUBLE:
+                    return with_size_check(scan_blocks(lhs, rhs, size, floating_point_diff<double>(lhs, rhs)));
+                default:
+                    break;
+            }
+
+            // Arrays sharing their buffers have the same elements, except NaN values
+            auto scan = [&](auto&& value_diff) -> std::optional<std::size_t>
+            {
+                if (same_buffers(lhs, rhs))
+                {
+                    return with_size_check(std::nullopt);
+                }
+                return with_size_check(scan_blocks(lhs, rhs, size, value_diff));
+            };
+            switch (lhs.data_type())
+            {
+                case data_type::BOOL:
+                    return scan(bool_diff(lhs, rhs));
+                case data_type::STRING:
+                case data_type::BINARY:
+                    return scan(binary_diff<std::int32_t>(lhs, rhs));
+                case data_type::LARGE_STRING:
+                case data_type::LARGE_BINARY:
+                    return scan(binary_diff<std::int64_t>(lhs, rhs));
+                default:
+                {
+                    const std::size_t width = detail::fixed_width_byte_size(lhs);
+                    if (width == 0)
+                    {
+                        return std::nullopt;
+                    }
+                    return scan(fixed_width_diff(lhs, rhs, width));
+                }
+            }
+        }
+    }
+
     bool operator==(const array& lhs, const array& rhs)
     {
+        return !first_difference(lhs, rhs).has_value();
+    }
+
+    std::optional<std::size_t> first_difference(const array& lhs, const array& rhs)
+    {
+        if (auto diff = buffers_first_difference(
+                detail::array_access::get_arrow_proxy(lhs),
+                detail::array_access::get_arrow_proxy(rhs)
+            ))
+        {
+            return *diff;
+        }
         return lhs.visit(
-            [&rhs](const auto& typed_lhs) -> bool
+            [&rhs](const auto& typed_lhs) -> std::optional<std::size_t>
             {
                 return rhs.visit(
-                    [&typed_lhs](const auto& typed_rhs) -> bool
+                    [&typed_lhs](const auto& typed_rhs) -> std::optional<std::size_t>
                     {
                         if constexpr (!std::same_as<decltype(typed_lhs), decltype(typed_rhs)>)
                         {
-                            return false;
+                            return 0;
                         }
                         else
                         {
-                            return typed_lhs == typed_rhs;
+                            const std::size_t size = std::min(typed_lhs.size(), typed_rhs.size());
+                            for (std::size_t i = 0; i < size; ++i)
+                            {
+                                if (!(typed_lhs[i] == typed_rhs[i]))
+                                {
+                                    return i;
+                                }
+                            }
+                            if (typed_lhs.size() != typed_rhs.size())
+                            {
+                                return size;
+                            }
+                            return std::nullopt;
                         }
                     }
                 );
@@ -196,55 +196,112 @@ namespace sparrow
         std::swap(lhs.private_data, rhs.private_data);
     }
 
-    void copy_array(const ArrowArray& source_array, const ArrowSchema& source_schema, ArrowArray& target)
+    namespace
     {
-        SPARROW_ASSERT_TRUE(&source_array != &target);
-        SPARROW_ASSERT_TRUE(source_array.release != nullptr);
-        SPARROW_ASSERT_TRUE(source_schema.release != nullptr);
-        SPARROW_ASSERT_TRUE(source_array.n_children == source_schema.n_children);
-        SPARROW_ASSERT_TRUE((source_array.dictionary == nullptr) == (source_schema.dictionary == nullptr));
-        const auto buffers = get_arrow_array_buffers(source_array, source_schema);
-        SPARROW_ASSERT_TRUE(buffers.size() == static_cast<std::size_t>(source_array.n_buffers));
-
-        target.n_children = source_array.n_children;
-        if (source_array.n_children > 0)
+        // Returns the private data of the source if its buffers can be shared, i.e. if
+        // the array has been created by sparrow, its buffers have not been replaced
+        // by writing directly into the ArrowArray structure and they are not allocated
+        // from an arena, which the copy could outlive.
+        const arrow_array_private_data* shareable_private_data(const ArrowArray& source_array)
         {
-            target.children = new ArrowArray*[static_cast<std::size_t>(source_array.n_children)];
-            for (int64_t i = 0; i < source_array.n_children; ++i)
+            if (source_array.release != std::addressof(release_arrow_array) || source_array.private_data == nullptr)
+            {
+                return nullptr;
+            }
+            const auto* private_data = static_cast<const arrow_array_private_data*>(source_array.private_data);
+            const auto& buffers = private_data->buffers();
+            if (buffers.size() != static_cast<std::size_t>(source_array.n_buffers))
             {
-                SPARROW_ASSERT_TRUE(source_array.children[i] != nullptr);
-                target.children[i] = new ArrowArray{};
-                copy_array(*source_array.children[i], *source_schema.children[i], *target.children[i]);
+                return nullptr;
+            }
+            for (std::size_t i = 0; i < buffers.size(); ++i)
+            {
+                if (static_cast<const void*>(buffers[i].data()) != source_array.buffers[i]
+                    || buffers[i].get_allocator().allocates_from_arena())
+                {
+                    return nullptr;
+                }
             }
+            return private_data;
         }
 
-        if (source_array.dictionary != nullptr)
+        template <bool share>
+        void copy_array_impl(const ArrowArray& source_array, const ArrowSchema& source_schema, ArrowArray& target)
         {
-            target.dictionary = new ArrowArray{};
-            copy_array(*source_array.dictionary, *source_schema.dictionary, *target.dictionary);
-        }
+            SPARROW_ASSERT_TRUE(&source_array != &target);
+            SPARROW_ASSERT_TRUE(source_array.release != nullptr);
+            SPARROW_ASSERT_TRUE(source_schema.release != nullptr);
+            SPARROW_ASSERT_TRUE(source_array.n_children == source_schema.n_children);
+            SPARROW_ASSERT_TRUE((source_array.dictionary == nullptr) == (source_schema.dictionary == nullptr));
 
-        target.length = source_array.length;
-        target.null_count = source_array.null_count;
-        target.offset = source_array.offset;
-        target.n_buffers = source_array.n_buffers;
+            target.n_children = source_array.n_children;
+            if (source_array.n_children > 0)
+            {
+                target.children = new ArrowArray*[static_cast<std::size_t>(source_array.n_children)];
+                for (int64_t i = 0; i < source_array.n_children; ++i)
+                {
+                    SPARROW_ASSERT_TRUE(source_array.children[i] != nullptr);
+                    target.children[i] = new ArrowArray{};
+                    copy_array_impl<share>(
+                        *source_array.children[i],
+                        *source_schema.children[i],
+                        *target.children[i]
+                    );
+                }
+            }
 
-        std::vector<buffer<std::uint8_t>> buffers_copy;
-        buffers_copy.reserve(static_cast<std::size_t>(source_array.n_buffers));
+            if (source_array.dictionary != nullptr)
+            {
+                target.dictionary = new ArrowArray{};
+                copy_array_impl<share>(*source_array.dictionary, *source_schema.dictionary, *target.dictionary);
+            }
 
-        for (const auto& buffer : buffers)
-        {
-            buffers_copy.emplace_back(buffer);
+            target.length = source_array.length;
+            target.null_count = source_array.null_count;
+            target.offset = source_array.offset;
+            target.n_buffers = source_array.n_buffers;
+
+            const auto children_ownership = repeat_view<bool>{true, static_cast<std::size_t>(target.n_children)};
+            const arrow_array_private_data* source_private_data = nullptr;
+            if constexpr (share)
+            {
+                source_private_data = shareable_private_data(source_array);
+            }
+            if (source_private_data != nullptr)
+            {
+                target.private_data = new arrow_array_private_data(
+                    source_private_data->share_buffers(),
+                    children_ownership,
+                    true
+                );
+            }
+            else
+            {
+                const auto buffers = get_arrow_array_buffers(source_array, source_schema);
+                SPARROW_ASSERT_TRUE(buffers.size() == static_cast<std::size_t>(source_array.n_buffers));
+                std::vector<buffer<std::uint8_t>> buffers_copy;
+                buffers_copy.reserve(static_cast<std::size_t>(source_array.n_buffers));
+                for (const auto& buffer : buffers)
+                {
+                    buffers_copy.emplace_back(buffer);
+                }
+                target.private_data = new arrow_array_private_data(std::move(buffers_copy), children_ownership, true);
+            }
+            const auto private_data = static_cast<arrow_array_private_data*>(target.private_data);
+            target.buffers = private_data->buffers_ptrs<void>();
+            target.release = release_arrow_array;
+            copy_tracker::increase(copy_tracker::key<ArrowArray>());
         }
-        target.private_data = new arrow_array_private_data(
-            std::move(buffers_copy),
-            repeat_view<bool>{true, static_cast<std::size_t>(target.n_children)},
-            true
-        );
-        const auto private_data = static_cast<arrow_array_private_data*>(target.private_data);
-        target.buffers = private_data->buffers_ptrs<void>();
-        target.release = release_arrow_array;
-        copy_tracker::increase(copy_tracker::key<ArrowArray>());
+    }
+
+    void copy_array(const ArrowArray& source_array, const ArrowSchema& source_schema, ArrowArray& target)
+    {
+        copy_array_impl<false>(source_array, source_schema, target);
+    }
+
+    void share_array(const ArrowArray& source_array, const ArrowSchema& source_schema, ArrowArray& target)
+    {
+        copy_array_impl<true>(source_array, source_schema, target);
     }
 
     void arrow_array_deleter::operator()(ArrowArray* array) const
@@ -75,8 +75,9 @@ namespace sparrow
     {
         if (is_created_with_sparrow() && !m_array_is_immutable && !m_schema_is_immutable)
         {
-            get_array_private_data()->update_buffers_ptrs();
-            array_without_sanitize().buffers = get_array_private_data()->buffers_ptrs<void>();
+            auto* private_data = static_cast<arrow_array_private_data*>(array_without_sanitize().private_data);
+            private_data->update_buffers_ptrs();
+            array_without_sanitize().buffers = private_data->buffers_ptrs<void>();
             array_without_sanitize().n_buffers = static_cast<int64_t>(n_buffers());
         }
         const arrow_proxy& const_this = *this;
@@ -209,7 +210,7 @@ namespace sparrow
     {
         if (!other.empty())
         {
-            m_array = copy_array(other.array(), other.schema());
+            m_array = share_array(other.array(), other.schema());
             m_schema = copy_schema(other.schema());
             m_array_is_immutable = false;
             m_schema_is_immutable = false;
@@ -396,6 +397,7 @@ namespace sparrow
     {
         static constexpr const char function_name[] = "set_flags";
         throw_if_immutable<function_name, false, true>();
+        invalidate_schema_fingerprints();
         schema_without_sanitize().flags = to_ArrowFlag_value(flags);
     }
 
@@ -611,6 +613,8 @@ namespace sparrow
     {
         static constexpr const char function_name[] = "get_schema_private_data";
         throw_if_immutable<function_name, false, true>();
+        // The schema is about to be modified
+        invalidate_schema_fingerprints();
         return static_cast<arrow_schema_private_data*>(schema_without_sanitize().private_data);
     }
 
@@ -618,9 +622,24 @@ namespace sparrow
     {
         static constexpr const char function_name[] = "get_array_private_data";
         throw_if_immutable<function_name, true, false>();
+        unshare_buffers();
         return static_cast<arrow_array_private_data*>(array_without_sanitize().private_data);
     }
 
+    void arrow_proxy::unshare_buffers()
+    {
+        if (m_array_is_immutable || !array_created_with_sparrow())
+        {
+            return;
+        }
+        auto* private_data = static_cast<arrow_array_private_data*>(array_without_sanitize().private_data);
+        if (private_data->unshare_buffers())
+        {
+            update_buffers();
+            create_bitmap_view();
+        }
+    }
+
     [[nodiscard]] const std::vector<sparrow::buffer_view<uint8_t>>& arrow_proxy::buffers() const
     {
         return m_buffers;
@@ -628,6 +647,7 @@ namespace sparrow
 
     [[nodiscard]] std::vector<sparrow::buffer_view<uint8_t>>& arrow_proxy::buffers()
     {
+        unshare_buffers();
         return m_buffers;
     }
 
@@ -636,8 +656,15 @@ namespace sparrow
         SPARROW_ASSERT_TRUE(std::cmp_less(index, n_buffers()));
         static constexpr const char function_name[] = "set_buffer";
         throw_if_immutable<function_name, true, false>();
-        get_array_private_data()->set_buffer(index, buffer);
+        // The private data copies the shared buffers except the replaced one
+        auto* private_data = static_cast<arrow_array_private_data*>(array_without_sanitize().private_data);
+        const bool was_shared = private_data->buffers_shared();
+        private_data->set_buffer(index, buffer);
         update_buffers();
+        if (was_shared)
+        {
+            create_bitmap_view();
+        }
         if (index == bitmap_buffer_index)
         {
             update_null_count();
@@ -649,8 +676,15 @@ namespace sparrow
         SPARROW_ASSERT_TRUE(std::cmp_less(index, n_buffers()));
         static constexpr const char function_name[] = "set_buffer";
         throw_if_immutable<function_name, true, false>();
-        get_array_private_data()->set_buffer(index, std::move(buffer));
+        // The private data copies the shared buffers except the replaced one
+        auto* private_data = static_cast<arrow_array_private_data*>(array_without_sanitize().private_data);
+        const bool was_shared = private_data->buffers_shared();
+        private_data->set_buffer(index, std::move(buffer));
         update_buffers();
+        if (was_shared)
+        {
+            create_bitmap_view();
+        }
         if (index == bitmap_buffer_index)
         {
             update_null_count();
@@ -716,6 +750,7 @@ namespace sparrow
                 current_dictionary_schema->release(current_dictionary_schema);
             }
             delete current_dictionary_schema;
+            invalidate_schema_fingerprints();
             schema_without_sanitize().dictionary = nullptr;
         }
     }
@@ -893,6 +928,7 @@ namespace sparrow
     {
         static constexpr const char function_name[] = "resize_bitmap";
         throw_if_immutable<function_name, true, false>();
+        unshare_buffers();
         SPARROW_ASSERT_TRUE(m_null_bitmap.has_value())
         m_null_bitmap->resize(new_size, value);
         const auto null_count = m_null_bitmap->null_count();
@@ -910,43 +946,42 @@ namespace sparrow
     {
         static constexpr const char function_name[] = "insert_bitmap";
         throw_if_immutable<function_name, true, false>();
-        SPARROW_ASSERT_TRUE(m_null_bitmap.has_value())
         SPARROW_ASSERT_TRUE(std::cmp_less_equal(index, length()))
         if (count == 0)
         {
             return index;
         }
-        auto it = m_null_bitmap->insert(sparrow::next(m_null_bitmap->cbegin(), index), count, value);
-        update_buffers();
-        const auto null_count = m_null_bitmap->null_count();
-        set_null_count(static_cast<int64_t>(null_count));
-        m_const_bitmap = const_bitmap_type(
-            m_null_bitmap->data(),
-            m_null_bitmap->size(),
-            static_cast<size_t>(m_null_bitmap->offset()),
-            static_cast<size_t>(null_count)
-        );
-        return std::distance(m_null_bitmap->begin(), it);
+        const bitset_edit edit{bitset_edit_kind::insert, index, count, value};
+        apply_bitmap_edits(std::span<const bitset_edit>(&edit, 1));
+        return index;
     }
 
     size_t arrow_proxy::erase_bitmap(size_t index, size_t count)
     {
         static constexpr const char function_name[] = "erase_bitmap";
         throw_if_immutable<function_name, true, false>();
-        SPARROW_ASSERT_TRUE(m_null_bitmap.has_value())
         SPARROW_ASSERT_TRUE(std::cmp_less(index, length()))
-        const auto it_first = sparrow::next(m_null_bitmap->cbegin(), index);
-        const auto it_last = sparrow::next(it_first, count);
-        const auto it = m_null_bitmap->erase(it_first, it_last);
+        const bitset_edit edit{bitset_edit_kind::erase, index, count};
+        apply_bitmap_edits(std::span<const bitset_edit>(&edit, 1));
+        return index;
+    }
+
+    void arrow_proxy::apply_bitmap_edits(std::span<const bitset_edit> edits)
+    {
+        static constexpr const char function_name[] = "apply_bitmap_edits";
+        throw_if_immutable<function_name, true, false>();
+        unshare_buffers();
+        SPARROW_ASSERT_TRUE(m_null_bitmap.has_value())
+        m_null_bitmap->apply_edits(edits);
         update_buffers();
-        set_null_count(static_cast<int64_t>(m_null_bitmap->null_count()));
+        const auto null_count = m_null_bitmap->null_count();
+        set_null_count(static_cast<int64_t>(null_count));
         m_const_bitmap = const_bitmap_type(
             m_null_bitmap->data(),
             m_null_bitmap->size(),
             static_cast<size_t>(m_null_bitmap->offset()),
-            static_cast<size_t>(null_count())
+            static_cast<size_t>(null_count)
         );
-        return std::distance(m_null_bitmap->begin(), it);
     }
 
     void arrow_proxy::push_back_bitmap(bool value)
@@ -1021,7 +1056,7 @@ namespace sparrow
 
         if (has_bitmap(data_type()))
         {
-            const auto& bitmap_buffer = buffers()[bitmap_buffer_index];
+            const auto& bitmap_buffer = std::as_const(*this).buffers()[bitmap_buffer_index];
             const auto new_non_null = count_non_null(
                 bitmap_buffer.data(),
                 new_length,
@@ -1108,6 +1143,7 @@ namespace sparrow
 
     [[nodiscard]] std::optional<arrow_proxy::bitmap_type>& arrow_proxy::bitmap()
     {
+        unshare_buffers();
         return m_null_bitmap;
     }
 
@@ -1125,12 +1161,25 @@ namespace sparrow
             // Use const accessor to get array - works for both mutable and immutable proxies
             const ArrowArray& arr = std::as_const(*this).array_without_sanitize();
 
-            const auto new_null_count = null_count.value_or(static_cast<size_t>(arr.null_count));
+            // A negative null count means it is unknown: the bitmap edits update the
+            // null count incrementally, so it has to be exact.
+            const auto new_null_count = null_count.value_or(
+                arr.null_count >= 0 ? static_cast<size_t>(arr.null_count)
+                                    : current_size
+                                          - count_non_null(
+                                              static_cast<const std::uint8_t*>(arr.buffers[bitmap_buffer_index]),
+                                              current_size,
+                                              (current_offset + current_size + 7) / 8,
+                                              current_offset
+                                          )
+            );
 
             if (array_created_with_sparrow())
             {
-                auto private_data = static_cast<arrow_array_private_data*>(arr.private_data);
-                auto& bitmap_buffer = private_data->buffers()[bitmap_buffer_index];
+                // The buffers may be shared with other proxies: the mutable bitmap is created
+                // without copying them, every mutating access calls unshare_buffers() first.
+                const auto private_data = static_cast<const arrow_array_private_data*>(arr.private_data);
+                auto& bitmap_buffer = const_cast<buffer<uint8_t>&>(private_data->buffers()[bitmap_buffer_index]);
                 m_null_bitmap.emplace(&bitmap_buffer, current_size, current_offset, new_null_count);
                 m_const_bitmap.emplace(bitmap_buffer.data(), current_size, current_offset, new_null_count);
             }
@@ -50,7 +50,13 @@ namespace sparrow
         auto private_data = static_cast<arrow_array_stream_private_data*>(stream->private_data);
         try
         {
-            copy_schema(*private_data->schema(), *out);
+            const ArrowSchema* schema = private_data->wait_for_schema();
+            if (schema == nullptr)
+            {
+                private_data->set_last_error_message("The ArrowArrayStream does not have a schema");
+                return EINVAL;
+            }
+            copy_schema(*schema, *out);
             return 0;
         }
         catch (const std::bad_alloc& e)
@@ -85,6 +91,11 @@ namespace sparrow
         try
         {
             ArrowArray* array_ptr = private_data->export_next_array();
+            if (array_ptr == nullptr)
+            {
+                // The stream has been closed with an error
+                return private_data->error_code();
+            }
             if (array_ptr->release == nullptr)
             {
                 // End of stream - return empty ArrowArray
@@ -131,14 +142,7 @@ namespace sparrow
         }
 
         auto private_data = static_cast<arrow_array_stream_private_data*>(stream->private_data);
-        const std::string& error_msg = private_data->get_last_error_message();
-
-        if (error_msg.empty())
-        {
-            return nullptr;
-        }
-
-        return error_msg.c_str();
+        return private_data->export_last_error_message();
     }
 
     void fill_arrow_array_stream(ArrowArrayStream& stream)
@@ -150,6 +154,15 @@ namespace sparrow
         stream.private_data = new arrow_array_stream_private_data();
     }
 
+    void fill_arrow_array_stream(ArrowArrayStream& stream, std::size_t capacity)
+    {
+        stream.get_last_error = &get_last_error_from_arrow_array_stream;
+        stream.get_next = &get_next_from_arrow_array_stream;
+        stream.get_schema = &get_schema_from_arrow_array_stream;
+        stream.release = &release_arrow_array_stream;
+        stream.private_data = new arrow_array_stream_private_data(capacity);
+    }
+
     ArrowArrayStream move_array_stream(ArrowArrayStream&& source)
     {
         ArrowArrayStream target = source;
@@ -16,6 +16,8 @@
 #include "sparrow/arrow_interface/arrow_array_stream_proxy.hpp"
 
 #include <optional>
+#include <string>
+#include <system_error>
 
 namespace sparrow
 {
@@ -25,6 +27,13 @@ namespace sparrow
         fill_arrow_array_stream(std::get<ArrowArrayStream>(m_stream));
     }
 
+    arrow_array_stream_proxy::arrow_array_stream_proxy(concurrent_stream_options options)
+        : m_stream(ArrowArrayStream{})
+    {
+        SPARROW_ASSERT_TRUE(options.capacity > 0);
+        fill_arrow_array_stream(std::get<ArrowArrayStream>(m_stream), options.capacity);
+    }
+
     arrow_array_stream_proxy::arrow_array_stream_proxy(ArrowArrayStream&& stream)
         : m_stream(move_array_stream(stream))
     {
@@ -124,6 +133,63 @@ namespace sparrow
         return *static_cast<arrow_array_stream_private_data*>(get_stream_ptr()->private_data);
     }
 
+    const arrow_array_stream_private_data& arrow_array_stream_proxy::get_private_data() const
+    {
+        throw_if_immutable();
+        return *static_cast<const arrow_array_stream_private_data*>(get_stream_ptr()->private_data);
+    }
+
+    bool arrow_array_stream_proxy::is_concurrent() const
+    {
+        return get_private_data().is_concurrent();
+    }
+
+    void arrow_array_stream_proxy::close()
+    {
+        get_private_data().close();
+    }
+
+    void arrow_array_stream_proxy::close(std::string_view message, int error_code)
+    {
+        SPARROW_ASSERT_TRUE(error_code != 0);
+        get_private_data().close(error_code, message);
+    }
+
+    bool arrow_array_stream_proxy::is_exhausted() const
+    {
+        return get_private_data().is_exhausted();
+    }
+
+    std::optional<array> arrow_array_stream_proxy::import_next_array(ArrowArray* next)
+    {
+        arrow_array_stream_private_data& private_data = get_private_data();
+        if (next == nullptr)
+        {
+            throw std::system_error(
+                private_data.error_code(),
+                std::generic_category(),
+                "Failed to get next array from ArrowArrayStream: " + private_data.get_last_error_message()
+            );
+        }
+
+        array_unique_ptr next_ptr(next, arrow_array_deleter{});
+        if (next->release == nullptr)
+        {
+            // End of stream
+            return std::nullopt;
+        }
+
+        const ArrowSchema* stream_schema = private_data.wait_for_schema();
+        if (stream_schema == nullptr)
+        {
+            throw std::runtime_error("ArrowArrayStream does not have a schema");
+        }
+        ArrowArray arr = move_array(*next_ptr);
+        ArrowSchema schema{};
+        copy_schema(*stream_schema, schema);
+        return sparrow::array(std::move(arr), std::move(schema));
+    }
+
     ArrowArrayStream* arrow_array_stream_proxy::export_stream()
     {
         if (std::holds_alternative<ArrowArrayStream*>(m_stream))
@@ -14,11 +14,27 @@
 
 #include "sparrow/arrow_interface/arrow_schema.hpp"
 
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <string_view>
+
 #include "sparrow/arrow_interface/arrow_array_schema_common_release.hpp"
 #include "sparrow/utils/repeat_container.hpp"
 
 namespace sparrow
 {
+    namespace
+    {
+        // Incremented each time arrow_proxy modifies a schema, see schema_fingerprint
+        std::atomic<std::uint64_t>& schema_generation()
+        {
+            static std::atomic<std::uint64_t> generation = 1;
+            return generation;
+        }
+    }
+
     void release_arrow_schema(ArrowSchema* schema)
     {
         SPARROW_ASSERT_FALSE(schema == nullptr);
@@ -102,9 +118,54 @@ namespace sparrow
         target.name = private_data->name_ptr();
         target.metadata = private_data->metadata_ptr();
         target.release = release_arrow_schema;
+        if (source.release == std::addressof(release_arrow_schema))
+        {
+            // The copy is compatible with the source: share the cached fingerprint
+            const auto* source_data = static_cast<const arrow_schema_private_data*>(source.private_data);
+            const std::uint64_t generation = schema_generation().load(std::memory_order_acquire);
+            if (const std::uint64_t fingerprint = source_data->cached_fingerprint(generation); fingerprint != 0)
+            {
+                private_data->set_cached_fingerprint(fingerprint, generation);
+            }
+        }
         copy_tracker::increase(copy_tracker::key<ArrowSchema>());
     }
 
+    namespace
+    {
+        // The whole binary encoding of the metadata, without decoding it
+        std::string_view metadata_bytes(const char* metadata)
+        {
+            const char* ptr = metadata;
+            const int32_t num_pairs = extract_int32(ptr);
+            for (int32_t i = 0; i < 2 * num_pairs; ++i)
+            {
+                const int32_t length = extract_int32(ptr);
+                std::advance(ptr, length);
+            }
+            return {metadata, static_cast<std::size_t>(ptr - metadata)};
+        }
+
+        constexpr std::uint64_t fingerprint_combine(std::uint64_t seed, std::uint64_t h)
+        {
+            seed ^= h + 0x9e3779b97f4a7c15ULL + (seed << 6) + (seed >> 2);
+            seed ^= seed >> 32;
+            seed *= 0xd6e8feb86659fd93ULL;
+            seed ^= seed >> 32;
+            return seed;
+        }
+
+        std::uint64_t fingerprint_string(std::uint64_t seed, const char* str)
+        {
+            // A null string and an empty string are different
+            if (str == nullptr)
+            {
+                return fingerprint_combine(seed, 0);
+            }
+            return fingerprint_combine(seed, std::hash<std::string_view>{}(str) | 1);
+        }
+    }
+
     bool check_compatible_schema(const ArrowSchema& schema1, const ArrowSchema& schema2)
     {
         if (&schema1 == &schema2)
@@ -146,9 +207,8 @@ namespace sparrow
         }
         if (schema1.metadata != nullptr && schema2.metadata != nullptr)
         {
-            key_value_view kv1(schema1.metadata);
-            key_value_view kv2(schema2.metadata);
-            if (get_metadata_from_key_values(kv1) != get_metadata_from_key_values(kv2))
+            // The encoding is the same for the same key/value pairs in the same order
+            if (metadata_bytes(schema1.metadata) != metadata_bytes(schema2.metadata))
             {
                 return false;
             }
@@ -195,6 +255,53 @@ namespace sparrow
         return true;
     }
 
+    std::uint64_t schema_fingerprint(const ArrowSchema& schema)
+    {
+        if (schema.release == nullptr)
+        {
+            return 0;
+        }
+        auto* private_data = schema.release == std::addressof(release_arrow_schema)
+                                 ? static_cast<arrow_schema_private_data*>(schema.private_data)
+                                 : nullptr;
+        // Read before hashing, so that a schema modified meanwhile is not cached as up to date
+        const std::uint64_t generation = schema_generation().load(std::memory_order_acquire);
+        if (private_data != nullptr)
+        {
+            if (const std::uint64_t fingerprint = private_data->cached_fingerprint(generation); fingerprint != 0)
+            {
+                return fingerprint;
+            }
+        }
+
+        std::uint64_t seed = fingerprint_string(0x2545f4914f6cdd1dULL, schema.format);
+        seed = fingerprint_string(seed, schema.name);
+        seed = fingerprint_combine(seed, static_cast<std::uint64_t>(schema.flags));
+        seed = fingerprint_combine(
+            seed,
+            schema.metadata == nullptr ? 0 : (std::hash<std::string_view>{}(metadata_bytes(schema.metadata)) | 1)
+        );
+        seed = fingerprint_combine(seed, schema.dictionary == nullptr ? 0 : schema_fingerprint(*schema.dictionary));
+        seed = fingerprint_combine(seed, static_cast<std::uint64_t>(schema.n_children));
+        for (int64_t i = 0; i < schema.n_children; ++i)
+        {
+            const ArrowSchema* child = schema.children == nullptr ? nullptr : schema.children[i];
+            seed = fingerprint_combine(seed, child == nullptr ? 0 : schema_fingerprint(*child));
+        }
+        // 0 is reserved for released schemas and for the absence of cached fingerprint
+        seed = seed == 0 ? 1 : seed;
+        if (private_data != nullptr)
+        {
+            private_data->set_cached_fingerprint(seed, generation);
+        }
+        return seed;
+    }
+
+    void invalidate_schema_fingerprints() noexcept
+    {
+        schema_generation().fetch_add(1, std::memory_order_acq_rel);
+    }
+
     void arrow_schema_deleter::operator()(ArrowSchema* schema) const
     {
         if (schema != nullptr)
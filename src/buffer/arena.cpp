@@ -0,0 +1,74 @@
+// Copyright 2024 Man Group Operations Limited
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "sparrow/buffer/arena.hpp"
+
+#include <algorithm>
+
+namespace sparrow
+{
+    namespace
+    {
+        thread_local arena* current_arena_ptr = nullptr;
+    }
+
+    arena::arena(std::size_t initial_size, std::pmr::memory_resource* upstream)
+        : m_resource(initial_size, upstream)
+    {
+    }
+
+    void arena::release()
+    {
+        m_resource.release();
+        m_allocated_bytes = 0;
+    }
+
+    std::size_t arena::allocated_bytes() const noexcept
+    {
+        return m_allocated_bytes;
+    }
+
+    void* arena::do_allocate(std::size_t bytes, std::size_t align)
+    {
+        void* p = m_resource.allocate(bytes, std::max(align, alignment));
+        m_allocated_bytes += bytes;
+        return p;
+    }
+
+    void arena::do_deallocate(void*, std::size_t, std::size_t)
+    {
+        // The memory is released all at once
+    }
+
+    bool arena::do_is_equal(const std::pmr::memory_resource& other) const noexcept
+    {
+        return this == &other;
+    }
+
+    arena_scope::arena_scope(arena& a) noexcept
+        : p_previous(current_arena_ptr)
+    {
+        current_arena_ptr = &a;
+    }
+
+    arena_scope::~arena_scope()
+    {
+        current_arena_ptr = p_previous;
+    }
+
+    arena* current_arena() noexcept
+    {
+        return current_arena_ptr;
+    }
+}
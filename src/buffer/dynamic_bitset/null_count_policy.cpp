@@ -15,13 +15,83 @@
 #include "sparrow/buffer/dynamic_bitset/null_count_policy.hpp"
 
 #include <algorithm>
+#include <atomic>
 #include <bit>
 #include <cstdint>
+#include <numeric>
+#include <vector>
 
 #include "sparrow/details/3rdparty/libpopcnt/libpopcnt.h"
+#include "sparrow/utils/parallel.hpp"
 
 namespace sparrow
 {
+    namespace
+    {
+        std::atomic<std::size_t> parallel_count_min_byte_size{0};
+        std::atomic<std::size_t> parallel_count_num_threads{0};
+
+        // Alignment of the chunks counted by different threads, so that each chunk
+        // is processed by the vector kernels of libpopcnt
+        constexpr std::size_t chunk_alignment = 64;
+
+        /**
+         * Counts the bits set in \c size whole bytes. libpopcnt selects its kernel at
+         * runtime (AVX-512 VPOPCNTDQ, AVX2, POPCNT or portable), from the CPU features
+         * detected on its first call. Large buffers are split into chunks counted by
+         * several threads, according to the parallel count settings.
+         */
+        [[nodiscard]] std::uint64_t count_bytes(const std::uint8_t* data, std::size_t size) noexcept
+        {
+            const std::size_t min_byte_size = parallel_count_min_byte_size.load(std::memory_order_relaxed);
+            if (min_byte_size != 0 && size >= min_byte_size)
+            {
+                const std::size_t num_threads = resolve_num_threads(
+                    parallel_count_num_threads.load(std::memory_order_relaxed)
+                );
+                const std::size_t chunk_size = ((size + num_threads - 1) / num_threads + chunk_alignment - 1)
+                                               / chunk_alignment * chunk_alignment;
+                const std::size_t chunk_count = (size + chunk_size - 1) / chunk_size;
+                if (chunk_count > 1)
+                {
+                    try
+                    {
+                        std::vector<std::uint64_t> counts(chunk_count);
+                        parallel_for(
+                            chunk_count,
+                            num_threads,
+                            [&](std::size_t i)
+                            {
+                                const std::size_t first = i * chunk_size;
+                                counts[i] = popcnt(data + first, std::min(chunk_size, size - first));
+                            }
+                        );
+                        return std::accumulate(counts.begin(), counts.end(), std::uint64_t(0));
+                    }
+                    catch (...)
+                    {
+                        // Threads could not be created, the buffer is counted by the calling thread
+                    }
+                }
+            }
+            return popcnt(data, size);
+        }
+    }
+
+    void set_parallel_count_settings(parallel_count_settings settings) noexcept
+    {
+        parallel_count_min_byte_size.store(settings.min_byte_size, std::memory_order_relaxed);
+        parallel_count_num_threads.store(settings.num_threads, std::memory_order_relaxed);
+    }
+
+    parallel_count_settings get_parallel_count_settings() noexcept
+    {
+        return {
+            parallel_count_min_byte_size.load(std::memory_order_relaxed),
+            parallel_count_num_threads.load(std::memory_order_relaxed)
+        };
+    }
+
     std::size_t
     count_non_null(const std::uint8_t* data, std::size_t bit_size, std::size_t byte_size, std::size_t offset) noexcept
     {
@@ -73,7 +143,7 @@ namespace sparrow
 
             if (bytes_to_count > 0)
             {
-                res += popcnt(data + current_byte, bytes_to_count);
+                res += count_bytes(data + current_byte, bytes_to_count);
                 bits_counted += bytes_to_count * bits_per_byte;
                 current_byte += bytes_to_count;
             }
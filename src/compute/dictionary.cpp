@@ -0,0 +1,621 @@
+// Copyright 2024 Man Group Operations Limited
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "sparrow/compute/dictionary.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <utility>
+
+#include "sparrow/arrow_interface/arrow_array.hpp"
+#include "sparrow/arrow_interface/arrow_schema.hpp"
+#include "sparrow/buffer/buffer.hpp"
+#include "sparrow/compute/kernel_utils.hpp"
+#include "sparrow/dictionary_encoded_array.hpp"
+#include "sparrow/layout/array_access.hpp"
+#include "sparrow/types/data_type.hpp"
+#include "sparrow/u8_buffer.hpp"
+#include "sparrow/utils/repeat_container.hpp"
+
+namespace sparrow::compute
+{
+    namespace
+    {
+        using buffer_type = buffer<std::uint8_t>;
+        using detail::bytes_view;
+        using detail::hash_bytes;
+        using detail::validity_reader;
+        using detail::value_reader;
+
+        constexpr std::size_t npos = std::numeric_limits<std::size_t>::max();
+
+        /**
+         * Builds a dictionary of distinct values in order of insertion, using an
+         * open-addressing hash table with linear probing. The table stores the hash
+         * and the index of the values, the bytes of the values are stored contiguously
+         * in the layout of the dictionary array.
+         */
+        class dictionary_builder
+        {
+        public:
+
+            dictionary_builder(std::size_t width, std::size_t expected_size)
+                : m_width(width)
+            {
+                std::size_t capacity = 16;
+                while (capacity < 2 * expected_size && capacity < (std::size_t(1) << 20))
+                {
+                    capacity *= 2;
+                }
+                m_slots.assign(capacity, slot{0, npos});
+                if (m_width == 0)
+                {
+                    m_offsets.push_back(0);
+                }
+            }
+
+            [[nodiscard]] std::size_t size() const noexcept
+            {
+                return m_size;
+            }
+
+            // Returns the index of \c value in the dictionary, inserting it if needed
+            std::size_t insert(bytes_view value)
+            {
+                const std::uint64_t h = hash_bytes(value);
+                std::size_t mask = m_slots.size() - 1;
+                std::size_t pos = static_cast<std::size_t>(h) & mask;
+                while (m_slots[pos].index != npos)
+                {
+                    const slot& s = m_slots[pos];
+                    if (s.hash == h && equal(s.index, value))
+                    {
+                        return s.index;
+                    }
+                    pos = (pos + 1) & mask;
+                }
+
+                const std::size_t index = m_size++;
+                m_slots[pos] = {h, index};
+                m_bytes.insert(m_bytes.end(), value.begin(), value.end());
+                if (m_width == 0)
+                {
+                    m_offsets.push_back(m_bytes.size());
+                }
+                if (2 * m_size > m_slots.size())
+                {
+                    grow();
+                }
+                return index;
+            }
+
+            // Builds the dictionary array, with the format of \c like
+            [[nodiscard]] array finish(const arrow_proxy& like) const
+            {
+                std::vector<buffer_type> buffers;
+                buffers.emplace_back(nullptr, 0, buffer_type::default_allocator());
+                const data_type dt = like.data_type();
+                if (m_width == 0)
+                {
+                    if (dt == data_type::LARGE_STRING || dt == data_type::LARGE_BINARY)
+                    {
+                        buffers.push_back(make_offsets<std::int64_t>());
+                    }
+                    else
+                    {
+                        if (m_bytes.size() > static_cast<std::size_t>(std::numeric_limits<std::int32_t>::max()))
+                        {
+                            throw std::overflow_error(
+                                "dictionary: the values of the dictionary do not fit in 32-bit offsets"
+                            );
+                        }
+                        buffers.push_back(make_offsets<std::int32_t>());
+                    }
+                }
+                buffer_type data(m_bytes.size(), buffer_type::default_allocator());
+                if (!m_bytes.empty())
+                {
+                    std::memcpy(data.data(), m_bytes.data(), m_bytes.size());
+                }
+                buffers.push_back(std::move(data));
+
+                ArrowArray arr = make_arrow_array(
+                    static_cast<std::int64_t>(m_size),
+                    0,  // null_count
+                    0,  // offset
+                    std::move(buffers),
+                    nullptr,
+                    repeat_view<bool>(true, 0),
+                    nullptr,
+                    true
+                );
+                ArrowSchema schema = make_arrow_schema(
+                    std::string(like.format()),
+                    std::optional<std::string_view>{},
+                    std::optional<std::vector<metadata_pair>>{},
+                    std::nullopt,
+                    nullptr,
+                    repeat_view<bool>(true, 0),
+                    nullptr,
+                    false
+                );
+                return array(arrow_proxy(std::move(arr), std::move(schema)));
+            }
+
+        private:
+
+            struct slot
+            {
+                std::uint64_t hash;
+                std::size_t index;
+            };
+
+            [[nodiscard]] bool equal(std::size_t index, bytes_view value) const noexcept
+            {
+                const std::size_t first = m_width == 0 ? m_offsets[index] : index * m_width;
+                const std::size_t last = m_width == 0 ? m_offsets[index + 1] : first + m_width;
+                return last - first == value.size()
+                       && (value.empty() || std::memcmp(m_bytes.data() + first, value.data(), value.size()) == 0);
+            }
+
+            void grow()
+            {
+                std::vector<slot> slots(2 * m_slots.size(), slot{0, npos});
+                const std::size_t mask = slots.size() - 1;
+                for (const slot& s : m_slots)
+                {
+                    if (s.index != npos)
+                    {
+                        std::size_t pos = static_cast<std::size_t>(s.hash) & mask;
+                        while (slots[pos].index != npos)
+                        {
+                            pos = (pos + 1) & mask;
+                        }
+                        slots[pos] = s;
+                    }
+                }
+                m_slots = std::move(slots);
+            }
+
+            template <class OT>
+            [[nodiscard]] buffer_type make_offsets() const
+            {
+                buffer_type result(m_offsets.size() * sizeof(OT), buffer_type::default_allocator());
+                auto* out = reinterpret_cast<OT*>(result.data());
+                for (std::size_t i = 0; i < m_offsets.size(); ++i)
+                {
+                    out[i] = static_cast<OT>(m_offsets[i]);
+                }
+                return result;
+            }
+
+            std::vector<slot> m_slots;
+            std::vector<std::uint8_t> m_bytes;
+            std::vector<std::size_t> m_offsets;
+            std::size_t m_width;
+            std::size_t m_size = 0;
+        };
+
+        // Calls \c func with the narrowest signed integer type able to index a
+        // dictionary of \c dictionary_size values
+        template <class F>
+        decltype(auto) with_key_type(std::size_t dictionary_size, F&& func)
+        {
+            if (dictionary_size <= std::size_t(std::numeric_limits<std::int8_t>::max()) + 1)
+            {
+                return func(std::type_identity<std::int8_t>{});
+            }
+            else if (dictionary_size <= std::size_t(std::numeric_limits<std::int16_t>::max()) + 1)
+            {
+                return func(std::type_identity<std::int16_t>{});
+            }
+            else if (dictionary_size <= std::size_t(std::numeric_limits<std::int32_t>::max()) + 1)
+            {
+                return func(std::type_identity<std::int32_t>{});
+            }
+            return func(std::type_identity<std::int64_t>{});
+        }
+
+        [[nodiscard]] const arrow_proxy& dictionary_of(const arrow_proxy& proxy, const char* caller)
+        {
+            if (proxy.dictionary() == nullptr)
+            {
+                throw std::invalid_argument(std::string(caller) + ": the array is not dictionary encoded");
+            }
+            return *proxy.dictionary();
+        }
+
+        // Calls \c func with the key type of the dictionary encoded array \c proxy
+        template <class F>
+        decltype(auto) visit_key_type(const arrow_proxy& proxy, const char* caller, F&& func)
+        {
+            switch (proxy.data_type())
+            {
+                case data_type::INT8:
+                    return func(std::type_identity<std::int8_t>{});
+                case data_type::UINT8:
+                    return func(std::type_identity<std::uint8_t>{});
+                case data_type::INT16:
+                    return func(std::type_identity<std::int16_t>{});
+                case data_type::UINT16:
+                    return func(std::type_identity<std::uint16_t>{});
+                case data_type::INT32:
+                    return func(std::type_identity<std::int32_t>{});
+                case data_type::UINT32:
+                    return func(std::type_identity<std::uint32_t>{});
+                case data_type::INT64:
+                    return func(std::type_identity<std::int64_t>{});
+                case data_type::UINT64:
+                    return func(std::type_identity<std::uint64_t>{});
+                default:
+                    throw std::invalid_argument(
+                        std::string(caller) + ": unsupported key format '" + std::string(proxy.format()) + "'"
+                    );
+            }
+        }
+
+        // Reads the keys of a dictionary encoded array, checking that the non null
+        // keys index a dictionary of \c dictionary_size values
+        template <std::integral IT>
+        class key_reader
+        {
+        public:
+
+            key_reader(const arrow_proxy& proxy, std::size_t dictionary_size)
+                : p_keys(reinterpret_cast<const IT*>(proxy.buffers()[1].data()) + proxy.offset())
+                , m_dictionary_size(dictionary_size)
+            {
+            }
+
+            [[nodiscard]] std::size_t operator[](std::size_t i) const
+            {
+                const IT key = p_keys[i];
+                if (std::cmp_less(key, 0) || std::cmp_greater_equal(key, m_dictionary_size))
+                {
+                    throw std::out_of_range("dictionary: key out of the range of the dictionary");
+                }
+                return static_cast<std::size_t>(key);
+            }
+
+        private:
+
+            const IT* p_keys;
+            std::size_t m_dictionary_size;
+        };
+
+        // Builds a dictionary encoded array from the dictionary indices of its elements
+        template <std::integral IT>
+        [[nodiscard]] array make_dictionary_array(
+            const std::vector<std::size_t>& indices,
+            array values,
+            std::optional<validity_bitmap> validity,
+            std::optional<std::string_view> name
+        )
+        {
+            u8_buffer<IT> keys(indices.size());
+            for (std::size_t i = 0; i < indices.size(); ++i)
+            {
+                keys[i] = static_cast<IT>(indices[i]);
+            }
+            if (validity.has_value())
+            {
+                return array(dictionary_encoded_array<IT>(std::move(keys), std::move(values), std::move(*validity), name));
+            }
+            return array(dictionary_encoded_array<IT>(std::move(keys), std::move(values), false, name));
+        }
+
+        template <std::size_t W>
+        void gather_fixed_width(
+            std::uint8_t* out,
+            const std::uint8_t* dictionary,
+            std::span<const std::size_t> indices,
+            const validity_bitmap& validity
+        )
+        {
+            for (std::size_t i = 0; i < indices.size(); ++i)
+            {
+                if (validity.test(i))
+                {
+                    std::memcpy(out + i * W, dictionary + indices[i] * W, W);
+                }
+            }
+        }
+
+        [[nodiscard]] buffer_type gather_fixed_width(
+            const value_reader& dictionary,
+            std::span<const std::size_t> indices,
+            const validity_bitmap& validity
+        )
+        {
+            const std::size_t width = dictionary.width();
+            buffer_type result(indices.size() * width, std::uint8_t(0), buffer_type::default_allocator());
+            std::uint8_t* out = result.data();
+            const std::uint8_t* in = dictionary.fixed_width_data();
+            switch (width)
+            {
+                case 1:
+                    gather_fixed_width<1>(out, in, indices, validity);
+                    break;
+                case 2:
+                    gather_fixed_width<2>(out, in, indices, validity);
+                    break;
+                case 4:
+                    gather_fixed_width<4>(out, in, indices, validity);
+                    break;
+                case 8:
+                    gather_fixed_width<8>(out, in, indices, validity);
+                    break;
+                case 16:
+                    gather_fixed_width<16>(out, in, indices, validity);
+                    break;
+                default:
+                    for (std::size_t i = 0; i < indices.size(); ++i)
+                    {
+                        if (validity.test(i))
+                        {
+                            std::memcpy(out + i * width, in + indices[i] * width, width);
+                        }
+                    }
+                    break;
+            }
+            return result;
+        }
+
+        template <class OT>
+        void gather_binary(
+            const value_reader& dictionary,
+            std::span<const std::size_t> indices,
+            const validity_bitmap& validity,
+            std::vector<buffer_type>& buffers
+        )
+        {
+            buffer_type offsets((indices.size() + 1) * sizeof(OT), buffer_type::default_allocator());
+            auto* out_offsets = reinterpret_cast<OT*>(offsets.data());
+            std::size_t total = 0;
+            out_offsets[0] = 0;
+            for (std::size_t i = 0; i < indices.size(); ++i)
+            {
+                if (validity.test(i))
+                {
+                    total += dictionary[indices[i]].size();
+                }
+                if (total > static_cast<std::size_t>(std::numeric_limits<OT>::max()))
+                {
+                    throw std::overflow_error("dictionary_decode: the decoded values do not fit in the offsets");
+                }
+                out_offsets[i + 1] = static_cast<OT>(total);
+            }
+
+            buffer_type data(total, buffer_type::default_allocator());
+            std::uint8_t* out = data.data();
+            for (std::size_t i = 0; i < indices.size(); ++i)
+            {
+                if (validity.test(i))
+                {
+                    const bytes_view value = dictionary[indices[i]];
+                    if (!value.empty())
+                    {
+                        std::memcpy(out + static_cast<std::size_t>(out_offsets[i]), value.data(), value.size());
+                    }
+                }
+            }
+            buffers.push_back(std::move(offsets));
+            buffers.push_back(std::move(data));
+        }
+    }
+
+    array dictionary_encode(const array& ar)
+    {
+        const arrow_proxy& proxy = sparrow::detail::array_access::get_arrow_proxy(ar);
+        const value_reader reader(proxy, "dictionary_encode");
+        const std::size_t size = reader.size();
+
+        dictionary_builder builder(reader.width(), size);
+        std::vector<std::size_t> indices(size, 0);
+        std::optional<validity_bitmap> validity;
+        if (reader.has_validity())
+        {
+            validity.emplace(size, true, validity_bitmap::default_allocator());
+        }
+        for (std::size_t i = 0; i < size; ++i)
+        {
+            if (reader.is_valid(i))
+            {
+                indices[i] = builder.insert(reader[i]);
+            }
+            else
+            {
+                validity->set(i, false);
+            }
+        }
+
+        return with_key_type(
+            builder.size(),
+            [&]<class IT>(std::type_identity<IT>)
+            {
+                return make_dictionary_array<IT>(indices, builder.finish(proxy), std::move(validity), proxy.name());
+            }
+        );
+    }
+
+    array dictionary_decode(const array& ar)
+    {
+        const arrow_proxy& proxy = sparrow::detail::array_access::get_arrow_proxy(ar);
+        const std::size_t size = proxy.length();
+        std::vector<std::size_t> indices(size, 0);
+        validity_bitmap validity(size, true, validity_bitmap::default_allocator());
+
+        const arrow_proxy& dictionary_proxy = dictionary_of(proxy, "dictionary_decode");
+        const value_reader dictionary(dictionary_proxy, "dictionary_decode");
+        const validity_reader keys_validity(proxy);
+        visit_key_type(
+            proxy,
+            "dictionary_decode",
+            [&]<class IT>(std::type_identity<IT>)
+            {
+                const key_reader<IT> keys(proxy, dictionary.size());
+                for (std::size_t i = 0; i < size; ++i)
+                {
+                    if (keys_validity.is_valid(i))
+                    {
+                        indices[i] = keys[i];
+                        if (!dictionary.is_valid(indices[i]))
+                        {
+                            validity.set(i, false);
+                        }
+                    }
+                    else
+                    {
+                        validity.set(i, false);
+                    }
+                }
+            }
+        );
+
+        std::vector<buffer_type> buffers;
+        if (dictionary.width() != 0)
+        {
+            buffers.push_back(gather_fixed_width(dictionary, indices, validity));
+        }
+        else if (dictionary.large_offsets())
+        {
+            gather_binary<std::int64_t>(dictionary, indices, validity, buffers);
+        }
+        else
+        {
+            gather_binary<std::int32_t>(dictionary, indices, validity, buffers);
+        }
+        const auto null_count = static_cast<std::int64_t>(validity.null_count());
+        buffers.insert(buffers.begin(), std::move(validity).extract_storage());
+
+        ArrowArray arr = make_arrow_array(
+            static_cast<std::int64_t>(size),
+            null_count,
+            0,  // offset
+            std::move(buffers),
+            nullptr,
+            repeat_view<bool>(true, 0),
+            nullptr,
+            true
+        );
+        ArrowSchema schema = make_arrow_schema(
+            std::string(dictionary_proxy.format()),
+            proxy.name(),
+            std::optional<std::vector<metadata_pair>>{},
+            std::make_optional<std::unordered_set<ArrowFlag>>({ArrowFlag::NULLABLE}),
+            nullptr,
+            repeat_view<bool>(true, 0),
+            nullptr,
+            false
+        );
+        return array(arrow_proxy(std::move(arr), std::move(schema)));
+    }
+
+    std::vector<array> unify_dictionaries(std::span<const array> arrays)
+    {
+        std::vector<array> result;
+        if (arrays.empty())
+        {
+            return result;
+        }
+
+        const arrow_proxy& first = dictionary_of(
+            sparrow::detail::array_access::get_arrow_proxy(arrays.front()),
+            "unify_dictionaries"
+        );
+        const value_reader first_dictionary(first, "unify_dictionaries");
+        dictionary_builder builder(first_dictionary.width(), first_dictionary.size());
+
+        // For each array, the index in the unified dictionary of each value of its
+        // dictionary, npos for null values
+        std::vector<std::vector<std::size_t>> transpositions;
+        transpositions.reserve(arrays.size());
+        for (const array& ar : arrays)
+        {
+            const arrow_proxy& dictionary_proxy = dictionary_of(
+                sparrow::detail::array_access::get_arrow_proxy(ar),
+                "unify_dictionaries"
+            );
+            if (dictionary_proxy.format() != first.format())
+            {
+                throw std::invalid_argument(
+                    "unify_dictionaries: cannot unify dictionaries of formats '" + std::string(first.format())
+                    + "' and '" + std::string(dictionary_proxy.format()) + "'"
+                );
+            }
+            const value_reader dictionary(dictionary_proxy, "unify_dictionaries");
+            std::vector<std::size_t> transposition(dictionary.size(), npos);
+            for (std::size_t i = 0; i < dictionary.size(); ++i)
+            {
+                if (dictionary.is_valid(i))
+                {
+                    transposition[i] = builder.insert(dictionary[i]);
+                }
+            }
+            transpositions.push_back(std::move(transposition));
+        }
+
+        const array unified = builder.finish(first);
+        result.reserve(arrays.size());
+        for (std::size_t a = 0; a < arrays.size(); ++a)
+        {
+            const arrow_proxy& proxy = sparrow::detail::array_access::get_arrow_proxy(arrays[a]);
+            const std::vector<std::size_t>& transposition = transpositions[a];
+            const validity_reader keys_validity(proxy);
+            const std::size_t size = proxy.length();
+            std::vector<std::size_t> indices(size, 0);
+            std::optional<validity_bitmap> validity;
+            if (keys_validity.has_validity() || std::ranges::find(transposition, npos) != transposition.end())
+            {
+                validity.emplace(size, true, validity_bitmap::default_allocator());
+            }
+
+            visit_key_type(
+                proxy,
+                "unify_dictionaries",
+                [&]<class IT>(std::type_identity<IT>)
+                {
+                    const key_reader<IT> keys(proxy, transposition.size());
+                    for (std::size_t i = 0; i < size; ++i)
+                    {
+                        const std::size_t index = keys_validity.is_valid(i) ? transposition[keys[i]] : npos;
+                        if (index == npos)
+                        {
+                            validity->set(i, false);
+                        }
+                        else
+                        {
+                            indices[i] = index;
+                        }
+                    }
+                }
+            );
+
+            result.push_back(with_key_type(
+                builder.size(),
+                [&]<class IT>(std::type_identity<IT>)
+                {
+                    return make_dictionary_array<IT>(indices, unified, std::move(validity), proxy.name());
+                }
+            ));
+        }
+        return result;
+    }
+}
@@ -0,0 +1,780 @@
+// Copyright 2024 Man Group Operations Limited
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "sparrow/compute/hash.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+#include "sparrow/compute/kernel_utils.hpp"
+#include "sparrow/layout/array_access.hpp"
+#include "sparrow/types/data_type.hpp"
+#include "sparrow/u8_buffer.hpp"
+
+namespace sparrow::compute
+{
+    namespace
+    {
+        using detail::bytes_view;
+        using detail::hash_bytes;
+        using detail::mix;
+        using detail::validity_reader;
+        using detail::value_reader;
+
+        constexpr std::size_t npos = std::numeric_limits<std::size_t>::max();
+        constexpr std::uint64_t null_hash = 0x2545f4914f6cdd1dULL;
+
+        [[nodiscard]] constexpr std::uint64_t combine(std::uint64_t seed, std::uint64_t h) noexcept
+        {
+            return mix(seed ^ (h + 0x9e3779b97f4a7c15ULL + (seed << 6) + (seed >> 2)));
+        }
+
+        template <std::size_t W>
+        void hash_fixed_width(const std::uint8_t* data, std::span<std::uint64_t> out) noexcept
+        {
+            for (std::size_t i = 0; i < out.size(); ++i)
+            {
+                out[i] = hash_bytes({data + i * W, W});
+            }
+        }
+
+        template <class IT>
+        void read_keys(const arrow_proxy& proxy, std::size_t dictionary_size, std::vector<std::size_t>& keys)
+        {
+            const IT* data = reinterpret_cast<const IT*>(proxy.buffers()[1].data()) + proxy.offset();
+            const validity_reader validity(proxy);
+            for (std::size_t i = 0; i < keys.size(); ++i)
+            {
+                if (validity.is_valid(i))
+                {
+                    if (std::cmp_less(data[i], 0) || std::cmp_greater_equal(data[i], dictionary_size))
+                    {
+                        throw std::out_of_range("hash: key out of the range of the dictionary");
+                    }
+                    keys[i] = static_cast<std::size_t>(data[i]);
+                }
+            }
+        }
+
+        /**
+         * Hashing and element comparison of an array. The children of nested arrays, and
+         * the dictionary of dictionary encoded arrays, are columns themselves.
+         */
+        class column
+        {
+        public:
+
+            column(const arrow_proxy& proxy, const char* caller)
+                : p_proxy(&proxy)
+                , m_validity(proxy)
+                , m_offset(proxy.offset())
+                , m_size(proxy.length())
+            {
+                if (proxy.dictionary() != nullptr)
+                {
+                    init_dictionary(caller);
+                    return;
+                }
+                switch (proxy.data_type())
+                {
+                    case data_type::NA:
+                        m_kind = kind::null;
+                        break;
+                    case data_type::BOOL:
+                        m_kind = kind::boolean;
+                        p_data = proxy.buffers()[1].data();
+                        break;
+                    case data_type::LIST:
+                    case data_type::MAP:
+                    case data_type::LARGE_LIST:
+                        m_kind = kind::list;
+                        m_large_offsets = proxy.data_type() == data_type::LARGE_LIST;
+                        p_data = proxy.buffers()[1].data();
+                        init_children(caller);
+                        break;
+                    case data_type::FIXED_SIZED_LIST:
+                        // Format is "+w:<list size>"
+                        m_kind = kind::fixed_size_list;
+                        m_list_size = static_cast<std::size_t>(std::stoull(std::string(proxy.format().substr(3))));
+                        init_children(caller);
+                        break;
+                    case data_type::STRUCT:
+                        m_kind = kind::structure;
+                        init_children(caller);
+                        break;
+                    default:
+                        // Throws for the other layouts
+                        m_kind = kind::values;
+                        m_values.emplace(proxy, caller);
+                        break;
+                }
+            }
+
+            [[nodiscard]] std::size_t size() const noexcept
+            {
+                return m_size;
+            }
+
+            // True if the values of the column can be compared with memcmp, a block at a time
+            [[nodiscard]] bool is_dense_fixed_width() const noexcept
+            {
+                return m_kind == kind::values && m_values->width() != 0 && !m_validity.has_validity();
+            }
+
+            [[nodiscard]] const std::uint8_t* fixed_width_data() const noexcept
+            {
+                return m_values->fixed_width_data();
+            }
+
+            [[nodiscard]] std::size_t width() const noexcept
+            {
+                return m_values->width();
+            }
+
+            [[nodiscard]] bool is_null(std::size_t i) const noexcept
+            {
+                switch (m_kind)
+                {
+                    case kind::null:
+                        return true;
+                    case kind::dictionary:
+                        return m_keys[i] == npos || m_children[0].is_null(m_keys[i]);
+                    default:
+                        return !m_validity.is_valid(i);
+                }
+            }
+
+            void hash(std::span<std::uint64_t> out) const
+            {
+                switch (m_kind)
+                {
+                    case kind::null:
+                        std::ranges::fill(out, null_hash);
+                        return;
+                    case kind::boolean:
+                        for (std::size_t i = 0; i < m_size; ++i)
+                        {
+                            out[i] = mix(bit(i) ? 2 : 1);
+                        }
+                        break;
+                    case kind::values:
+                        hash_values(out);
+                        break;
+                    case kind::dictionary:
+                    {
+                        // The dictionary is hashed once, null values included
+                        std::vector<std::uint64_t> dictionary_hashes(m_children[0].size());
+                        m_children[0].hash(dictionary_hashes);
+                        for (std::size_t i = 0; i < m_size; ++i)
+                        {
+                            out[i] = m_keys[i] == npos ? null_hash : dictionary_hashes[m_keys[i]];
+                        }
+                        return;
+                    }
+                    case kind::structure:
+                    {
+                        std::ranges::fill(out, mix(m_children.size()));
+                        for (const column& child : m_children)
+                        {
+                            std::vector<std::uint64_t> child_hashes(child.size());
+                            child.hash(child_hashes);
+                            for (std::size_t i = 0; i < m_size; ++i)
+                            {
+                                out[i] = combine(out[i], child_hashes[m_offset + i]);
+                            }
+                        }
+                        break;
+                    }
+                    case kind::list:
+                    case kind::fixed_size_list:
+                    {
+                        std::vector<std::uint64_t> child_hashes(m_children[0].size());
+                        m_children[0].hash(child_hashes);
+                        for (std::size_t i = 0; i < m_size; ++i)
+                        {
+                            const auto [first, last] = list_range(i);
+                            std::uint64_t h = mix(last - first);
+                            for (std::size_t k = first; k < last; ++k)
+                            {
+                                h = combine(h, child_hashes[k]);
+                            }
+                            out[i] = h;
+                        }
+                        break;
+                    }
+                }
+                if (m_validity.has_validity())
+                {
+                    for (std::size_t i = 0; i < m_size; ++i)
+                    {
+                        if (!m_validity.is_valid(i))
+                        {
+                            out[i] = null_hash;
+                        }
+                    }
+                }
+            }
+
+            // Compares the element i of this column with the element j of \c other,
+            // which must be comparable with this column
+            [[nodiscard]] bool equal(std::size_t i, const column& other, std::size_t j) const
+            {
+                const bool null = is_null(i);
+                const bool other_null = other.is_null(j);
+                if (null || other_null)
+                {
+                    return null && other_null;
+                }
+                switch (m_kind)
+                {
+                    case kind::null:
+                        return true;
+                    case kind::boolean:
+                        return bit(i) == other.bit(j);
+                    case kind::values:
+                    {
+                        const bytes_view lhs = (*m_values)[i];
+                        const bytes_view rhs = (*other.m_values)[j];
+                        return lhs.size() == rhs.size()
+                               && (lhs.empty() || std::memcmp(lhs.data(), rhs.data(), lhs.size()) == 0);
+                    }
+                    case kind::dictionary:
+                        return m_children[0].equal(m_keys[i], other.m_children[0], other.m_keys[j]);
+                    case kind::structure:
+                        for (std::size_t c = 0; c < m_children.size(); ++c)
+                        {
+                            if (!m_children[c].equal(m_offset + i, other.m_children[c], other.m_offset + j))
+                            {
+                                return false;
+                            }
+                        }
+                        return true;
+                    case kind::list:
+                    case kind::fixed_size_list:
+                    {
+                        const auto [first, last] = list_range(i);
+                        const auto [other_first, other_last] = other.list_range(j);
+                        if (last - first != other_last - other_first)
+                        {
+                            return false;
+                        }
+                        for (std::size_t k = 0; k < last - first; ++k)
+                        {
+                            if (!m_children[0].equal(first + k, other.m_children[0], other_first + k))
+                            {
+                                return false;
+                            }
+                        }
+                        return true;
+                    }
+                }
+                return false;
+            }
+
+            // Throws if the elements of this column cannot be compared with those of \c other
+            void check_comparable(const column& other, const char* caller) const
+            {
+                const bool comparable = m_kind == other.m_kind && m_children.size() == other.m_children.size()
+                                        && (m_kind == kind::dictionary
+                                            || p_proxy->format() == other.p_proxy->format());
+                if (!comparable)
+                {
+                    throw std::invalid_argument(
+                        std::string(caller) + ": arrays of formats '" + std::string(p_proxy->format())
+                        + "' and '" + std::string(other.p_proxy->format()) + "' cannot be compared"
+                    );
+                }
+                for (std::size_t c = 0; c < m_children.size(); ++c)
+                {
+                    m_children[c].check_comparable(other.m_children[c], caller);
+                }
+            }
+
+        private:
+
+            enum class kind
+            {
+                null,
+                boolean,
+                values,
+                dictionary,
+                structure,
+                list,
+                fixed_size_list
+            };
+
+            void init_children(const char* caller)
+            {
+                m_children.reserve(p_proxy->children().size());
+                for (const arrow_proxy& child : p_proxy->children())
+                {
+                    m_children.emplace_back(child, caller);
+                }
+            }
+
+            void init_dictionary(const char* caller)
+            {
+                m_kind = kind::dictionary;
+                m_children.emplace_back(*p_proxy->dictionary(), caller);
+                m_keys.assign(m_size, npos);
+                const std::size_t dictionary_size = m_children[0].size();
+                switch (p_proxy->data_type())
+                {
+                    case data_type::INT8:
+                        read_keys<std::int8_t>(*p_proxy, dictionary_size, m_keys);
+                        break;
+                    case data_type::UINT8:
+                        read_keys<std::uint8_t>(*p_proxy, dictionary_size, m_keys);
+                        break;
+                    case data_type::INT16:
+                        read_keys<std::int16_t>(*p_proxy, dictionary_size, m_keys);
+                        break;
+                    case data_type::UINT16:
+                        read_keys<std::uint16_t>(*p_proxy, dictionary_size, m_keys);
+                        break;
+                    case data_type::INT32:
+                        read_keys<std::int32_t>(*p_proxy, dictionary_size, m_keys);
+                        break;
+                    case data_type::UINT32:
+                        read_keys<std::uint32_t>(*p_proxy, dictionary_size, m_keys);
+                        break;
+                    case data_type::INT64:
+                        read_keys<std::int64_t>(*p_proxy, dictionary_size, m_keys);
+                        break;
+                    case data_type::UINT64:
+                        read_keys<std::uint64_t>(*p_proxy, dictionary_size, m_keys);
+                        break;
+                    default:
+                        throw std::invalid_argument(
+                            std::string(caller) + ": unsupported key format '" + std::string(p_proxy->format()) + "'"
+                        );
+                }
+            }
+
+            [[nodiscard]] bool bit(std::size_t i) const noexcept
+            {
+                const std::size_t index = m_offset + i;
+                return ((p_data[index / 8] >> (index % 8)) & 1) != 0;
+            }
+
+            // Range of the child elements of the list i
+            [[nodiscard]] std::pair<std::size_t, std::size_t> list_range(std::size_t i) const noexcept
+            {
+                const std::size_t index = m_offset + i;
+                if (m_kind == kind::fixed_size_list)
+                {
+                    return {index * m_list_size, (index + 1) * m_list_size};
+                }
+                if (m_large_offsets)
+                {
+                    const auto* offsets = reinterpret_cast<const std::int64_t*>(p_data);
+                    return {static_cast<std::size_t>(offsets[index]), static_cast<std::size_t>(offsets[index + 1])};
+                }
+                const auto* offsets = reinterpret_cast<const std::int32_t*>(p_data);
+                return {static_cast<std::size_t>(offsets[index]), static_cast<std::size_t>(offsets[index + 1])};
+            }
+
+            void hash_values(std::span<std::uint64_t> out) const noexcept
+            {
+                const value_reader& values = *m_values;
+                switch (values.width())
+                {
+                    case 0:
+                        for (std::size_t i = 0; i < m_size; ++i)
+                        {
+                            out[i] = hash_bytes(values[i]);
+                        }
+                        break;
+                    case 1:
+                        hash_fixed_width<1>(values.fixed_width_data(), out);
+                        break;
+                    case 2:
+                        hash_fixed_width<2>(values.fixed_width_data(), out);
+                        break;
+                    case 4:
+                        hash_fixed_width<4>(values.fixed_width_data(), out);
+                        break;
+                    case 8:
+                        hash_fixed_width<8>(values.fixed_width_data(), out);
+                        break;
+                    case 16:
+                        hash_fixed_width<16>(values.fixed_width_data(), out);
+                        break;
+                    default:
+                        for (std::size_t i = 0; i < m_size; ++i)
+                        {
+                            out[i] = hash_bytes(values[i]);
+                        }
+                        break;
+                }
+            }
+
+            const arrow_proxy* p_proxy;
+            kind m_kind = kind::values;
+            validity_reader m_validity;
+            std::optional<value_reader> m_values;
+            const std::uint8_t* p_data = nullptr;
+            std::size_t m_offset;
+            std::size_t m_size;
+            std::size_t m_list_size = 0;
+            bool m_large_offsets = false;
+            std::vector<std::size_t> m_keys;
+            std::vector<column> m_children;
+        };
+
+        [[nodiscard]] primitive_array<std::uint64_t> make_hash_array(std::vector<std::uint64_t>&& hashes)
+        {
+            u8_buffer<std::uint64_t> data(hashes.size());
+            std::ranges::copy(hashes, data.begin());
+            return primitive_array<std::uint64_t>(std::move(data), hashes.size(), false);
+        }
+
+        [[nodiscard]] const arrow_proxy&
+        get_column_proxy(const record_batch& rb, const std::string& name, const char* caller)
+        {
+            if (!rb.contains_column(name))
+            {
+                throw std::out_of_range(std::string(caller) + ": no column named '" + name + "'");
+            }
+            return sparrow::detail::array_access::get_arrow_proxy(rb.get_column(name));
+        }
+
+        // Key columns of a record batch, hashed and compared row by row
+        class key_columns
+        {
+        public:
+
+            key_columns(const record_batch& rb, std::span<const std::string> names, const char* caller)
+                : m_size(rb.nb_rows())
+            {
+                m_columns.reserve(names.size());
+                for (const std::string& name : names)
+                {
+                    m_columns.emplace_back(get_column_proxy(rb, name, caller), caller);
+                }
+            }
+
+            [[nodiscard]] std::size_t size() const noexcept
+            {
+                return m_size;
+            }
+
+            [[nodiscard]] std::vector<std::uint64_t> hash() const
+            {
+                std::vector<std::uint64_t> hashes(m_size, mix(m_columns.size()));
+                std::vector<std::uint64_t> column_hashes(m_size);
+                for (const column& col : m_columns)
+                {
+                    col.hash(column_hashes);
+                    for (std::size_t i = 0; i < m_size; ++i)
+                    {
+                        hashes[i] = combine(hashes[i], column_hashes[i]);
+                    }
+                }
+                return hashes;
+            }
+
+            [[nodiscard]] bool has_null(std::size_t row) const noexcept
+            {
+                return std::ranges::any_of(
+                    m_columns,
+                    [row](const column& col)
+                    {
+                        return col.is_null(row);
+                    }
+                );
+            }
+
+            [[nodiscard]] bool equal(std::size_t row, const key_columns& other, std::size_t other_row) const
+            {
+                for (std::size_t c = 0; c < m_columns.size(); ++c)
+                {
+                    if (!m_columns[c].equal(row, other.m_columns[c], other_row))
+                    {
+                        return false;
+                    }
+                }
+                return true;
+            }
+
+            void check_comparable(const key_columns& other, const char* caller) const
+            {
+                if (m_columns.size() != other.m_columns.size())
+                {
+                    throw std::invalid_argument(std::string(caller) + ": the numbers of keys differ");
+                }
+                for (std::size_t c = 0; c < m_columns.size(); ++c)
+                {
+                    m_columns[c].check_comparable(other.m_columns[c], caller);
+                }
+            }
+
+        private:
+
+            std::vector<column> m_columns;
+            std::size_t m_size;
+        };
+
+        /**
+         * Open-addressing hash table with linear probing, mapping distinct keys to the
+         * index of their first row. The slots store the hash of the keys so that most
+         * of the mismatching rows are not compared.
+         */
+        class row_table
+        {
+        public:
+
+            explicit row_table(std::size_t expected_size)
+            {
+                std::size_t capacity = 16;
+                while (capacity < 2 * expected_size)
+                {
+                    capacity *= 2;
+                }
+                m_slots.assign(capacity, slot{0, npos});
+            }
+
+            // Returns the slot of the row with the given hash for which \c equal holds,
+            // or the empty slot where such a row must be inserted
+            template <class Equal>
+            [[nodiscard]] std::size_t find(std::uint64_t hash, Equal&& equal) const
+            {
+                const std::size_t mask = m_slots.size() - 1;
+                std::size_t pos = static_cast<std::size_t>(hash) & mask;
+                while (m_slots[pos].row != npos && !(m_slots[pos].hash == hash && equal(m_slots[pos].row)))
+                {
+                    pos = (pos + 1) & mask;
+                }
+                return pos;
+            }
+
+            [[nodiscard]] std::size_t row(std::size_t pos) const noexcept
+            {
+                return m_slots[pos].row;
+            }
+
+            void insert(std::size_t pos, std::uint64_t hash, std::size_t row)
+            {
+                m_slots[pos] = {hash, row};
+                if (2 * ++m_size > m_slots.size())
+                {
+                    grow();
+                }
+            }
+
+        private:
+
+            struct slot
+            {
+                std::uint64_t hash;
+                std::size_t row;
+            };
+
+            void grow()
+            {
+                std::vector<slot> slots(2 * m_slots.size(), slot{0, npos});
+                const std::size_t mask = slots.size() - 1;
+                for (const slot& s : m_slots)
+                {
+                    if (s.row != npos)
+                    {
+                        std::size_t pos = static_cast<std::size_t>(s.hash) & mask;
+                        while (slots[pos].row != npos)
+                        {
+                            pos = (pos + 1) & mask;
+                        }
+                        slots[pos] = s;
+                    }
+                }
+                m_slots = std::move(slots);
+            }
+
+            std::vector<slot> m_slots;
+            std::size_t m_size = 0;
+        };
+    }
+
+    primitive_array<std::uint64_t> hash(const array& ar)
+    {
+        const column col(sparrow::detail::array_access::get_arrow_proxy(ar), "hash");
+        std::vector<std::uint64_t> hashes(col.size());
+        col.hash(hashes);
+        return make_hash_array(std::move(hashes));
+    }
+
+    primitive_array<std::uint64_t> hash(const record_batch& rb, std::span<const std::string> columns)
+    {
+        return make_hash_array(key_columns(rb, columns, "hash").hash());
+    }
+
+    dynamic_bitset<std::uint8_t> equals(const array& lhs, const array& rhs)
+    {
+        detail::check_same_size(lhs.size(), rhs.size());
+        const column lhs_column(sparrow::detail::array_access::get_arrow_proxy(lhs), "equals");
+        const column rhs_column(sparrow::detail::array_access::get_arrow_proxy(rhs), "equals");
+        lhs_column.check_comparable(rhs_column, "equals");
+
+        const std::size_t size = lhs.size();
+        if (lhs_column.is_dense_fixed_width() && rhs_column.is_dense_fixed_width())
+        {
+            // Blocks of 8 values are compared at once, a block with a difference is
+            // compared value by value
+            using storage_type = dynamic_bitset<std::uint8_t>::storage_type;
+            const std::size_t width = lhs_column.width();
+            const std::uint8_t* lhs_data = lhs_column.fixed_width_data();
+            const std::uint8_t* rhs_data = rhs_column.fixed_width_data();
+            storage_type storage((size + 7) / 8, std::uint8_t(0), validity_bitmap::default_allocator());
+            std::uint8_t* out = storage.data();
+            auto same = [&](std::size_t i)
+            {
+                return std::memcmp(lhs_data + i * width, rhs_data + i * width, width) == 0;
+            };
+            const std::size_t full_bytes = size / 8;
+            for (std::size_t k = 0; k < full_bytes; ++k)
+            {
+                if (std::memcmp(lhs_data + k * 8 * width, rhs_data + k * 8 * width, 8 * width) == 0)
+                {
+                    out[k] = 0xFF;
+                    continue;
+                }
+                std::uint8_t bits = 0;
+                for (std::size_t j = 0; j < 8; ++j)
+                {
+                    bits |= static_cast<std::uint8_t>(static_cast<std::uint8_t>(same(k * 8 + j)) << j);
+                }
+                out[k] = bits;
+            }
+            for (std::size_t i = full_bytes * 8; i < size; ++i)
+            {
+                if (same(i))
+                {
+                    out[i / 8] |= static_cast<std::uint8_t>(1u << (i % 8));
+                }
+            }
+            return dynamic_bitset<std::uint8_t>(std::move(storage), size, 0);
+        }
+
+        dynamic_bitset<std::uint8_t> result(size, false, validity_bitmap::default_allocator());
+        for (std::size_t i = 0; i < size; ++i)
+        {
+            if (lhs_column.equal(i, rhs_column, i))
+            {
+                result.set(i, true);
+            }
+        }
+        return result;
+    }
+
+    grouping group_by(const record_batch& rb, std::span<const std::string> keys)
+    {
+        const key_columns columns(rb, keys, "group_by");
+        const std::vector<std::uint64_t> hashes = columns.hash();
+        grouping result;
+        result.group_ids.resize(columns.size());
+        // The table maps the first row of each group to the group
+        row_table table(columns.size());
+        std::vector<std::size_t> group_of_first_row(columns.size(), npos);
+        for (std::size_t row = 0; row < columns.size(); ++row)
+        {
+            const std::size_t pos = table.find(
+                hashes[row],
+                [&](std::size_t other_row)
+                {
+                    return columns.equal(row, columns, other_row);
+                }
+            );
+            if (table.row(pos) == npos)
+            {
+                group_of_first_row[row] = result.first_rows.size();
+                result.first_rows.push_back(row);
+                table.insert(pos, hashes[row], row);
+            }
+            result.group_ids[row] = group_of_first_row[table.row(pos)];
+        }
+        return result;
+    }
+
+    std::vector<std::pair<std::size_t, std::size_t>> hash_join(
+        const record_batch& left,
+        std::span<const std::string> left_keys,
+        const record_batch& right,
+        std::span<const std::string> right_keys
+    )
+    {
+        const key_columns left_columns(left, left_keys, "hash_join");
+        const key_columns right_columns(right, right_keys, "hash_join");
+        left_columns.check_comparable(right_columns, "hash_join");
+
+        // Build side: the table maps each distinct key of the right side to its first
+        // row, and the next rows with the same key are chained in increasing order
+        const std::vector<std::uint64_t> right_hashes = right_columns.hash();
+        row_table table(right_columns.size());
+        std::vector<std::size_t> next(right_columns.size(), npos);
+        std::vector<std::size_t> last(right_columns.size(), npos);
+        for (std::size_t row = 0; row < right_columns.size(); ++row)
+        {
+            if (right_columns.has_null(row))
+            {
+                continue;
+            }
+            const std::size_t pos = table.find(
+                right_hashes[row],
+                [&](std::size_t other_row)
+                {
+                    return right_columns.equal(row, right_columns, other_row);
+                }
+            );
+            const std::size_t first = table.row(pos);
+            if (first == npos)
+            {
+                table.insert(pos, right_hashes[row], row);
+                last[row] = row;
+            }
+            else
+            {
+                next[last[first]] = row;
+                last[first] = row;
+            }
+        }
+
+        // Probe side
+        const std::vector<std::uint64_t> left_hashes = left_columns.hash();
+        std::vector<std::pair<std::size_t, std::size_t>> result;
+        for (std::size_t row = 0; row < left_columns.size(); ++row)
+        {
+            if (left_columns.has_null(row))
+            {
+                continue;
+            }
+            const std::size_t pos = table.find(
+                left_hashes[row],
+                [&](std::size_t other_row)
+                {
+                    return left_columns.equal(row, right_columns, other_row);
+                }
+            );
+            for (std::size_t match = table.row(pos); match != npos; match = next[match])
+            {
+                result.emplace_back(row, match);
+            }
+        }
+        return result;
+    }
+}
@@ -0,0 +1,760 @@
+// Copyright 2024 Man Group Operations Limited
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "sparrow/compute/selection.hpp"
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "sparrow/arrow_interface/arrow_array.hpp"
+#include "sparrow/arrow_interface/arrow_schema.hpp"
+#include "sparrow/buffer/buffer.hpp"
+#include "sparrow/buffer/dynamic_bitset/dynamic_bitset.hpp"
+#include "sparrow/compute/kernel_utils.hpp"
+#include "sparrow/layout/array_access.hpp"
+#include "sparrow/types/data_type.hpp"
+#include "sparrow/utils/repeat_container.hpp"
+
+namespace sparrow::compute
+{
+    namespace
+    {
+        using buffer_type = buffer<std::uint8_t>;
+        using indices_type = std::span<const std::size_t>;
+
+        [[nodiscard]] buffer_type make_buffer(std::size_t size)
+        {
+            return buffer_type(size, buffer_type::default_allocator());
+        }
+
+        [[nodiscard]] bool test_bit(const std::uint8_t* bits, std::size_t bit) noexcept
+        {
+            return ((bits[bit / 8] >> (bit % 8)) & 1) != 0;
+        }
+
+        /**
+         * Gathers the bits \c offset + \c indices[i] of \c bits into a new bitmap, a byte
+         * of output at a time. Returns the bitmap and its number of unset bits.
+         */
+        [[nodiscard]] std::pair<buffer_type, std::size_t>
+        gather_bits(const std::uint8_t* bits, std::size_t offset, indices_type indices)
+        {
+            buffer_type result = make_buffer((indices.size() + 7) / 8);
+            std::uint8_t* out = result.data();
+            std::size_t set_count = 0;
+            const std::size_t full_bytes = indices.size() / 8;
+            for (std::size_t k = 0; k < full_bytes; ++k)
+            {
+                std::uint8_t byte = 0;
+                for (std::size_t j = 0; j < 8; ++j)
+                {
+                    byte |= static_cast<std::uint8_t>(test_bit(bits, offset + indices[8 * k + j]) << j);
+                }
+                out[k] = byte;
+                set_count += static_cast<std::size_t>(std::popcount(byte));
+            }
+            if (full_bytes * 8 < indices.size())
+            {
+                std::uint8_t byte = 0;
+                for (std::size_t i = full_bytes * 8; i < indices.size(); ++i)
+                {
+                    byte |= static_cast<std::uint8_t>(test_bit(bits, offset + indices[i]) << (i % 8));
+                }
+                out[full_bytes] = byte;
+                set_count += static_cast<std::size_t>(std::popcount(byte));
+            }
+            return {std::move(result), indices.size() - set_count};
+        }
+
+        // Gathers the validity bitmap, an array without nulls gives an array without bitmap
+        [[nodiscard]] std::pair<buffer_type, std::size_t> take_validity(const arrow_proxy& proxy, indices_type indices)
+        {
+            const detail::validity_reader validity(proxy);
+            if (!validity.has_validity())
+            {
+                return {buffer_type(nullptr, 0, buffer_type::default_allocator()), 0};
+            }
+            return gather_bits(proxy.buffers()[0].data(), proxy.offset(), indices);
+        }
+
+        template <std::size_t W>
+        void gather_fixed_width(std::uint8_t* out, const std::uint8_t* in, indices_type indices)
+        {
+            for (std::size_t i = 0; i < indices.size(); ++i)
+            {
+                std::memcpy(out + i * W, in + indices[i] * W, W);
+            }
+        }
+
+        [[nodiscard]] buffer_type take_fixed_width(const arrow_proxy& proxy, std::size_t width, indices_type indices)
+        {
+            buffer_type result = make_buffer(indices.size() * width);
+            std::uint8_t* out = result.data();
+            const std::uint8_t* in = proxy.buffers()[1].data() + proxy.offset() * width;
+            switch (width)
+            {
+                case 1:
+                    gather_fixed_width<1>(out, in, indices);
+                    break;
+                case 2:
+                    gather_fixed_width<2>(out, in, indices);
+                    break;
+                case 4:
+                    gather_fixed_width<4>(out, in, indices);
+                    break;
+                case 8:
+                    gather_fixed_width<8>(out, in, indices);
+                    break;
+                case 16:
+                    gather_fixed_width<16>(out, in, indices);
+                    break;
+                case 32:
+                    gather_fixed_width<32>(out, in, indices);
+                    break;
+                default:
+                    for (std::size_t i = 0; i < indices.size(); ++i)
+                    {
+                        std::memcpy(out + i * width, in + indices[i] * width, width);
+                    }
+                    break;
+            }
+            return result;
+        }
+
+        /**
+         * Builds the offsets of the gathered elements of a layout with offsets, and returns
+         * them with the positions of the values (bytes or child elements) to copy.
+         */
+        template <class OT>
+        [[nodiscard]] std::pair<buffer_type, std::vector<std::size_t>>
+        take_offsets(const arrow_proxy& proxy, indices_type indices, bool expand_positions)
+        {
+            const OT* offsets = reinterpret_cast<const OT*>(proxy.buffers()[1].data()) + proxy.offset();
+            buffer_type result = make_buffer((indices.size() + 1) * sizeof(OT));
+            OT* out = reinterpret_cast<OT*>(result.data());
+            std::size_t total = 0;
+            out[0] = 0;
+            for (std::size_t i = 0; i < indices.size(); ++i)
+            {
+                total += static_cast<std::size_t>(offsets[indices[i] + 1] - offsets[indices[i]]);
+                if (total > static_cast<std::size_t>(std::numeric_limits<OT>::max()))
+                {
+                    throw std::overflow_error("take: the offsets of the result overflow");
+                }
+                out[i + 1] = static_cast<OT>(total);
+            }
+
+            std::vector<std::size_t> positions;
+            if (expand_positions)
+            {
+                positions.reserve(total);
+                for (const std::size_t index : indices)
+                {
+                    for (auto pos = offsets[index]; pos < offsets[index + 1]; ++pos)
+                    {
+                        positions.push_back(static_cast<std::size_t>(pos));
+                    }
+                }
+            }
+            return {std::move(result), std::move(positions)};
+        }
+
+        template <class OT>
+        void take_binary(const arrow_proxy& proxy, indices_type indices, std::vector<buffer_type>& buffers)
+        {
+            auto [offsets, positions] = take_offsets<OT>(proxy, indices, false);
+            const OT* in_offsets = reinterpret_cast<const OT*>(proxy.buffers()[1].data()) + proxy.offset();
+            const OT* out_offsets = reinterpret_cast<const OT*>(offsets.data());
+            const std::uint8_t* in = proxy.buffers()[2].data();
+            buffer_type data = make_buffer(static_cast<std::size_t>(out_offsets[indices.size()]));
+            std::uint8_t* out = data.data();
+            for (std::size_t i = 0; i < indices.size(); ++i)
+            {
+                const auto first = static_cast<std::size_t>(in_offsets[indices[i]]);
+                const auto length = static_cast<std::size_t>(in_offsets[indices[i] + 1]) - first;
+                if (length != 0)
+                {
+                    std::memcpy(out + static_cast<std::size_t>(out_offsets[i]), in + first, length);
+                }
+            }
+            buffers.push_back(std::move(offsets));
+            buffers.push_back(std::move(data));
+        }
+
+        [[nodiscard]] arrow_proxy take_proxy(const arrow_proxy& proxy, indices_type indices);
+
+        [[nodiscard]] std::vector<arrow_proxy> take_children(const arrow_proxy& proxy, indices_type child_indices)
+        {
+            std::vector<arrow_proxy> children;
+            children.reserve(proxy.n_children());
+            for (const arrow_proxy& child : proxy.children())
+            {
+                children.push_back(take_proxy(child, child_indices));
+            }
+            return children;
+        }
+
+        [[nodiscard]] arrow_proxy make_result(
+            const arrow_proxy& like,
+            std::size_t length,
+            std::size_t null_count,
+            std::vector<buffer_type>&& buffers,
+            std::vector<arrow_proxy>&& children
+        )
+        {
+            const std::size_t n_children = children.size();
+            ArrowArray** child_arrays = n_children == 0 ? nullptr : new ArrowArray*[n_children];
+            for (std::size_t i = 0; i < n_children; ++i)
+            {
+                child_arrays[i] = new ArrowArray(children[i].extract_array());
+            }
+            ArrowArray* dictionary = nullptr;
+            if (like.array().dictionary != nullptr)
+            {
+                dictionary = new ArrowArray(copy_array(*like.array().dictionary, *like.schema().dictionary));
+            }
+
+            ArrowArray arr = make_arrow_array(
+                static_cast<std::int64_t>(length),
+                static_cast<std::int64_t>(null_count),
+                0,  // offset
+                std::move(buffers),
+                child_arrays,
+                repeat_view<bool>(true, n_children),
+                dictionary,
+                true
+            );
+            return arrow_proxy(std::move(arr), copy_schema(like.schema()));
+        }
+
+        template <class OT>
+        void take_list_view(
+            const arrow_proxy& proxy,
+            indices_type indices,
+            std::vector<buffer_type>& buffers,
+            std::vector<arrow_proxy>& children
+        )
+        {
+            // The gathered lists are laid out contiguously in the child
+            const OT* offsets = reinterpret_cast<const OT*>(proxy.buffers()[1].data()) + proxy.offset();
+            const OT* sizes = reinterpret_cast<const OT*>(proxy.buffers()[2].data()) + proxy.offset();
+            buffer_type out_offsets_buffer = make_buffer(indices.size() * sizeof(OT));
+            buffer_type out_sizes_buffer = make_buffer(indices.size() * sizeof(OT));
+            OT* out_offsets = reinterpret_cast<OT*>(out_offsets_buffer.data());
+            OT* out_sizes = reinterpret_cast<OT*>(out_sizes_buffer.data());
+            std::vector<std::size_t> positions;
+            for (std::size_t i = 0; i < indices.size(); ++i)
+            {
+                const auto first = static_cast<std::size_t>(offsets[indices[i]]);
+                const auto size = static_cast<std::size_t>(sizes[indices[i]]);
+                if (positions.size() + size > static_cast<std::size_t>(std::numeric_limits<OT>::max()))
+                {
+                    throw std::overflow_error("take: the offsets of the result overflow");
+                }
+                out_offsets[i] = static_cast<OT>(positions.size());
+                out_sizes[i] = static_cast<OT>(size);
+                for (std::size_t k = 0; k < size; ++k)
+                {
+                    positions.push_back(first + k);
+                }
+            }
+            buffers.push_back(std::move(out_offsets_buffer));
+            buffers.push_back(std::move(out_sizes_buffer));
+            children = take_children(proxy, positions);
+        }
+
+        /**
+         * Gathers the 16-byte views of a binary view layout. The values that are not inlined
+         * in their view are copied to new variadic buffers, so that the result does not keep
+         * the unreferenced bytes of the input buffers.
+         */
+        void take_views(const arrow_proxy& proxy, indices_type indices, std::vector<buffer_type>& buffers)
+        {
+            constexpr std::size_t view_size = 16;
+            constexpr std::size_t max_inline_size = 12;
+            constexpr auto max_buffer_size = static_cast<std::size_t>(std::numeric_limits<std::int32_t>::max());
+
+            const auto& in_buffers = proxy.buffers();
+            const std::uint8_t* in_views = in_buffers[1].data() + proxy.offset() * view_size;
+            auto value_length = [in_views](std::size_t index)
+            {
+                std::int32_t length;
+                std::memcpy(&length, in_views + index * view_size, sizeof(length));
+                return static_cast<std::size_t>(length);
+            };
+
+            // Sizes of the output variadic buffers, each one being limited to what
+            // the 32-bit offsets of the views can address
+            std::vector<std::size_t> data_sizes;
+            for (const std::size_t index : indices)
+            {
+                const std::size_t length = value_length(index);
+                if (length > max_inline_size)
+                {
+                    if (data_sizes.empty() || data_sizes.back() + length > max_buffer_size)
+                    {
+                        data_sizes.push_back(0);
+                    }
+                    data_sizes.back() += length;
+                }
+            }
+            if (data_sizes.empty())
+            {
+                data_sizes.push_back(0);
+            }
+
+            buffer_type views = make_buffer(indices.size() * view_size);
+            std::vector<buffer_type> data;
+            data.reserve(data_sizes.size());
+            for (const std::size_t size : data_sizes)
+            {
+                data.push_back(make_buffer(size));
+            }
+
+            std::size_t buffer_index = 0;
+            std::size_t buffer_offset = 0;
+            for (std::size_t i = 0; i < indices.size(); ++i)
+            {
+                std::uint8_t* view = views.data() + i * view_size;
+                const std::uint8_t* in_view = in_views + indices[i] * view_size;
+                std::memcpy(view, in_view, view_size);
+                const std::size_t length = value_length(indices[i]);
+                if (length > max_inline_size)
+                {
+                    if (buffer_offset + length > data_sizes[buffer_index])
+                    {
+                        ++buffer_index;
+                        buffer_offset = 0;
+                    }
+                    std::int32_t in_buffer_index;
+                    std::int32_t in_offset;
+                    std::memcpy(&in_buffer_index, in_view + 8, sizeof(in_buffer_index));
+                    std::memcpy(&in_offset, in_view + 12, sizeof(in_offset));
+                    const std::uint8_t* value = in_buffers[2 + static_cast<std::size_t>(in_buffer_index)].data()
+                                                + in_offset;
+                    std::memcpy(data[buffer_index].data() + buffer_offset, value, length);
+                    const auto out_buffer_index = static_cast<std::int32_t>(buffer_index);
+                    const auto out_offset = static_cast<std::int32_t>(buffer_offset);
+                    std::memcpy(view + 8, &out_buffer_index, sizeof(out_buffer_index));
+                    std::memcpy(view + 12, &out_offset, sizeof(out_offset));
+                    buffer_offset += length;
+                }
+            }
+
+            buffer_type sizes = make_buffer(data_sizes.size() * sizeof(std::int64_t));
+            for (std::size_t i = 0; i < data_sizes.size(); ++i)
+            {
+                const auto size = static_cast<std::int64_t>(data_sizes[i]);
+                std::memcpy(sizes.data() + i * sizeof(std::int64_t), &size, sizeof(size));
+            }
+
+            buffers.push_back(std::move(views));
+            for (buffer_type& buf : data)
+            {
+                buffers.push_back(std::move(buf));
+            }
+            buffers.push_back(std::move(sizes));
+        }
+
+        // Index of the child of each type id of a union, whose format is
+        // "+ud:<id>,<id>,..." or "+us:<id>,<id>,..."
+        [[nodiscard]] std::array<std::size_t, 128> union_children(const arrow_proxy& proxy)
+        {
+            std::array<std::size_t, 128> children;
+            children.fill(0);
+            std::string_view ids = proxy.format().substr(4);
+            std::size_t child = 0;
+            while (!ids.empty())
+            {
+                const auto comma = ids.find(',');
+                const auto id = static_cast<std::size_t>(std::stoul(std::string(ids.substr(0, comma))));
+                children[id % children.size()] = child++;
+                ids = comma == std::string_view::npos ? std::string_view{} : ids.substr(comma + 1);
+            }
+            return children;
+        }
+
+        [[nodiscard]] arrow_proxy take_union(const arrow_proxy& proxy, indices_type indices)
+        {
+            const std::size_t length = indices.size();
+            const std::uint8_t* type_ids = proxy.buffers()[0].data() + proxy.offset();
+            buffer_type out_type_ids = make_buffer(length);
+            for (std::size_t i = 0; i < length; ++i)
+            {
+                out_type_ids.data()[i] = type_ids[indices[i]];
+            }
+            std::vector<buffer_type> buffers;
+            buffers.push_back(std::move(out_type_ids));
+
+            std::vector<arrow_proxy> children;
+            if (proxy.data_type() == data_type::SPARSE_UNION)
+            {
+                // All the children have the length of the union
+                std::vector<std::size_t> positions(length);
+                for (std::size_t i = 0; i < length; ++i)
+                {
+                    positions[i] = proxy.offset() + indices[i];
+                }
+                children = take_children(proxy, positions);
+            }
+            else
+            {
+                const auto* offsets = reinterpret_cast<const std::int32_t*>(proxy.buffers()[1].data())
+                                      + proxy.offset();
+                const auto child_of = union_children(proxy);
+                std::vector<std::vector<std::size_t>> positions(proxy.n_children());
+                buffer_type out_offsets_buffer = make_buffer(length * sizeof(std::int32_t));
+                auto* out_offsets = reinterpret_cast<std::int32_t*>(out_offsets_buffer.data());
+                for (std::size_t i = 0; i < length; ++i)
+                {
+                    auto& child_positions = positions[child_of[type_ids[indices[i]] % child_of.size()]];
+                    out_offsets[i] = static_cast<std::int32_t>(child_positions.size());
+                    child_positions.push_back(static_cast<std::size_t>(offsets[indices[i]]));
+                }
+                buffers.push_back(std::move(out_offsets_buffer));
+                children.reserve(proxy.n_children());
+                for (std::size_t c = 0; c < proxy.n_children(); ++c)
+                {
+                    children.push_back(take_proxy(proxy.children()[c], positions[c]));
+                }
+            }
+            return make_result(proxy, length, 0, std::move(buffers), std::move(children));
+        }
+
+        /**
+         * Gathers the elements of a run-end encoded array. Consecutive output elements that
+         * come from the same run are encoded as a single run, so that gathering sorted
+         * indices keeps the runs.
+         */
+        template <std::integral RT>
+        [[nodiscard]] arrow_proxy take_run_end_encoded(const arrow_proxy& proxy, indices_type indices)
+        {
+            const arrow_proxy& run_ends_proxy = proxy.children()[0];
+            const arrow_proxy& values_proxy = proxy.children()[1];
+            const RT* run_ends = reinterpret_cast<const RT*>(run_ends_proxy.buffers()[1].data())
+                                 + run_ends_proxy.offset();
+            const RT* run_ends_last = run_ends + run_ends_proxy.length();
+            const detail::validity_reader values_validity(values_proxy);
+            const std::size_t length = indices.size();
+            if (length > static_cast<std::size_t>(std::numeric_limits<RT>::max()))
+            {
+                throw std::overflow_error("take: the run ends of the result overflow");
+            }
+
+            std::vector<std::size_t> runs;
+            std::vector<RT> out_run_ends;
+            std::size_t null_count = 0;
+            std::size_t run = 0;
+            for (std::size_t i = 0; i < length; ++i)
+            {
+                const std::size_t logical_index = proxy.offset() + indices[i];
+                // The run of the previous element is checked first, for sorted indices
+                const bool in_run = !runs.empty() && std::cmp_less(logical_index, run_ends[run])
+                                    && (run == 0 || std::cmp_greater_equal(logical_index, run_ends[run - 1]));
+                if (!in_run)
+                {
+                    run = static_cast<std::size_t>(
+                        std::upper_bound(run_ends, run_ends_last, logical_index, [](std::size_t lhs, RT rhs)
+                        {
+                            return std::cmp_less(lhs, rhs);
+                        }) - run_ends
+                    );
+                }
+                if (!runs.empty() && runs.back() == run)
+                {
+                    out_run_ends.back() = static_cast<RT>(i + 1);
+                }
+                else
+                {
+                    runs.push_back(run);
+                    out_run_ends.push_back(static_cast<RT>(i + 1));
+                }
+                if (!values_validity.is_valid(run))
+                {
+                    ++null_count;
+                }
+            }
+
+            buffer_type run_ends_data = make_buffer(out_run_ends.size() * sizeof(RT));
+            if (!out_run_ends.empty())
+            {
+                std::memcpy(run_ends_data.data(), out_run_ends.data(), run_ends_data.size());
+            }
+            std::vector<buffer_type> run_ends_buffers;
+            run_ends_buffers.emplace_back(nullptr, 0, buffer_type::default_allocator());
+            run_ends_buffers.push_back(std::move(run_ends_data));
+
+            std::vector<arrow_proxy> children;
+            children.push_back(make_result(run_ends_proxy, runs.size(), 0, std::move(run_ends_buffers), {}));
+            children.push_back(take_proxy(values_proxy, runs));
+            return make_result(proxy, length, null_count, {}, std::move(children));
+        }
+
+        [[nodiscard]] arrow_proxy take_run_end_encoded(const arrow_proxy& proxy, indices_type indices)
+        {
+            switch (proxy.children()[0].data_type())
+            {
+                case data_type::INT16:
+                    return take_run_end_encoded<std::int16_t>(proxy, indices);
+                case data_type::INT32:
+                    return take_run_end_encoded<std::int32_t>(proxy, indices);
+                case data_type::INT64:
+                    return take_run_end_encoded<std::int64_t>(proxy, indices);
+                default:
+                    throw std::invalid_argument(
+                        "take: unsupported run ends format '" + std::string(proxy.children()[0].format()) + "'"
+                    );
+            }
+        }
+
+        arrow_proxy take_proxy(const arrow_proxy& proxy, indices_type indices)
+        {
+            const data_type dt = proxy.data_type();
+            const std::size_t length = indices.size();
+            std::vector<buffer_type> buffers;
+            std::vector<arrow_proxy> children;
+            std::size_t null_count = 0;
+
+            switch (dt)
+            {
+                case data_type::NA:
+                    return make_result(proxy, length, length, std::move(buffers), std::move(children));
+                case data_type::SPARSE_UNION:
+                case data_type::DENSE_UNION:
+                    return take_union(proxy, indices);
+                case data_type::RUN_ENCODED:
+                    return take_run_end_encoded(proxy, indices);
+                default:
+                    break;
+            }
+
+            auto [validity, validity_null_count] = take_validity(proxy, indices);
+            buffers.push_back(std::move(validity));
+            null_count = validity_null_count;
+
+            switch (dt)
+            {
+                case data_type::BOOL:
+                    buffers.push_back(gather_bits(proxy.buffers()[1].data(), proxy.offset(), indices).first);
+                    break;
+                case data_type::STRING:
+                case data_type::BINARY:
+                    take_binary<std::int32_t>(proxy, indices, buffers);
+                    break;
+                case data_type::LARGE_STRING:
+                case data_type::LARGE_BINARY:
+                    take_binary<std::int64_t>(proxy, indices, buffers);
+                    break;
+                case data_type::LIST:
+                case data_type::MAP:
+                {
+                    auto [offsets, positions] = take_offsets<std::int32_t>(proxy, indices, true);
+                    buffers.push_back(std::move(offsets));
+                    children = take_children(proxy, positions);
+                    break;
+                }
+                case data_type::LARGE_LIST:
+                {
+                    auto [offsets, positions] = take_offsets<std::int64_t>(proxy, indices, true);
+                    buffers.push_back(std::move(offsets));
+                    children = take_children(proxy, positions);
+                    break;
+                }
+                case data_type::LIST_VIEW:
+                    take_list_view<std::int32_t>(proxy, indices, buffers, children);
+                    break;
+                case data_type::LARGE_LIST_VIEW:
+                    take_list_view<std::int64_t>(proxy, indices, buffers, children);
+                    break;
+                case data_type::STRING_VIEW:
+                case data_type::BINARY_VIEW:
+                    take_views(proxy, indices, buffers);
+                    break;
+                case data_type::FIXED_SIZED_LIST:
+                {
+                    // Format is "+w:<list size>"
+                    const auto list_size = static_cast<std::size_t>(std::stoull(std::string(proxy.format().substr(3))));
+                    std::vector<std::size_t> positions;
+                    positions.reserve(length * list_size);
+                    for (const std::size_t index : indices)
+                    {
+                        const std::size_t first = (proxy.offset() + index) * list_size;
+                        for (std::size_t k = 0; k < list_size; ++k)
+                        {
+                            positions.push_back(first + k);
+                        }
+                    }
+                    children = take_children(proxy, positions);
+                    break;
+                }
+                case data_type::STRUCT:
+                {
+                    std::vector<std::size_t> positions(length);
+                    for (std::size_t i = 0; i < length; ++i)
+                    {
+                        positions[i] = proxy.offset() + indices[i];
+                    }
+                    children = take_children(proxy, positions);
+                    break;
+                }
+                default:
+                {
+                    const std::size_t width = sparrow::detail::fixed_width_byte_size(proxy);
+                    if (width == 0)
+                    {
+                        throw std::invalid_argument(
+                            "take: arrays of format '" + std::string(proxy.format()) + "' are not supported"
+                        );
+                    }
+                    buffers.push_back(take_fixed_width(proxy, width, indices));
+                    break;
+                }
+            }
+            return make_result(proxy, length, null_count, std::move(buffers), std::move(children));
+        }
+
+        void check_indices(indices_type indices, std::size_t size)
+        {
+            for (const std::size_t index : indices)
+            {
+                if (index >= size)
+                {
+                    throw std::out_of_range(
+                        "take: index " + std::to_string(index) + " is out of range for an array of size "
+                        + std::to_string(size)
+                    );
+                }
+            }
+        }
+        // Indices of the set bits of a filter mask, found a 64-bit word at a time
+        [[nodiscard]] std::vector<std::size_t> mask_indices(const dynamic_bitset<std::uint8_t>& mask)
+        {
+            std::vector<std::size_t> indices;
+            indices.reserve(mask.size() - mask.null_count());
+            const std::uint8_t* bits = mask.data();
+            const std::size_t size = mask.size();
+            for (std::size_t base = 0; base < size; base += 64)
+            {
+                const std::size_t bit_count = std::min<std::size_t>(64, size - base);
+                std::uint64_t word = 0;
+                for (std::size_t k = 0; k < (bit_count + 7) / 8; ++k)
+                {
+                    word |= static_cast<std::uint64_t>(bits[base / 8 + k]) << (8 * k);
+                }
+                if (bit_count < 64)
+                {
+                    word &= (std::uint64_t{1} << bit_count) - 1;
+                }
+                while (word != 0)
+                {
+                    indices.push_back(base + static_cast<std::size_t>(std::countr_zero(word)));
+                    word &= word - 1;
+                }
+            }
+            return indices;
+        }
+
+        // Copies the selected fixed width values, a run of consecutive indices at a time
+        [[nodiscard]] buffer_type
+        compress_fixed_width(const arrow_proxy& proxy, std::size_t width, indices_type indices)
+        {
+            buffer_type result = make_buffer(indices.size() * width);
+            std::uint8_t* out = result.data();
+            const std::uint8_t* in = proxy.buffers()[1].data() + proxy.offset() * width;
+            std::size_t i = 0;
+            while (i < indices.size())
+            {
+                std::size_t run_end = i + 1;
+                while (run_end < indices.size() && indices[run_end] == indices[run_end - 1] + 1)
+                {
+                    ++run_end;
+                }
+                std::memcpy(out + i * width, in + indices[i] * width, (run_end - i) * width);
+                i = run_end;
+            }
+            return result;
+        }
+
+        [[nodiscard]] arrow_proxy filter_proxy(const arrow_proxy& proxy, indices_type indices)
+        {
+            const std::size_t width = sparrow::detail::fixed_width_byte_size(proxy);
+            if (width == 0)
+            {
+                return take_proxy(proxy, indices);
+            }
+            auto [validity, null_count] = take_validity(proxy, indices);
+            std::vector<buffer_type> buffers;
+            buffers.push_back(std::move(validity));
+            buffers.push_back(compress_fixed_width(proxy, width, indices));
+            return make_result(proxy, indices.size(), null_count, std::move(buffers), {});
+        }
+
+        void check_mask(const dynamic_bitset<std::uint8_t>& mask, std::size_t size)
+        {
+            if (mask.size() != size)
+            {
+                throw std::invalid_argument(
+                    "filter: mask of size " + std::to_string(mask.size()) + " does not match a size of "
+                    + std::to_string(size)
+                );
+            }
+        }
+    }
+
+    array take(const array& ar, std::span<const std::size_t> indices)
+    {
+        const arrow_proxy& proxy = sparrow::detail::array_access::get_arrow_proxy(ar);
+        check_indices(indices, proxy.length());
+        return array(take_proxy(proxy, indices));
+    }
+
+    record_batch take(const record_batch& rb, std::span<const std::size_t> indices)
+    {
+        check_indices(indices, rb.nb_rows());
+        return rb.transform_columns(
+            [indices](const array& column)
+            {
+                return array(take_proxy(sparrow::detail::array_access::get_arrow_proxy(column), indices));
+            }
+        );
+    }
+
+    array filter(const array& ar, const dynamic_bitset<std::uint8_t>& mask)
+    {
+        const arrow_proxy& proxy = sparrow::detail::array_access::get_arrow_proxy(ar);
+        check_mask(mask, proxy.length());
+        return array(filter_proxy(proxy, mask_indices(mask)));
+    }
+
+    record_batch filter(const record_batch& rb, const dynamic_bitset<std::uint8_t>& mask)
+    {
+        check_mask(mask, rb.nb_rows());
+        const std::vector<std::size_t> indices = mask_indices(mask);
+        return rb.transform_columns(
+            [&indices](const array& column)
+            {
+                return array(filter_proxy(sparrow::detail::array_access::get_arrow_proxy(column), indices));
+            }
+        );
+    }
+}
@@ -0,0 +1,404 @@
+// Copyright 2024 Man Group Operations Limited
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "sparrow/compute/sort.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <numeric>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+#include "sparrow/compute/kernel_utils.hpp"
+#include "sparrow/layout/array_access.hpp"
+#include "sparrow/types/data_type.hpp"
+
+namespace sparrow::compute
+{
+    namespace
+    {
+        using detail::bytes_view;
+        using detail::validity_reader;
+        using detail::value_reader;
+
+        /**
+         * Stable LSD radix sort of \c indices on \c keys, one byte per pass. The histograms
+         * of all the passes are computed in a single scan of the keys, and the passes on a
+         * byte that has the same value for all the keys are skipped, so that small keys
+         * stored in 64-bit words only cost the passes on their significant bytes.
+         */
+        void radix_sort(std::vector<std::uint64_t>& keys, std::vector<std::size_t>& indices)
+        {
+            const std::size_t size = keys.size();
+            if (size < 2)
+            {
+                return;
+            }
+
+            std::array<std::array<std::size_t, 256>, 8> counts{};
+            for (const std::uint64_t key : keys)
+            {
+                for (std::size_t pass = 0; pass < 8; ++pass)
+                {
+                    ++counts[pass][(key >> (8 * pass)) & 0xFF];
+                }
+            }
+
+            std::vector<std::uint64_t> keys_tmp(size);
+            std::vector<std::size_t> indices_tmp(size);
+            for (std::size_t pass = 0; pass < 8; ++pass)
+            {
+                const std::size_t shift = 8 * pass;
+                auto& count = counts[pass];
+                if (count[(keys[0] >> shift) & 0xFF] == size)
+                {
+                    continue;
+                }
+                std::array<std::size_t, 256> positions;
+                std::size_t position = 0;
+                for (std::size_t digit = 0; digit < 256; ++digit)
+                {
+                    positions[digit] = position;
+                    position += count[digit];
+                }
+                for (std::size_t i = 0; i < size; ++i)
+                {
+                    const std::size_t pos = positions[(keys[i] >> shift) & 0xFF]++;
+                    keys_tmp[pos] = keys[i];
+                    indices_tmp[pos] = indices[i];
+                }
+                keys.swap(keys_tmp);
+                indices.swap(indices_tmp);
+            }
+        }
+
+        // How the bytes of a fixed width value are turned into keys whose unsigned
+        // order is the order of the values
+        enum class key_kind
+        {
+            unsigned_integer,
+            signed_integer,
+            floating_point,
+            bytes
+        };
+
+        [[nodiscard]] key_kind fixed_width_key_kind(const arrow_proxy& proxy)
+        {
+            switch (proxy.data_type())
+            {
+                case data_type::UINT8:
+                case data_type::UINT16:
+                case data_type::UINT32:
+                case data_type::UINT64:
+                    return key_kind::unsigned_integer;
+                case data_type::HALF_FLOAT:
+                case data_type::FLOAT:
+                case data_type::DOUBLE:
+                    return key_kind::floating_point;
+                case data_type::FIXED_WIDTH_BINARY:
+                    return key_kind::bytes;
+                case data_type::INTERVAL_MONTHS:
+                case data_type::INTERVAL_DAYS_TIME:
+                case data_type::INTERVAL_MONTHS_DAYS_NANOSECONDS:
+                    throw std::invalid_argument("sort_indices: intervals cannot be sorted");
+                default:
+                    // Signed integers, decimals and temporal types
+                    return key_kind::signed_integer;
+            }
+        }
+
+        [[nodiscard]] std::uint64_t load_le(const std::uint8_t* src, std::size_t byte_count) noexcept
+        {
+            std::uint64_t word = 0;
+            for (std::size_t i = 0; i < byte_count; ++i)
+            {
+                word |= std::uint64_t(src[i]) << (8 * i);
+            }
+            return word;
+        }
+
+        [[nodiscard]] std::uint64_t load_be(const std::uint8_t* src, std::size_t byte_count) noexcept
+        {
+            std::uint64_t word = 0;
+            for (std::size_t i = 0; i < byte_count; ++i)
+            {
+                word |= std::uint64_t(src[i]) << (56 - 8 * i);
+            }
+            return word;
+        }
+
+        [[nodiscard]] bool is_nan(std::uint64_t bits, std::size_t width) noexcept
+        {
+            switch (width)
+            {
+                case 2:
+                    return (bits & 0x7C00) == 0x7C00 && (bits & 0x03FF) != 0;
+                case 4:
+                {
+                    float value;
+                    const auto bits32 = static_cast<std::uint32_t>(bits);
+                    std::memcpy(&value, &bits32, sizeof(value));
+                    return std::isnan(value);
+                }
+                default:
+                {
+                    double value;
+                    std::memcpy(&value, &bits, sizeof(value));
+                    return std::isnan(value);
+                }
+            }
+        }
+
+        /**
+         * Normalized keys of the values of a fixed width array. A value of W bytes is split
+         * in ceil(W / 8) 64-bit words; word 0 is the least significant one.
+         */
+        class fixed_width_keys
+        {
+        public:
+
+            fixed_width_keys(const value_reader& values, key_kind kind)
+                : p_data(values.fixed_width_data())
+                , m_width(values.width())
+                , m_kind(kind)
+            {
+            }
+
+            [[nodiscard]] std::size_t word_count() const noexcept
+            {
+                return (m_width + 7) / 8;
+            }
+
+            // Fills keys[i] with the word \c word of the key of the element rows[i]
+            void fill(std::span<const std::size_t> rows, std::size_t word, bool descending, std::vector<std::uint64_t>& keys) const
+            {
+                keys.resize(rows.size());
+                const std::uint64_t flip = descending ? ~std::uint64_t(0) : 0;
+                switch (m_kind)
+                {
+                    case key_kind::unsigned_integer:
+                        fill_with(rows, keys, flip, [this](const std::uint8_t* value)
+                        {
+                            return load_le(value, m_width);
+                        });
+                        break;
+                    case key_kind::signed_integer:
+                    {
+                        // Words of a two's complement integer, only the sign bit of the most
+                        // significant word has to be flipped
+                        const std::size_t first = 8 * word;
+                        const std::size_t byte_count = std::min(std::size_t(8), m_width - first);
+                        const std::uint64_t sign = word + 1 == word_count()
+                                                       ? std::uint64_t(1) << (8 * byte_count - 1)
+                                                       : 0;
+                        fill_with(rows, keys, flip, [first, byte_count, sign](const std::uint8_t* value)
+                        {
+                            return load_le(value + first, byte_count) ^ sign;
+                        });
+                        break;
+                    }
+                    case key_kind::floating_point:
+                    {
+                        const std::size_t bit_count = 8 * m_width;
+                        const std::uint64_t sign = std::uint64_t(1) << (bit_count - 1);
+                        const std::uint64_t mask = bit_count == 64 ? ~std::uint64_t(0)
+                                                                   : (std::uint64_t(1) << bit_count) - 1;
+                        fill_with(rows, keys, flip, [this, sign, mask](const std::uint8_t* value)
+                        {
+                            const std::uint64_t bits = load_le(value, m_width);
+                            if (is_nan(bits, m_width))
+                            {
+                                return mask;
+                            }
+                            return (bits & sign) != 0 ? ~bits & mask : bits | sign;
+                        });
+                        break;
+                    }
+                    case key_kind::bytes:
+                    {
+                        // Lexicographic order: the first bytes are the most significant ones
+                        const std::size_t first = 8 * (word_count() - 1 - word);
+                        const std::size_t byte_count = std::min(std::size_t(8), m_width - first);
+                        fill_with(rows, keys, flip, [first, byte_count](const std::uint8_t* value)
+                        {
+                            return load_be(value + first, byte_count);
+                        });
+                        break;
+                    }
+                }
+            }
+
+        private:
+
+            template <class F>
+            void fill_with(std::span<const std::size_t> rows, std::vector<std::uint64_t>& keys, std::uint64_t flip, F&& key_of)
+                const
+            {
+                for (std::size_t i = 0; i < rows.size(); ++i)
+                {
+                    keys[i] = key_of(p_data + rows[i] * m_width) ^ flip;
+                }
+            }
+
+            const std::uint8_t* p_data;
+            std::size_t m_width;
+            key_kind m_kind;
+        };
+
+        [[nodiscard]] int compare_bytes(bytes_view lhs, bytes_view rhs) noexcept
+        {
+            const std::size_t common = std::min(lhs.size(), rhs.size());
+            const int res = common == 0 ? 0 : std::memcmp(lhs.data(), rhs.data(), common);
+            if (res != 0)
+            {
+                return res;
+            }
+            return lhs.size() < rhs.size() ? -1 : (lhs.size() > rhs.size() ? 1 : 0);
+        }
+
+        void sort_binary(const value_reader& values, std::vector<std::size_t>& rows, bool descending)
+        {
+            // Radix sort on the first 8 bytes of the values
+            const std::uint64_t flip = descending ? ~std::uint64_t(0) : 0;
+            std::vector<std::uint64_t> keys(rows.size());
+            for (std::size_t i = 0; i < rows.size(); ++i)
+            {
+                const bytes_view value = values[rows[i]];
+                keys[i] = load_be(value.data(), std::min(std::size_t(8), value.size())) ^ flip;
+            }
+            radix_sort(keys, rows);
+
+            // Values sharing the same prefix are ordered with full comparisons
+            auto less = [&values, descending](std::size_t lhs, std::size_t rhs)
+            {
+                const int res = compare_bytes(values[lhs], values[rhs]);
+                return descending ? res > 0 : res < 0;
+            };
+            std::size_t run_start = 0;
+            for (std::size_t i = 1; i <= rows.size(); ++i)
+            {
+                if (i == rows.size() || keys[i] != keys[run_start])
+                {
+                    if (i - run_start > 1)
+                    {
+                        std::stable_sort(
+                            rows.begin() + static_cast<std::ptrdiff_t>(run_start),
+                            rows.begin() + static_cast<std::ptrdiff_t>(i),
+                            less
+                        );
+                    }
+                    run_start = i;
+                }
+            }
+        }
+
+        void sort_bool(const arrow_proxy& proxy, std::vector<std::size_t>& rows, bool descending)
+        {
+            const std::uint8_t* bits = proxy.buffers()[1].data();
+            const std::size_t offset = proxy.offset();
+            std::stable_partition(
+                rows.begin(),
+                rows.end(),
+                [bits, offset, descending](std::size_t row)
+                {
+                    const std::size_t bit = offset + row;
+                    return (((bits[bit / 8] >> (bit % 8)) & 1) != 0) == descending;
+                }
+            );
+        }
+
+        // Sorts the valid rows of \c rows by the values of \c proxy
+        void sort_values(const arrow_proxy& proxy, std::vector<std::size_t>& rows, bool descending)
+        {
+            if (proxy.data_type() == data_type::BOOL && proxy.dictionary() == nullptr)
+            {
+                sort_bool(proxy, rows, descending);
+                return;
+            }
+            const value_reader values(proxy, "sort_indices");
+            if (values.width() == 0)
+            {
+                sort_binary(values, rows, descending);
+                return;
+            }
+            const fixed_width_keys keys(values, fixed_width_key_kind(proxy));
+            std::vector<std::uint64_t> words;
+            for (std::size_t word = 0; word < keys.word_count(); ++word)
+            {
+                keys.fill(rows, word, descending, words);
+                radix_sort(words, rows);
+            }
+        }
+
+        /**
+         * Stably reorders the row indices \c rows by the values of \c proxy. The null rows
+         * are moved before or after the valid ones, keeping their relative order.
+         */
+        void sort_permutation(const arrow_proxy& proxy, std::vector<std::size_t>& rows, sort_order order, null_placement nulls)
+        {
+            const validity_reader validity(proxy);
+            std::vector<std::size_t> null_rows;
+            if (validity.has_validity())
+            {
+                const auto last = std::stable_partition(
+                    rows.begin(),
+                    rows.end(),
+                    [&validity](std::size_t row)
+                    {
+                        return validity.is_valid(row);
+                    }
+                );
+                null_rows.assign(last, rows.end());
+                rows.erase(last, rows.end());
+            }
+
+            sort_values(proxy, rows, order == sort_order::descending);
+
+            if (!null_rows.empty())
+            {
+                const auto pos = nulls == null_placement::at_start ? rows.begin() : rows.end();
+                rows.insert(pos, null_rows.begin(), null_rows.end());
+            }
+        }
+    }
+
+    std::vector<std::size_t> sort_indices(const array& ar, sort_order order, null_placement nulls)
+    {
+        const arrow_proxy& proxy = sparrow::detail::array_access::get_arrow_proxy(ar);
+        std::vector<std::size_t> rows(proxy.length());
+        std::iota(rows.begin(), rows.end(), std::size_t(0));
+        sort_permutation(proxy, rows, order, nulls);
+        return rows;
+    }
+
+    std::vector<std::size_t> sort_indices(const record_batch& rb, std::span<const sort_key> keys)
+    {
+        std::vector<std::size_t> rows(rb.nb_rows());
+        std::iota(rows.begin(), rows.end(), std::size_t(0));
+        for (auto it = keys.rbegin(); it != keys.rend(); ++it)
+        {
+            if (!rb.contains_column(it->column))
+            {
+                throw std::out_of_range("sort_indices: no column named '" + it->column + "'");
+            }
+            const arrow_proxy& proxy = sparrow::detail::array_access::get_arrow_proxy(rb.get_column(it->column));
+            sort_permutation(proxy, rows, it->order, it->nulls);
+        }
+        return rows;
+    }
+}
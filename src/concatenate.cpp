@@ -0,0 +1,560 @@
+// Copyright 2024 Man Group Operations Limited
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "sparrow/concatenate.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+#include "sparrow/arrow_interface/arrow_array.hpp"
+#include "sparrow/arrow_interface/arrow_schema.hpp"
+#include "sparrow/buffer/buffer.hpp"
+#include "sparrow/types/data_type.hpp"
+#include "sparrow/utils/contracts.hpp"
+#include "sparrow/utils/repeat_container.hpp"
+
+namespace sparrow::detail
+{
+    namespace
+    {
+        using buffer_type = buffer<std::uint8_t>;
+
+        // Range of elements of an array taking part in a concatenation. The offset is
+        // absolute: it already includes the offset of the array.
+        struct segment
+        {
+            const arrow_proxy* proxy;
+            std::size_t offset;
+            std::size_t length;
+        };
+
+        [[nodiscard]] buffer_type make_buffer(std::size_t size)
+        {
+            return buffer_type(size, buffer_type::default_allocator());
+        }
+
+        [[nodiscard]] std::uint64_t load_word(const std::uint8_t* src, std::size_t byte_count) noexcept
+        {
+            std::uint64_t word = 0;
+            if constexpr (std::endian::native == std::endian::little)
+            {
+                std::memcpy(&word, src, byte_count);
+            }
+            else
+            {
+                for (std::size_t i = 0; i < byte_count; ++i)
+                {
+                    word |= std::uint64_t(src[i]) << (8 * i);
+                }
+            }
+            return word;
+        }
+
+        void store_word(std::uint8_t* dst, std::uint64_t word, std::size_t byte_count) noexcept
+        {
+            if constexpr (std::endian::native == std::endian::little)
+            {
+                std::memcpy(dst, &word, byte_count);
+            }
+            else
+            {
+                for (std::size_t i = 0; i < byte_count; ++i)
+                {
+                    dst[i] = static_cast<std::uint8_t>(word >> (8 * i));
+                }
+            }
+        }
+
+        /**
+         * Appends bits to a bitmap, 64 bits at a time. The source bits can start at any
+         * bit offset; they are shifted in a register rather than copied one by one.
+         */
+        class bitmap_appender
+        {
+        public:
+
+            bitmap_appender(std::uint8_t* data, std::size_t bit_size) noexcept
+                : p_data(data)
+                , m_byte_size((bit_size + 7) / 8)
+            {
+            }
+
+            void append(const std::uint8_t* src, std::size_t src_offset, std::size_t count) noexcept
+            {
+                src += src_offset / 8;
+                const std::size_t shift = src_offset % 8;
+                while (count >= 64)
+                {
+                    std::uint64_t word = load_word(src, 8);
+                    if (shift != 0)
+                    {
+                        word = (word >> shift) | (std::uint64_t(src[8]) << (64 - shift));
+                    }
+                    push(word, 64);
+                    src += 8;
+                    count -= 64;
+                }
+                if (count != 0)
+                {
+                    const std::size_t byte_count = (shift + count + 7) / 8;
+                    std::uint64_t word = load_word(src, std::min(byte_count, std::size_t(8))) >> shift;
+                    if (byte_count > 8)
+                    {
+                        word |= std::uint64_t(src[8]) << (64 - shift);
+                    }
+                    push(word & low_bits(count), count);
+                }
+            }
+
+            void append_ones(std::size_t count) noexcept
+            {
+                for (; count >= 64; count -= 64)
+                {
+                    push(~std::uint64_t(0), 64);
+                }
+                if (count != 0)
+                {
+                    push(low_bits(count), count);
+                }
+            }
+
+            void finish() noexcept
+            {
+                if (m_pending_bits != 0)
+                {
+                    flush();
+                }
+            }
+
+        private:
+
+            [[nodiscard]] static std::uint64_t low_bits(std::size_t count) noexcept
+            {
+                return count == 64 ? ~std::uint64_t(0) : (std::uint64_t(1) << count) - 1;
+            }
+
+            // bits must not have any bit set above count
+            void push(std::uint64_t bits, std::size_t count) noexcept
+            {
+                m_pending |= bits << m_pending_bits;
+                if (m_pending_bits + count >= 64)
+                {
+                    const std::size_t consumed = 64 - m_pending_bits;
+                    flush();
+                    m_pending = consumed == 64 ? 0 : bits >> consumed;
+                    m_pending_bits = count - consumed;
+                }
+                else
+                {
+                    m_pending_bits += count;
+                }
+            }
+
+            void flush() noexcept
+            {
+                store_word(p_data + m_byte_pos, m_pending, std::min(std::size_t(8), m_byte_size - m_byte_pos));
+                m_byte_pos += 8;
+                m_pending = 0;
+            }
+
+            std::uint8_t* p_data;
+            std::size_t m_byte_size;
+            std::size_t m_byte_pos = 0;
+            std::uint64_t m_pending = 0;
+            std::size_t m_pending_bits = 0;
+        };
+
+        [[nodiscard]] std::size_t total_length(std::span<const segment> segments)
+        {
+            std::size_t length = 0;
+            for (const segment& seg : segments)
+            {
+                length += seg.length;
+            }
+            return length;
+        }
+
+        [[nodiscard]] bool has_nulls(const segment& seg)
+        {
+            const auto& bitmap = seg.proxy->buffers()[0];
+            return bitmap.data() != nullptr && seg.proxy->null_count() != 0;
+        }
+
+        /**
+         * Concatenates the bits [offset, offset + length) of the buffer \c buffer_index of
+         * each segment. If \c validity is true, segments without a bitmap are considered
+         * fully valid.
+         */
+        [[nodiscard]] buffer_type
+        concatenate_bits(std::span<const segment> segments, std::size_t buffer_index, std::size_t length, bool validity)
+        {
+            buffer_type result = make_buffer((length + 7) / 8);
+            bitmap_appender appender(result.data(), length);
+            for (const segment& seg : segments)
+            {
+                if (validity && !has_nulls(seg))
+                {
+                    appender.append_ones(seg.length);
+                }
+                else
+                {
+                    appender.append(seg.proxy->buffers()[buffer_index].data(), seg.offset, seg.length);
+                }
+            }
+            appender.finish();
+            return result;
+        }
+
+        [[nodiscard]] std::int64_t count_nulls(const buffer_type& bitmap, std::size_t length)
+        {
+            std::size_t set_bits = 0;
+            for (const std::uint8_t byte : bitmap)
+            {
+                set_bits += static_cast<std::size_t>(std::popcount(byte));
+            }
+            return static_cast<std::int64_t>(length - set_bits);
+        }
+
+        [[nodiscard]] buffer_type concatenate_fixed_width(std::span<const segment> segments, std::size_t length)
+        {
+            const std::size_t width = fixed_width_byte_size(*segments.front().proxy);
+            buffer_type result = make_buffer(length * width);
+            std::uint8_t* out = result.data();
+            for (const segment& seg : segments)
+            {
+                if (seg.length != 0)
+                {
+                    std::memcpy(out, seg.proxy->buffers()[1].data() + seg.offset * width, seg.length * width);
+                    out += seg.length * width;
+                }
+            }
+            return result;
+        }
+
+        /**
+         * Concatenates the offsets of the segments, rebasing them on the end of the
+         * previous segment. Returns the new offsets buffer and, for each segment, the
+         * range of values (bytes or child elements) it refers to.
+         */
+        template <class OT>
+        [[nodiscard]] std::pair<buffer_type, std::vector<std::pair<std::size_t, std::size_t>>>
+        concatenate_offsets(std::span<const segment> segments, std::size_t length)
+        {
+            buffer_type result = make_buffer((length + 1) * sizeof(OT));
+            OT* out = reinterpret_cast<OT*>(result.data());
+            std::vector<std::pair<std::size_t, std::size_t>> ranges;
+            ranges.reserve(segments.size());
+            std::size_t base = 0;
+            *out++ = 0;
+            for (const segment& seg : segments)
+            {
+                const OT* offsets = reinterpret_cast<const OT*>(seg.proxy->buffers()[1].data()) + seg.offset;
+                const auto first = static_cast<std::size_t>(offsets[0]);
+                const auto last = static_cast<std::size_t>(offsets[seg.length]);
+                if (base + (last - first) > static_cast<std::size_t>(std::numeric_limits<OT>::max()))
+                {
+                    throw std::overflow_error("concatenate: the offsets of the result overflow");
+                }
+                const auto delta = static_cast<OT>(base) - offsets[0];
+                for (std::size_t i = 1; i <= seg.length; ++i)
+                {
+                    *out++ = static_cast<OT>(offsets[i] + delta);
+                }
+                ranges.emplace_back(first, last);
+                base += last - first;
+            }
+            return {std::move(result), std::move(ranges)};
+        }
+
+        template <class OT>
+        void concatenate_binary(std::span<const segment> segments, std::size_t length, std::vector<buffer_type>& buffers)
+        {
+            auto [offsets, ranges] = concatenate_offsets<OT>(segments, length);
+            std::size_t byte_count = 0;
+            for (const auto& [first, last] : ranges)
+            {
+                byte_count += last - first;
+            }
+            buffer_type data = make_buffer(byte_count);
+            std::uint8_t* out = data.data();
+            for (std::size_t i = 0; i < segments.size(); ++i)
+            {
+                const auto [first, last] = ranges[i];
+                if (last != first)
+                {
+                    std::memcpy(out, segments[i].proxy->buffers()[2].data() + first, last - first);
+                    out += last - first;
+                }
+            }
+            buffers.push_back(std::move(offsets));
+            buffers.push_back(std::move(data));
+        }
+
+        // Segments of the child \c child_index of the segments
+        template <class F>
+        [[nodiscard]] std::vector<segment>
+        child_segments(std::span<const segment> segments, std::size_t child_index, F&& child_range)
+        {
+            std::vector<segment> result;
+            result.reserve(segments.size());
+            for (std::size_t i = 0; i < segments.size(); ++i)
+            {
+                const arrow_proxy& child = segments[i].proxy->children()[child_index];
+                const auto [first, last] = child_range(i);
+                result.push_back({&child, child.offset() + first, last - first});
+            }
+            return result;
+        }
+
+        [[nodiscard]] arrow_proxy concatenate_segments(std::span<const segment> segments);
+
+        [[nodiscard]] std::vector<arrow_proxy> concatenate_children(
+            std::span<const segment> segments,
+            const std::vector<std::pair<std::size_t, std::size_t>>& child_ranges
+        )
+        {
+            const std::size_t n_children = segments.front().proxy->n_children();
+            std::vector<arrow_proxy> children;
+            children.reserve(n_children);
+            for (std::size_t c = 0; c < n_children; ++c)
+            {
+                const auto child_segs = child_segments(
+                    segments,
+                    c,
+                    [&child_ranges](std::size_t i)
+                    {
+                        return child_ranges[i];
+                    }
+                );
+                children.push_back(concatenate_segments(child_segs));
+            }
+            return children;
+        }
+
+        [[nodiscard]] bool is_supported(const arrow_proxy& proxy)
+        {
+            if (proxy.schema().dictionary != nullptr)
+            {
+                return false;
+            }
+            switch (proxy.data_type())
+            {
+                case data_type::NA:
+                case data_type::BOOL:
+                case data_type::STRING:
+                case data_type::BINARY:
+                case data_type::LARGE_STRING:
+                case data_type::LARGE_BINARY:
+                case data_type::LIST:
+                case data_type::LARGE_LIST:
+                case data_type::FIXED_SIZED_LIST:
+                case data_type::MAP:
+                case data_type::STRUCT:
+                    return true;
+                default:
+                    return fixed_width_byte_size(proxy) != 0;
+            }
+        }
+
+        void check_concatenable(std::span<const segment> segments)
+        {
+            const arrow_proxy& first = *segments.front().proxy;
+            if (!is_supported(first))
+            {
+                throw std::invalid_argument(
+                    "concatenate: arrays of format '" + std::string(first.format()) + "' are not supported"
+                );
+            }
+            for (const segment& seg : segments)
+            {
+                if (seg.proxy->format() != first.format() || seg.proxy->n_children() != first.n_children())
+                {
+                    throw std::invalid_argument(
+                        "concatenate: cannot concatenate arrays of formats '" + std::string(first.format())
+                        + "' and '" + std::string(seg.proxy->format()) + "'"
+                    );
+                }
+            }
+        }
+
+        [[nodiscard]] arrow_proxy concatenate_segments(std::span<const segment> segments)
+        {
+            check_concatenable(segments);
+            const arrow_proxy& first = *segments.front().proxy;
+            const data_type dt = first.data_type();
+            const std::size_t length = total_length(segments);
+
+            std::vector<buffer_type> buffers;
+            std::vector<arrow_proxy> children;
+            std::int64_t null_count = 0;
+
+            if (dt == data_type::NA)
+            {
+                null_count = static_cast<std::int64_t>(length);
+            }
+            else
+            {
+                buffers.push_back(concatenate_bits(segments, 0, length, true));
+                null_count = count_nulls(buffers.front(), length);
+            }
+
+            std::vector<std::pair<std::size_t, std::size_t>> child_ranges;
+            child_ranges.reserve(segments.size());
+            switch (dt)
+            {
+                case data_type::NA:
+                    break;
+                case data_type::BOOL:
+                    buffers.push_back(concatenate_bits(segments, 1, length, false));
+                    break;
+                case data_type::STRING:
+                case data_type::BINARY:
+                    concatenate_binary<std::int32_t>(segments, length, buffers);
+                    break;
+                case data_type::LARGE_STRING:
+                case data_type::LARGE_BINARY:
+                    concatenate_binary<std::int64_t>(segments, length, buffers);
+                    break;
+                case data_type::LIST:
+                case data_type::MAP:
+                {
+                    auto [offsets, ranges] = concatenate_offsets<std::int32_t>(segments, length);
+                    buffers.push_back(std::move(offsets));
+                    children = concatenate_children(segments, ranges);
+                    break;
+                }
+                case data_type::LARGE_LIST:
+                {
+                    auto [offsets, ranges] = concatenate_offsets<std::int64_t>(segments, length);
+                    buffers.push_back(std::move(offsets));
+                    children = concatenate_children(segments, ranges);
+                    break;
+                }
+                case data_type::FIXED_SIZED_LIST:
+                {
+                    // Format is "+w:<list size>"
+                    const auto list_size = static_cast<std::size_t>(std::stoull(std::string(first.format().substr(3))));
+                    for (const segment& seg : segments)
+                    {
+                        child_ranges.emplace_back(seg.offset * list_size, (seg.offset + seg.length) * list_size);
+                    }
+                    children = concatenate_children(segments, child_ranges);
+                    break;
+                }
+                case data_type::STRUCT:
+                {
+                    for (const segment& seg : segments)
+                    {
+                        child_ranges.emplace_back(seg.offset, seg.offset + seg.length);
+                    }
+                    children = concatenate_children(segments, child_ranges);
+                    break;
+                }
+                default:
+                    buffers.push_back(concatenate_fixed_width(segments, length));
+                    break;
+            }
+
+            const std::size_t n_children = children.size();
+            ArrowArray** child_arrays = n_children == 0 ? nullptr : new ArrowArray*[n_children];
+            for (std::size_t i = 0; i < n_children; ++i)
+            {
+                child_arrays[i] = new ArrowArray(children[i].extract_array());
+            }
+
+            ArrowArray arr = make_arrow_array(
+                static_cast<std::int64_t>(length),
+                null_count,
+                0,  // offset
+                std::move(buffers),
+                child_arrays,
+                repeat_view<bool>(true, n_children),
+                nullptr,
+                true
+            );
+            return arrow_proxy(std::move(arr), copy_schema(first.schema()));
+        }
+    }
+
+    std::size_t fixed_width_byte_size(const arrow_proxy& proxy)
+    {
+        switch (proxy.data_type())
+        {
+            case data_type::UINT8:
+            case data_type::INT8:
+                return 1;
+            case data_type::UINT16:
+            case data_type::INT16:
+            case data_type::HALF_FLOAT:
+                return 2;
+            case data_type::UINT32:
+            case data_type::INT32:
+            case data_type::FLOAT:
+            case data_type::DATE_DAYS:
+            case data_type::TIME_SECONDS:
+            case data_type::TIME_MILLISECONDS:
+            case data_type::INTERVAL_MONTHS:
+                return 4;
+            case data_type::UINT64:
+            case data_type::INT64:
+            case data_type::DOUBLE:
+            case data_type::DATE_MILLISECONDS:
+            case data_type::TIMESTAMP_SECONDS:
+            case data_type::TIMESTAMP_MILLISECONDS:
+            case data_type::TIMESTAMP_MICROSECONDS:
+            case data_type::TIMESTAMP_NANOSECONDS:
+            case data_type::TIME_MICROSECONDS:
+            case data_type::TIME_NANOSECONDS:
+            case data_type::DURATION_SECONDS:
+            case data_type::DURATION_MILLISECONDS:
+            case data_type::DURATION_MICROSECONDS:
+            case data_type::DURATION_NANOSECONDS:
+            case data_type::INTERVAL_DAYS_TIME:
+                return 8;
+            case data_type::INTERVAL_MONTHS_DAYS_NANOSECONDS:
+                return 16;
+            case data_type::DECIMAL32:
+            case data_type::DECIMAL64:
+            case data_type::DECIMAL128:
+            case data_type::DECIMAL256:
+                return num_bytes_for_decimal(std::string(proxy.format()).c_str());
+            case data_type::FIXED_WIDTH_BINARY:
+                // Format is "w:<byte width>"
+                return static_cast<std::size_t>(std::stoull(std::string(proxy.format().substr(2))));
+            default:
+                return 0;
+        }
+    }
+
+    arrow_proxy concatenate_proxies(std::span<const arrow_proxy* const> proxies)
+    {
+        if (proxies.empty())
+        {
+            throw std::invalid_argument("concatenate: at least one array is required");
+        }
+        std::vector<segment> segments;
+        segments.reserve(proxies.size());
+        for (const arrow_proxy* proxy : proxies)
+        {
+            segments.push_back({proxy, proxy->offset(), proxy->length()});
+        }
+        return concatenate_segments(segments);
+    }
+}
@@ -0,0 +1,1676 @@
+// Copyright 2024 Man Group Operations Limited
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "sparrow/ipc/ipc_reader.hpp"
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <charconv>
+#include <iterator>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+
+#include "sparrow/arrow_interface/arrow_array.hpp"
+#include "sparrow/ipc/flatbuffer.hpp"
+#include "sparrow/ipc/ipc_format.hpp"
+#include "sparrow/types/data_type.hpp"
+#include "sparrow/utils/repeat_container.hpp"
+
+namespace sparrow::ipc
+{
+    static_assert(std::endian::native == std::endian::little, "The IPC format is little-endian");
+
+    namespace detail
+    {
+        /**
+         * Dictionaries of a stream. The dictionary-encoded fields of the schema are
+         * numbered in depth first order, the fields nested in the values of a
+         * dictionary coming after it; the id of each field maps to its last
+         * dictionary batch.
+         */
+        struct dictionary_memo
+        {
+            struct field
+            {
+                std::int64_t id;
+                const ArrowSchema* schema;
+            };
+
+            std::vector<field> fields;
+            std::unordered_map<std::int64_t, std::size_t> ordinals;
+            std::unordered_map<std::int64_t, std::shared_ptr<const ArrowArray>> values;
+        };
+    }
+
+    namespace
+    {
+        using detail::fb_type;
+        using detail::flatbuffer_table_view;
+        using detail::flatbuffer_vector_view;
+
+        // Guards against stack exhaustion on malformed input
+        constexpr std::size_t max_nesting_depth = 64;
+
+        // MetadataVersion::V4, the oldest version Arrow readers accept
+        constexpr std::int16_t min_metadata_version = 3;
+
+        // Backs the empty buffers that must not be null, such as the offsets of empty arrays
+        alignas(64) constexpr std::array<std::uint8_t, 64> zeros{};
+
+        std::int32_t parse_int(std::string_view str)
+        {
+            std::int32_t value = 0;
+            const auto [ptr, ec] = std::from_chars(str.data(), str.data() + str.size(), value);
+            if (ec != std::errc{} || ptr != str.data() + str.size())
+            {
+                throw std::runtime_error("Invalid format in IPC schema");
+            }
+            return value;
+        }
+
+        /******************
+         * Schema decoding *
+         ******************/
+
+        std::string int_format(const flatbuffer_table_view& type)
+        {
+            const bool is_signed = type.scalar<std::uint8_t>(detail::fb_int::is_signed, 0) != 0;
+            switch (type.scalar<std::int32_t>(detail::fb_int::bit_width, 0))
+            {
+                case 8:
+                    return is_signed ? "c" : "C";
+                case 16:
+                    return is_signed ? "s" : "S";
+                case 32:
+                    return is_signed ? "i" : "I";
+                case 64:
+                    return is_signed ? "l" : "L";
+                default:
+                    throw std::runtime_error("Unsupported integer bit width in IPC schema");
+            }
+        }
+
+        std::string unit_suffix(std::int16_t unit)
+        {
+            switch (unit)
+            {
+                case 0:
+                    return "s";
+                case 1:
+                    return "m";
+                case 2:
+                    return "u";
+                case 3:
+                    return "n";
+                default:
+                    throw std::runtime_error("Unsupported time unit in IPC schema");
+            }
+        }
+
+        struct field_type
+        {
+            field_type(std::string type_format, std::size_t type_n_children = 0, std::unordered_set<ArrowFlag> type_flags = {})
+                : format(std::move(type_format))
+                , n_children(type_n_children)
+                , flags(std::move(type_flags))
+            {
+            }
+
+            std::string format;
+            std::size_t n_children;
+            std::unordered_set<ArrowFlag> flags;
+        };
+
+        field_type decode_type(const flatbuffer_table_view& field, std::size_t n_children)
+        {
+            const auto type_type = static_cast<fb_type>(field.scalar<std::uint8_t>(detail::fb_field::type_type, 0));
+            const auto type_table = field.table(detail::fb_field::type);
+            auto type = [&type_table]() -> const flatbuffer_table_view&
+            {
+                if (!type_table.has_value())
+                {
+                    throw std::runtime_error("Missing type in IPC schema");
+                }
+                return *type_table;
+            };
+            auto single_field = [&type](auto default_value)
+            {
+                return type().scalar(detail::fb_single_field, default_value);
+            };
+            switch (type_type)
+            {
+                case fb_type::null:
+                    return {"n"};
+                case fb_type::int_:
+                    return {int_format(type())};
+                case fb_type::floating_point:
+                    switch (single_field(std::int16_t(0)))
+                    {
+                        case 0:
+                            return {"e"};
+                        case 1:
+                            return {"f"};
+                        case 2:
+                            return {"g"};
+                        default:
+                            throw std::runtime_error("Unsupported floating point precision in IPC schema");
+                    }
+                case fb_type::binary:
+                    return {"z"};
+                case fb_type::utf8:
+                    return {"u"};
+                case fb_type::large_binary:
+                    return {"Z"};
+                case fb_type::large_utf8:
+                    return {"U"};
+                case fb_type::binary_view:
+                    return {"vz"};
+                case fb_type::utf8_view:
+                    return {"vu"};
+                case fb_type::bool_:
+                    return {"b"};
+                case fb_type::decimal:
+                {
+                    const auto precision = type().scalar<std::int32_t>(detail::fb_decimal::precision, 0);
+                    const auto scale = type().scalar<std::int32_t>(detail::fb_decimal::scale, 0);
+                    const auto bit_width = type().scalar<std::int32_t>(detail::fb_decimal::bit_width, 128);
+                    if (bit_width != 32 && bit_width != 64 && bit_width != 128 && bit_width != 256)
+                    {
+                        throw std::runtime_error("Unsupported decimal bit width in IPC schema");
+                    }
+                    std::string format = "d:" + std::to_string(precision) + "," + std::to_string(scale);
+                    if (bit_width != 128)
+                    {
+                        format += "," + std::to_string(bit_width);
+                    }
+                    return {std::move(format)};
+                }
+                case fb_type::date:
+                    switch (single_field(std::int16_t(1)))
+                    {
+                        case 0:
+                            return {"tdD"};
+                        case 1:
+                            return {"tdm"};
+                        default:
+                            throw std::runtime_error("Unsupported date unit in IPC schema");
+                    }
+                case fb_type::time:
+                {
+                    const auto unit = type().scalar<std::int16_t>(detail::fb_time::unit, 1);
+                    const auto bit_width = type().scalar<std::int32_t>(detail::fb_time::bit_width, 32);
+                    if (bit_width != (unit < 2 ? 32 : 64))
+                    {
+                        throw std::runtime_error("Invalid time bit width in IPC schema");
+                    }
+                    return {"tt" + unit_suffix(unit)};
+                }
+                case fb_type::timestamp:
+                {
+                    const auto timezone = type().string(detail::fb_timestamp::timezone);
+                    return {
+                        "ts" + unit_suffix(type().scalar<std::int16_t>(detail::fb_timestamp::unit, 0)) + ":"
+                        + std::string(timezone.value_or(""))
+                    };
+                }
+                case fb_type::interval:
+                    switch (single_field(std::int16_t(0)))
+                    {
+                        case 0:
+                            return {"tiM"};
+                        case 1:
+                            return {"tiD"};
+                        case 2:
+                            return {"tin"};
+                        default:
+                            throw std::runtime_error("Unsupported interval unit in IPC schema");
+                    }
+                case fb_type::duration:
+                    return {"tD" + unit_suffix(single_field(std::int16_t(1)))};
+                case fb_type::list:
+                    return {"+l", 1};
+                case fb_type::large_list:
+                    return {"+L", 1};
+                case fb_type::list_view:
+                    return {"+vl", 1};
+                case fb_type::large_list_view:
+                    return {"+vL", 1};
+                case fb_type::fixed_size_list:
+                {
+                    const auto list_size = single_field(std::int32_t(0));
+                    if (list_size < 0)
+                    {
+                        throw std::runtime_error("Invalid list size in IPC schema");
+                    }
+                    return {"+w:" + std::to_string(list_size), 1};
+                }
+                case fb_type::struct_:
+                    return {"+s", n_children};
+                case fb_type::map:
+                {
+                    std::unordered_set<ArrowFlag> flags;
+                    if (single_field(std::uint8_t(0)) != 0)
+                    {
+                        flags.insert(ArrowFlag::MAP_KEYS_SORTED);
+                    }
+                    return {"+m", 1, std::move(flags)};
+                }
+                case fb_type::union_:
+                {
+                    const auto mode = type().scalar<std::int16_t>(detail::fb_union::mode, 0);
+                    if (mode != 0 && mode != 1)
+                    {
+                        throw std::runtime_error("Unsupported union mode in IPC schema");
+                    }
+                    std::string format = mode == 0 ? "+us:" : "+ud:";
+                    const auto type_ids = type().vector(detail::fb_union::type_ids, sizeof(std::int32_t));
+                    // Without type ids, the type ids are the indices of the children
+                    for (std::size_t i = 0; i < n_children; ++i)
+                    {
+                        format += (i == 0 ? "" : ",")
+                                  + std::to_string(
+                                      type_ids.has_value() ? type_ids->get<std::int32_t>(i)
+                                                           : static_cast<std::int32_t>(i)
+                                  );
+                    }
+                    if (type_ids.has_value() && type_ids->size() != n_children)
+                    {
+                        throw std::runtime_error("Invalid union type ids in IPC schema");
+                    }
+                    return {std::move(format), n_children};
+                }
+                case fb_type::fixed_size_binary:
+                {
+                    const auto byte_width = single_field(std::int32_t(0));
+                    if (byte_width < 0)
+                    {
+                        throw std::runtime_error("Invalid byte width in IPC schema");
+                    }
+                    return {"w:" + std::to_string(byte_width)};
+                }
+                case fb_type::run_end_encoded:
+                    return {"+r", 2};
+                default:
+                    throw std::runtime_error("Unsupported type in IPC schema");
+            }
+        }
+
+        std::optional<std::vector<metadata_pair>> decode_metadata(std::optional<flatbuffer_vector_view> key_values)
+        {
+            if (!key_values.has_value())
+            {
+                return std::nullopt;
+            }
+            std::vector<metadata_pair> metadata;
+            for (std::size_t i = 0; i < key_values->size(); ++i)
+            {
+                const auto pair = key_values->table(i);
+                metadata.emplace_back(
+                    std::string(pair.string(detail::fb_key_value::key).value_or("")),
+                    std::string(pair.string(detail::fb_key_value::value).value_or(""))
+                );
+            }
+            return metadata;
+        }
+
+        ArrowSchema** release_children(std::vector<schema_unique_ptr>& children)
+        {
+            if (children.empty())
+            {
+                return nullptr;
+            }
+            auto** children_ptrs = new ArrowSchema*[children.size()];
+            std::ranges::transform(
+                children,
+                children_ptrs,
+                [](auto& child)
+                {
+                    return child.release();
+                }
+            );
+            return children_ptrs;
+        }
+
+        ArrowSchema decode_field(const flatbuffer_table_view& field, detail::dictionary_memo& memo, std::size_t depth)
+        {
+            if (depth > max_nesting_depth)
+            {
+                throw std::runtime_error("IPC schema is too deeply nested");
+            }
+            std::optional<std::string> name;
+            if (const auto field_name = field.string(detail::fb_field::name))
+            {
+                name = std::string(*field_name);
+            }
+            auto metadata = decode_metadata(field.vector(detail::fb_field::custom_metadata, sizeof(std::uint32_t)));
+            const bool nullable = field.scalar<std::uint8_t>(detail::fb_field::nullable, 0) != 0;
+
+            // The dictionary is numbered before the fields nested in its values
+            const auto dictionary = field.table(detail::fb_field::dictionary);
+            if (dictionary.has_value())
+            {
+                const auto id = dictionary->scalar<std::int64_t>(detail::fb_dictionary_encoding::id, 0);
+                if (!memo.ordinals.emplace(id, memo.fields.size()).second)
+                {
+                    throw std::runtime_error("Duplicate dictionary id in IPC schema");
+                }
+                memo.fields.push_back({id, nullptr});
+            }
+
+            std::vector<schema_unique_ptr> children;
+            if (const auto children_fields = field.vector(detail::fb_field::children, sizeof(std::uint32_t)))
+            {
+                for (std::size_t i = 0; i < children_fields->size(); ++i)
+                {
+                    children.emplace_back(new ArrowSchema(decode_field(children_fields->table(i), memo, depth + 1)));
+                }
+            }
+            field_type type = decode_type(field, children.size());
+            if (type.n_children != children.size())
+            {
+                throw std::runtime_error("Invalid number of children in IPC schema");
+            }
+
+            std::unordered_set<ArrowFlag> flags;
+            if (nullable)
+            {
+                flags.insert(ArrowFlag::NULLABLE);
+            }
+            const std::size_t n_children = children.size();
+            if (!dictionary.has_value())
+            {
+                flags.insert(type.flags.begin(), type.flags.end());
+                return make_arrow_schema(
+                    std::move(type.format),
+                    std::move(name),
+                    std::move(metadata),
+                    std::move(flags),
+                    release_children(children),
+                    repeat_view<bool>(true, n_children),
+                    nullptr,
+                    false
+                );
+            }
+
+            // The field holds the indices, and the dictionary the values
+            const auto index_type = dictionary->table(detail::fb_dictionary_encoding::index_type);
+            std::string index_format = index_type.has_value() ? int_format(*index_type) : "i";
+            if (dictionary->scalar<std::uint8_t>(detail::fb_dictionary_encoding::is_ordered, 0) != 0)
+            {
+                flags.insert(ArrowFlag::DICTIONARY_ORDERED);
+            }
+            type.flags.insert(ArrowFlag::NULLABLE);
+            schema_unique_ptr values{new ArrowSchema(make_arrow_schema(
+                std::move(type.format),
+                std::optional<std::string>{},
+                std::optional<std::vector<metadata_pair>>{},
+                std::move(type.flags),
+                release_children(children),
+                repeat_view<bool>(true, n_children),
+                nullptr,
+                false
+            ))};
+            return make_arrow_schema(
+                std::move(index_format),
+                std::move(name),
+                std::move(metadata),
+                std::move(flags),
+                nullptr,
+                repeat_view<bool>(true, 0),
+                values.release(),
+                true
+            );
+        }
+
+        // Same order as decode_field
+        void register_dictionary_fields(const ArrowSchema& schema, detail::dictionary_memo& memo, std::size_t& ordinal)
+        {
+            const ArrowSchema* values = &schema;
+            if (schema.dictionary != nullptr)
+            {
+                memo.fields[ordinal++].schema = &schema;
+                values = schema.dictionary;
+            }
+            for (std::int64_t i = 0; i < values->n_children; ++i)
+            {
+                register_dictionary_fields(*values->children[i], memo, ordinal);
+            }
+        }
+
+        std::size_t count_dictionary_fields(const ArrowSchema& schema)
+        {
+            const ArrowSchema* values = schema.dictionary != nullptr ? schema.dictionary : &schema;
+            std::size_t res = schema.dictionary != nullptr ? 1 : 0;
+            for (std::int64_t i = 0; i < values->n_children; ++i)
+            {
+                res += count_dictionary_fields(*values->children[i]);
+            }
+            return res;
+        }
+
+        schema_unique_ptr decode_schema(const flatbuffer_table_view& schema, detail::dictionary_memo& memo)
+        {
+            if (schema.scalar<std::int16_t>(detail::fb_schema::endianness, 0) != 0)
+            {
+                throw std::runtime_error("Big-endian IPC data is not supported");
+            }
+            std::vector<schema_unique_ptr> fields;
+            if (const auto fields_vector = schema.vector(detail::fb_schema::fields, sizeof(std::uint32_t)))
+            {
+                for (std::size_t i = 0; i < fields_vector->size(); ++i)
+                {
+                    fields.emplace_back(new ArrowSchema(decode_field(fields_vector->table(i), memo, 0)));
+                }
+            }
+            auto metadata = decode_metadata(schema.vector(detail::fb_schema::custom_metadata, sizeof(std::uint32_t)));
+            const std::size_t n_fields = fields.size();
+            schema_unique_ptr res{new ArrowSchema(make_arrow_schema(
+                std::string("+s"),
+                std::optional<std::string>{},
+                std::move(metadata),
+                std::optional<std::unordered_set<ArrowFlag>>{},
+                release_children(fields),
+                repeat_view<bool>(true, n_fields),
+                nullptr,
+                false
+            ))};
+            std::size_t ordinal = 0;
+            register_dictionary_fields(*res, memo, ordinal);
+            return res;
+        }
+
+        /*******************
+         * Message decoding *
+         *******************/
+
+        struct message_header
+        {
+            message_type type;
+            std::int16_t version;
+            std::int64_t body_length;
+            flatbuffer_table_view header;
+        };
+
+        message_header decode_message_header(std::span<const std::uint8_t> metadata)
+        {
+            const auto message = flatbuffer_table_view::root(metadata);
+            const auto version = message.scalar<std::int16_t>(detail::fb_message::version, 0);
+            if (version < min_metadata_version)
+            {
+                throw std::runtime_error("Unsupported IPC metadata version");
+            }
+            const auto body_length = message.scalar<std::int64_t>(detail::fb_message::body_length, 0);
+            if (body_length < 0)
+            {
+                throw std::runtime_error("Invalid IPC message body size");
+            }
+            const auto header = message.table(detail::fb_message::header);
+            if (!header.has_value())
+            {
+                throw std::runtime_error("Invalid IPC message: missing header");
+            }
+            return {
+                static_cast<message_type>(message.scalar<std::uint8_t>(detail::fb_message::header_type, 0)),
+                version,
+                body_length,
+                *header
+            };
+        }
+
+        message_header decode_message_header(std::span<const std::uint8_t> metadata, message_type expected)
+        {
+            auto res = decode_message_header(metadata);
+            if (res.type != expected)
+            {
+                throw std::runtime_error("Unexpected IPC message type");
+            }
+            return res;
+        }
+
+        schema_unique_ptr decode_schema_message(std::span<const std::uint8_t> metadata, detail::dictionary_memo& memo)
+        {
+            return decode_schema(decode_message_header(metadata, message_type::schema).header, memo);
+        }
+
+        /************************
+         * Record batch decoding *
+         ************************/
+
+        // ArrowArray whose buffers point into a message body kept alive by owner
+        struct ipc_array_private_data
+        {
+            std::shared_ptr<const void> owner;
+            std::vector<const void*> buffers;
+            std::vector<ArrowArray*> children;
+            // Sizes of the data buffers of view arrays, which Arrow IPC does not store
+            std::vector<std::int64_t> buffer_sizes;
+        };
+
+        void release_ipc_array(ArrowArray* array)
+        {
+            auto* private_data = static_cast<ipc_array_private_data*>(array->private_data);
+            for (ArrowArray* child : private_data->children)
+            {
+                arrow_array_deleter{}(child);
+            }
+            arrow_array_deleter{}(array->dictionary);
+            delete private_data;
+            *array = ArrowArray{};
+        }
+
+        std::vector<ArrowArray*> release_children(std::vector<array_unique_ptr>& children)
+        {
+            std::vector<ArrowArray*> res;
+            std::ranges::transform(
+                children,
+                std::back_inserter(res),
+                [](auto& child)
+                {
+                    return child.release();
+                }
+            );
+            return res;
+        }
+
+        // Returns an array sharing the buffers of source, which owner keeps alive
+        ArrowArray* share_array(const ArrowArray& source, const std::shared_ptr<const void>& owner)
+        {
+            std::vector<array_unique_ptr> children;
+            for (std::int64_t i = 0; i < source.n_children; ++i)
+            {
+                children.emplace_back(share_array(*source.children[i], owner));
+            }
+            array_unique_ptr dictionary(source.dictionary != nullptr ? share_array(*source.dictionary, owner) : nullptr);
+
+            auto private_data = std::make_unique<ipc_array_private_data>();
+            private_data->owner = owner;
+            private_data->buffers.assign(source.buffers, source.buffers + source.n_buffers);
+            private_data->children = release_children(children);
+
+            auto* array = new ArrowArray(source);
+            array->buffers = private_data->buffers.data();
+            array->children = private_data->children.empty() ? nullptr : private_data->children.data();
+            array->dictionary = dictionary.release();
+            array->release = release_ipc_array;
+            array->private_data = private_data.release();
+            return array;
+        }
+
+        struct node_info
+        {
+            std::int64_t length;
+            std::int64_t null_count;
+        };
+
+        struct buffer_info
+        {
+            std::int64_t offset;
+            std::int64_t size;
+        };
+
+        // Buffers and children of an array being decoded
+        struct array_parts
+        {
+            std::vector<const void*> buffers;
+            std::vector<array_unique_ptr> children;
+            std::optional<std::vector<std::int64_t>> buffer_sizes;
+        };
+
+        [[noreturn]] void throw_invalid_batch(const std::string& what)
+        {
+            throw std::runtime_error("Invalid IPC record batch: " + what);
+        }
+
+        // Size in bytes of n elements of width bytes, throwing on overflow
+        std::size_t byte_size(std::size_t n, std::size_t width)
+        {
+            if (width != 0 && n > std::numeric_limits<std::size_t>::max() / width)
+            {
+                throw_invalid_batch("array too large");
+            }
+            return n * width;
+        }
+
+        bool is_valid(const void* validity, std::size_t i)
+        {
+            return validity == nullptr || ((static_cast<const std::uint8_t*>(validity)[i / 8] >> (i % 8)) & 1u) != 0;
+        }
+
+        template <class T>
+        T load(const void* data, std::size_t i)
+        {
+            T value;
+            std::memcpy(&value, static_cast<const std::uint8_t*>(data) + i * sizeof(T), sizeof(T));
+            return value;
+        }
+
+        // Reads an integer of a signed or unsigned integer array, std::nullopt if it does not fit in int64
+        std::optional<std::int64_t> load_integer(data_type dt, const void* data, std::size_t i)
+        {
+            switch (dt)
+            {
+                case data_type::INT8:
+                    return load<std::int8_t>(data, i);
+                case data_type::UINT8:
+                    return load<std::uint8_t>(data, i);
+                case data_type::INT16:
+                    return load<std::int16_t>(data, i);
+                case data_type::UINT16:
+                    return load<std::uint16_t>(data, i);
+                case data_type::INT32:
+                    return load<std::int32_t>(data, i);
+                case data_type::UINT32:
+                    return load<std::uint32_t>(data, i);
+                case data_type::INT64:
+                    return load<std::int64_t>(data, i);
+                case data_type::UINT64:
+                {
+                    const auto value = load<std::uint64_t>(data, i);
+                    if (value > static_cast<std::uint64_t>(std::numeric_limits<std::int64_t>::max()))
+                    {
+                        return std::nullopt;
+                    }
+                    return static_cast<std::int64_t>(value);
+                }
+                default:
+                    throw_invalid_batch("integer array expected");
+            }
+        }
+
+        /**
+         * Decodes the nodes and buffers of a RecordBatch table into arrays, checking
+         * them against the schema: every buffer the layout needs must be present, lie
+         * within the body, be aligned and be large enough for the length of the node,
+         * and every offset, size, type id, run end, view and dictionary index must
+         * stay in bounds, so that the arrays can be accessed without further checks.
+         */
+        class record_batch_decoder
+        {
+        public:
+
+            record_batch_decoder(
+                const flatbuffer_table_view& batch,
+                std::int16_t version,
+                std::span<const std::uint8_t> body,
+                std::shared_ptr<const void> owner,
+                const detail::dictionary_memo& dictionaries,
+                std::size_t first_dictionary_ordinal
+            )
+                : m_version(version)
+                , m_body(body)
+                , m_owner(std::move(owner))
+                , m_dictionaries(dictionaries)
+                , m_dictionary_ordinal(first_dictionary_ordinal)
+            {
+                if (batch.has(detail::fb_record_batch::compression))
+                {
+                    throw std::runtime_error("Compressed IPC bodies are not supported");
+                }
+                m_length = batch.scalar<std::int64_t>(detail::fb_record_batch::length, 0);
+                if (m_length < 0)
+                {
+                    throw std::runtime_error("Invalid IPC record batch length");
+                }
+                if (const auto nodes = batch.vector(detail::fb_record_batch::nodes, detail::fb_record_batch::node_size))
+                {
+                    for (std::size_t i = 0; i < nodes->size(); ++i)
+                    {
+                        m_nodes.push_back({nodes->get<std::int64_t>(i, 0), nodes->get<std::int64_t>(i, 8)});
+                    }
+                }
+                if (const auto buffers = batch.vector(detail::fb_record_batch::buffers, detail::fb_record_batch::buffer_size))
+                {
+                    for (std::size_t i = 0; i < buffers->size(); ++i)
+                    {
+                        m_buffers.push_back({buffers->get<std::int64_t>(i, 0), buffers->get<std::int64_t>(i, 8)});
+                    }
+                }
+                if (const auto counts = batch.vector(
+                        detail::fb_record_batch::variadic_buffer_counts,
+                        sizeof(std::int64_t)
+                    ))
+                {
+                    for (std::size_t i = 0; i < counts->size(); ++i)
+                    {
+                        m_variadic_buffer_counts.push_back(counts->get<std::int64_t>(i));
+                    }
+                }
+            }
+
+            // The record batch itself is a struct array without validity bitmap nor node
+            ArrowArray decode_record_batch(const ArrowSchema& schema)
+            {
+                array_parts parts;
+                parts.buffers.push_back(nullptr);
+                for (std::int64_t i = 0; i < schema.n_children; ++i)
+                {
+                    parts.children.push_back(decode(*schema.children[i], 0));
+                    if (parts.children.back()->length != m_length)
+                    {
+                        throw_invalid_batch("column length differs from the record batch length");
+                    }
+                }
+                check_consumed();
+                return move_array(*make_array({m_length, 0}, std::move(parts)));
+            }
+
+            // A dictionary batch holds a record batch with a single column, the values
+            array_unique_ptr decode_dictionary(const ArrowSchema& values)
+            {
+                array_unique_ptr res = decode(values, 0);
+                if (res->length != m_length)
+                {
+                    throw_invalid_batch("dictionary length differs from the record batch length");
+                }
+                check_consumed();
+                return res;
+            }
+
+        private:
+
+            struct buffer_view
+            {
+                const std::uint8_t* data;
+                std::size_t size;
+            };
+
+            void check_consumed() const
+            {
+                if (m_node_index != m_nodes.size() || m_buffer_index != m_buffers.size()
+                    || m_variadic_index != m_variadic_buffer_counts.size())
+                {
+                    throw_invalid_batch("unexpected nodes or buffers");
+                }
+            }
+
+            node_info next_node()
+            {
+                if (m_node_index == m_nodes.size())
+                {
+                    throw_invalid_batch("missing node");
+                }
+                const node_info& node = m_nodes[m_node_index++];
+                if (node.length < 0 || node.null_count < 0 || node.null_count > node.length)
+                {
+                    throw_invalid_batch("invalid node");
+                }
+                return node;
+            }
+
+            // Buffers are 8-byte aligned in the body and aligned on their element size in memory
+            buffer_view next_buffer(std::size_t alignment)
+            {
+                if (m_buffer_index == m_buffers.size())
+                {
+                    throw_invalid_batch("missing buffer");
+                }
+                const buffer_info& buffer = m_buffers[m_buffer_index++];
+                if (buffer.offset < 0 || buffer.size < 0 || static_cast<std::uint64_t>(buffer.offset) > m_body.size()
+                    || static_cast<std::uint64_t>(buffer.size) > m_body.size() - static_cast<std::size_t>(buffer.offset))
+                {
+                    throw_invalid_batch("buffer out of the message body");
+                }
+                if (buffer.size == 0)
+                {
+                    return {nullptr, 0};
+                }
+                const std::uint8_t* data = m_body.data() + buffer.offset;
+                if (static_cast<std::size_t>(buffer.offset) % detail::buffer_alignment != 0
+                    || reinterpret_cast<std::uintptr_t>(data) % alignment != 0)
+                {
+                    throw_invalid_batch("misaligned buffer");
+                }
+                return {data, static_cast<std::size_t>(buffer.size)};
+            }
+
+            // Returns a buffer of at least size bytes; empty buffers point to zeros
+            const std::uint8_t* next_buffer(std::size_t size, std::size_t alignment)
+            {
+                const buffer_view buffer = next_buffer(alignment);
+                if (buffer.size < size)
+                {
+                    throw_invalid_batch("buffer too small for the array length");
+                }
+                return buffer.data != nullptr ? buffer.data : zeros.data();
+            }
+
+            // The validity bitmap may be omitted when there is no null
+            const void* next_validity(const node_info& node)
+            {
+                const buffer_view buffer = next_buffer(1);
+                if (buffer.data == nullptr)
+                {
+                    if (node.null_count != 0)
+                    {
+                        throw_invalid_batch("missing validity bitmap");
+                    }
+                    return nullptr;
+                }
+                if (buffer.size < (static_cast<std::size_t>(node.length) + 7) / 8)
+                {
+                    throw_invalid_batch("validity bitmap too small for the array length");
+                }
+                return buffer.data;
+            }
+
+            // Offsets must start at or after 0, increase, and end at most at limit
+            template <class T>
+            static void check_offsets(const void* offsets, std::size_t length, std::size_t limit)
+            {
+                if (length == 0)
+                {
+                    return;
+                }
+                T previous = load<T>(offsets, 0);
+                if (previous < 0)
+                {
+                    throw_invalid_batch("negative offset");
+                }
+                for (std::size_t i = 1; i <= length; ++i)
+                {
+                    const T current = load<T>(offsets, i);
+                    if (current < previous)
+                    {
+                        throw_invalid_batch("decreasing offsets");
+                    }
+                    previous = current;
+                }
+                if (static_cast<std::uint64_t>(previous) > limit)
+                {
+                    throw_invalid_batch("offset out of bounds");
+                }
+            }
+
+            // Empty arrays may omit their offsets
+            const std::uint8_t* next_offsets(std::size_t length, std::size_t offset_size)
+            {
+                return next_buffer(length == 0 ? 0 : byte_size(length + 1, offset_size), offset_size);
+            }
+
+            // List view offsets and sizes of the valid elements must stay within limit
+            template <class T>
+            static void check_list_views(
+                const void* validity,
+                const void* offsets,
+                const void* sizes,
+                std::size_t length,
+                std::size_t limit
+            )
+            {
+                for (std::size_t i = 0; i < length; ++i)
+                {
+                    if (!is_valid(validity, i))
+                    {
+                        continue;
+                    }
+                    const T offset = load<T>(offsets, i);
+                    const T size = load<T>(sizes, i);
+                    if (offset < 0 || size < 0 || static_cast<std::uint64_t>(offset) > limit
+                        || static_cast<std::uint64_t>(size) > limit - static_cast<std::uint64_t>(offset))
+                    {
+                        throw_invalid_batch("list view out of bounds");
+                    }
+                }
+            }
+
+            array_unique_ptr decode_child(const ArrowSchema& schema, std::size_t depth, std::size_t min_length)
+            {
+                array_unique_ptr child = decode(schema, depth + 1);
+                if (static_cast<std::uint64_t>(child->length) < min_length)
+                {
+                    throw_invalid_batch("child array too short");
+                }
+                return child;
+            }
+
+            array_unique_ptr decode(const ArrowSchema& schema, std::size_t depth)
+            {
+                if (depth > max_nesting_depth)
+                {
+                    throw std::runtime_error("IPC record batch is too deeply nested");
+                }
+                const node_info node = next_node();
+                const std::string_view format = schema.format;
+                const data_type dt = format_to_data_type(format);
+                const auto length = static_cast<std::size_t>(node.length);
+                auto child_schema = [&schema](std::int64_t i) -> const ArrowSchema&
+                {
+                    if (i >= schema.n_children)
+                    {
+                        throw std::runtime_error("Invalid number of children in IPC schema");
+                    }
+                    return *schema.children[i];
+                };
+                array_parts parts;
+
+                switch (dt)
+                {
+                    case data_type::NA:
+                        if (format != "n")
+                        {
+                            throw std::runtime_error("Unsupported format in IPC schema");
+                        }
+                        return make_array({node.length, node.length}, std::move(parts));
+                    case data_type::SPARSE_UNION:
+                    case data_type::DENSE_UNION:
+                        return decode_union(node, schema, dt == data_type::DENSE_UNION, depth);
+                    case data_type::RUN_ENCODED:
+                        return decode_run_end_encoded(node, schema, depth);
+                    default:
+                        break;
+                }
+
+                const void* validity = next_validity(node);
+                parts.buffers.push_back(validity);
+
+                if (const auto width = detail::fixed_width(dt, format); width.has_value())
+                {
+                    // Elements whose size is not a power of two, such as fixed-width binaries, are byte aligned
+                    const std::size_t alignment = std::has_single_bit(*width)
+                                                      ? std::min(*width, detail::buffer_alignment)
+                                                      : 1;
+                    const std::uint8_t* data = next_buffer(byte_size(length, *width), alignment);
+                    parts.buffers.push_back(data);
+                    std::shared_ptr<const ArrowArray> dictionary;
+                    if (schema.dictionary != nullptr)
+                    {
+                        dictionary = lookup_dictionary(schema);
+                        check_indices(dt, validity, data, length, static_cast<std::uint64_t>(dictionary->length));
+                    }
+                    return make_array(node, std::move(parts), std::move(dictionary));
+                }
+                if (schema.dictionary != nullptr)
+                {
+                    throw std::runtime_error("The indices of a dictionary-encoded field must be integers");
+                }
+
+                switch (dt)
+                {
+                    case data_type::BOOL:
+                        parts.buffers.push_back(next_buffer((length + 7) / 8, 1));
+                        break;
+                    case data_type::STRING:
+                    case data_type::BINARY:
+                    case data_type::LARGE_STRING:
+                    case data_type::LARGE_BINARY:
+                    {
+                        const bool large = dt == data_type::LARGE_STRING || dt == data_type::LARGE_BINARY;
+                        const std::uint8_t* offsets = next_offsets(length, large ? sizeof(std::int64_t) : sizeof(std::int32_t));
+                        const buffer_view data = next_buffer(1);
+                        if (large)
+                        {
+                            check_offsets<std::int64_t>(offsets, length, data.size);
+                        }
+                        else
+                        {
+                            check_offsets<std::int32_t>(offsets, length, data.size);
+                        }
+                        parts.buffers.push_back(offsets);
+                        parts.buffers.push_back(data.data != nullptr ? data.data : zeros.data());
+                        break;
+                    }
+                    case data_type::STRING_VIEW:
+                    case data_type::BINARY_VIEW:
+                        decode_views(validity, length, parts);
+                        break;
+                    case data_type::LIST:
+                    case data_type::LARGE_LIST:
+                    case data_type::MAP:
+                    {
+                        const bool large = dt == data_type::LARGE_LIST;
+                        const std::uint8_t* offsets = next_offsets(length, large ? sizeof(std::int64_t) : sizeof(std::int32_t));
+                        parts.buffers.push_back(offsets);
+                        parts.children.push_back(decode_child(child_schema(0), depth, 0));
+                        const auto limit = static_cast<std::size_t>(parts.children[0]->length);
+                        if (large)
+                        {
+                            check_offsets<std::int64_t>(offsets, length, limit);
+                        }
+                        else
+                        {
+                            check_offsets<std::int32_t>(offsets, length, limit);
+                        }
+                        break;
+                    }
+                    case data_type::LIST_VIEW:
+                    case data_type::LARGE_LIST_VIEW:
+                    {
+                        const std::size_t offset_size = dt == data_type::LIST_VIEW ? sizeof(std::int32_t)
+                                                                                   : sizeof(std::int64_t);
+                        const std::uint8_t* offsets = next_buffer(byte_size(length, offset_size), offset_size);
+                        const std::uint8_t* sizes = next_buffer(byte_size(length, offset_size), offset_size);
+                        parts.buffers.push_back(offsets);
+                        parts.buffers.push_back(sizes);
+                        parts.children.push_back(decode_child(child_schema(0), depth, 0));
+                        const auto limit = static_cast<std::size_t>(parts.children[0]->length);
+                        if (dt == data_type::LIST_VIEW)
+                        {
+                            check_list_views<std::int32_t>(validity, offsets, sizes, length, limit);
+                        }
+                        else
+                        {
+                            check_list_views<std::int64_t>(validity, offsets, sizes, length, limit);
+                        }
+                        break;
+                    }
+                    case data_type::FIXED_SIZED_LIST:
+                    {
+                        const auto list_size = static_cast<std::size_t>(parse_int(format.substr(3)));
+                        parts.children.push_back(decode_child(child_schema(0), depth, byte_size(length, list_size)));
+                        break;
+                    }
+                    case data_type::STRUCT:
+                        for (std::int64_t i = 0; i < schema.n_children; ++i)
+                        {
+                            parts.children.push_back(decode_child(child_schema(i), depth, length));
+                        }
+                        break;
+                    default:
+                        throw std::runtime_error("Unsupported format in IPC schema");
+                }
+                return make_array(node, std::move(parts));
+            }
+
+            // Views hold their size, then either the inlined data (up to 12 bytes), or a
+            // prefix, the index of a data buffer and an offset in it
+            void decode_views(const void* validity, std::size_t length, array_parts& parts)
+            {
+                constexpr std::size_t view_size = 16;
+                constexpr std::int32_t max_inlined_size = 12;
+                const std::uint8_t* views = next_buffer(byte_size(length, view_size), detail::buffer_alignment);
+                parts.buffers.push_back(views);
+                if (m_variadic_index == m_variadic_buffer_counts.size())
+                {
+                    throw_invalid_batch("missing variadic buffer count");
+                }
+                const std::int64_t n_data_buffers = m_variadic_buffer_counts[m_variadic_index++];
+                if (n_data_buffers < 0 || static_cast<std::uint64_t>(n_data_buffers) > m_buffers.size() - m_buffer_index)
+                {
+                    throw_invalid_batch("invalid variadic buffer count");
+                }
+                auto& sizes = parts.buffer_sizes.emplace();
+                sizes.reserve(static_cast<std::size_t>(n_data_buffers) + 1);
+                for (std::int64_t i = 0; i < n_data_buffers; ++i)
+                {
+                    const buffer_view buffer = next_buffer(1);
+                    parts.buffers.push_back(buffer.data != nullptr ? buffer.data : zeros.data());
+                    sizes.push_back(static_cast<std::int64_t>(buffer.size));
+                }
+                for (std::size_t i = 0; i < length; ++i)
+                {
+                    if (!is_valid(validity, i))
+                    {
+                        continue;
+                    }
+                    const std::uint8_t* view = views + i * view_size;
+                    const auto size = load<std::int32_t>(view, 0);
+                    if (size < 0)
+                    {
+                        throw_invalid_batch("negative view size");
+                    }
+                    if (size <= max_inlined_size)
+                    {
+                        continue;
+                    }
+                    const auto index = load<std::int32_t>(view + 8, 0);
+                    const auto offset = load<std::int32_t>(view + 12, 0);
+                    if (index < 0 || index >= n_data_buffers || offset < 0
+                        || static_cast<std::int64_t>(offset) + size > sizes[static_cast<std::size_t>(index)])
+                    {
+                        throw_invalid_batch("view out of bounds");
+                    }
+                }
+            }
+
+            array_unique_ptr decode_union(const node_info& node, const ArrowSchema& schema, bool dense, std::size_t depth)
+            {
+                const auto length = static_cast<std::size_t>(node.length);
+                // Unions had a validity bitmap before MetadataVersion::V5
+                if (m_version < detail::metadata_version)
+                {
+                    std::ignore = next_buffer(1);
+                }
+                array_parts parts;
+                const std::uint8_t* type_ids = next_buffer(length, 1);
+                parts.buffers.push_back(type_ids);
+                const std::uint8_t* offsets = nullptr;
+                if (dense)
+                {
+                    offsets = next_buffer(byte_size(length, sizeof(std::int32_t)), sizeof(std::int32_t));
+                    parts.buffers.push_back(offsets);
+                }
+
+                // Maps the type ids to the children
+                std::array<std::int16_t, 128> child_of_type_id;
+                child_of_type_id.fill(-1);
+                std::string_view ids = std::string_view(schema.format).substr(4);
+                for (std::int64_t i = 0; i < schema.n_children; ++i)
+                {
+                    const auto comma = ids.find(',');
+                    const auto id = parse_int(ids.substr(0, comma));
+                    if (id < 0 || id >= static_cast<std::int32_t>(child_of_type_id.size()))
+                    {
+                        throw std::runtime_error("Invalid union type ids in IPC schema");
+                    }
+                    child_of_type_id[static_cast<std::size_t>(id)] = static_cast<std::int16_t>(i);
+                    ids = comma == std::string_view::npos ? std::string_view{} : ids.substr(comma + 1);
+                }
+                for (std::int64_t i = 0; i < schema.n_children; ++i)
+                {
+                    parts.children.push_back(decode_child(*schema.children[i], depth, dense ? 0 : length));
+                }
+
+                for (std::size_t i = 0; i < length; ++i)
+                {
+                    const auto type_id = static_cast<std::int8_t>(type_ids[i]);
+                    if (type_id < 0 || child_of_type_id[static_cast<std::size_t>(type_id)] < 0)
+                    {
+                        throw_invalid_batch("invalid union type id");
+                    }
+                    if (dense)
+                    {
+                        const auto& child = parts.children[static_cast<std::size_t>(child_of_type_id[static_cast<std::size_t>(type_id)])];
+                        const auto offset = load<std::int32_t>(offsets, i);
+                        if (offset < 0 || offset >= child->length)
+                        {
+                            throw_invalid_batch("union offset out of bounds");
+                        }
+                    }
+                }
+                // Unions do not have a validity bitmap
+                return make_array({node.length, 0}, std::move(parts));
+            }
+
+            array_unique_ptr decode_run_end_encoded(const node_info& node, const ArrowSchema& schema, std::size_t depth)
+            {
+                if (node.null_count != 0 || schema.n_children != 2)
+                {
+                    throw_invalid_batch("invalid run-end encoded array");
+                }
+                array_parts parts;
+                parts.children.push_back(decode_child(*schema.children[0], depth, 0));
+                const ArrowArray& run_ends = *parts.children[0];
+                parts.children.push_back(decode_child(*schema.children[1], depth, static_cast<std::size_t>(run_ends.length)));
+
+                const data_type run_end_type = format_to_data_type(schema.children[0]->format);
+                if (run_ends.null_count != 0
+                    || (run_end_type != data_type::INT16 && run_end_type != data_type::INT32 && run_end_type != data_type::INT64))
+                {
+                    throw_invalid_batch("invalid run ends");
+                }
+                std::int64_t previous = 0;
+                for (std::int64_t i = 0; i < run_ends.length; ++i)
+                {
+                    const auto run_end = *load_integer(run_end_type, run_ends.buffers[1], static_cast<std::size_t>(i));
+                    if (run_end <= previous)
+                    {
+                        throw_invalid_batch("run ends must be positive and increasing");
+                    }
+                    previous = run_end;
+                }
+                if (previous < node.length)
+                {
+                    throw_invalid_batch("run ends shorter than the array");
+                }
+                return make_array(node, std::move(parts));
+            }
+
+            std::shared_ptr<const ArrowArray> lookup_dictionary(const ArrowSchema& schema)
+            {
+                const std::size_t ordinal = m_dictionary_ordinal;
+                m_dictionary_ordinal += count_dictionary_fields(schema);
+                if (ordinal >= m_dictionaries.fields.size())
+                {
+                    throw std::runtime_error("Invalid IPC dictionary");
+                }
+                const auto it = m_dictionaries.values.find(m_dictionaries.fields[ordinal].id);
+                if (it == m_dictionaries.values.end())
+                {
+                    throw std::runtime_error("Missing dictionary batch in IPC stream");
+                }
+                return it->second;
+            }
+
+            static void check_indices(
+                data_type dt,
+                const void* validity,
+                const void* indices,
+                std::size_t length,
+                std::uint64_t dictionary_length
+            )
+            {
+                for (std::size_t i = 0; i < length; ++i)
+                {
+                    if (!is_valid(validity, i))
+                    {
+                        continue;
+                    }
+                    const auto index = load_integer(dt, indices, i);
+                    if (!index.has_value() || *index < 0 || static_cast<std::uint64_t>(*index) >= dictionary_length)
+                    {
+                        throw_invalid_batch("dictionary index out of bounds");
+                    }
+                }
+            }
+
+            array_unique_ptr
+            make_array(const node_info& node, array_parts parts, std::shared_ptr<const ArrowArray> dictionary = nullptr)
+            {
+                auto private_data = std::make_unique<ipc_array_private_data>();
+                private_data->owner = m_owner;
+                private_data->buffers = std::move(parts.buffers);
+                if (parts.buffer_sizes.has_value())
+                {
+                    private_data->buffer_sizes = std::move(*parts.buffer_sizes);
+                    private_data->buffers.push_back(private_data->buffer_sizes.data());
+                }
+                private_data->children = release_children(parts.children);
+
+                array_unique_ptr array(new ArrowArray{});
+                array->length = node.length;
+                array->null_count = node.null_count;
+                array->offset = 0;
+                array->n_buffers = static_cast<std::int64_t>(private_data->buffers.size());
+                array->n_children = static_cast<std::int64_t>(private_data->children.size());
+                array->buffers = private_data->buffers.data();
+                array->children = private_data->children.empty() ? nullptr : private_data->children.data();
+                // Each array gets its own view of the dictionary, which keeps it alive
+                array->dictionary = dictionary != nullptr ? share_array(*dictionary, dictionary) : nullptr;
+                array->release = release_ipc_array;
+                array->private_data = private_data.release();
+                return array;
+            }
+
+            std::int16_t m_version;
+            std::span<const std::uint8_t> m_body;
+            std::shared_ptr<const void> m_owner;
+            const detail::dictionary_memo& m_dictionaries;
+            std::size_t m_dictionary_ordinal;
+            std::int64_t m_length = 0;
+            std::vector<node_info> m_nodes;
+            std::vector<buffer_info> m_buffers;
+            std::vector<std::int64_t> m_variadic_buffer_counts;
+            std::size_t m_node_index = 0;
+            std::size_t m_buffer_index = 0;
+            std::size_t m_variadic_index = 0;
+        };
+
+        ArrowArray decode_record_batch_message(
+            const ArrowSchema& schema,
+            const detail::dictionary_memo& dictionaries,
+            std::span<const std::uint8_t> metadata,
+            std::span<const std::uint8_t> body,
+            std::shared_ptr<const void> owner
+        )
+        {
+            const auto message = decode_message_header(metadata, message_type::record_batch);
+            record_batch_decoder decoder(message.header, message.version, body, std::move(owner), dictionaries, 0);
+            return decoder.decode_record_batch(schema);
+        }
+
+        /**
+         * Decodes a dictionary batch and stores it in \c dictionaries, replacing the
+         * previous dictionary with the same id unless \c allow_replacement is false.
+         */
+        void decode_dictionary_message(
+            detail::dictionary_memo& dictionaries,
+            std::span<const std::uint8_t> metadata,
+            std::span<const std::uint8_t> body,
+            std::shared_ptr<const void> owner,
+            bool allow_replacement
+        )
+        {
+            const auto message = decode_message_header(metadata, message_type::dictionary_batch);
+            if (message.header.scalar<std::uint8_t>(detail::fb_dictionary_batch::is_delta, 0) != 0)
+            {
+                throw std::runtime_error("Delta dictionary batches are not supported");
+            }
+            const auto id = message.header.scalar<std::int64_t>(detail::fb_dictionary_batch::id, 0);
+            const auto ordinal = dictionaries.ordinals.find(id);
+            if (ordinal == dictionaries.ordinals.end())
+            {
+                throw std::runtime_error("Unknown IPC dictionary id");
+            }
+            if (!allow_replacement && dictionaries.values.contains(id))
+            {
+                throw std::runtime_error("Arrow IPC files cannot replace a dictionary");
+            }
+            const auto data = message.header.table(detail::fb_dictionary_batch::data);
+            if (!data.has_value())
+            {
+                throw std::runtime_error("Invalid IPC dictionary batch");
+            }
+            // Nested dictionaries are numbered after the dictionary that holds them
+            record_batch_decoder decoder(*data, message.version, body, std::move(owner), dictionaries, ordinal->second + 1);
+            const ArrowSchema& field = *dictionaries.fields[ordinal->second].schema;
+            dictionaries.values[id] = std::shared_ptr<const ArrowArray>(
+                decoder.decode_dictionary(*field.dictionary).release(),
+                arrow_array_deleter{}
+            );
+        }
+
+        /******************
+         * Message framing *
+         ******************/
+
+        struct message_span
+        {
+            std::span<const std::uint8_t> metadata;
+            std::span<const std::uint8_t> body;
+        };
+
+        std::size_t body_size(std::span<const std::uint8_t> metadata)
+        {
+            return static_cast<std::size_t>(decode_message_header(metadata).body_length);
+        }
+
+        // Returns std::nullopt at the end of the stream, and advances position past the message.
+        // Messages written before Arrow 0.15 do not start with the continuation marker.
+        std::optional<message_span> parse_message(std::span<const std::uint8_t> data, std::size_t& position)
+        {
+            if (position == data.size())
+            {
+                return std::nullopt;
+            }
+            detail::message_decoder decoder(data.subspan(position));
+            auto metadata_size = decoder.read<std::int32_t>();
+            if (static_cast<std::uint32_t>(metadata_size) == detail::continuation_marker)
+            {
+                metadata_size = decoder.read<std::int32_t>();
+            }
+            if (metadata_size < 0)
+            {
+                throw std::runtime_error("Invalid IPC message metadata size");
+            }
+            if (metadata_size == 0)
+            {
+                position += decoder.position();
+                return std::nullopt;
+            }
+            message_span message;
+            message.metadata = decoder.read_bytes(static_cast<std::size_t>(metadata_size));
+            message.body = decoder.read_bytes(body_size(message.metadata));
+            position += decoder.position();
+            return message;
+        }
+
+        bool is_file_magic(std::span<const std::uint8_t> bytes)
+        {
+            return std::ranges::equal(
+                bytes,
+                detail::file_magic,
+                [](std::uint8_t lhs, char rhs)
+                {
+                    return lhs == static_cast<std::uint8_t>(rhs);
+                }
+            );
+        }
+    }
+
+    /********************************
+     * stream_reader implementation *
+     ********************************/
+
+    stream_reader::stream_reader(std::span<const std::uint8_t> data, std::shared_ptr<const void> owner)
+        : m_data(data)
+        , m_owner(std::move(owner))
+        , m_dictionaries(std::make_shared<detail::dictionary_memo>())
+    {
+        if (auto schema_message = next_message())
+        {
+            m_schema = decode_schema_message(schema_message->metadata, *m_dictionaries);
+        }
+        else
+        {
+            m_done = true;
+        }
+    }
+
+    stream_reader::stream_reader(std::istream& input)
+        : p_input(&input)
+        , m_dictionaries(std::make_shared<detail::dictionary_memo>())
+    {
+        if (auto schema_message = next_message())
+        {
+            m_schema = decode_schema_message(schema_message->metadata, *m_dictionaries);
+        }
+        else
+        {
+            m_done = true;
+        }
+    }
+
+    const ArrowSchema* stream_reader::schema() const noexcept
+    {
+        return m_schema.get();
+    }
+
+    std::optional<record_batch> stream_reader::next()
+    {
+        auto arrow_array = next_arrow_array();
+        if (!arrow_array.has_value())
+        {
+            return std::nullopt;
+        }
+        return record_batch(std::move(*arrow_array), copy_schema(*m_schema));
+    }
+
+    void stream_reader::read_all(arrow_array_stream_proxy& stream)
+    {
+        while (auto arrow_array = next_arrow_array())
+        {
+            stream.push(array(std::move(*arrow_array), copy_schema(*m_schema)));
+        }
+    }
+
+    std::optional<ArrowArray> stream_reader::next_arrow_array()
+    {
+        while (!m_done)
+        {
+            auto batch_message = next_message();
+            if (!batch_message.has_value())
+            {
+                m_done = true;
+                break;
+            }
+            if (decode_message_header(batch_message->metadata).type == message_type::dictionary_batch)
+            {
+                decode_dictionary_message(
+                    *m_dictionaries,
+                    batch_message->metadata,
+                    batch_message->body,
+                    std::move(batch_message->owner),
+                    true
+                );
+                continue;
+            }
+            return decode_record_batch_message(
+                *m_schema,
+                *m_dictionaries,
+                batch_message->metadata,
+                batch_message->body,
+                std::move(batch_message->owner)
+            );
+        }
+        return std::nullopt;
+    }
+
+    auto stream_reader::next_message() -> std::optional<message>
+    {
+        if (p_input != nullptr)
+        {
+            return next_message_from_stream();
+        }
+        auto parsed = parse_message(m_data, m_position);
+        if (!parsed.has_value())
+        {
+            return std::nullopt;
+        }
+        return message{parsed->metadata, parsed->body, m_owner};
+    }
+
+    auto stream_reader::next_message_from_stream() -> std::optional<message>
+    {
+        std::int32_t metadata_size = 0;
+        p_input->read(reinterpret_cast<char*>(&metadata_size), sizeof(metadata_size));
+        if (p_input->gcount() == 0 && p_input->eof())
+        {
+            return std::nullopt;
+        }
+        if (static_cast<std::uint32_t>(metadata_size) == detail::continuation_marker)
+        {
+            p_input->read(reinterpret_cast<char*>(&metadata_size), sizeof(metadata_size));
+        }
+        if (!*p_input)
+        {
+            throw std::runtime_error("Truncated IPC message");
+        }
+        if (metadata_size < 0)
+        {
+            throw std::runtime_error("Invalid IPC message metadata size");
+        }
+        if (metadata_size == 0)
+        {
+            return std::nullopt;
+        }
+        m_metadata.resize(static_cast<std::size_t>(metadata_size));
+        p_input->read(reinterpret_cast<char*>(m_metadata.data()), metadata_size);
+        if (!*p_input)
+        {
+            throw std::runtime_error("Truncated IPC message");
+        }
+        // The body is read in a single block that the arrays of the record batch share
+        auto body = std::make_shared<std::vector<std::uint8_t>>(body_size(m_metadata));
+        p_input->read(reinterpret_cast<char*>(body->data()), static_cast<std::streamsize>(body->size()));
+        if (!*p_input)
+        {
+            throw std::runtime_error("Truncated IPC message");
+        }
+        std::span<const std::uint8_t> body_span(*body);
+        return message{m_metadata, body_span, std::move(body)};
+    }
+
+    /******************************
+     * file_reader implementation *
+     ******************************/
+
+    file_reader::file_reader(std::span<const std::uint8_t> data, std::shared_ptr<const void> owner)
+        : m_data(data)
+        , m_owner(std::move(owner))
+        , m_dictionaries(std::make_shared<detail::dictionary_memo>())
+    {
+        const std::size_t magic_size = detail::file_magic.size();
+        if (data.size() < detail::file_header_size + sizeof(std::int32_t) + magic_size
+            || !is_file_magic(data.first(magic_size)) || !is_file_magic(data.last(magic_size)))
+        {
+            throw std::runtime_error("Invalid IPC file: missing magic");
+        }
+
+        const std::size_t footer_end = data.size() - magic_size - sizeof(std::int32_t);
+        const auto footer_size = detail::message_decoder(data.subspan(footer_end)).read<std::int32_t>();
+        if (footer_size <= 0 || static_cast<std::size_t>(footer_size) > footer_end - detail::file_header_size)
+        {
+            throw std::runtime_error("Invalid IPC file footer size");
+        }
+        const auto footer = flatbuffer_table_view::root(
+            data.subspan(footer_end - static_cast<std::size_t>(footer_size), static_cast<std::size_t>(footer_size))
+        );
+        const auto schema = footer.table(detail::fb_footer::schema);
+        if (!schema.has_value())
+        {
+            throw std::runtime_error("Invalid IPC file: missing schema");
+        }
+        m_schema = decode_schema(*schema, *m_dictionaries);
+
+        // Returns the message at the position given by a Block of the footer
+        auto read_block = [&](const flatbuffer_vector_view& blocks, std::size_t i)
+        {
+            const auto offset = blocks.get<std::int64_t>(i, 0);
+            if (offset < static_cast<std::int64_t>(detail::file_header_size)
+                || static_cast<std::uint64_t>(offset) >= footer_end)
+            {
+                throw std::runtime_error("Invalid IPC file block offset");
+            }
+            return offset;
+        };
+        if (const auto dictionaries = footer.vector(detail::fb_footer::dictionaries, detail::fb_footer::block_size))
+        {
+            for (std::size_t i = 0; i < dictionaries->size(); ++i)
+            {
+                auto position = static_cast<std::size_t>(read_block(*dictionaries, i));
+                const auto message = parse_message(m_data.first(footer_end), position);
+                if (!message.has_value())
+                {
+                    throw std::runtime_error("Invalid IPC file: missing dictionary batch");
+                }
+                decode_dictionary_message(*m_dictionaries, message->metadata, message->body, m_owner, false);
+            }
+        }
+        if (const auto record_batches = footer.vector(detail::fb_footer::record_batches, detail::fb_footer::block_size))
+        {
+            for (std::size_t i = 0; i < record_batches->size(); ++i)
+            {
+                m_record_batch_offsets.push_back(read_block(*record_batches, i));
+            }
+        }
+    }
+
+    const ArrowSchema* file_reader::schema() const noexcept
+    {
+        return m_schema.get();
+    }
+
+    std::size_t file_reader::nb_record_batches() const noexcept
+    {
+        return m_record_batch_offsets.size();
+    }
+
+    record_batch file_reader::read(std::size_t index) const
+    {
+        // Read first, so that the copy of the schema is not leaked if the message is invalid
+        ArrowArray arrow_array = read_arrow_array(index);
+        return record_batch(std::move(arrow_array), copy_schema(*m_schema));
+    }
+
+    void file_reader::read_all(arrow_array_stream_proxy& stream) const
+    {
+        for (std::size_t i = 0; i < nb_record_batches(); ++i)
+        {
+            ArrowArray arrow_array = read_arrow_array(i);
+            stream.push(array(std::move(arrow_array), copy_schema(*m_schema)));
+        }
+    }
+
+    ArrowArray file_reader::read_arrow_array(std::size_t index) const
+    {
+        if (index >= m_record_batch_offsets.size())
+        {
+            throw std::out_of_range("IPC file record batch index out of range");
+        }
+        auto position = static_cast<std::size_t>(m_record_batch_offsets[index]);
+        const std::size_t footer_end = m_data.size() - detail::file_magic.size() - sizeof(std::int32_t);
+        const auto message = parse_message(m_data.first(footer_end), position);
+        if (!message.has_value())
+        {
+            throw std::runtime_error("Invalid IPC file: missing record batch");
+        }
+        return decode_record_batch_message(*m_schema, *m_dictionaries, message->metadata, message->body, m_owner);
+    }
+}
@@ -0,0 +1,1055 @@
+// Copyright 2024 Man Group Operations Limited
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "sparrow/ipc/ipc_writer.hpp"
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <charconv>
+#include <cstring>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <utility>
+
+#include "sparrow/arrow_interface/arrow_array.hpp"
+#include "sparrow/ipc/flatbuffer.hpp"
+#include "sparrow/ipc/ipc_format.hpp"
+#include "sparrow/types/data_type.hpp"
+#include "sparrow/utils/metadata.hpp"
+
+namespace sparrow::ipc
+{
+    static_assert(std::endian::native == std::endian::little, "The IPC format is little-endian");
+
+    namespace
+    {
+        using detail::flatbuffer_table;
+        using detail::fb_type;
+
+        constexpr std::size_t max_nesting_depth = 64;
+
+        // Backs the offsets buffer of empty arrays that do not have one
+        alignas(8) constexpr std::array<std::uint8_t, 8> zero_offset{};
+
+        [[noreturn]] void throw_unsupported_format(std::string_view format)
+        {
+            throw std::invalid_argument("Cannot write the format '" + std::string(format) + "' to Arrow IPC");
+        }
+
+        bool has_flag(const ArrowSchema& schema, ArrowFlag flag)
+        {
+            return (schema.flags & static_cast<std::int64_t>(flag)) != 0;
+        }
+
+        std::int32_t parse_int(std::string_view str, std::string_view format)
+        {
+            std::int32_t value = 0;
+            const auto [ptr, ec] = std::from_chars(str.data(), str.data() + str.size(), value);
+            if (ec != std::errc{} || ptr != str.data() + str.size())
+            {
+                throw_unsupported_format(format);
+            }
+            return value;
+        }
+
+        std::vector<std::int32_t> parse_ints(std::string_view str, std::string_view format)
+        {
+            std::vector<std::int32_t> values;
+            while (!str.empty())
+            {
+                const auto comma = str.find(',');
+                values.push_back(parse_int(str.substr(0, comma), format));
+                str = comma == std::string_view::npos ? std::string_view{} : str.substr(comma + 1);
+            }
+            return values;
+        }
+
+        /******************
+         * Schema encoding *
+         ******************/
+
+        flatbuffer_table int_type(std::int32_t bit_width, bool is_signed)
+        {
+            flatbuffer_table res;
+            res.add_scalar(detail::fb_int::bit_width, bit_width);
+            res.add_scalar(detail::fb_int::is_signed, static_cast<std::uint8_t>(is_signed));
+            return res;
+        }
+
+        flatbuffer_table single_field_type(std::int16_t value)
+        {
+            flatbuffer_table res;
+            res.add_scalar(detail::fb_single_field, value);
+            return res;
+        }
+
+        flatbuffer_table time_type(std::int16_t unit, std::int32_t bit_width)
+        {
+            flatbuffer_table res;
+            res.add_scalar(detail::fb_time::unit, unit);
+            res.add_scalar(detail::fb_time::bit_width, bit_width);
+            return res;
+        }
+
+        flatbuffer_table timestamp_type(std::int16_t unit, std::string_view format)
+        {
+            flatbuffer_table res;
+            res.add_scalar(detail::fb_timestamp::unit, unit);
+            // The format is "ts<unit>:<timezone>"
+            if (const auto timezone = format.substr(4); !timezone.empty())
+            {
+                res.add_string(detail::fb_timestamp::timezone, timezone);
+            }
+            return res;
+        }
+
+        flatbuffer_table decimal_type(std::string_view format)
+        {
+            // The format is "d:<precision>,<scale>[,<bit width>]"
+            const auto values = parse_ints(format.substr(2), format);
+            if (values.size() != 2 && values.size() != 3)
+            {
+                throw_unsupported_format(format);
+            }
+            flatbuffer_table res;
+            res.add_scalar(detail::fb_decimal::precision, values[0]);
+            res.add_scalar(detail::fb_decimal::scale, values[1]);
+            res.add_scalar(detail::fb_decimal::bit_width, values.size() == 3 ? values[2] : std::int32_t(128));
+            return res;
+        }
+
+        flatbuffer_table union_type(std::int16_t mode, std::string_view format)
+        {
+            // The format is "+u<mode>:<type ids>"
+            const auto type_ids = parse_ints(format.substr(4), format);
+            flatbuffer_table res;
+            res.add_scalar(detail::fb_union::mode, mode);
+            res.add_vector(detail::fb_union::type_ids, std::span<const std::int32_t>(type_ids));
+            return res;
+        }
+
+        std::pair<fb_type, flatbuffer_table> encode_type(const ArrowSchema& schema)
+        {
+            const std::string_view format = schema.format;
+            switch (format_to_data_type(format))
+            {
+                case data_type::NA:
+                    if (format != "n")
+                    {
+                        throw_unsupported_format(format);
+                    }
+                    return {fb_type::null, {}};
+                case data_type::BOOL:
+                    return {fb_type::bool_, {}};
+                case data_type::UINT8:
+                    return {fb_type::int_, int_type(8, false)};
+                case data_type::INT8:
+                    return {fb_type::int_, int_type(8, true)};
+                case data_type::UINT16:
+                    return {fb_type::int_, int_type(16, false)};
+                case data_type::INT16:
+                    return {fb_type::int_, int_type(16, true)};
+                case data_type::UINT32:
+                    return {fb_type::int_, int_type(32, false)};
+                case data_type::INT32:
+                    return {fb_type::int_, int_type(32, true)};
+                case data_type::UINT64:
+                    return {fb_type::int_, int_type(64, false)};
+                case data_type::INT64:
+                    return {fb_type::int_, int_type(64, true)};
+                case data_type::HALF_FLOAT:
+                    return {fb_type::floating_point, single_field_type(0)};
+                case data_type::FLOAT:
+                    return {fb_type::floating_point, single_field_type(1)};
+                case data_type::DOUBLE:
+                    return {fb_type::floating_point, single_field_type(2)};
+                case data_type::STRING:
+                    return {fb_type::utf8, {}};
+                case data_type::LARGE_STRING:
+                    return {fb_type::large_utf8, {}};
+                case data_type::BINARY:
+                    return {fb_type::binary, {}};
+                case data_type::LARGE_BINARY:
+                    return {fb_type::large_binary, {}};
+                case data_type::STRING_VIEW:
+                    return {fb_type::utf8_view, {}};
+                case data_type::BINARY_VIEW:
+                    return {fb_type::binary_view, {}};
+                case data_type::LIST:
+                    return {fb_type::list, {}};
+                case data_type::LARGE_LIST:
+                    return {fb_type::large_list, {}};
+                case data_type::LIST_VIEW:
+                    return {fb_type::list_view, {}};
+                case data_type::LARGE_LIST_VIEW:
+                    return {fb_type::large_list_view, {}};
+                case data_type::FIXED_SIZED_LIST:
+                {
+                    flatbuffer_table res;
+                    res.add_scalar(detail::fb_single_field, parse_int(format.substr(3), format));
+                    return {fb_type::fixed_size_list, std::move(res)};
+                }
+                case data_type::STRUCT:
+                    return {fb_type::struct_, {}};
+                case data_type::MAP:
+                {
+                    flatbuffer_table res;
+                    res.add_scalar(
+                        detail::fb_single_field,
+                        static_cast<std::uint8_t>(has_flag(schema, ArrowFlag::MAP_KEYS_SORTED))
+                    );
+                    return {fb_type::map, std::move(res)};
+                }
+                case data_type::DENSE_UNION:
+                    return {fb_type::union_, union_type(1, format)};
+                case data_type::SPARSE_UNION:
+                    return {fb_type::union_, union_type(0, format)};
+                case data_type::RUN_ENCODED:
+                    return {fb_type::run_end_encoded, {}};
+                case data_type::DECIMAL32:
+                case data_type::DECIMAL64:
+                case data_type::DECIMAL128:
+                case data_type::DECIMAL256:
+                    return {fb_type::decimal, decimal_type(format)};
+                case data_type::FIXED_WIDTH_BINARY:
+                {
+                    flatbuffer_table res;
+                    res.add_scalar(detail::fb_single_field, parse_int(format.substr(2), format));
+                    return {fb_type::fixed_size_binary, std::move(res)};
+                }
+                case data_type::DATE_DAYS:
+                    return {fb_type::date, single_field_type(0)};
+                case data_type::DATE_MILLISECONDS:
+                    return {fb_type::date, single_field_type(1)};
+                case data_type::TIMESTAMP_SECONDS:
+                    return {fb_type::timestamp, timestamp_type(0, format)};
+                case data_type::TIMESTAMP_MILLISECONDS:
+                    return {fb_type::timestamp, timestamp_type(1, format)};
+                case data_type::TIMESTAMP_MICROSECONDS:
+                    return {fb_type::timestamp, timestamp_type(2, format)};
+                case data_type::TIMESTAMP_NANOSECONDS:
+                    return {fb_type::timestamp, timestamp_type(3, format)};
+                case data_type::TIME_SECONDS:
+                    return {fb_type::time, time_type(0, 32)};
+                case data_type::TIME_MILLISECONDS:
+                    return {fb_type::time, time_type(1, 32)};
+                case data_type::TIME_MICROSECONDS:
+                    return {fb_type::time, time_type(2, 64)};
+                case data_type::TIME_NANOSECONDS:
+                    return {fb_type::time, time_type(3, 64)};
+                case data_type::DURATION_SECONDS:
+                    return {fb_type::duration, single_field_type(0)};
+                case data_type::DURATION_MILLISECONDS:
+                    return {fb_type::duration, single_field_type(1)};
+                case data_type::DURATION_MICROSECONDS:
+                    return {fb_type::duration, single_field_type(2)};
+                case data_type::DURATION_NANOSECONDS:
+                    return {fb_type::duration, single_field_type(3)};
+                case data_type::INTERVAL_MONTHS:
+                    return {fb_type::interval, single_field_type(0)};
+                case data_type::INTERVAL_DAYS_TIME:
+                    return {fb_type::interval, single_field_type(1)};
+                case data_type::INTERVAL_MONTHS_DAYS_NANOSECONDS:
+                    return {fb_type::interval, single_field_type(2)};
+            }
+            throw_unsupported_format(format);
+        }
+
+        flatbuffer_table encode_index_type(const ArrowSchema& schema)
+        {
+            const auto [type, table] = encode_type(schema);
+            if (type != fb_type::int_)
+            {
+                throw std::invalid_argument("The indices of a dictionary-encoded array must be integers");
+            }
+            return table;
+        }
+
+        std::vector<flatbuffer_table> encode_metadata(const char* metadata)
+        {
+            std::vector<flatbuffer_table> res;
+            if (metadata == nullptr)
+            {
+                return res;
+            }
+            for (const auto& [key, value] : key_value_view(metadata))
+            {
+                flatbuffer_table& pair = res.emplace_back();
+                pair.add_string(detail::fb_key_value::key, key);
+                pair.add_string(detail::fb_key_value::value, value);
+            }
+            return res;
+        }
+
+        // Dictionary ids are given in depth first order, each dictionary before the
+        // dictionaries nested in its values; collect_dictionaries follows the same order.
+        flatbuffer_table encode_field(
+            const ArrowSchema& schema,
+            std::optional<std::string_view> name,
+            std::int64_t& next_dictionary_id,
+            std::size_t depth
+        )
+        {
+            if (depth > max_nesting_depth)
+            {
+                throw std::invalid_argument("The schema is too deeply nested to be written to Arrow IPC");
+            }
+            flatbuffer_table field;
+            if (name.has_value())
+            {
+                field.add_string(detail::fb_field::name, *name);
+            }
+            field.add_scalar(
+                detail::fb_field::nullable,
+                static_cast<std::uint8_t>(has_flag(schema, ArrowFlag::NULLABLE))
+            );
+
+            const ArrowSchema& value_schema = schema.dictionary != nullptr ? *schema.dictionary : schema;
+            if (schema.dictionary != nullptr)
+            {
+                if (value_schema.dictionary != nullptr)
+                {
+                    throw std::invalid_argument("Arrow IPC cannot represent a dictionary of dictionary-encoded values");
+                }
+                flatbuffer_table encoding;
+                encoding.add_scalar(detail::fb_dictionary_encoding::id, next_dictionary_id++);
+                encoding.add_table(detail::fb_dictionary_encoding::index_type, encode_index_type(schema));
+                encoding.add_scalar(
+                    detail::fb_dictionary_encoding::is_ordered,
+                    static_cast<std::uint8_t>(has_flag(schema, ArrowFlag::DICTIONARY_ORDERED))
+                );
+                field.add_table(detail::fb_field::dictionary, std::move(encoding));
+            }
+            auto [type_type, type] = encode_type(value_schema);
+            field.add_scalar(detail::fb_field::type_type, static_cast<std::uint8_t>(type_type));
+            field.add_table(detail::fb_field::type, std::move(type));
+
+            std::vector<flatbuffer_table> children;
+            for (std::int64_t i = 0; i < value_schema.n_children; ++i)
+            {
+                const ArrowSchema& child = *value_schema.children[i];
+                children.push_back(encode_field(
+                    child,
+                    child.name == nullptr ? std::nullopt : std::optional<std::string_view>(child.name),
+                    next_dictionary_id,
+                    depth + 1
+                ));
+            }
+            // Arrow readers require the children, even when there are none
+            field.add_tables(detail::fb_field::children, std::move(children));
+            if (schema.metadata != nullptr)
+            {
+                field.add_tables(detail::fb_field::custom_metadata, encode_metadata(schema.metadata));
+            }
+            return field;
+        }
+
+        std::vector<std::uint8_t> encode_schema(const record_batch& batch)
+        {
+            std::int64_t next_dictionary_id = 0;
+            std::vector<flatbuffer_table> fields;
+            for (std::size_t i = 0; i < batch.nb_columns(); ++i)
+            {
+                const ArrowSchema* schema = get_arrow_schema(batch.get_column(i));
+                fields.push_back(encode_field(*schema, batch.get_column_name(i), next_dictionary_id, 0));
+            }
+            flatbuffer_table schema;
+            schema.add_scalar(detail::fb_schema::endianness, std::int16_t(0));
+            schema.add_tables(detail::fb_schema::fields, std::move(fields));
+            return schema.finish();
+        }
+
+        std::vector<std::uint8_t>
+        encode_message(message_type type, const flatbuffer_table& header, std::int64_t body_length)
+        {
+            flatbuffer_table message;
+            message.add_scalar(detail::fb_message::version, detail::metadata_version);
+            message.add_scalar(detail::fb_message::header_type, static_cast<std::uint8_t>(type));
+            message.add_flatbuffer(detail::fb_message::header, header.finish());
+            message.add_scalar(detail::fb_message::body_length, body_length);
+            return message.finish();
+        }
+
+        std::vector<std::uint8_t> encode_schema_message(std::span<const std::uint8_t> schema)
+        {
+            flatbuffer_table message;
+            message.add_scalar(detail::fb_message::version, detail::metadata_version);
+            message.add_scalar(detail::fb_message::header_type, static_cast<std::uint8_t>(message_type::schema));
+            message.add_flatbuffer(detail::fb_message::header, schema);
+            message.add_scalar(detail::fb_message::body_length, std::int64_t(0));
+            return message.finish();
+        }
+
+        /****************
+         * Body encoding *
+         ****************/
+
+        std::int64_t read_offset(const void* offsets, std::int64_t index, std::size_t offset_size)
+        {
+            const auto* ptr = static_cast<const std::uint8_t*>(offsets) + static_cast<std::size_t>(index) * offset_size;
+            if (offset_size == sizeof(std::int32_t))
+            {
+                std::int32_t value = 0;
+                std::memcpy(&value, ptr, sizeof(value));
+                return value;
+            }
+            std::int64_t value = 0;
+            std::memcpy(&value, ptr, sizeof(value));
+            return value;
+        }
+
+        std::size_t to_size(std::int64_t value)
+        {
+            if (value < 0)
+            {
+                throw std::invalid_argument("Invalid ArrowArray: negative size");
+            }
+            return static_cast<std::size_t>(value);
+        }
+
+        std::span<const std::uint8_t> as_bytes(const std::vector<std::int64_t>& values)
+        {
+            return {reinterpret_cast<const std::uint8_t*>(values.data()), values.size() * sizeof(std::int64_t)};
+        }
+
+        /**
+         * Nodes and buffers of a record batch, in depth first order. Arrow IPC has no
+         * array offset: sliced arrays are written from their first element, by moving
+         * the buffer pointers, and by passing the offset down to the children whose
+         * elements are positional (struct, sparse union and fixed-size list).
+         */
+        class body_builder
+        {
+        public:
+
+            void add_column(const ArrowArray& array, const ArrowSchema& schema)
+            {
+                add(array, schema, array.offset, array.length, 0);
+            }
+
+            [[nodiscard]] std::int64_t body_length() const
+            {
+                std::size_t length = 0;
+                for (const auto& buffer : m_buffers)
+                {
+                    length += detail::padded_size(buffer.size(), detail::buffer_alignment);
+                }
+                return static_cast<std::int64_t>(length);
+            }
+
+            [[nodiscard]] flatbuffer_table record_batch_table(std::int64_t length) const
+            {
+                std::vector<std::int64_t> buffers;
+                std::int64_t offset = 0;
+                for (const auto& buffer : m_buffers)
+                {
+                    buffers.push_back(offset);
+                    buffers.push_back(static_cast<std::int64_t>(buffer.size()));
+                    offset += static_cast<std::int64_t>(detail::padded_size(buffer.size(), detail::buffer_alignment));
+                }
+                flatbuffer_table res;
+                res.add_scalar(detail::fb_record_batch::length, length);
+                res.add_vector(
+                    detail::fb_record_batch::nodes,
+                    as_bytes(m_nodes),
+                    detail::fb_record_batch::node_size,
+                    sizeof(std::int64_t)
+                );
+                res.add_vector(
+                    detail::fb_record_batch::buffers,
+                    as_bytes(buffers),
+                    detail::fb_record_batch::buffer_size,
+                    sizeof(std::int64_t)
+                );
+                if (!m_variadic_buffer_counts.empty())
+                {
+                    res.add_vector(
+                        detail::fb_record_batch::variadic_buffer_counts,
+                        std::span<const std::int64_t>(m_variadic_buffer_counts)
+                    );
+                }
+                return res;
+            }
+
+            [[nodiscard]] const std::vector<std::span<const std::uint8_t>>& buffers() const noexcept
+            {
+                return m_buffers;
+            }
+
+        private:
+
+            void add(const ArrowArray& array, const ArrowSchema& schema, std::int64_t offset, std::int64_t length, std::size_t depth)
+            {
+                if (depth > max_nesting_depth)
+                {
+                    throw std::invalid_argument("The array is too deeply nested to be written to Arrow IPC");
+                }
+                const std::string_view format = schema.format;
+                const data_type dt = format_to_data_type(format);
+                auto buffer = [&array](std::size_t i)
+                {
+                    if (static_cast<std::int64_t>(i) >= array.n_buffers)
+                    {
+                        throw std::invalid_argument("Unexpected number of buffers in ArrowArray");
+                    }
+                    return static_cast<const std::uint8_t*>(array.buffers[i]);
+                };
+                auto child = [&array, &schema](std::int64_t i) -> std::pair<const ArrowArray&, const ArrowSchema&>
+                {
+                    if (i >= array.n_children || i >= schema.n_children)
+                    {
+                        throw std::invalid_argument("Unexpected number of children in ArrowArray");
+                    }
+                    return {*array.children[i], *schema.children[i]};
+                };
+                const auto n = to_size(length);
+                const auto first = to_size(offset);
+
+                switch (dt)
+                {
+                    case data_type::NA:
+                        if (format != "n")
+                        {
+                            throw_unsupported_format(format);
+                        }
+                        m_nodes.insert(m_nodes.end(), {length, length});
+                        return;
+                    case data_type::SPARSE_UNION:
+                    case data_type::DENSE_UNION:
+                    {
+                        m_nodes.insert(m_nodes.end(), {length, 0});
+                        add_buffer(buffer(0) + first, n);
+                        const bool dense = dt == data_type::DENSE_UNION;
+                        if (dense)
+                        {
+                            add_buffer(buffer(1) + first * sizeof(std::int32_t), n * sizeof(std::int32_t));
+                        }
+                        for (std::int64_t i = 0; i < array.n_children; ++i)
+                        {
+                            const auto [child_array, child_schema] = child(i);
+                            if (dense)
+                            {
+                                add(child_array, child_schema, child_array.offset, child_array.length, depth + 1);
+                            }
+                            else
+                            {
+                                add(child_array, child_schema, child_array.offset + offset, length, depth + 1);
+                            }
+                        }
+                        return;
+                    }
+                    case data_type::RUN_ENCODED:
+                    {
+                        if (offset != 0)
+                        {
+                            throw std::invalid_argument("Arrow IPC cannot represent a sliced run-end encoded array");
+                        }
+                        m_nodes.insert(m_nodes.end(), {length, 0});
+                        for (std::int64_t i = 0; i < 2; ++i)
+                        {
+                            const auto [child_array, child_schema] = child(i);
+                            add(child_array, child_schema, child_array.offset, child_array.length, depth + 1);
+                        }
+                        return;
+                    }
+                    default:
+                        break;
+                }
+
+                // The other layouts start with a validity bitmap
+                const std::uint8_t* validity = array.n_buffers > 0 ? buffer(0) : nullptr;
+                std::int64_t null_count = 0;
+                if (validity != nullptr)
+                {
+                    null_count = offset == array.offset && length == array.length && array.null_count >= 0
+                                     ? array.null_count
+                                     : count_nulls(validity, first, n);
+                }
+                m_nodes.insert(m_nodes.end(), {length, null_count});
+                // The bitmap can be omitted when there is no null
+                if (null_count == 0)
+                {
+                    add_buffer(nullptr, 0);
+                }
+                else
+                {
+                    add_bitmap(validity, first, n);
+                }
+
+                if (const auto width = detail::fixed_width(dt, format); width.has_value())
+                {
+                    add_buffer(buffer(1) + first * *width, n * *width);
+                    return;
+                }
+                switch (dt)
+                {
+                    case data_type::BOOL:
+                        add_bitmap(buffer(1), first, n);
+                        return;
+                    case data_type::STRING:
+                    case data_type::BINARY:
+                    case data_type::LARGE_STRING:
+                    case data_type::LARGE_BINARY:
+                    {
+                        const std::size_t offset_size = dt == data_type::STRING || dt == data_type::BINARY
+                                                            ? sizeof(std::int32_t)
+                                                            : sizeof(std::int64_t);
+                        if (add_offsets(buffer(1), first, n, offset_size))
+                        {
+                            // The offsets are kept as they are, the data is written from its start
+                            add_buffer(buffer(2), to_size(read_offset(buffer(1), offset + length, offset_size)));
+                        }
+                        else
+                        {
+                            add_buffer(nullptr, 0);
+                        }
+                        return;
+                    }
+                    case data_type::LIST:
+                    case data_type::LARGE_LIST:
+                    case data_type::MAP:
+                    {
+                        add_offsets(buffer(1), first, n, dt == data_type::LARGE_LIST ? sizeof(std::int64_t) : sizeof(std::int32_t));
+                        const auto [child_array, child_schema] = child(0);
+                        add(child_array, child_schema, child_array.offset, child_array.length, depth + 1);
+                        return;
+                    }
+                    case data_type::LIST_VIEW:
+                    case data_type::LARGE_LIST_VIEW:
+                    {
+                        const std::size_t offset_size = dt == data_type::LIST_VIEW ? sizeof(std::int32_t)
+                                                                                   : sizeof(std::int64_t);
+                        add_buffer(buffer(1) + first * offset_size, n * offset_size);
+                        add_buffer(buffer(2) + first * offset_size, n * offset_size);
+                        const auto [child_array, child_schema] = child(0);
+                        add(child_array, child_schema, child_array.offset, child_array.length, depth + 1);
+                        return;
+                    }
+                    case data_type::FIXED_SIZED_LIST:
+                    {
+                        const std::int64_t list_size = parse_int(format.substr(3), format);
+                        const auto [child_array, child_schema] = child(0);
+                        add(child_array, child_schema, child_array.offset + offset * list_size, length * list_size, depth + 1);
+                        return;
+                    }
+                    case data_type::STRUCT:
+                    {
+                        for (std::int64_t i = 0; i < array.n_children; ++i)
+                        {
+                            const auto [child_array, child_schema] = child(i);
+                            add(child_array, child_schema, child_array.offset + offset, length, depth + 1);
+                        }
+                        return;
+                    }
+                    case data_type::STRING_VIEW:
+                    case data_type::BINARY_VIEW:
+                    {
+                        // The views, the data buffers, then the sizes of the data buffers,
+                        // which Arrow IPC gives through the variadic buffer counts
+                        constexpr std::size_t view_size = 16;
+                        if (array.n_buffers < 3)
+                        {
+                            throw std::invalid_argument("Unexpected number of buffers in ArrowArray");
+                        }
+                        add_buffer(buffer(1) + first * view_size, n * view_size);
+                        const auto n_data_buffers = static_cast<std::size_t>(array.n_buffers - 3);
+                        const std::uint8_t* sizes = buffer(n_data_buffers + 2);
+                        for (std::size_t i = 0; i < n_data_buffers; ++i)
+                        {
+                            add_buffer(buffer(i + 2), to_size(read_offset(sizes, static_cast<std::int64_t>(i), sizeof(std::int64_t))));
+                        }
+                        m_variadic_buffer_counts.push_back(static_cast<std::int64_t>(n_data_buffers));
+                        return;
+                    }
+                    default:
+                        throw_unsupported_format(format);
+                }
+            }
+
+            // Returns false if the array has no offsets buffer, which is allowed when it is empty
+            bool add_offsets(const std::uint8_t* offsets, std::size_t first, std::size_t n, std::size_t offset_size)
+            {
+                if (offsets == nullptr)
+                {
+                    if (n != 0)
+                    {
+                        throw std::invalid_argument("Invalid ArrowArray: missing offsets buffer");
+                    }
+                    add_buffer(zero_offset.data(), offset_size);
+                    return false;
+                }
+                add_buffer(offsets + first * offset_size, (n + 1) * offset_size);
+                return true;
+            }
+
+            void add_buffer(const std::uint8_t* data, std::size_t size)
+            {
+                m_buffers.emplace_back(data, data == nullptr ? 0 : size);
+            }
+
+            // Bitmaps are realigned when the offset is not a multiple of 8
+            void add_bitmap(const std::uint8_t* bitmap, std::size_t first, std::size_t n)
+            {
+                if (bitmap == nullptr)
+                {
+                    add_buffer(nullptr, 0);
+                    return;
+                }
+                const std::size_t n_bytes = (n + 7) / 8;
+                const std::size_t shift = first % 8;
+                if (shift == 0)
+                {
+                    add_buffer(bitmap + first / 8, n_bytes);
+                    return;
+                }
+                auto& copy = m_realigned_bitmaps.emplace_back(n_bytes, std::uint8_t(0));
+                const std::uint8_t* src = bitmap + first / 8;
+                // The source holds ceil((shift + n) / 8) bytes
+                const std::size_t src_bytes = (shift + n + 7) / 8;
+                for (std::size_t i = 0; i < n_bytes; ++i)
+                {
+                    const unsigned low = static_cast<unsigned>(src[i]) >> shift;
+                    const unsigned high = i + 1 < src_bytes ? static_cast<unsigned>(src[i + 1]) << (8 - shift) : 0u;
+                    copy[i] = static_cast<std::uint8_t>(low | high);
+                }
+                add_buffer(copy.data(), n_bytes);
+            }
+
+            static std::int64_t count_nulls(const std::uint8_t* bitmap, std::size_t first, std::size_t n)
+            {
+                std::size_t n_valid = 0;
+                for (std::size_t i = first; i < first + n; ++i)
+                {
+                    n_valid += (bitmap[i / 8] >> (i % 8)) & 1u;
+                }
+                return static_cast<std::int64_t>(n - n_valid);
+            }
+
+            // FieldNode structs: length and null count of each node
+            std::vector<std::int64_t> m_nodes;
+            std::vector<std::span<const std::uint8_t>> m_buffers;
+            std::vector<std::int64_t> m_variadic_buffer_counts;
+            // The vectors move, their data stays in place
+            std::vector<std::vector<std::uint8_t>> m_realigned_bitmaps;
+        };
+
+        struct dictionary_ref
+        {
+            std::int64_t id;
+            const ArrowArray* array;
+            const ArrowSchema* schema;
+        };
+
+        // Same order as encode_field; the nested dictionaries come first, so that they
+        // are known by the reader when it reads the dictionaries that use them.
+        void collect_dictionaries(
+            const ArrowArray& array,
+            const ArrowSchema& schema,
+            std::int64_t& next_dictionary_id,
+            std::vector<dictionary_ref>& dictionaries
+        )
+        {
+            if (schema.dictionary != nullptr)
+            {
+                if (array.dictionary == nullptr)
+                {
+                    throw std::invalid_argument("Invalid ArrowArray: missing dictionary");
+                }
+                const std::int64_t id = next_dictionary_id++;
+                for (std::int64_t i = 0; i < schema.dictionary->n_children; ++i)
+                {
+                    collect_dictionaries(
+                        *array.dictionary->children[i],
+                        *schema.dictionary->children[i],
+                        next_dictionary_id,
+                        dictionaries
+                    );
+                }
+                dictionaries.push_back({id, array.dictionary, schema.dictionary});
+                return;
+            }
+            for (std::int64_t i = 0; i < schema.n_children; ++i)
+            {
+                collect_dictionaries(*array.children[i], *schema.children[i], next_dictionary_id, dictionaries);
+            }
+        }
+
+        // FNV-1a, to detect the dictionaries that did not change since the previous batch
+        std::uint64_t fingerprint(std::uint64_t seed, std::span<const std::uint8_t> bytes)
+        {
+            for (const std::uint8_t byte : bytes)
+            {
+                seed = (seed ^ byte) * 0x100000001b3ULL;
+            }
+            return seed;
+        }
+
+        std::uint64_t fingerprint(const std::vector<std::uint8_t>& metadata, const body_builder& body)
+        {
+            std::uint64_t seed = fingerprint(0xcbf29ce484222325ULL, metadata);
+            for (const auto& buffer : body.buffers())
+            {
+                seed = fingerprint(seed, buffer);
+            }
+            return seed;
+        }
+    }
+
+    /********************************
+     * stream_writer implementation *
+     ********************************/
+
+    stream_writer::stream_writer(std::ostream& output)
+        : p_output(&output)
+    {
+    }
+
+    void stream_writer::write(const record_batch& batch)
+    {
+        if (m_closed)
+        {
+            throw std::runtime_error("Cannot write to a closed IPC writer");
+        }
+        auto schema = encode_schema(batch);
+        if (m_schema.empty())
+        {
+            write_message(encode_schema_message(schema), {});
+            m_schema = std::move(schema);
+        }
+        else if (schema != m_schema)
+        {
+            throw std::invalid_argument("The schema of the record batch differs from the schema of the IPC stream");
+        }
+
+        std::int64_t next_dictionary_id = 0;
+        std::vector<dictionary_ref> dictionaries;
+        body_builder body;
+        for (std::size_t i = 0; i < batch.nb_columns(); ++i)
+        {
+            const auto [arrow_array, arrow_schema] = get_arrow_structures(batch.get_column(i));
+            collect_dictionaries(*arrow_array, *arrow_schema, next_dictionary_id, dictionaries);
+            body.add_column(*arrow_array, *arrow_schema);
+        }
+        m_dictionary_fingerprints.resize(static_cast<std::size_t>(next_dictionary_id), 0);
+
+        for (const dictionary_ref& dictionary : dictionaries)
+        {
+            body_builder dictionary_body;
+            dictionary_body.add_column(*dictionary.array, *dictionary.schema);
+            flatbuffer_table dictionary_batch;
+            dictionary_batch.add_scalar(detail::fb_dictionary_batch::id, dictionary.id);
+            dictionary_batch.add_table(
+                detail::fb_dictionary_batch::data,
+                dictionary_body.record_batch_table(dictionary.array->length)
+            );
+            const auto metadata = encode_message(
+                message_type::dictionary_batch,
+                dictionary_batch,
+                dictionary_body.body_length()
+            );
+
+            // Unchanged dictionaries are not written again
+            auto& previous = m_dictionary_fingerprints[static_cast<std::size_t>(dictionary.id)];
+            const std::uint64_t current = fingerprint(metadata, dictionary_body);
+            if (current == previous)
+            {
+                continue;
+            }
+            if (previous != 0 && m_file)
+            {
+                throw std::invalid_argument("The Arrow IPC file format does not support replacing a dictionary");
+            }
+            previous = current;
+            const block written = write_message(metadata, dictionary_body.buffers());
+            if (m_file)
+            {
+                m_dictionary_blocks.push_back(written);
+            }
+        }
+
+        const auto metadata = encode_message(
+            message_type::record_batch,
+            body.record_batch_table(static_cast<std::int64_t>(batch.nb_rows())),
+            body.body_length()
+        );
+        const block written = write_message(metadata, body.buffers());
+        if (m_file)
+        {
+            m_record_batch_blocks.push_back(written);
+        }
+    }
+
+    void stream_writer::write(arrow_array_stream_proxy& stream)
+    {
+        while (auto ar = stream.pop())
+        {
+            auto [arrow_array, arrow_schema] = extract_arrow_structures(std::move(*ar));
+            write(record_batch(std::move(arrow_array), std::move(arrow_schema)));
+        }
+    }
+
+    void stream_writer::close()
+    {
+        if (m_closed)
+        {
+            return;
+        }
+        const std::array<std::uint32_t, 2> end_of_stream = {detail::continuation_marker, 0};
+        write_bytes(end_of_stream.data(), sizeof(end_of_stream));
+        m_closed = true;
+    }
+
+    bool stream_writer::is_closed() const noexcept
+    {
+        return m_closed;
+    }
+
+    std::size_t stream_writer::written_bytes() const noexcept
+    {
+        return m_written_bytes;
+    }
+
+    void stream_writer::write_bytes(const void* data, std::size_t size)
+    {
+        if (size == 0)
+        {
+            return;
+        }
+        p_output->write(static_cast<const char*>(data), static_cast<std::streamsize>(size));
+        if (!*p_output)
+        {
+            throw std::runtime_error("Failed to write IPC stream");
+        }
+        m_written_bytes += size;
+    }
+
+    void stream_writer::write_padding(std::size_t size)
+    {
+        static constexpr std::array<char, detail::buffer_alignment> zeros{};
+        while (size > 0)
+        {
+            const std::size_t n = std::min(size, zeros.size());
+            write_bytes(zeros.data(), n);
+            size -= n;
+        }
+    }
+
+    // The metadata is padded so that the body starts on an 8-byte boundary
+    auto stream_writer::write_message(
+        const std::vector<std::uint8_t>& metadata,
+        std::span<const std::span<const std::uint8_t>> body
+    ) -> block
+    {
+        const std::size_t prefix_size = 2 * sizeof(std::uint32_t);
+        const std::size_t padded = detail::padded_size(prefix_size + metadata.size(), detail::message_alignment)
+                                   - prefix_size;
+        block res{static_cast<std::int64_t>(m_written_bytes), static_cast<std::int32_t>(prefix_size + padded), 0};
+        const std::uint32_t marker = detail::continuation_marker;
+        const auto size = static_cast<std::int32_t>(padded);
+        write_bytes(&marker, sizeof(marker));
+        write_bytes(&size, sizeof(size));
+        write_bytes(metadata.data(), metadata.size());
+        write_padding(padded - metadata.size());
+        const std::size_t body_start = m_written_bytes;
+        for (const auto& buffer : body)
+        {
+            write_bytes(buffer.data(), buffer.size());
+            write_padding(detail::padded_size(buffer.size(), detail::buffer_alignment) - buffer.size());
+        }
+        res.body_length = static_cast<std::int64_t>(m_written_bytes - body_start);
+        return res;
+    }
+
+    /******************************
+     * file_writer implementation *
+     ******************************/
+
+    file_writer::file_writer(std::ostream& output)
+        : p_output(&output)
+        , m_writer(output)
+    {
+        m_writer.m_file = true;
+        std::array<char, detail::file_header_size> header{};
+        std::ranges::copy(detail::file_magic, header.begin());
+        p_output->write(header.data(), header.size());
+        if (!*p_output)
+        {
+            throw std::runtime_error("Failed to write IPC file");
+        }
+    }
+
+    void file_writer::write(const record_batch& batch)
+    {
+        m_writer.write(batch);
+    }
+
+    void file_writer::write(arrow_array_stream_proxy& stream)
+    {
+        m_writer.write(stream);
+    }
+
+    void file_writer::close()
+    {
+        if (m_writer.is_closed())
+        {
+            return;
+        }
+        m_writer.close();
+
+        auto encode_blocks = [](const std::vector<stream_writer::block>& blocks)
+        {
+            std::vector<std::uint8_t> bytes(blocks.size() * detail::fb_footer::block_size, 0);
+            for (std::size_t i = 0; i < blocks.size(); ++i)
+            {
+                // The offsets of the blocks are relative to the start of the stream
+                const auto offset = static_cast<std::int64_t>(detail::file_header_size) + blocks[i].offset;
+                std::uint8_t* dst = bytes.data() + i * detail::fb_footer::block_size;
+                std::memcpy(dst, &offset, sizeof(offset));
+                std::memcpy(dst + 8, &blocks[i].metadata_length, sizeof(blocks[i].metadata_length));
+                std::memcpy(dst + 16, &blocks[i].body_length, sizeof(blocks[i].body_length));
+            }
+            return bytes;
+        };
+        flatbuffer_table footer;
+        footer.add_scalar(detail::fb_footer::version, detail::metadata_version);
+        if (!m_writer.m_schema.empty())
+        {
+            footer.add_flatbuffer(detail::fb_footer::schema, m_writer.m_schema);
+        }
+        footer.add_vector(
+            detail::fb_footer::dictionaries,
+            encode_blocks(m_writer.m_dictionary_blocks),
+            detail::fb_footer::block_size,
+            sizeof(std::int64_t)
+        );
+        footer.add_vector(
+            detail::fb_footer::record_batches,
+            encode_blocks(m_writer.m_record_batch_blocks),
+            detail::fb_footer::block_size,
+            sizeof(std::int64_t)
+        );
+        const auto bytes = footer.finish();
+        const auto footer_size = static_cast<std::int32_t>(bytes.size());
+        p_output->write(reinterpret_cast<const char*>(bytes.data()), static_cast<std::streamsize>(bytes.size()));
+        p_output->write(reinterpret_cast<const char*>(&footer_size), sizeof(footer_size));
+        p_output->write(detail::file_magic.data(), detail::file_magic.size());
+        if (!*p_output)
+        {
+            throw std::runtime_error("Failed to write IPC file");
+        }
+    }
+}
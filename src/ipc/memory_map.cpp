@@ -0,0 +1,167 @@
+// Copyright 2024 Man Group Operations Limited
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "sparrow/ipc/memory_map.hpp"
+
+#include <stdexcept>
+#include <string>
+
+#if defined(_WIN32)
+#    ifndef NOMINMAX
+#        define NOMINMAX
+#    endif
+#    include <windows.h>
+#else
+#    include <fcntl.h>
+#    include <sys/mman.h>
+#    include <sys/stat.h>
+#    include <unistd.h>
+#endif
+
+namespace sparrow::ipc
+{
+    namespace
+    {
+        [[noreturn]] void throw_map_error(const std::filesystem::path& path, const char* what)
+        {
+            throw std::runtime_error(std::string(what) + " '" + path.string() + "'");
+        }
+    }
+
+    /*****************************
+     * memory_map implementation *
+     *****************************/
+
+#if defined(_WIN32)
+
+    std::shared_ptr<const memory_map> memory_map::open(const std::filesystem::path& path)
+    {
+        std::shared_ptr<memory_map> res(new memory_map());
+        HANDLE file = ::CreateFileW(
+            path.c_str(),
+            GENERIC_READ,
+            FILE_SHARE_READ,
+            nullptr,
+            OPEN_EXISTING,
+            FILE_ATTRIBUTE_NORMAL,
+            nullptr
+        );
+        if (file == INVALID_HANDLE_VALUE)
+        {
+            throw_map_error(path, "Cannot open file");
+        }
+        LARGE_INTEGER size;
+        if (!::GetFileSizeEx(file, &size))
+        {
+            ::CloseHandle(file);
+            throw_map_error(path, "Cannot get the size of file");
+        }
+        if (size.QuadPart == 0)
+        {
+            ::CloseHandle(file);
+            return res;
+        }
+        HANDLE mapping = ::CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        // The mapping keeps a reference on the file
+        ::CloseHandle(file);
+        if (mapping == nullptr)
+        {
+            throw_map_error(path, "Cannot map file");
+        }
+        res->m_mapping_handle = mapping;
+        const void* data = ::MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+        if (data == nullptr)
+        {
+            throw_map_error(path, "Cannot map file");
+        }
+        res->p_data = static_cast<const std::uint8_t*>(data);
+        res->m_size = static_cast<std::size_t>(size.QuadPart);
+        return res;
+    }
+
+    memory_map::~memory_map()
+    {
+        if (p_data != nullptr)
+        {
+            ::UnmapViewOfFile(p_data);
+        }
+        if (m_mapping_handle != nullptr)
+        {
+            ::CloseHandle(m_mapping_handle);
+        }
+    }
+
+#else
+
+    std::shared_ptr<const memory_map> memory_map::open(const std::filesystem::path& path)
+    {
+        std::shared_ptr<memory_map> res(new memory_map());
+        const int fd = ::open(path.c_str(), O_RDONLY);
+        if (fd == -1)
+        {
+            throw_map_error(path, "Cannot open file");
+        }
+        struct stat st;
+        if (::fstat(fd, &st) == -1)
+        {
+            ::close(fd);
+            throw_map_error(path, "Cannot get the size of file");
+        }
+        const auto size = static_cast<std::size_t>(st.st_size);
+        if (size == 0)
+        {
+            ::close(fd);
+            return res;
+        }
+        void* data = ::mmap(nullptr, size, PROT_READ, MAP_SHARED, fd, 0);
+        // The mapping keeps a reference on the file
+        ::close(fd);
+        if (data == MAP_FAILED)
+        {
+            throw_map_error(path, "Cannot map file");
+        }
+        res->p_data = static_cast<const std::uint8_t*>(data);
+        res->m_size = size;
+        return res;
+    }
+
+    memory_map::~memory_map()
+    {
+        if (p_data != nullptr)
+        {
+            ::munmap(const_cast<std::uint8_t*>(p_data), m_size);
+        }
+    }
+
+#endif
+
+    std::span<const std::uint8_t> memory_map::data() const noexcept
+    {
+        return {p_data, m_size};
+    }
+
+    file_reader open_file(const std::filesystem::path& path)
+    {
+        auto map = memory_map::open(path);
+        const auto data = map->data();
+        return file_reader(data, std::move(map));
+    }
+
+    stream_reader open_stream(const std::filesystem::path& path)
+    {
+        auto map = memory_map::open(path);
+        const auto data = map->data();
+        return stream_reader(data, std::move(map));
+    }
+}
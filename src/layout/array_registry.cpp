@@ -14,7 +14,12 @@
 
 #include "sparrow/layout/array_registry.hpp"
 
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <mutex>
 #include <stdexcept>
+#include <string>
 
 namespace sparrow
 {
@@ -39,14 +44,67 @@ namespace sparrow
             }
         }
 
+        // Helper to register a single type using compile-time type information
+        template <data_type DT>
+        void register_type(std::unordered_map<data_type, array_registry::factory_func>& factories)
+        {
+            if constexpr (
+                DT == data_type::TIMESTAMP_SECONDS || DT == data_type::TIMESTAMP_MILLISECONDS
+                || DT == data_type::TIMESTAMP_MICROSECONDS || DT == data_type::TIMESTAMP_NANOSECONDS
+            )
+            {
+                // Special handling for timestamp types with timezone check
+                using types = timestamp_type_map<DT>;
+                factories[DT] = [](arrow_proxy proxy)
+                {
+                    return make_timestamp_wrapper<typename types::with_tz, typename types::without_tz>(
+                        std::move(proxy)
+                    );
+                };
+            }
+            else
+            {
+                // Standard type registration
+                using array_t = array_type_t<DT>;
+                factories[DT] = [](arrow_proxy proxy)
+                {
+                    return make_wrapper_ptr<array_t>(std::move(proxy));
+                };
+            }
+        }
+
+        // Counts a call to array_registry::create in progress for its lifetime
+        class state_reader_guard
+        {
+        public:
+
+            explicit state_reader_guard(std::atomic<std::size_t>& readers) noexcept
+                : m_readers(readers)
+            {
+                m_readers.fetch_add(1, std::memory_order_seq_cst);
+            }
+
+            ~state_reader_guard()
+            {
+                m_readers.fetch_sub(1, std::memory_order_release);
+            }
+
+            state_reader_guard(const state_reader_guard&) = delete;
+            state_reader_guard& operator=(const state_reader_guard&) = delete;
+
+        private:
+
+            std::atomic<std::size_t>& m_readers;
+        };
+
         // Recursive helper to register all types from all_data_types array
         template <std::size_t I = 0>
-        void register_all_types(array_registry& registry)
+        void register_all_types(std::unordered_map<data_type, array_registry::factory_func>& factories)
         {
             if constexpr (I < all_data_types.size())
             {
-                register_type<all_data_types[I]>(registry);
-                register_all_types<I + 1>(registry);
+                register_type<all_data_types[I]>(factories);
+                register_all_types<I + 1>(factories);
             }
         }
     }
@@ -55,7 +113,10 @@ namespace sparrow
     {
         // ===== Register all base types using template metaprogramming =====
         // This iterates over all_data_types array and registers each type automatically
-        detail::register_all_types(*this);
+        auto state = std::make_unique<registry_state>();
+        detail::register_all_types(state->base_factories);
+        m_state.store(state.get(), std::memory_order_release);
+        m_states.push_back(std::move(state));
     }
 
     array_registry& array_registry::instance()
@@ -64,28 +125,91 @@ namespace sparrow
         return reg;
     }
 
+    template <class F>
+    void array_registry::update(F&& f)
+    {
+        std::lock_guard<std::mutex> lock(m_update_mutex);
+        auto state = std::make_unique<registry_state>(*m_state.load(std::memory_order_relaxed));
+        std::forward<F>(f)(*state);
+        m_state.store(state.get(), std::memory_order_seq_cst);
+        // A call to create starting after this load reads the new state, the former
+        // ones are unused if no call is in progress
+        if (m_readers.load(std::memory_order_seq_cst) == 0)
+        {
+            m_states.clear();
+        }
+        m_states.push_back(std::move(state));
+    }
+
     void array_registry::register_base_type(data_type dt, factory_func factory)
     {
-        m_base_factories[dt] = std::move(factory);
+        update(
+            [&](registry_state& state)
+            {
+                state.base_factories[dt] = std::move(factory);
+            }
+        );
     }
 
     void
     array_registry::register_extension(data_type base_type, std::string_view extension_name, factory_func factory)
     {
-        register_extension(
-            base_type,
-            [extension_name](const arrow_proxy& proxy)
+        std::string name(extension_name);
+        auto predicate = [name](const arrow_proxy& proxy)
+        {
+            return has_extension_name(proxy, name);
+        };
+        update(
+            [&](registry_state& state)
             {
-                return has_extension_name(proxy, extension_name);
-            },
-            std::move(factory)
+                extension_set& extensions = state.extensions[base_type];
+                // The first extension registered with a name wins, as with the predicates
+                extensions.by_name.try_emplace(name, extensions.entries.size());
+                extensions.entries.emplace_back(std::move(name), std::move(predicate), std::move(factory));
+            }
         );
     }
 
     void
     array_registry::register_extension(data_type base_type, extension_predicate predicate, factory_func factory)
     {
-        m_extensions[base_type].emplace_back(std::move(predicate), std::move(factory));
+        update(
+            [&](registry_state& state)
+            {
+                extension_set& extensions = state.extensions[base_type];
+                extensions.predicate_entries.push_back(extensions.entries.size());
+                extensions.entries.emplace_back(std::move(predicate), std::move(factory));
+            }
+        );
+    }
+
+    const array_registry::extension_entry*
+    array_registry::extension_set::resolve(const arrow_proxy& proxy) const
+    {
+        std::size_t named = entries.size();
+        if (!by_name.empty())
+        {
+            if (const auto name = get_extension_name(proxy); name.has_value())
+            {
+                if (const auto it = by_name.find(*name); it != by_name.end())
+                {
+                    named = it->second;
+                }
+            }
+        }
+        // Custom predicates registered before the named extension take precedence
+        for (const std::size_t index : predicate_entries)
+        {
+            if (index > named)
+            {
+                break;
+            }
+            if (entries[index].predicate(proxy))
+            {
+                return &entries[index];
+            }
+        }
+        return named < entries.size() ? &entries[named] : nullptr;
     }
 
     bool array_registry::extension_entry::matches(const array_wrapper& wrapper) const
@@ -123,22 +247,21 @@ namespace sparrow
             }
         }
 
-        // Check for extensions first
-        auto ext_it = m_extensions.find(dt);
-        if (ext_it != m_extensions.end())
+        // Check for extensions first; the state must not be released before the factory returns
+        const detail::state_reader_guard guard(m_readers);
+        const registry_state& state = *m_state.load(std::memory_order_seq_cst);
+        auto ext_it = state.extensions.find(dt);
+        if (ext_it != state.extensions.end())
         {
-            for (const auto& entry : ext_it->second)
+            if (const extension_entry* entry = ext_it->second.resolve(proxy); entry != nullptr)
             {
-                if (entry.predicate(proxy))
-                {
-                    return entry.factory(std::move(proxy));
-                }
+                return entry->factory(std::move(proxy));
             }
         }
 
         // Fall back to base type
-        auto base_it = m_base_factories.find(dt);
-        if (base_it != m_base_factories.end())
+        auto base_it = state.base_factories.find(dt);
+        if (base_it != state.base_factories.end())
         {
             return base_it->second(std::move(proxy));
         }
@@ -148,47 +271,21 @@ namespace sparrow
 
     bool array_registry::has_extension_name(const arrow_proxy& proxy, std::string_view extension_name)
     {
-        const std::optional<key_value_view> metadata = proxy.metadata();
-        if (metadata.has_value())
-        {
-            const auto it = metadata->find("ARROW:extension:name");
-            return it != metadata->end() && (*it).second == extension_name;
-        }
-        return false;
+        const std::optional<std::string_view> name = get_extension_name(proxy);
+        return name.has_value() && *name == extension_name;
     }
 
-    // Helper to register a single type using compile-time type information
-    template <data_type DT>
-    void register_type(array_registry& registry)
+    std::optional<std::string_view> array_registry::get_extension_name(const arrow_proxy& proxy)
     {
-        if constexpr (
-            DT == data_type::TIMESTAMP_SECONDS || DT == data_type::TIMESTAMP_MILLISECONDS
-            || DT == data_type::TIMESTAMP_MICROSECONDS || DT == data_type::TIMESTAMP_NANOSECONDS
-        )
-        {
-            // Special handling for timestamp types with timezone check
-            using types = timestamp_type_map<DT>;
-            registry.register_base_type(
-                DT,
-                [](arrow_proxy proxy)
-                {
-                    return detail::make_timestamp_wrapper<typename types::with_tz, typename types::without_tz>(
-                        std::move(proxy)
-                    );
-                }
-            );
-        }
-        else
+        const std::optional<key_value_view> metadata = proxy.metadata();
+        if (metadata.has_value())
         {
-            // Standard type registration
-            using array_t = array_type_t<DT>;
-            registry.register_base_type(
-                DT,
-                [](arrow_proxy proxy)
-                {
-                    return detail::make_wrapper_ptr<array_t>(std::move(proxy));
-                }
-            );
+            const auto it = metadata->find("ARROW:extension:name");
+            if (it != metadata->end())
+            {
+                return (*it).second;
+            }
         }
+        return std::nullopt;
     }
 }
@@ -14,6 +14,13 @@
 
 #include "sparrow/record_batch.hpp"
 
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+
+#include "sparrow/concatenate.hpp"
 #include "sparrow/debug/copy_tracker.hpp"
 #include "sparrow/utils/contracts.hpp"
 
@@ -28,6 +35,15 @@ namespace sparrow
         }
     }
 
+    struct record_batch::lazy_columns
+    {
+        std::function<array(std::size_t)> make_column;
+        std::unique_ptr<std::once_flag[]> imported;
+        std::vector<size_type> sizes;
+        // make_column, and the Arrow structures it owns, are released when this reaches 0
+        std::atomic<std::size_t> nb_pending = 0;
+    };
+
     array* record_batch::get_array_ptr(array_storage_type& storage)
     {
         return std::visit(
@@ -80,42 +96,51 @@ namespace sparrow
         update_array_map_cache();
     }
 
-    record_batch::record_batch(ArrowArray&& arr, ArrowSchema&& sch)
+    record_batch::record_batch(ArrowArray&& arr, ArrowSchema&& sch, const record_batch_import_options& options)
     {
-        partial_init_from_schema(sch);
-
-        std::size_t column_size = m_name_list.capacity();
-        for (std::size_t i = 0; i < column_size; ++i)
-        {
-            m_name_list.emplace_back(sch.children[i]->name);
-            m_array_list.emplace_back(array(std::move(*(arr.children[i])), std::move(*(sch.children[i]))));
-            *(arr.children[i]) = make_empty_arrow_array();
-            *(sch.children[i]) = make_empty_arrow_schema();
-        }
-        arr.release(&arr);
-        sch.release(&sch);
-
-        update_array_map_cache();
+        // The structures are released once all their columns are imported
+        std::shared_ptr<ArrowArray> owned_arr(new ArrowArray(move_array(std::move(arr))), arrow_array_deleter{});
+        std::shared_ptr<ArrowSchema> owned_sch(
+            new ArrowSchema(move_schema(std::move(sch))),
+            arrow_schema_deleter{}
+        );
+        // The names are read before the children of the schema are moved
+        import_columns(
+            *owned_arr,
+            *owned_sch,
+            [owned_arr, owned_sch](std::size_t i)
+            {
+                array col(std::move(*(owned_arr->children[i])), std::move(*(owned_sch->children[i])));
+                *(owned_arr->children[i]) = make_empty_arrow_array();
+                *(owned_sch->children[i]) = make_empty_arrow_schema();
+                return col;
+            },
+            options
+        );
     }
 
-    record_batch::record_batch(ArrowArray&& arr, ArrowSchema* sch)
+    record_batch::record_batch(ArrowArray&& arr, ArrowSchema* sch, const record_batch_import_options& options)
     {
-        init(std::move(arr), sch);
+        init(std::move(arr), sch, options);
     }
 
-    record_batch::record_batch(ArrowArray&& arr, const ArrowSchema* sch)
+    record_batch::record_batch(ArrowArray&& arr, const ArrowSchema* sch, const record_batch_import_options& options)
     {
-        init(std::move(arr), sch);
+        init(std::move(arr), sch, options);
     }
 
-    record_batch::record_batch(ArrowArray* arr, ArrowSchema* sch)
+    record_batch::record_batch(ArrowArray* arr, ArrowSchema* sch, const record_batch_import_options& options)
     {
-        init(arr, sch);
+        init(arr, sch, options);
     }
 
-    record_batch::record_batch(const ArrowArray* arr, const ArrowSchema* sch)
+    record_batch::record_batch(
+        const ArrowArray* arr,
+        const ArrowSchema* sch,
+        const record_batch_import_options& options
+    )
     {
-        init(arr, sch);
+        init(arr, sch, options);
     }
 
     record_batch::record_batch(struct_array&& arr)
@@ -139,17 +164,20 @@ namespace sparrow
     }
 
     record_batch::record_batch(const record_batch& rhs)
-        : m_name_list(rhs.m_name_list)
-        , m_array_list(rhs.m_array_list)
     {
+        rhs.materialize_all();
+        m_name_list = rhs.m_name_list;
+        m_array_list = rhs.m_array_list;
         update_array_map_cache();
         copy_tracker::increase(copy_tracker::key<record_batch>());
     }
 
     record_batch& record_batch::operator=(const record_batch& rhs)
     {
+        rhs.materialize_all();
         m_name_list = rhs.m_name_list;
         m_array_list = rhs.m_array_list;
+        m_lazy.reset();
         update_array_map_cache();
         return *this;
     }
@@ -161,7 +189,7 @@ namespace sparrow
 
     auto record_batch::nb_rows() const -> size_type
     {
-        return m_array_list.empty() ? size_type(0) : get_array_ptr(m_array_list.front())->size();
+        return m_array_list.empty() ? size_type(0) : column_size(0);
     }
 
     bool record_batch::contains_column(const name_type& name) const
@@ -189,18 +217,20 @@ namespace sparrow
         {
             throw std::out_of_range("Column's name not found in record batch");
         }
-        return *(iter->second);
+        return get_column(iter->second);
     }
 
     array& record_batch::get_column(size_type index)
     {
         SPARROW_ASSERT_TRUE(index < nb_columns());
+        materialize(index);
         return *get_array_ptr(m_array_list[index]);
     }
 
     const array& record_batch::get_column(size_type index) const
     {
         SPARROW_ASSERT_TRUE(index < nb_columns());
+        materialize(index);
         return *get_array_ptr(m_array_list[index]);
     }
 
@@ -214,8 +244,33 @@ namespace sparrow
         return std::ranges::ref_view(m_name_list);
     }
 
+    record_batch record_batch::slice(size_type start, size_type end) const
+    {
+        SPARROW_ASSERT_TRUE(start <= end);
+        SPARROW_ASSERT_TRUE(end <= nb_rows());
+        return transform_columns(
+            [start, end](const array& column)
+            {
+                return column.slice(start, end);
+            }
+        );
+    }
+
+    record_batch record_batch::slice_view(size_type start, size_type end) const
+    {
+        SPARROW_ASSERT_TRUE(start <= end);
+        SPARROW_ASSERT_TRUE(end <= nb_rows());
+        return transform_columns(
+            [start, end](const array& column)
+            {
+                return column.slice_view(start, end);
+            }
+        );
+    }
+
     struct_array record_batch::extract_struct_array()
     {
+        materialize_all();
         std::vector<array> owned_arrays;
         owned_arrays.reserve(m_array_list.size());
 
@@ -240,6 +295,7 @@ namespace sparrow
         m_array_map.clear();
         m_array_list.clear();
         m_name_list.clear();
+        m_lazy.reset();
 
         return struct_array(std::move(owned_arrays), false, m_name, std::move(m_metadata));
     }
@@ -292,6 +348,66 @@ namespace sparrow
         m_array_list.reserve(column_size);
     }
 
+    void record_batch::import_columns(
+        const ArrowArray& arr,
+        const ArrowSchema& sch,
+        std::function<array(std::size_t)> make_column,
+        const record_batch_import_options& options
+    )
+    {
+        partial_init_from_schema(sch);
+        const std::size_t column_size = static_cast<std::size_t>(sch.n_children);
+        for (std::size_t i = 0; i < column_size; ++i)
+        {
+            m_name_list.emplace_back(sch.children[i]->name);
+        }
+
+        if (options.lazy)
+        {
+            auto lazy = std::make_shared<lazy_columns>();
+            lazy->make_column = std::move(make_column);
+            lazy->imported = std::make_unique<std::once_flag[]>(column_size);
+            lazy->sizes.reserve(column_size);
+            lazy->nb_pending = column_size;
+            for (std::size_t i = 0; i < column_size; ++i)
+            {
+                lazy->sizes.push_back(static_cast<size_type>(arr.children[i]->length));
+            }
+            m_array_list.resize(column_size);
+            m_lazy = std::move(lazy);
+            update_array_map_cache();
+            return;
+        }
+
+        const std::size_t min_columns_per_thread = std::max(options.min_columns_per_thread, std::size_t(1));
+        const std::size_t num_threads = std::min(
+            resolve_num_threads(options.num_threads),
+            std::max(column_size / min_columns_per_thread, std::size_t(1))
+        );
+        if (num_threads == 1)
+        {
+            for (std::size_t i = 0; i < column_size; ++i)
+            {
+                m_array_list.emplace_back(make_column(i));
+            }
+        }
+        else
+        {
+            // Each thread assigns its own slots, so that the columns keep
+            // the order of the children whatever the scheduling.
+            m_array_list.resize(column_size);
+            parallel_for(
+                column_size,
+                num_threads,
+                [this, &make_column](std::size_t i)
+                {
+                    std::get<array>(m_array_list[i]) = make_column(i);
+                }
+            );
+        }
+        update_array_map_cache();
+    }
+
     void record_batch::update_array_map_cache() const
     {
         if (!m_dirty_map)
@@ -305,8 +421,7 @@ namespace sparrow
         for (std::size_t i = m_name_list.size(); i != 0; --i)
         {
             const auto& name = m_name_list[i - 1];
-            array* ar = const_cast<array*>(get_array_ptr(m_array_list[i - 1]));
-            if (!m_array_map.try_emplace(name, ar).second)
+            if (!m_array_map.try_emplace(name, i - 1).second)
             {
                 break;
             }
@@ -315,6 +430,45 @@ namespace sparrow
         check_consistency();
     }
 
+    void record_batch::materialize(size_type index) const
+    {
+        if (m_lazy != nullptr && index < m_lazy->sizes.size())
+        {
+            std::call_once(
+                m_lazy->imported[index],
+                [this, index]
+                {
+                    std::get<array>(m_array_list[index]) = m_lazy->make_column(index);
+                    // Every other column has returned from make_column, nothing calls it anymore
+                    if (m_lazy->nb_pending.fetch_sub(1, std::memory_order_acq_rel) == 1)
+                    {
+                        m_lazy->make_column = nullptr;
+                    }
+                }
+            );
+        }
+    }
+
+    void record_batch::materialize_all() const
+    {
+        if (m_lazy != nullptr)
+        {
+            for (size_type i = 0; i < m_lazy->sizes.size(); ++i)
+            {
+                materialize(i);
+            }
+        }
+    }
+
+    auto record_batch::column_size(size_type index) const -> size_type
+    {
+        if (m_lazy != nullptr && index < m_lazy->sizes.size())
+        {
+            return m_lazy->sizes[index];
+        }
+        return get_array_ptr(m_array_list[index])->size();
+    }
+
     void record_batch::check_consistency() const
     {
         SPARROW_ASSERT(
@@ -327,10 +481,10 @@ namespace sparrow
 
         if (!m_array_list.empty())
         {
-            const size_type size = get_array_ptr(m_array_list[0])->size();
+            const size_type size = column_size(0);
             for (size_type i = 1u; i < m_array_list.size(); ++i)
             {
-                const size_type current_size = get_array_ptr(m_array_list[i])->size();
+                const size_type current_size = column_size(i);
                 const bool same_size = current_size == size;
 
                 if (!same_size)
@@ -346,7 +500,28 @@ namespace sparrow
 
     bool operator==(const record_batch& lhs, const record_batch& rhs)
     {
-        return std::ranges::equal(lhs.names(), rhs.names()) && std::ranges::equal(lhs.columns(), rhs.columns());
+        return !first_difference(lhs, rhs).has_value();
+    }
+
+    std::optional<record_batch_difference> first_difference(const record_batch& lhs, const record_batch& rhs)
+    {
+        const std::size_t nb_columns = std::min(lhs.nb_columns(), rhs.nb_columns());
+        for (std::size_t i = 0; i < nb_columns; ++i)
+        {
+            if (lhs.get_column_name(i) != rhs.get_column_name(i))
+            {
+                return record_batch_difference{i, 0};
+            }
+            if (const auto row = first_difference(lhs.get_column(i), rhs.get_column(i)))
+            {
+                return record_batch_difference{i, *row};
+            }
+        }
+        if (lhs.nb_columns() != rhs.nb_columns())
+        {
+            return record_batch_difference{nb_columns, 0};
+        }
+        return std::nullopt;
     }
 
     std::pair<ArrowArray, ArrowSchema> extract_arrow_structures(sparrow::record_batch&& rb)
@@ -355,4 +530,33 @@ namespace sparrow
         arrow_proxy& proxy = detail::array_access::get_arrow_proxy(sa);
         return std::make_pair(proxy.extract_array(), proxy.extract_schema());
     }
+
+    record_batch concatenate(std::span<const record_batch* const> batches)
+    {
+        if (batches.empty())
+        {
+            throw std::invalid_argument("concatenate: at least one record batch is required");
+        }
+        const record_batch& first = *batches.front();
+        for (const record_batch* rb : batches)
+        {
+            if (rb->m_name_list != first.m_name_list)
+            {
+                throw std::invalid_argument("concatenate: the record batches must have the same columns");
+            }
+        }
+
+        std::vector<array> columns;
+        columns.reserve(first.nb_columns());
+        std::vector<const arrow_proxy*> proxies(batches.size());
+        for (std::size_t column_index = 0; column_index < first.nb_columns(); ++column_index)
+        {
+            for (std::size_t i = 0; i < batches.size(); ++i)
+            {
+                proxies[i] = &detail::array_access::get_arrow_proxy(batches[i]->get_column(column_index));
+            }
+            columns.emplace_back(detail::concatenate_proxies(proxies));
+        }
+        return record_batch(first.m_name_list, std::move(columns), first.m_name, first.m_metadata);
+    }
 }
@@ -14,7 +14,11 @@
 
 #include "sparrow/run_end_encoded_array.hpp"
 
+#include <algorithm>
+#include <cstring>
 #include <limits>
+#include <memory>
+#include <optional>
 #include <stdexcept>
 #include <utility>
 
@@ -23,6 +27,8 @@
 #include "sparrow/layout/array_helper.hpp"
 #include "sparrow/layout/array_registry.hpp"
 #include "sparrow/primitive_array.hpp"
+#include "sparrow/u8_buffer.hpp"
+#include "sparrow/variable_size_binary_array.hpp"
 
 namespace
 {
@@ -268,6 +274,222 @@ namespace sparrow
         }
     }
 
+    namespace
+    {
+        /**
+         * Returns the index of the run containing \c logical_index, searching from the
+         * run \c cursor: the search range is doubled until it contains the run, and is
+         * then binary searched. The cost is logarithmic in the distance to \c cursor
+         * instead of in the number of runs.
+         */
+        template <class ACC_LENGTH_TYPE>
+        auto gallop_run_index(
+            const ACC_LENGTH_TYPE* acc_length_data,
+            std::size_t run_count,
+            std::size_t cursor,
+            std::uint64_t logical_index
+        ) -> std::size_t
+        {
+            const auto ends_after = [acc_length_data, logical_index](std::size_t run_index)
+            {
+                return static_cast<std::uint64_t>(acc_length_data[run_index]) > logical_index;
+            };
+
+            // The searched run is in (first, last]
+            std::size_t first = 0;
+            std::size_t last = 0;
+            if (ends_after(cursor))
+            {
+                last = cursor;
+                std::size_t step = 1;
+                while (step <= last && ends_after(last - step))
+                {
+                    last -= step;
+                    step *= 2;
+                }
+                if (step > last)
+                {
+                    return static_cast<std::size_t>(
+                        std::distance(
+                            acc_length_data,
+                            std::upper_bound(acc_length_data, acc_length_data + last + 1, logical_index)
+                        )
+                    );
+                }
+                first = last - step;
+            }
+            else
+            {
+                first = cursor;
+                std::size_t step = 1;
+                while (first + step < run_count && !ends_after(first + step))
+                {
+                    first += step;
+                    step *= 2;
+                }
+                last = std::min(first + step, run_count - 1);
+            }
+            const auto it = std::upper_bound(acc_length_data + first + 1, acc_length_data + last + 1, logical_index);
+            return static_cast<std::size_t>(std::distance(acc_length_data, it));
+        }
+
+        void clear_validity_bits(std::uint8_t* bits, std::size_t first, std::size_t last)
+        {
+            for (; first < last && first % 8 != 0; ++first)
+            {
+                bits[first / 8] &= static_cast<std::uint8_t>(~(1u << (first % 8)));
+            }
+            const std::size_t full_bytes_end = first + (last - first) / 8 * 8;
+            std::fill(bits + first / 8, bits + full_bytes_end / 8, std::uint8_t(0));
+            for (first = full_bytes_end; first < last; ++first)
+            {
+                bits[first / 8] &= static_cast<std::uint8_t>(~(1u << (first % 8)));
+            }
+        }
+
+        /**
+         * Calls \c write_run(run_index, first, last) for each run of the first \c length
+         * logical elements, and returns the validity bitmap of the decoded elements, or
+         * an empty optional if all the runs are valid.
+         */
+        template <class ACC_LENGTH_TYPE, class WRITE_FUNC, class HAS_VALUE_FUNC>
+        auto decode_runs(
+            const ACC_LENGTH_TYPE* acc_length_data,
+            std::size_t run_count,
+            std::size_t length,
+            WRITE_FUNC write_run,
+            HAS_VALUE_FUNC has_value
+        ) -> std::optional<validity_bitmap>
+        {
+            std::optional<buffer<std::uint8_t>> validity;
+            std::size_t first = 0;
+            for (std::size_t run_index = 0; run_index < run_count && first < length; ++run_index)
+            {
+                const std::size_t last = std::min(static_cast<std::size_t>(acc_length_data[run_index]), length);
+                if (last <= first)
+                {
+                    continue;
+                }
+                write_run(run_index, first, last);
+                if (!has_value(run_index))
+                {
+                    if (!validity.has_value())
+                    {
+                        validity.emplace((length + 7) / 8, std::uint8_t(0xFF), validity_bitmap::default_allocator());
+                    }
+                    clear_validity_bits(validity->data(), first, last);
+                }
+                first = last;
+            }
+            if (!validity.has_value())
+            {
+                return std::nullopt;
+            }
+            return validity_bitmap(std::move(*validity), length, 0);
+        }
+
+        template <class T>
+        concept decodable_primitive_array = is_primitive_array_v<T>
+                                            && std::same_as<T, primitive_array<typename T::inner_value_type>>
+                                            && !std::same_as<typename T::inner_value_type, bool>;
+
+        template <class T>
+        concept decodable_binary_array = std::same_as<T, string_array> || std::same_as<T, big_string_array>
+                                         || std::same_as<T, binary_array> || std::same_as<T, big_binary_array>;
+
+        template <decodable_primitive_array ARRAY, class ACC_LENGTH_TYPE>
+        auto decode_primitive(
+            const ARRAY& encoded_values,
+            const ACC_LENGTH_TYPE* acc_length_data,
+            std::size_t run_count,
+            std::size_t length
+        ) -> array
+        {
+            using value_type = typename ARRAY::inner_value_type;
+            u8_buffer<value_type> data(length);
+            value_type* out = data.data();
+            const value_type* encoded_data = std::to_address(encoded_values.values().begin());
+            auto validity = decode_runs(
+                acc_length_data,
+                run_count,
+                length,
+                [out, encoded_data](std::size_t run_index, std::size_t first, std::size_t last)
+                {
+                    std::fill(out + first, out + last, encoded_data[run_index]);
+                },
+                [&encoded_values](std::size_t run_index)
+                {
+                    return encoded_values[run_index].has_value();
+                }
+            );
+            if (validity.has_value())
+            {
+                return array(ARRAY(std::move(data), length, std::move(*validity)));
+            }
+            return array(ARRAY(std::move(data), length, true));
+        }
+
+        template <decodable_binary_array ARRAY, class ACC_LENGTH_TYPE>
+        auto decode_binary(
+            const ARRAY& encoded_values,
+            const ACC_LENGTH_TYPE* acc_length_data,
+            std::size_t run_count,
+            std::size_t length
+        ) -> array
+        {
+            using offset_type = std::remove_const_t<typename ARRAY::offset_type>;
+
+            // First pass to compute the size of the data buffer
+            std::size_t byte_count = 0;
+            std::size_t first = 0;
+            for (std::size_t run_index = 0; run_index < run_count && first < length; ++run_index)
+            {
+                const std::size_t last = std::min(static_cast<std::size_t>(acc_length_data[run_index]), length);
+                if (last > first)
+                {
+                    byte_count += (last - first) * std::ranges::size(encoded_values[run_index].get());
+                    first = last;
+                }
+            }
+            SPARROW_ASSERT_TRUE(std::in_range<offset_type>(byte_count));
+
+            u8_buffer<std::uint8_t> data(byte_count);
+            u8_buffer<offset_type> offsets(length + 1);
+            std::uint8_t* data_out = data.data();
+            offset_type* offsets_out = offsets.data();
+            offsets_out[0] = 0;
+            std::size_t byte_offset = 0;
+            auto validity = decode_runs(
+                acc_length_data,
+                run_count,
+                length,
+                [&](std::size_t run_index, std::size_t run_first, std::size_t run_last)
+                {
+                    const auto value = encoded_values[run_index].get();
+                    const std::size_t value_size = std::ranges::size(value);
+                    for (std::size_t i = run_first; i < run_last; ++i)
+                    {
+                        if (value_size != 0)
+                        {
+                            std::memcpy(data_out + byte_offset, std::ranges::data(value), value_size);
+                        }
+                        byte_offset += value_size;
+                        offsets_out[i + 1] = static_cast<offset_type>(byte_offset);
+                    }
+                },
+                [&encoded_values](std::size_t run_index)
+                {
+                    return encoded_values[run_index].has_value();
+                }
+            );
+            if (validity.has_value())
+            {
+                return array(ARRAY(std::move(data), std::move(offsets), std::move(*validity)));
+            }
+            return array(ARRAY(std::move(data), std::move(offsets)));
+        }
+    }
+
     namespace copy_tracker
     {
         template <>
@@ -584,20 +806,119 @@ namespace sparrow
     auto run_end_encoded_array::find_run_index(std::uint64_t logical_index) const -> size_type
     {
         SPARROW_ASSERT_TRUE(logical_index < size());
+        size_type first = 0;
+        size_type last = m_encoded_length;
+        if (!m_run_end_samples.empty())
+        {
+            const auto block_it = std::upper_bound(
+                m_run_end_samples.cbegin(),
+                m_run_end_samples.cend(),
+                logical_index
+            );
+            first = static_cast<size_type>(std::distance(m_run_end_samples.cbegin(), block_it))
+                    * run_end_sample_stride;
+            last = std::min(first + run_end_sample_stride, m_encoded_length);
+        }
         return visit(
-            [logical_index, this](const auto& acc_lengths_ptr) -> size_type
+            [logical_index, first, last](const auto& acc_lengths_ptr) -> size_type
             {
-                const auto it = std::upper_bound(
-                    acc_lengths_ptr,
-                    acc_lengths_ptr + this->m_encoded_length,
-                    logical_index
-                );
+                const auto it = std::upper_bound(acc_lengths_ptr + first, acc_lengths_ptr + last, logical_index);
                 return static_cast<size_type>(std::distance(acc_lengths_ptr, it));
             },
             m_acc_lengths
         );
     }
 
+    auto run_end_encoded_array::find_run_indices(std::span<const size_type> indices) const
+        -> std::vector<size_type>
+    {
+        std::vector<size_type> run_indices(indices.size());
+        if (indices.empty())
+        {
+            return run_indices;
+        }
+        visit(
+            [&indices, &run_indices, this](const auto& acc_lengths_ptr)
+            {
+                size_type cursor = find_run_index(indices.front());
+                for (size_type i = 0; i < indices.size(); ++i)
+                {
+                    SPARROW_ASSERT_TRUE(indices[i] < size());
+                    cursor = gallop_run_index(acc_lengths_ptr, m_encoded_length, cursor, indices[i]);
+                    run_indices[i] = cursor;
+                }
+            },
+            m_acc_lengths
+        );
+        return run_indices;
+    }
+
+    auto run_end_encoded_array::take(std::span<const size_type> indices) const
+        -> std::vector<array_traits::const_reference>
+    {
+        const std::vector<size_type> run_indices = find_run_indices(indices);
+        std::vector<array_traits::const_reference> values;
+        values.reserve(run_indices.size());
+        for (size_type i = 0; i < run_indices.size(); ++i)
+        {
+            if (i != 0 && run_indices[i] == run_indices[i - 1])
+            {
+                values.push_back(values.back());
+            }
+            else
+            {
+                values.push_back(encoded_value(run_indices[i]));
+            }
+        }
+        return values;
+    }
+
+    array run_end_encoded_array::decode() const
+    {
+        const size_type length = size();
+        return visit(
+            [this, length](const auto& acc_lengths_ptr) -> array
+            {
+                return p_encoded_values_array.visit(
+                    [this, length, acc_lengths_ptr](const auto& encoded_values) -> array
+                    {
+                        using encoded_values_type = std::decay_t<decltype(encoded_values)>;
+                        if constexpr (decodable_primitive_array<encoded_values_type>)
+                        {
+                            return decode_primitive(encoded_values, acc_lengths_ptr, m_encoded_length, length);
+                        }
+                        else if constexpr (decodable_binary_array<encoded_values_type>)
+                        {
+                            return decode_binary(encoded_values, acc_lengths_ptr, m_encoded_length, length);
+                        }
+                        else
+                        {
+                            throw std::invalid_argument(
+                                "run_end_encoded_array::decode: encoded values type not supported"
+                            );
+                        }
+                    }
+                );
+            },
+            m_acc_lengths
+        );
+    }
+
+    void run_end_encoded_array::build_run_end_samples()
+    {
+        m_run_end_samples.clear();
+        if (m_encoded_length < run_end_samples_min_runs)
+        {
+            return;
+        }
+        const size_type block_count = m_encoded_length / run_end_sample_stride;
+        m_run_end_samples.reserve(block_count);
+        for (size_type block = 0; block < block_count; ++block)
+        {
+            m_run_end_samples.push_back(get_acc_length((block + 1) * run_end_sample_stride - 1));
+        }
+    }
+
     auto run_end_encoded_array::run_start(size_type run_index) const -> std::uint64_t
     {
         return run_index == 0 ? 0 : get_acc_length(run_index - 1);
@@ -647,6 +968,7 @@ namespace sparrow
         p_acc_lengths_array = array(m_proxy.children()[0].view());
         p_encoded_values_array = array(m_proxy.children()[1].view());
         m_acc_lengths = run_end_encoded_array::get_acc_lengths_ptr(p_acc_lengths_array);
+        build_run_end_samples();
     }
 
     void run_end_encoded_array::insert_acc_length(size_type pos, std::uint64_t value)
@@ -921,6 +1243,7 @@ namespace sparrow
     {
         m_encoded_length = detail::array_access::get_arrow_proxy(p_acc_lengths_array).length();
         m_acc_lengths = run_end_encoded_array::get_acc_lengths_ptr(p_acc_lengths_array);
+        build_run_end_samples();
         m_proxy.set_length(
             m_encoded_length == 0 ? 0 : static_cast<size_type>(get_acc_length(m_encoded_length - 1))
         );
@@ -0,0 +1,88 @@
+// Copyright 2024 Man Group Operations Limited
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "sparrow/utils/parallel.hpp"
+
+#include <algorithm>
+#include <exception>
+#include <thread>
+#include <vector>
+
+namespace sparrow
+{
+    std::size_t resolve_num_threads(std::size_t num_threads) noexcept
+    {
+        if (num_threads == 0)
+        {
+            num_threads = std::thread::hardware_concurrency();
+        }
+        return std::max(num_threads, std::size_t(1));
+    }
+
+    void parallel_for(std::size_t count, std::size_t num_threads, const std::function<void(std::size_t)>& f)
+    {
+        const std::size_t nb_ranges = std::min(resolve_num_threads(num_threads), count);
+        if (nb_ranges <= 1)
+        {
+            for (std::size_t i = 0; i < count; ++i)
+            {
+                f(i);
+            }
+            return;
+        }
+
+        std::vector<std::exception_ptr> errors(nb_ranges);
+        auto process_range = [&](std::size_t range)
+        {
+            // The first count % nb_ranges ranges get one more index
+            const std::size_t base_size = count / nb_ranges;
+            const std::size_t remainder = count % nb_ranges;
+            const std::size_t begin = range * base_size + std::min(range, remainder);
+            const std::size_t end = begin + base_size + (range < remainder ? 1 : 0);
+            try
+            {
+                for (std::size_t i = begin; i < end; ++i)
+                {
+                    f(i);
+                }
+            }
+            catch (...)
+            {
+                errors[range] = std::current_exception();
+            }
+        };
+
+        {
+            std::vector<std::jthread> workers;
+            workers.reserve(nb_ranges - 1);
+            for (std::size_t range = 1; range < nb_ranges; ++range)
+            {
+                workers.emplace_back(process_range, range);
+            }
+            process_range(0);
+        }
+
+        const auto error = std::ranges::find_if(
+            errors,
+            [](const std::exception_ptr& e)
+            {
+                return e != nullptr;
+            }
+        );
+        if (error != errors.end())
+        {
+            std::rethrow_exception(*error);
+        }
+    }
+}
@@ -12,12 +12,19 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include <cstdint>
 #include <memory>
 #include <memory_resource>
 #include <numeric>
+#include <string>
+#include <thread>
 #include <vector>
 
 #include "sparrow/buffer/allocator.hpp"
+#include "sparrow/buffer/buffer.hpp"
+#include "sparrow/buffer/tracking_allocator.hpp"
+#include "sparrow/primitive_array.hpp"
+#include "sparrow/variable_size_binary_array.hpp"
 
 #include "doctest/doctest.h"
 
@@ -83,11 +90,150 @@ TEST_SUITE("any_allocator")
     // to an exception at runtime.
     TEST_CASE_TEMPLATE_INVOKE(
         value_semantic_id,
-        std::allocator<int> /*, std::pmr::polymorphic_allocator<int>*/
+        std::allocator<int>,
+        sparrow::tracking_allocator<int> /*, std::pmr::polymorphic_allocator<int>*/
+    );
+    TEST_CASE_TEMPLATE_INVOKE(
+        allocate_id,
+        std::allocator<int>,
+        sparrow::tracking_allocator<int> /*, std::pmr::polymorphic_allocator<int>*/
     );
-    TEST_CASE_TEMPLATE_INVOKE(allocate_id, std::allocator<int> /*, std::pmr::polymorphic_allocator<int>*/);
 #else
-    TEST_CASE_TEMPLATE_INVOKE(value_semantic_id, std::allocator<int>, std::pmr::polymorphic_allocator<int>);
-    TEST_CASE_TEMPLATE_INVOKE(allocate_id, std::allocator<int>, std::pmr::polymorphic_allocator<int>);
+    TEST_CASE_TEMPLATE_INVOKE(
+        value_semantic_id,
+        std::allocator<int>,
+        std::pmr::polymorphic_allocator<int>,
+        sparrow::tracking_allocator<int>
+    );
+    TEST_CASE_TEMPLATE_INVOKE(
+        allocate_id,
+        std::allocator<int>,
+        std::pmr::polymorphic_allocator<int>,
+        sparrow::tracking_allocator<int>
+    );
+#endif
+}
+
+TEST_SUITE("tracking_allocator")
+{
+    TEST_CASE("counters")
+    {
+        sparrow::allocation_tracker tracker;
+        sparrow::tracking_allocator<std::int32_t> data_alloc(tracker, sparrow::buffer_role::data);
+        sparrow::tracking_allocator<std::int64_t> offsets_alloc(tracker, sparrow::buffer_role::offsets);
+
+        std::int32_t* data = data_alloc.allocate(10);
+        std::int64_t* offsets = offsets_alloc.allocate(4);
+        CHECK_EQ(tracker.live_bytes(), 72);
+        CHECK_EQ(tracker.live_bytes(sparrow::buffer_role::data), 40);
+        CHECK_EQ(tracker.live_bytes(sparrow::buffer_role::offsets), 32);
+        CHECK_EQ(tracker.live_bytes(sparrow::buffer_role::validity), 0);
+        CHECK_EQ(tracker.peak_bytes(), 72);
+        CHECK_EQ(tracker.allocation_count(), 2);
+
+        data_alloc.deallocate(data, 10);
+        CHECK_EQ(tracker.live_bytes(), 32);
+        CHECK_EQ(tracker.live_bytes(sparrow::buffer_role::data), 0);
+        CHECK_EQ(tracker.peak_bytes(), 72);
+
+        tracker.reset_peak();
+        CHECK_EQ(tracker.peak_bytes(), 32);
+
+        offsets_alloc.deallocate(offsets, 4);
+        CHECK_EQ(tracker.live_bytes(), 0);
+        CHECK_EQ(tracker.allocation_count(), 2);
+    }
+
+    TEST_CASE("equality")
+    {
+        sparrow::allocation_tracker tracker;
+        sparrow::tracking_allocator<int> a(tracker, sparrow::buffer_role::data);
+        sparrow::tracking_allocator<double> b(a);
+        CHECK(a == b);
+        CHECK(a != sparrow::tracking_allocator<int>(tracker, sparrow::buffer_role::validity));
+        CHECK(a != sparrow::tracking_allocator<int>(sparrow::buffer_role::data));
+    }
+
+    TEST_CASE("buffer")
+    {
+        sparrow::allocation_tracker tracker;
+        {
+            sparrow::buffer<std::uint8_t> b(16, sparrow::tracking_allocator<std::uint8_t>(tracker));
+            CHECK_EQ(tracker.live_bytes(), 16);
+            b.resize(64);
+            CHECK_EQ(tracker.live_bytes(), b.capacity());
+            CHECK_GE(tracker.peak_bytes(), 80);
+
+            const sparrow::buffer<std::uint8_t> copy(b);
+            CHECK_EQ(tracker.live_bytes(), b.capacity() + copy.capacity());
+        }
+        CHECK_EQ(tracker.live_bytes(), 0);
+    }
+
+    TEST_CASE("threads")
+    {
+        sparrow::allocation_tracker tracker;
+        constexpr std::size_t n_threads = 4;
+        constexpr std::size_t n_allocations = 1000;
+        std::vector<std::thread> threads;
+        for (std::size_t i = 0; i < n_threads; ++i)
+        {
+            threads.emplace_back(
+                [&tracker]
+                {
+                    sparrow::tracking_allocator<std::uint8_t> alloc(tracker);
+                    for (std::size_t j = 0; j < n_allocations; ++j)
+                    {
+                        alloc.deallocate(alloc.allocate(8), 8);
+                    }
+                }
+            );
+        }
+        for (auto& thread : threads)
+        {
+            thread.join();
+        }
+        CHECK_EQ(tracker.live_bytes(), 0);
+        CHECK_EQ(tracker.allocation_count(), n_threads * n_allocations);
+        CHECK_LE(tracker.peak_bytes(), 8 * n_threads);
+    }
+
+#ifdef SPARROW_TRACK_ALLOCATIONS
+    TEST_CASE("default allocator")
+    {
+        sparrow::allocation_tracker& tracker = sparrow::global_allocation_tracker();
+        const std::int64_t live_bytes = tracker.live_bytes();
+        {
+            sparrow::buffer<std::int64_t> b(32, sparrow::buffer<std::int64_t>::default_allocator());
+            CHECK_EQ(tracker.live_bytes(), live_bytes + 32 * static_cast<std::int64_t>(sizeof(std::int64_t)));
+        }
+        CHECK_EQ(tracker.live_bytes(), live_bytes);
+    }
+
+    TEST_CASE("buffer roles")
+    {
+        sparrow::allocation_tracker& tracker = sparrow::global_allocation_tracker();
+        const std::int64_t validity_bytes = tracker.live_bytes(sparrow::buffer_role::validity);
+        const std::int64_t offsets_bytes = tracker.live_bytes(sparrow::buffer_role::offsets);
+        const std::int64_t data_bytes = tracker.live_bytes(sparrow::buffer_role::data);
+        {
+            const sparrow::string_array strings(
+                std::vector<std::string>{"a", "bb", "ccc"},
+                std::vector<bool>{true, false, true}
+            );
+            CHECK_GT(tracker.live_bytes(sparrow::buffer_role::validity), validity_bytes);
+            CHECK_GT(tracker.live_bytes(sparrow::buffer_role::offsets), offsets_bytes);
+            CHECK_GE(tracker.live_bytes(sparrow::buffer_role::data), data_bytes + 6);
+
+            const sparrow::primitive_array<std::int32_t> ints(std::vector<std::int32_t>{1, 2, 3});
+            CHECK_GE(
+                tracker.live_bytes(sparrow::buffer_role::data),
+                data_bytes + 6 + 3 * static_cast<std::int64_t>(sizeof(std::int32_t))
+            );
+        }
+        CHECK_EQ(tracker.live_bytes(sparrow::buffer_role::validity), validity_bytes);
+        CHECK_EQ(tracker.live_bytes(sparrow::buffer_role::offsets), offsets_bytes);
+        CHECK_EQ(tracker.live_bytes(sparrow::buffer_role::data), data_bytes);
+    }
 #endif
 }
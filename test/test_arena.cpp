@@ -0,0 +1,146 @@
+// Copyright 2024 Man Group Operations Limited
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <cstdint>
+#include <memory_resource>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "sparrow/array.hpp"
+#include "sparrow/buffer/arena.hpp"
+#include "sparrow/buffer/buffer.hpp"
+#include "sparrow/buffer/dynamic_bitset.hpp"
+#include "sparrow/primitive_array.hpp"
+#include "sparrow/record_batch.hpp"
+#include "sparrow/variable_size_binary_array.hpp"
+
+#include "doctest/doctest.h"
+
+namespace sparrow
+{
+    TEST_SUITE("arena")
+    {
+        TEST_CASE("allocate")
+        {
+            arena a(256);
+            void* p1 = a.allocate(10, 1);
+            void* p2 = a.allocate(100, 8);
+            CHECK_EQ(reinterpret_cast<std::uintptr_t>(p1) % arena::alignment, 0);
+            CHECK_EQ(reinterpret_cast<std::uintptr_t>(p2) % arena::alignment, 0);
+            CHECK_NE(p1, p2);
+            CHECK_EQ(a.allocated_bytes(), 110);
+
+            a.deallocate(p1, 10, 1);
+            CHECK_EQ(a.allocated_bytes(), 110);
+
+            a.release();
+            CHECK_EQ(a.allocated_bytes(), 0);
+        }
+
+        TEST_CASE("arena_scope")
+        {
+            arena a1;
+            arena a2;
+            CHECK_EQ(current_arena(), nullptr);
+            {
+                arena_scope scope1(a1);
+                CHECK_EQ(current_arena(), &a1);
+                {
+                    arena_scope scope2(a2);
+                    CHECK_EQ(current_arena(), &a2);
+                }
+                CHECK_EQ(current_arena(), &a1);
+            }
+            CHECK_EQ(current_arena(), nullptr);
+        }
+
+        TEST_CASE("buffer")
+        {
+            arena a;
+            {
+                arena_scope scope(a);
+                buffer<std::int32_t> b(16, buffer<std::int32_t>::default_allocator());
+                CHECK(b.get_allocator() == any_allocator<std::int32_t>(std::pmr::polymorphic_allocator<std::int32_t>(&a)));
+                CHECK_EQ(a.allocated_bytes(), 16 * sizeof(std::int32_t));
+
+                validity_bitmap bitmap(64, true, validity_bitmap::default_allocator());
+                CHECK_EQ(a.allocated_bytes(), 16 * sizeof(std::int32_t) + 8);
+
+                // An explicit allocator is not replaced
+                buffer<std::int32_t> b2(16, std::allocator<std::int32_t>());
+                CHECK(b2.get_allocator() == any_allocator<std::int32_t>(std::allocator<std::int32_t>()));
+            }
+
+            buffer<std::int32_t> b(16, buffer<std::int32_t>::default_allocator());
+            CHECK(b.get_allocator() == any_allocator<std::int32_t>(buffer<std::int32_t>::default_allocator()));
+        }
+
+        TEST_CASE("record_batch")
+        {
+            arena a;
+            {
+                arena_scope scope(a);
+                primitive_array<std::int32_t> pa(std::vector<std::int32_t>{1, 2, 3, 4}, true, "ints");
+                string_array sa(std::vector<std::string>{"a", "bb", "ccc", "dddd"}, true, "strings");
+                std::vector<array> columns;
+                columns.emplace_back(std::move(pa));
+                columns.emplace_back(std::move(sa));
+                record_batch rb(std::move(columns));
+                CHECK_GT(a.allocated_bytes(), 0);
+
+                REQUIRE_EQ(rb.nb_rows(), 4);
+                const auto& ints = rb.get_column("ints");
+                CHECK_EQ(ints, array(primitive_array<std::int32_t>(std::vector<std::int32_t>{1, 2, 3, 4})));
+                const auto& strings = rb.get_column("strings");
+                CHECK_EQ(strings, array(string_array(std::vector<std::string>{"a", "bb", "ccc", "dddd"})));
+            }
+            // The batches have been destroyed, the memory can be reused
+            a.release();
+            CHECK_EQ(a.allocated_bytes(), 0);
+        }
+
+        TEST_CASE("copy outlives the arena")
+        {
+            std::optional<buffer<std::int32_t>> buffer_copy;
+            std::optional<primitive_array<std::int32_t>> array_copy;
+            std::optional<string_array> string_copy;
+            {
+                arena a;
+                std::optional<buffer<std::int32_t>> b;
+                std::optional<primitive_array<std::int32_t>> pa;
+                std::optional<string_array> sa;
+                {
+                    arena_scope scope(a);
+                    b.emplace(std::size_t(16), std::int32_t(1), buffer<std::int32_t>::default_allocator());
+                    pa.emplace(std::vector<std::int32_t>{1, 2, 3, 4}, true, "ints");
+                    sa.emplace(std::vector<std::string>{"a", "bb", "ccc", "dddd"}, true, "strings");
+                }
+                buffer_copy.emplace(*b);
+                array_copy.emplace(*pa);
+                string_copy.emplace(*sa);
+                CHECK(
+                    buffer_copy->get_allocator()
+                    == any_allocator<std::int32_t>(buffer<std::int32_t>::default_allocator())
+                );
+            }
+            CHECK_EQ(
+                *buffer_copy,
+                buffer<std::int32_t>(std::size_t(16), std::int32_t(1), buffer<std::int32_t>::default_allocator())
+            );
+            CHECK_EQ(*array_copy, primitive_array<std::int32_t>(std::vector<std::int32_t>{1, 2, 3, 4}, true, "ints"));
+            CHECK_EQ(*string_copy, string_array(std::vector<std::string>{"a", "bb", "ccc", "dddd"}, true, "strings"));
+        }
+    }
+}
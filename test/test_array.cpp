@@ -20,6 +20,7 @@
 #include "sparrow/utils/contracts.hpp"
 #include "sparrow/utils/nullable.hpp"
 #include "sparrow/utils/sparrow_exception.hpp"
+#include "sparrow/variable_size_binary_array.hpp"
 
 #include "../test/external_array_data_creation.hpp"
 #include "doctest/doctest.h"
@@ -110,6 +111,97 @@ namespace sparrow
         }
         TEST_CASE_TEMPLATE_APPLY(equal_operator_id, testing_types);
 
+        TEST_CASE("first_difference")
+        {
+            SUBCASE("primitive")
+            {
+                std::vector<std::int64_t> values(150);
+                std::iota(values.begin(), values.end(), 0);
+                const array ar(primitive_array<std::int64_t>(values, std::vector<std::size_t>{3, 70}));
+                CHECK_FALSE(first_difference(ar, ar).has_value());
+                CHECK_FALSE(first_difference(ar, array(primitive_array<std::int64_t>(values, std::vector<std::size_t>{3, 70}))));
+
+                // The value of a null element does not matter
+                std::vector<std::int64_t> other_values = values;
+                other_values[70] = -1;
+                CHECK_FALSE(first_difference(ar, array(primitive_array<std::int64_t>(other_values, std::vector<std::size_t>{3, 70}))));
+                other_values[130] = -1;
+                const array other(primitive_array<std::int64_t>(other_values, std::vector<std::size_t>{3, 70}));
+                CHECK_EQ(first_difference(ar, other), 130);
+                CHECK(ar != other);
+
+                const array other_nulls(primitive_array<std::int64_t>(values, std::vector<std::size_t>{3, 69}));
+                CHECK_EQ(first_difference(ar, other_nulls), 69);
+                CHECK_EQ(first_difference(ar, ar.slice(0, 140)), 140);
+            }
+
+            SUBCASE("sliced")
+            {
+                std::vector<std::int32_t> values(100);
+                std::iota(values.begin(), values.end(), 0);
+                const array ar(primitive_array<std::int32_t>(values, std::vector<std::size_t>{50}));
+                std::vector<std::int32_t> shifted(values.begin() + 7, values.end());
+                const array expected(primitive_array<std::int32_t>(shifted, std::vector<std::size_t>{43}));
+                CHECK_FALSE(first_difference(ar.slice(7, 100), expected).has_value());
+                CHECK_EQ(first_difference(ar.slice(6, 99), expected), 0);
+            }
+
+            SUBCASE("floating point")
+            {
+                const double nan = std::numeric_limits<double>::quiet_NaN();
+                const array ar(primitive_array<double>(std::vector<double>{1.0, nan}));
+                CHECK_EQ(first_difference(ar, ar), 1);
+                const array zeros(primitive_array<double>(std::vector<double>{0.0}));
+                const array negative_zeros(primitive_array<double>(std::vector<double>{-0.0}));
+                CHECK(zeros == negative_zeros);
+            }
+
+            SUBCASE("bool")
+            {
+                std::vector<bool> values(90);
+                for (std::size_t i = 0; i < values.size(); ++i)
+                {
+                    values[i] = i % 3 == 0;
+                }
+                const array ar = array(primitive_array<bool>(values)).slice(5, 90);
+                values[80] = !values[80];
+                const array other = array(primitive_array<bool>(values)).slice(5, 90);
+                CHECK_EQ(first_difference(ar, other), 75);
+            }
+
+            SUBCASE("strings")
+            {
+                std::vector<std::string> words;
+                for (std::size_t i = 0; i < 100; ++i)
+                {
+                    words.push_back(std::string(i % 5, static_cast<char>('a' + i % 26)));
+                }
+                const array ar{string_array(words)};
+                CHECK_FALSE(first_difference(ar.slice(10, 100), array(string_array(std::vector<std::string>(words.begin() + 10, words.end())))));
+                std::vector<std::string> other_words = words;
+                other_words[77] = "xx";
+                CHECK_EQ(first_difference(ar, array(string_array(other_words))), 77);
+            }
+
+            SUBCASE("different types")
+            {
+                const array ar(primitive_array<std::int32_t>(std::vector<std::int32_t>{}));
+                const array other(primitive_array<std::int64_t>(std::vector<std::int64_t>{}));
+                CHECK_EQ(first_difference(ar, other), 0);
+            }
+
+            SUBCASE("nested")
+            {
+                std::vector<array> children;
+                children.emplace_back(primitive_array<std::int32_t>(std::vector<std::int32_t>{1, 2, 3}));
+                const array ar{struct_array(std::move(children))};
+                std::vector<array> other_children;
+                other_children.emplace_back(primitive_array<std::int32_t>(std::vector<std::int32_t>{1, 2, 4}));
+                const array other{struct_array(std::move(other_children))};
+                CHECK_EQ(first_difference(ar, other), 2);
+            }
+        }
+
         TEST_CASE_TEMPLATE_DEFINE("data_type", AR, data_type_id)
         {
             using scalar_value_type = typename AR::inner_value_type;
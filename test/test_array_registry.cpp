@@ -12,8 +12,17 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include <atomic>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+#include "sparrow/layout/array_access.hpp"
 #include "sparrow/layout/array_factory.hpp"
 #include "sparrow/layout/array_registry.hpp"
+#include "sparrow/primitive_array.hpp"
 #include "sparrow/utils/extension.hpp"
 #include "sparrow/variable_size_binary_array.hpp"
 
@@ -425,5 +434,183 @@ namespace sparrow
                 CHECK_EQ(size, 10);
             }
         }
+
+        TEST_CASE("extension_resolution")
+        {
+            // The registry is a singleton: the factories only touch static counters
+            static int first_calls = 0;
+            static int second_calls = 0;
+            static int predicate_calls = 0;
+
+            auto& registry = array_registry::instance();
+            // doctest runs the body once per SUBCASE: register the extensions only once,
+            // so that the singleton does not accumulate duplicates seen by later tests
+            [[maybe_unused]] static const bool registered = [&registry]()
+            {
+                auto make_factory = [](int& counter)
+                {
+                    return [&counter](arrow_proxy proxy)
+                    {
+                        ++counter;
+                        return cloning_ptr<array_wrapper>{
+                            new array_wrapper_impl<primitive_array<std::int16_t>>(
+                                primitive_array<std::int16_t>(std::move(proxy))
+                            )
+                        };
+                    };
+                };
+
+                registry.register_extension(
+                    data_type::INT16,
+                    "test.resolution.first",
+                    make_factory(first_calls)
+                );
+                registry.register_extension(
+                    data_type::INT16,
+                    "test.resolution.second",
+                    make_factory(second_calls)
+                );
+                // Registered after the named extensions, only used when none of them matches
+                registry.register_extension(
+                    data_type::INT16,
+                    [](const arrow_proxy& proxy)
+                    {
+                        return proxy.name() == "test.resolution.predicate";
+                    },
+                    make_factory(predicate_calls)
+                );
+                return true;
+            }();
+
+            auto make_proxy = [](std::optional<std::string_view> extension_name, std::string_view name)
+            {
+                primitive_array<std::int16_t> pa(std::vector<std::int16_t>{1, 2, 3});
+                arrow_proxy proxy = detail::array_access::get_arrow_proxy(pa);
+                proxy.set_name(name);
+                if (extension_name.has_value())
+                {
+                    proxy.set_metadata(std::optional<std::vector<metadata_pair>>(
+                        std::vector<metadata_pair>{{"ARROW:extension:name", std::string(*extension_name)}}
+                    ));
+                }
+                return proxy;
+            };
+
+            SUBCASE("by name")
+            {
+                const int first = first_calls;
+                const int second = second_calls;
+                auto wrapper = registry.create(make_proxy("test.resolution.second", "col"));
+                CHECK_EQ(wrapper->data_type(), data_type::INT16);
+                CHECK_EQ(first_calls, first);
+                CHECK_EQ(second_calls, second + 1);
+
+                wrapper = registry.create(make_proxy("test.resolution.first", "col"));
+                CHECK_EQ(first_calls, first + 1);
+                CHECK_EQ(second_calls, second + 1);
+            }
+
+            SUBCASE("by predicate")
+            {
+                const int predicate = predicate_calls;
+                auto wrapper = registry.create(make_proxy("test.resolution.unknown", "test.resolution.predicate"));
+                CHECK_EQ(predicate_calls, predicate + 1);
+                wrapper = registry.create(make_proxy(std::nullopt, "test.resolution.predicate"));
+                CHECK_EQ(predicate_calls, predicate + 2);
+            }
+
+            SUBCASE("base type")
+            {
+                const int first = first_calls;
+                const int second = second_calls;
+                const int predicate = predicate_calls;
+                auto wrapper = registry.create(make_proxy("test.resolution.unknown", "col"));
+                CHECK_EQ(wrapper->data_type(), data_type::INT16);
+                CHECK_EQ(first_calls, first);
+                CHECK_EQ(second_calls, second);
+                CHECK_EQ(predicate_calls, predicate);
+            }
+        }
+
+        TEST_CASE("concurrent_creation_and_registration")
+        {
+            // Threads create arrays while another thread registers extensions
+            static std::atomic<int> extension_calls = 0;
+            auto& registry = array_registry::instance();
+            constexpr int nb_extensions = 64;
+            constexpr int nb_readers = 4;
+            constexpr int nb_creations = 500;
+
+            auto make_proxy = [](int i)
+            {
+                primitive_array<std::uint32_t> pa(std::vector<std::uint32_t>{1, 2, 3});
+                arrow_proxy proxy = detail::array_access::get_arrow_proxy(pa);
+                proxy.set_metadata(std::optional<std::vector<metadata_pair>>(
+                    std::vector<metadata_pair>{{"ARROW:extension:name", "test.concurrent." + std::to_string(i)}}
+                ));
+                return proxy;
+            };
+
+            std::atomic<bool> start = false;
+            std::atomic<int> failures = 0;
+            std::vector<std::thread> threads;
+            threads.emplace_back(
+                [&]
+                {
+                    while (!start.load())
+                    {
+                    }
+                    for (int i = 0; i < nb_extensions; ++i)
+                    {
+                        registry.register_extension(
+                            data_type::UINT32,
+                            "test.concurrent." + std::to_string(i),
+                            [](arrow_proxy proxy)
+                            {
+                                ++extension_calls;
+                                return cloning_ptr<array_wrapper>{
+                                    new array_wrapper_impl<primitive_array<std::uint32_t>>(
+                                        primitive_array<std::uint32_t>(std::move(proxy))
+                                    )
+                                };
+                            }
+                        );
+                    }
+                }
+            );
+            for (int t = 0; t < nb_readers; ++t)
+            {
+                threads.emplace_back(
+                    [&, t]
+                    {
+                        while (!start.load())
+                        {
+                        }
+                        for (int i = 0; i < nb_creations; ++i)
+                        {
+                            auto wrapper = registry.create(make_proxy((i + t) % nb_extensions));
+                            if (wrapper->data_type() != data_type::UINT32)
+                            {
+                                ++failures;
+                            }
+                        }
+                    }
+                );
+            }
+            start = true;
+            for (auto& thread : threads)
+            {
+                thread.join();
+            }
+            CHECK_EQ(failures.load(), 0);
+
+            // Once registered, every extension is used
+            const int calls = extension_calls.load();
+            for (int i = 0; i < nb_extensions; ++i)
+            {
+                auto wrapper = registry.create(make_proxy(i));
+            }
+            CHECK_EQ(extension_calls.load(), calls + nb_extensions);
+        }
     }
 }
@@ -149,6 +149,51 @@ TEST_SUITE("ArrowArrowSchemaProxy")
             proxy2.set_format("L");
             CHECK_EQ(proxy.format(), "c");
         }
+
+        SUBCASE("copy shares buffers")
+        {
+            auto [array, schema] = test::make_arrow_schema_and_array(true);
+            const sparrow::arrow_proxy proxy(std::move(array), std::move(schema));
+            const sparrow::arrow_proxy proxy2(proxy);
+            REQUIRE_EQ(proxy2.buffers().size(), proxy.buffers().size());
+            for (std::size_t i = 0; i < proxy.buffers().size(); ++i)
+            {
+                CHECK_EQ(proxy2.buffers()[i].data(), proxy.buffers()[i].data());
+            }
+            REQUIRE_EQ(proxy2.children().size(), proxy.children().size());
+            for (std::size_t i = 0; i < proxy.children().size(); ++i)
+            {
+                CHECK_EQ(proxy2.children()[i].buffers()[1].data(), proxy.children()[i].buffers()[1].data());
+            }
+        }
+
+        SUBCASE("set_buffer on copy does not modify source")
+        {
+            auto [array, schema] = test::make_arrow_schema_and_array(false);
+            const sparrow::arrow_proxy proxy(std::move(array), std::move(schema));
+            sparrow::arrow_proxy proxy2(proxy);
+            proxy2.set_buffer(1, sparrow::buffer<uint8_t>(std::size_t(10), uint8_t(9), sparrow::buffer<uint8_t>::default_allocator()));
+            CHECK_EQ(proxy2.buffers()[1][0], 9);
+            CHECK_EQ(proxy.buffers()[1][0], 0);
+            // The buffers that were not replaced have been copied
+            CHECK_NE(proxy2.buffers()[0].data(), proxy.buffers()[0].data());
+            CHECK_EQ(proxy2.buffers()[0][0], proxy.buffers()[0][0]);
+        }
+
+        SUBCASE("mutable access on copy does not modify source")
+        {
+            auto [array, schema] = test::make_arrow_schema_and_array(false);
+            sparrow::arrow_proxy proxy(std::move(array), std::move(schema));
+            sparrow::arrow_proxy proxy2(proxy);
+            proxy2.buffers()[1][0] = 42;
+            CHECK_EQ(proxy2.buffers()[1][0], 42);
+            CHECK_EQ(proxy.buffers()[1][0], 0);
+
+            proxy.push_back_bitmap(false);
+            CHECK_EQ(proxy.null_count(), proxy2.null_count() + 1);
+            CHECK_EQ(proxy2.buffers()[1][0], 42);
+            CHECK_EQ(proxy.buffers()[1][0], 0);
+        }
     }
 
     TEST_CASE("format")
@@ -254,6 +299,15 @@ TEST_SUITE("ArrowArrowSchemaProxy")
             array.release(const_cast<ArrowArray*>(&array));
             schema.release(const_cast<ArrowSchema*>(&schema));
         }
+
+        SUBCASE("on child resets the parent fingerprint")
+        {
+            auto [array, schema] = test::make_arrow_schema_and_array(true);
+            sparrow::arrow_proxy proxy(std::move(array), std::move(schema));
+            const auto fingerprint = sparrow::schema_fingerprint(proxy.schema());
+            proxy.children()[0].set_name("new name");
+            CHECK_NE(sparrow::schema_fingerprint(proxy.schema()), fingerprint);
+        }
     }
 
     TEST_CASE("metadata")
@@ -12,8 +12,13 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include <cerrno>
+#include <chrono>
 #include <cstdint>
 #include <string_view>
+#include <system_error>
+#include <thread>
+#include <tuple>
 #include <vector>
 
 #include "sparrow/arrow_interface/arrow_array_stream.hpp"
@@ -503,5 +508,101 @@ namespace sparrow
             stream->release(stream);
             delete stream;
         }
+
+        TEST_CASE("concurrent stream")
+        {
+            using namespace std::chrono_literals;
+
+            SUBCASE("producer and consumer threads")
+            {
+                constexpr std::size_t n_arrays = 100;
+                arrow_array_stream_proxy proxy(concurrent_stream_options{.capacity = 4});
+                CHECK(proxy.is_concurrent());
+                std::thread producer(
+                    [&proxy]
+                    {
+                        for (std::size_t i = 0; i < n_arrays; ++i)
+                        {
+                            proxy.push(make_test_primitive_array<int32_t>(i + 1));
+                        }
+                        proxy.close();
+                    }
+                );
+                std::size_t n_popped = 0;
+                while (auto arr = proxy.pop())
+                {
+                    CHECK_EQ(arr->size(), n_popped + 1);
+                    ++n_popped;
+                }
+                producer.join();
+                CHECK_EQ(n_popped, n_arrays);
+                CHECK(proxy.is_exhausted());
+            }
+
+            SUBCASE("timed pop")
+            {
+                arrow_array_stream_proxy proxy(concurrent_stream_options{.capacity = 2});
+                CHECK_FALSE(proxy.pop_for(1ms).has_value());
+                CHECK_FALSE(proxy.is_exhausted());
+
+                proxy.push(make_test_primitive_array<int32_t>(5));
+                auto arr = proxy.pop_for(1ms);
+                REQUIRE(arr.has_value());
+                CHECK_EQ(arr->size(), 5);
+
+                proxy.close();
+                CHECK_FALSE(proxy.pop_for(1s).has_value());
+                CHECK(proxy.is_exhausted());
+            }
+
+            SUBCASE("backpressure")
+            {
+                arrow_array_stream_proxy proxy(concurrent_stream_options{.capacity = 1});
+                proxy.push(make_test_primitive_array<int32_t>(1));
+                std::thread producer(
+                    [&proxy]
+                    {
+                        // Blocks until the consumer pops the first array
+                        proxy.push(make_test_primitive_array<int32_t>(2));
+                        proxy.close();
+                    }
+                );
+                auto first = proxy.pop();
+                REQUIRE(first.has_value());
+                CHECK_EQ(first->size(), 1);
+                auto second = proxy.pop();
+                REQUIRE(second.has_value());
+                CHECK_EQ(second->size(), 2);
+                CHECK_FALSE(proxy.pop().has_value());
+                producer.join();
+            }
+
+            SUBCASE("push after close")
+            {
+                arrow_array_stream_proxy proxy(concurrent_stream_options{});
+                proxy.close();
+                CHECK_THROWS_AS(proxy.push(make_test_primitive_array<int32_t>(3)), std::runtime_error);
+            }
+
+            SUBCASE("error propagation")
+            {
+                arrow_array_stream_proxy proxy(concurrent_stream_options{.capacity = 4});
+                proxy.push(make_test_primitive_array<int32_t>(3));
+                proxy.close("producer failed", EIO);
+
+                // The arrays pushed before the error are still delivered
+                auto arr = proxy.pop();
+                REQUIRE(arr.has_value());
+                CHECK_EQ(arr->size(), 3);
+                CHECK_THROWS_AS(std::ignore = proxy.pop(), std::system_error);
+
+                ArrowArrayStream* stream = proxy.export_stream();
+                ArrowArray out{};
+                CHECK_EQ(stream->get_next(stream, &out), EIO);
+                CHECK_EQ(std::string_view(stream->get_last_error(stream)), "producer failed");
+                stream->release(stream);
+                delete stream;
+            }
+        }
     }
 }
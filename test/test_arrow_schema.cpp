@@ -462,6 +462,77 @@ TEST_SUITE("C Data Interface")
             }
         }
 
+        SUBCASE("schema_fingerprint")
+        {
+            auto make_schema = [](std::optional<std::vector<sparrow::metadata_pair>> metadata)
+            {
+                return sparrow::make_arrow_schema(
+                    "fmt"s,
+                    "n"s,
+                    std::move(metadata),
+                    std::unordered_set<sparrow::ArrowFlag>{},
+                    nullptr,
+                    sparrow::repeat_view<bool>(true, 0),
+                    nullptr,
+                    true
+                );
+            };
+
+            SUBCASE("deep copy")
+            {
+                auto s = test::make_arrow_schema(true);
+                auto s_copy = sparrow::copy_schema(s);
+                CHECK_EQ(sparrow::schema_fingerprint(s), sparrow::schema_fingerprint(s_copy));
+                s_copy.release(&s_copy);
+                s.release(&s);
+            }
+
+            SUBCASE("different schema")
+            {
+                auto s = test::make_arrow_schema(true);
+                auto t = test::make_arrow_schema(false);
+                CHECK_NE(sparrow::schema_fingerprint(s), sparrow::schema_fingerprint(t));
+                t.release(&t);
+                s.release(&s);
+            }
+
+            SUBCASE("metadata")
+            {
+                auto m1 = make_schema(sparrow::metadata_sample_opt);
+                auto m2 = make_schema(sparrow::metadata_sample_opt);
+                auto m3 = make_schema(std::optional<std::vector<sparrow::metadata_pair>>{});
+                CHECK(sparrow::check_compatible_schema(m1, m2));
+                CHECK_EQ(sparrow::schema_fingerprint(m1), sparrow::schema_fingerprint(m2));
+                CHECK_NE(sparrow::schema_fingerprint(m1), sparrow::schema_fingerprint(m3));
+                m1.release(&m1);
+                m2.release(&m2);
+                m3.release(&m3);
+            }
+
+            SUBCASE("cache")
+            {
+                auto s = test::make_arrow_schema(true);
+                const auto fingerprint = sparrow::schema_fingerprint(s);
+                // Direct writes are not tracked: the cached fingerprint is returned
+                s.flags = static_cast<int64_t>(sparrow::ArrowFlag::NULLABLE);
+                CHECK_EQ(sparrow::schema_fingerprint(s), fingerprint);
+                sparrow::invalidate_schema_fingerprints();
+                CHECK_NE(sparrow::schema_fingerprint(s), fingerprint);
+                s.release(&s);
+            }
+
+            SUBCASE("copy shares the cache")
+            {
+                auto s = test::make_arrow_schema(true);
+                const auto fingerprint = sparrow::schema_fingerprint(s);
+                auto s_copy = sparrow::copy_schema(s);
+                s_copy.flags = static_cast<int64_t>(sparrow::ArrowFlag::NULLABLE);
+                CHECK_EQ(sparrow::schema_fingerprint(s_copy), fingerprint);
+                s_copy.release(&s_copy);
+                s.release(&s);
+            }
+        }
+
 #if defined(__cpp_lib_format)
         SUBCASE("formatting")
         {
@@ -13,6 +13,7 @@
 // limitations under the License.
 
 #include <array>
+#include <string>
 #include <tuple>
 #include <variant>
 #include <vector>
@@ -79,6 +80,24 @@ namespace sparrow
                 CHECK_NULLABLE_VARIANT_EQ(arr[3], std::string_view("world"));
                 CHECK(!arr[4].has_value());
             }
+            SUBCASE("dict[string]-many-values")
+            {
+                // enough distinct values to grow the hash table several times
+                std::vector<std::string> input;
+                for (int i = 0; i < 1000; ++i)
+                {
+                    input.push_back(std::to_string(i % 300));
+                }
+                dict_encode<std::vector<std::string>> v{input};
+                auto arr = sparrow::build(v);
+                test::generic_consistency_test(arr);
+
+                REQUIRE_EQ(arr.size(), input.size());
+                for (std::size_t i = 0; i < input.size(); ++i)
+                {
+                    CHECK_NULLABLE_VARIANT_EQ(arr[i], std::string_view(input[i]));
+                }
+            }
             SUBCASE("dict[struct[int,float]]")
             {
                 using tuple_type = std::tuple<nullable<int>, std::uint16_t>;
@@ -13,11 +13,14 @@
 // limitations under the License.
 
 #include <array>
+#include <string>
 #include <tuple>
 #include <variant>
 #include <vector>
 
 #include "sparrow/builder/builder_utils.hpp"
+#include "sparrow/builder/nested_eq.hpp"
+#include "sparrow/builder/nested_hash.hpp"
 
 #include "test_utils.hpp"
 
@@ -272,5 +275,38 @@ namespace sparrow
                 CHECK_EQ(res[0], 1);
             }
         }
+        TEST_CASE("nested_hash")
+        {
+            SUBCASE("scalars")
+            {
+                CHECK_EQ(detail::nested_hash<int>{}(42), detail::nested_hash<int>{}(42));
+                CHECK_NE(detail::nested_hash<int>{}(42), detail::nested_hash<int>{}(43));
+                // 0.0 and -0.0 are equal for nested_eq
+                CHECK_EQ(detail::nested_hash<double>{}(0.0), detail::nested_hash<double>{}(-0.0));
+            }
+            SUBCASE("nullables")
+            {
+                using type = nullable<int>;
+                CHECK_EQ(detail::nested_hash<type>{}(type{}), detail::nested_hash<type>{}(type{}));
+                CHECK_EQ(detail::nested_hash<type>{}(type{1}), detail::nested_hash<type>{}(type{1}));
+                CHECK_NE(detail::nested_hash<type>{}(type{1}), detail::nested_hash<type>{}(type{}));
+            }
+            SUBCASE("strings")
+            {
+                using type = std::string;
+                CHECK_EQ(detail::nested_hash<type>{}("hello"), detail::nested_hash<type>{}(std::string("hello")));
+                CHECK_NE(detail::nested_hash<type>{}("hello"), detail::nested_hash<type>{}("world"));
+            }
+            SUBCASE("nested")
+            {
+                using type = std::tuple<int, std::vector<nullable<std::string>>, std::variant<int, double>>;
+                const type a{1, {"a", nullable<std::string>{}}, 2};
+                const type b{1, {"a", nullable<std::string>{}}, 2};
+                const type c{1, {"a", nullable<std::string>{}}, 2.0};
+                CHECK(detail::nested_eq<type>{}(a, b));
+                CHECK_EQ(detail::nested_hash<type>{}(a), detail::nested_hash<type>{}(b));
+                CHECK_NE(detail::nested_hash<type>{}(a), detail::nested_hash<type>{}(c));
+            }
+        }
     }
 }
@@ -0,0 +1,1037 @@
+// Copyright 2024 Man Group Operations Limited
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <numeric>
+#include <stdexcept>
+#include <string>
+#include <tuple>
+#include <vector>
+
+#include "sparrow/compute/aggregation.hpp"
+#include "sparrow/compute/arithmetic.hpp"
+#include "sparrow/compute/comparison.hpp"
+#include "sparrow/compute/dictionary.hpp"
+#include "sparrow/compute/hash.hpp"
+#include "sparrow/compute/selection.hpp"
+#include "sparrow/compute/sort.hpp"
+#include "sparrow/layout/array_access.hpp"
+#include "sparrow/array.hpp"
+#include "sparrow/list_array.hpp"
+#include "sparrow/primitive_array.hpp"
+#include "sparrow/record_batch.hpp"
+#include "sparrow/run_end_encoded_array.hpp"
+#include "sparrow/struct_array.hpp"
+#include "sparrow/union_array.hpp"
+#include "sparrow/utils/nullable.hpp"
+#include "sparrow/variable_size_binary_array.hpp"
+#include "sparrow/variable_size_binary_view_array.hpp"
+
+#include "doctest/doctest.h"
+
+namespace sparrow
+{
+    namespace
+    {
+        // 20 elements so that the bitmaps have full bytes and a trailing partial one
+        primitive_array<std::int32_t> make_array(std::int32_t first, const std::vector<std::size_t>& nulls)
+        {
+            std::vector<std::int32_t> values(20);
+            for (std::size_t i = 0; i < values.size(); ++i)
+            {
+                values[i] = first + static_cast<std::int32_t>(i);
+            }
+            return primitive_array<std::int32_t>(values, nulls);
+        }
+
+        template <class T>
+        void check_array(const primitive_array<T>& ar, const std::vector<nullable<T>>& expected)
+        {
+            REQUIRE_EQ(ar.size(), expected.size());
+            for (std::size_t i = 0; i < expected.size(); ++i)
+            {
+                CHECK_EQ(ar[i].has_value(), expected[i].has_value());
+                if (expected[i].has_value())
+                {
+                    CHECK_EQ(ar[i].value(), expected[i].value());
+                }
+            }
+        }
+
+        // Expected result of sort_indices, computed with std::stable_sort
+        template <class T, class Less = std::less<>>
+        std::vector<std::size_t> expected_permutation(
+            const std::vector<T>& values,
+            const std::vector<std::size_t>& nulls,
+            compute::sort_order order,
+            compute::null_placement placement,
+            Less less = {}
+        )
+        {
+            std::vector<std::size_t> valid;
+            for (std::size_t i = 0; i < values.size(); ++i)
+            {
+                if (std::ranges::find(nulls, i) == nulls.end())
+                {
+                    valid.push_back(i);
+                }
+            }
+            std::ranges::stable_sort(
+                valid,
+                [&](std::size_t lhs, std::size_t rhs)
+                {
+                    return order == compute::sort_order::ascending ? less(values[lhs], values[rhs])
+                                                                   : less(values[rhs], values[lhs]);
+                }
+            );
+            std::vector<std::size_t> sorted_nulls(nulls);
+            std::ranges::sort(sorted_nulls);
+            const auto pos = placement == compute::null_placement::at_start ? valid.begin() : valid.end();
+            valid.insert(pos, sorted_nulls.begin(), sorted_nulls.end());
+            return valid;
+        }
+    }
+
+    TEST_SUITE("compute")
+    {
+        TEST_CASE("arithmetic")
+        {
+            const auto lhs = make_array(10, {1, 9});
+            const auto rhs = make_array(1, {9, 17});
+
+            SUBCASE("add")
+            {
+                const auto res = compute::add(lhs, rhs);
+                REQUIRE_EQ(res.size(), 20);
+                for (std::size_t i = 0; i < res.size(); ++i)
+                {
+                    const bool valid = i != 1 && i != 9 && i != 17;
+                    REQUIRE_EQ(res[i].has_value(), valid);
+                    if (valid)
+                    {
+                        CHECK_EQ(res[i].value(), static_cast<std::int32_t>(11 + 2 * i));
+                    }
+                }
+            }
+
+            SUBCASE("with scalar")
+            {
+                const auto res = compute::subtract(lhs, 10);
+                const auto rres = compute::subtract(10, lhs);
+                const auto mres = compute::multiply(lhs, 2);
+                for (std::size_t i = 0; i < res.size(); ++i)
+                {
+                    const bool valid = i != 1 && i != 9;
+                    REQUIRE_EQ(res[i].has_value(), valid);
+                    REQUIRE_EQ(rres[i].has_value(), valid);
+                    if (valid)
+                    {
+                        CHECK_EQ(res[i].value(), static_cast<std::int32_t>(i));
+                        CHECK_EQ(rres[i].value(), -static_cast<std::int32_t>(i));
+                        CHECK_EQ(mres[i].value(), static_cast<std::int32_t>(20 + 2 * i));
+                    }
+                }
+            }
+
+            SUBCASE("sliced inputs")
+            {
+                const auto res = compute::add(lhs.slice(3, 13), rhs.slice(5, 15));
+                REQUIRE_EQ(res.size(), 10);
+                for (std::size_t i = 0; i < res.size(); ++i)
+                {
+                    const bool valid = i != 4 && i != 6;
+                    REQUIRE_EQ(res[i].has_value(), valid);
+                    if (valid)
+                    {
+                        CHECK_EQ(res[i].value(), static_cast<std::int32_t>(19 + 2 * i));
+                    }
+                }
+            }
+
+            SUBCASE("size mismatch")
+            {
+                CHECK_THROWS_AS(std::ignore = compute::add(lhs, rhs.slice(0, 10)), std::invalid_argument);
+            }
+
+            SUBCASE("integer wraps around")
+            {
+                const primitive_array<std::int8_t> ar{std::vector<std::int8_t>{127, -128}};
+                check_array(compute::add(ar, std::int8_t(1)), {std::int8_t(-128), std::int8_t(-127)});
+                check_array(compute::divide(ar, std::int8_t(-1)), {std::int8_t(-127), std::int8_t(-128)});
+            }
+
+            SUBCASE("divide")
+            {
+                const primitive_array<std::int32_t> num{std::vector<nullable<std::int32_t>>{7, 8, {9, false}, -9}};
+                const primitive_array<std::int32_t> den{std::vector<nullable<std::int32_t>>{2, {0, false}, 0, 2}};
+                check_array(compute::divide(num, den), {3, {0, false}, {0, false}, -4});
+
+                const primitive_array<std::int32_t> zero{std::vector<std::int32_t>{1, 0, 1, 1}};
+                CHECK_THROWS_AS(std::ignore = compute::divide(num, zero), std::domain_error);
+                CHECK_THROWS_AS(std::ignore = compute::divide(num, 0), std::domain_error);
+
+                const primitive_array<double> fnum{std::vector<double>{1., -1.}};
+                const auto fres = compute::divide(fnum, 0.);
+                CHECK(std::isinf(fres[0].value()));
+                CHECK(std::isinf(fres[1].value()));
+            }
+        }
+
+        TEST_CASE("comparison")
+        {
+            const auto lhs = make_array(0, {2, 16});
+            const auto rhs = make_array(0, {3});
+
+            SUBCASE("equal")
+            {
+                const auto mask = compute::equal(lhs, rhs);
+                REQUIRE_EQ(mask.size(), 20);
+                for (std::size_t i = 0; i < mask.size(); ++i)
+                {
+                    CHECK_EQ(mask.test(i), i != 2 && i != 3 && i != 16);
+                }
+                CHECK_EQ(mask.null_count(), 3);
+            }
+
+            SUBCASE("with scalar")
+            {
+                const auto less = compute::less(lhs, 10);
+                const auto greater_equal = compute::greater_equal(lhs, 10);
+                const auto not_equal = compute::not_equal(lhs, 5);
+                for (std::size_t i = 0; i < less.size(); ++i)
+                {
+                    const bool valid = i != 2 && i != 16;
+                    CHECK_EQ(less.test(i), valid && i < 10);
+                    CHECK_EQ(greater_equal.test(i), valid && i >= 10);
+                    CHECK_EQ(not_equal.test(i), valid && i != 5);
+                }
+            }
+
+            SUBCASE("sliced inputs")
+            {
+                const auto mask = compute::less_equal(lhs.slice(1, 20), rhs.slice(0, 19));
+                REQUIRE_EQ(mask.size(), 19);
+                for (std::size_t i = 0; i < mask.size(); ++i)
+                {
+                    CHECK_FALSE(mask.test(i));
+                }
+                const auto gmask = compute::greater(lhs.slice(1, 20), rhs.slice(0, 19));
+                for (std::size_t i = 0; i < gmask.size(); ++i)
+                {
+                    CHECK_EQ(gmask.test(i), i != 1 && i != 3 && i != 15);
+                }
+            }
+        }
+
+        TEST_CASE("aggregation")
+        {
+            SUBCASE("integers")
+            {
+                const auto ar = make_array(-5, {0, 8, 19});
+                std::int64_t expected = 0;
+                for (std::int32_t i = 1; i < 19; ++i)
+                {
+                    expected += (i != 8) ? -5 + i : 0;
+                }
+                CHECK_EQ(compute::sum(ar), expected);
+                CHECK_EQ(compute::mean(ar).value(), doctest::Approx(static_cast<double>(expected) / 17.));
+                CHECK_EQ(compute::min(ar).value(), -4);
+                CHECK_EQ(compute::max(ar).value(), 13);
+
+                const auto sliced = ar.slice(9, 12);
+                CHECK_EQ(compute::sum(sliced), 4 + 5 + 6);
+                CHECK_EQ(compute::min(sliced).value(), 4);
+                CHECK_EQ(compute::max(sliced).value(), 6);
+            }
+
+            SUBCASE("no valid value")
+            {
+                const primitive_array<std::uint16_t> ar{std::vector<nullable<std::uint16_t>>{{1, false}, {2, false}}};
+                CHECK_EQ(compute::sum(ar), 0u);
+                CHECK_FALSE(compute::mean(ar).has_value());
+                CHECK_FALSE(compute::min(ar).has_value());
+                CHECK_FALSE(compute::max(ar).has_value());
+
+                const primitive_array<std::uint16_t> empty{std::vector<std::uint16_t>{}};
+                CHECK_FALSE(compute::max(empty).has_value());
+            }
+
+            SUBCASE("floating point")
+            {
+                const double nan = std::numeric_limits<double>::quiet_NaN();
+                const primitive_array<double> ar{std::vector<nullable<double>>{nan, 2.5, {100., false}, -1.5, nan}};
+                CHECK_EQ(compute::min(ar).value(), -1.5);
+                CHECK_EQ(compute::max(ar).value(), 2.5);
+                CHECK(std::isnan(compute::sum(ar)));
+
+                const primitive_array<float> far{std::vector<float>{1.f, 2.f, 4.5f}};
+                CHECK_EQ(compute::sum(far), 7.5);
+                CHECK_EQ(compute::mean(far).value(), doctest::Approx(2.5));
+            }
+        }
+
+        TEST_CASE("dictionary")
+        {
+            auto key_format = [](const array& ar)
+            {
+                return detail::array_access::get_arrow_proxy(ar).format();
+            };
+
+            const std::vector<std::string> words{"b", "a", "b", "", "c", "a", "b", "c"};
+            const array strings(string_array(words, std::vector<std::size_t>{2, 6}));
+
+            SUBCASE("encode")
+            {
+                const array encoded = compute::dictionary_encode(strings);
+                REQUIRE_EQ(encoded.size(), strings.size());
+                CHECK_EQ(encoded.null_count(), 2);
+                CHECK_EQ(key_format(encoded), "c");
+                for (std::size_t i = 0; i < strings.size(); ++i)
+                {
+                    CHECK_EQ(encoded[i], strings[i]);
+                }
+
+                const auto dictionary = encoded.dictionary();
+                REQUIRE(dictionary.has_value());
+                CHECK_EQ(*dictionary, array(string_array(std::vector<std::string>{"b", "a", "", "c"}, false)));
+            }
+
+            SUBCASE("encode sliced")
+            {
+                const array sliced = strings.slice(3, 8);
+                const array encoded = compute::dictionary_encode(sliced);
+                REQUIRE_EQ(encoded.size(), 5);
+                CHECK_EQ(encoded.null_count(), 1);
+                CHECK_EQ(encoded.dictionary()->size(), 3);
+                for (std::size_t i = 0; i < sliced.size(); ++i)
+                {
+                    CHECK_EQ(encoded[i], sliced[i]);
+                }
+            }
+
+            SUBCASE("encode wide dictionary")
+            {
+                std::vector<std::int64_t> values(1000);
+                for (std::size_t i = 0; i < values.size(); ++i)
+                {
+                    values[i] = static_cast<std::int64_t>((i * 7) % 300) - 150;
+                }
+                const array ar{primitive_array<std::int64_t>(values)};
+                const array encoded = compute::dictionary_encode(ar);
+                CHECK_EQ(key_format(encoded), "s");
+                CHECK_EQ(encoded.dictionary()->size(), 300);
+                CHECK_EQ(encoded.null_count(), 0);
+                CHECK_EQ(compute::dictionary_decode(encoded), ar);
+            }
+
+            SUBCASE("decode")
+            {
+                const array decoded = compute::dictionary_decode(compute::dictionary_encode(strings));
+                REQUIRE_EQ(decoded.size(), strings.size());
+                CHECK_EQ(decoded.null_count(), 2);
+                for (std::size_t i = 0; i < strings.size(); ++i)
+                {
+                    CHECK_EQ(decoded[i], strings[i]);
+                }
+
+                const array ints(make_array(3, {0, 9, 17}));
+                CHECK_EQ(compute::dictionary_decode(compute::dictionary_encode(ints)), ints);
+            }
+
+            SUBCASE("unify")
+            {
+                const std::vector<array> arrays{
+                    compute::dictionary_encode(strings.slice(0, 4)),
+                    compute::dictionary_encode(array(string_array(std::vector<std::string>{"d", "c", "a", "d"})))
+                };
+                const std::vector<array> unified = compute::unify_dictionaries(arrays);
+                REQUIRE_EQ(unified.size(), 2);
+                const array expected_dictionary(string_array(std::vector<std::string>{"b", "a", "", "d", "c"}, false));
+                for (std::size_t a = 0; a < arrays.size(); ++a)
+                {
+                    CHECK_EQ(*unified[a].dictionary(), expected_dictionary);
+                    REQUIRE_EQ(unified[a].size(), arrays[a].size());
+                    CHECK_EQ(unified[a].null_count(), arrays[a].null_count());
+                    for (std::size_t i = 0; i < arrays[a].size(); ++i)
+                    {
+                        CHECK_EQ(unified[a][i], arrays[a][i]);
+                    }
+                }
+            }
+
+            SUBCASE("errors")
+            {
+                const array bools(primitive_array<bool>(std::vector<bool>{true, false}));
+                CHECK_THROWS_AS(std::ignore = compute::dictionary_encode(bools), std::invalid_argument);
+                CHECK_THROWS_AS(std::ignore = compute::dictionary_decode(strings), std::invalid_argument);
+                const std::vector<array> arrays{
+                    compute::dictionary_encode(strings),
+                    compute::dictionary_encode(array(make_array(0, {})))
+                };
+                CHECK_THROWS_AS(std::ignore = compute::unify_dictionaries(arrays), std::invalid_argument);
+            }
+        }
+
+        TEST_CASE("sort_indices")
+        {
+            using compute::null_placement;
+            using compute::sort_order;
+
+            SUBCASE("integers")
+            {
+                std::vector<std::int32_t> values(1000);
+                for (std::size_t i = 0; i < values.size(); ++i)
+                {
+                    values[i] = static_cast<std::int32_t>((i * 7919) % 2003) - 1000;
+                }
+                const std::vector<std::size_t> nulls{3, 10, 500, 999};
+                const array ar(primitive_array<std::int32_t>(values, nulls));
+                for (const auto order : {sort_order::ascending, sort_order::descending})
+                {
+                    for (const auto placement : {null_placement::at_start, null_placement::at_end})
+                    {
+                        CHECK_EQ(
+                            compute::sort_indices(ar, order, placement),
+                            expected_permutation(values, nulls, order, placement)
+                        );
+                    }
+                }
+            }
+
+            SUBCASE("wide integers")
+            {
+                std::vector<std::int64_t> values(500);
+                for (std::size_t i = 0; i < values.size(); ++i)
+                {
+                    values[i] = static_cast<std::int64_t>(i % 7) * (std::int64_t(1) << 40) - static_cast<std::int64_t>(i % 13);
+                }
+                const array ar(primitive_array<std::int64_t>(values, std::vector<std::size_t>{}));
+                CHECK_EQ(
+                    compute::sort_indices(ar, sort_order::descending),
+                    expected_permutation(values, {}, sort_order::descending, null_placement::at_end)
+                );
+            }
+
+            SUBCASE("floating point")
+            {
+                const double inf = std::numeric_limits<double>::infinity();
+                const double nan = std::numeric_limits<double>::quiet_NaN();
+                const array ar(primitive_array<double>(std::vector<double>{2.5, -inf, nan, -1.0, 0.0, inf, -3.25, 1e-300}));
+                CHECK_EQ(compute::sort_indices(ar), std::vector<std::size_t>{1, 6, 3, 4, 7, 0, 5, 2});
+                CHECK_EQ(compute::sort_indices(ar, sort_order::descending), std::vector<std::size_t>{2, 5, 0, 7, 4, 3, 6, 1});
+            }
+
+            SUBCASE("strings")
+            {
+                const std::vector<std::string> words{
+                    "abcdefghij", "abcdefgh", "b", "", "abcdefghia", "abcdefgh", "abc", "abcdefghij", "zz", "a"
+                };
+                const std::vector<std::size_t> nulls{2};
+                const array ar(string_array(words, nulls));
+                for (const auto order : {sort_order::ascending, sort_order::descending})
+                {
+                    CHECK_EQ(
+                        compute::sort_indices(ar, order, null_placement::at_start),
+                        expected_permutation(words, nulls, order, null_placement::at_start)
+                    );
+                }
+            }
+
+            SUBCASE("bool")
+            {
+                const array ar(primitive_array<bool>(std::vector<bool>{true, false, true, false, false}));
+                CHECK_EQ(compute::sort_indices(ar), std::vector<std::size_t>{1, 3, 4, 0, 2});
+                CHECK_EQ(compute::sort_indices(ar, sort_order::descending), std::vector<std::size_t>{0, 2, 1, 3, 4});
+            }
+
+            SUBCASE("sliced")
+            {
+                const array ar = array(make_array(0, {5})).slice(3, 10);
+                CHECK_EQ(
+                    compute::sort_indices(ar, sort_order::descending),
+                    std::vector<std::size_t>{6, 5, 4, 3, 1, 0, 2}
+                );
+            }
+
+            SUBCASE("record_batch")
+            {
+                const std::vector<std::int32_t> groups{2, 1, 2, 1, 3, 1, 2};
+                const std::vector<std::string> names{"c", "b", "a", "b", "a", "a", "d"};
+                const record_batch rb(
+                    std::vector<std::string>{"group", "name"},
+                    std::vector<array>{
+                        array(primitive_array<std::int32_t>(groups)),
+                        array(string_array(names, std::vector<std::size_t>{6}))
+                    }
+                );
+                const std::vector<compute::sort_key> keys{
+                    {"group", sort_order::ascending, null_placement::at_end},
+                    {"name", sort_order::descending, null_placement::at_start}
+                };
+                CHECK_EQ(compute::sort_indices(rb, keys), std::vector<std::size_t>{1, 3, 5, 6, 0, 2, 4});
+
+                const std::vector<compute::sort_key> unknown{{"unknown"}};
+                CHECK_THROWS_AS(std::ignore = compute::sort_indices(rb, unknown), std::out_of_range);
+            }
+
+            SUBCASE("unsupported layout")
+            {
+                const array encoded = compute::dictionary_encode(array(make_array(0, {})));
+                CHECK_THROWS_AS(std::ignore = compute::sort_indices(encoded), std::invalid_argument);
+            }
+        }
+
+        TEST_CASE("take")
+        {
+            const std::vector<std::size_t> indices{19, 0, 9, 9, 4, 17, 1, 18, 2};
+
+            SUBCASE("primitive")
+            {
+                const array ar(make_array(0, {1, 9}));
+                const array result = compute::take(ar, indices);
+                REQUIRE_EQ(result.size(), indices.size());
+                CHECK_EQ(result.null_count(), 3);
+                for (std::size_t i = 0; i < indices.size(); ++i)
+                {
+                    CHECK_EQ(result[i], ar[indices[i]]);
+                }
+            }
+
+            SUBCASE("sliced strings")
+            {
+                std::vector<std::string> words;
+                for (std::size_t i = 0; i < 25; ++i)
+                {
+                    words.push_back(std::string(i % 6, static_cast<char>('a' + i)));
+                }
+                const array ar = array(string_array(words, std::vector<std::size_t>{7, 12})).slice(5, 25);
+                const array result = compute::take(ar, indices);
+                REQUIRE_EQ(result.size(), indices.size());
+                for (std::size_t i = 0; i < indices.size(); ++i)
+                {
+                    CHECK_EQ(result[i], ar[indices[i]]);
+                }
+            }
+
+            SUBCASE("bool")
+            {
+                std::vector<bool> values(20);
+                for (std::size_t i = 0; i < values.size(); ++i)
+                {
+                    values[i] = i % 3 == 0;
+                }
+                const array ar(primitive_array<bool>(values, std::vector<std::size_t>{4}));
+                const array result = compute::take(ar, indices);
+                for (std::size_t i = 0; i < indices.size(); ++i)
+                {
+                    CHECK_EQ(result[i], ar[indices[i]]);
+                }
+            }
+
+            SUBCASE("list")
+            {
+                std::vector<std::size_t> sizes;
+                std::size_t flat_size = 0;
+                for (std::size_t i = 0; i < 20; ++i)
+                {
+                    sizes.push_back(i % 4);
+                    flat_size += i % 4;
+                }
+                std::vector<std::int32_t> flat(flat_size);
+                std::iota(flat.begin(), flat.end(), 0);
+                const array ar(list_array(
+                    array(primitive_array<std::int32_t>(flat)),
+                    list_array::offset_from_sizes(sizes),
+                    std::vector<std::size_t>{9}
+                ));
+                const array result = compute::take(ar, indices);
+                REQUIRE_EQ(result.size(), indices.size());
+                CHECK_EQ(result.null_count(), 2);
+                for (std::size_t i = 0; i < indices.size(); ++i)
+                {
+                    CHECK_EQ(result[i], ar[indices[i]]);
+                }
+            }
+
+            SUBCASE("struct")
+            {
+                std::vector<array> children;
+                children.emplace_back(make_array(0, {2}));
+                children.emplace_back(make_array(100, {}));
+                const array ar(struct_array(std::move(children), std::vector<std::size_t>{17}));
+                const array result = compute::take(ar, indices);
+                CHECK_EQ(result.null_count(), 1);
+                for (std::size_t i = 0; i < indices.size(); ++i)
+                {
+                    CHECK_EQ(result[i], ar[indices[i]]);
+                }
+            }
+
+            SUBCASE("dictionary")
+            {
+                const array ar = compute::dictionary_encode(array(make_array(0, {3})));
+                const array result = compute::take(ar, indices);
+                REQUIRE(result.dictionary().has_value());
+                for (std::size_t i = 0; i < indices.size(); ++i)
+                {
+                    CHECK_EQ(result[i], ar[indices[i]]);
+                }
+            }
+
+            SUBCASE("sort and take")
+            {
+                const array ar(primitive_array<std::int32_t>(std::vector<std::int32_t>{5, -1, 3, 3, 0}));
+                const array sorted = compute::take(ar, compute::sort_indices(ar));
+                CHECK_EQ(sorted, array(primitive_array<std::int32_t>(std::vector<std::int32_t>{-1, 0, 3, 3, 5})));
+            }
+
+            SUBCASE("record_batch")
+            {
+                const record_batch rb(
+                    std::vector<std::string>{"a", "b"},
+                    std::vector<array>{array(make_array(0, {})), array(make_array(50, {4}))}
+                );
+                const record_batch result = compute::take(rb, indices);
+                CHECK_EQ(result.nb_rows(), indices.size());
+                CHECK_EQ(result.get_column_name(1), "b");
+                for (std::size_t i = 0; i < indices.size(); ++i)
+                {
+                    CHECK_EQ(result.get_column(1)[i], rb.get_column(1)[indices[i]]);
+                }
+            }
+
+            SUBCASE("string view")
+            {
+                std::vector<std::string> words;
+                for (std::size_t i = 0; i < 20; ++i)
+                {
+                    words.push_back(std::string(i * 2, static_cast<char>('a' + i)));
+                }
+                const array ar(string_view_array(words, std::vector<std::size_t>{9}));
+                const array result = compute::take(ar, indices);
+                REQUIRE_EQ(result.size(), indices.size());
+                CHECK_EQ(result.null_count(), 2);
+                for (std::size_t i = 0; i < indices.size(); ++i)
+                {
+                    CHECK_EQ(result[i], ar[indices[i]]);
+                }
+            }
+
+            SUBCASE("list view")
+            {
+                std::vector<std::int32_t> flat(30);
+                std::iota(flat.begin(), flat.end(), 0);
+                std::vector<std::int32_t> offsets;
+                std::vector<std::int32_t> sizes;
+                for (std::int32_t i = 0; i < 20; ++i)
+                {
+                    offsets.push_back(27 - i);
+                    sizes.push_back(i % 3);
+                }
+                const array ar(list_view_array(
+                    array(primitive_array<std::int32_t>(flat)),
+                    std::move(offsets),
+                    std::move(sizes),
+                    std::vector<std::size_t>{4}
+                ));
+                const array result = compute::take(ar, indices);
+                REQUIRE_EQ(result.size(), indices.size());
+                CHECK_EQ(result.null_count(), 1);
+                for (std::size_t i = 0; i < indices.size(); ++i)
+                {
+                    CHECK_EQ(result[i], ar[indices[i]]);
+                }
+            }
+
+            SUBCASE("sparse union")
+            {
+                sparse_union_array::type_id_buffer_type type_ids(20, std::uint8_t(0));
+                for (std::size_t i = 0; i < 20; ++i)
+                {
+                    type_ids[i] = i % 3 == 0 ? std::uint8_t(7) : std::uint8_t(4);
+                }
+                std::vector<array> children;
+                children.emplace_back(make_array(0, {1}));
+                children.emplace_back(make_array(100, {}));
+                const array ar(sparse_union_array(
+                    std::move(children),
+                    std::move(type_ids),
+                    std::make_optional(std::vector<std::size_t>{4, 7})
+                ));
+                const array result = compute::take(ar, indices);
+                REQUIRE_EQ(result.size(), indices.size());
+                for (std::size_t i = 0; i < indices.size(); ++i)
+                {
+                    CHECK_EQ(result[i], ar[indices[i]]);
+                }
+            }
+
+            SUBCASE("dense union")
+            {
+                dense_union_array::type_id_buffer_type type_ids(20, std::uint8_t(0));
+                dense_union_array::offset_buffer_type offsets(20, std::uint32_t(0));
+                std::uint32_t child_sizes[2] = {0, 0};
+                for (std::size_t i = 0; i < 20; ++i)
+                {
+                    const std::size_t child = i % 3 == 0 ? 1 : 0;
+                    type_ids[i] = child == 0 ? std::uint8_t(5) : std::uint8_t(2);
+                    offsets[i] = child_sizes[child]++;
+                }
+                std::vector<array> children;
+                children.emplace_back(make_array(0, {3}));
+                children.emplace_back(make_array(100, {}));
+                const array ar(dense_union_array(
+                    std::move(children),
+                    std::move(type_ids),
+                    std::move(offsets),
+                    std::make_optional(std::vector<std::size_t>{5, 2})
+                ));
+                const array result = compute::take(ar, indices);
+                REQUIRE_EQ(result.size(), indices.size());
+                for (std::size_t i = 0; i < indices.size(); ++i)
+                {
+                    CHECK_EQ(result[i], ar[indices[i]]);
+                }
+            }
+
+            SUBCASE("run-end encoded")
+            {
+                const array ar(run_end_encoded_array(
+                    array(primitive_array<std::int32_t>(std::vector<std::int32_t>{3, 5, 12, 20})),
+                    array(primitive_array<std::int32_t>(
+                        std::vector<std::int32_t>{10, 20, 30, 40},
+                        std::vector<std::size_t>{2}
+                    ))
+                ));
+                const array result = compute::take(ar, indices);
+                REQUIRE_EQ(result.size(), indices.size());
+                CHECK_EQ(result.null_count(), 2);
+                for (std::size_t i = 0; i < indices.size(); ++i)
+                {
+                    CHECK_EQ(result[i], ar[indices[i]]);
+                }
+
+                // Consecutive elements of the same run are merged
+                const std::vector<std::size_t> sorted{0, 1, 2, 4, 6, 13, 19};
+                const array merged = compute::take(ar, sorted);
+                CHECK_EQ(sparrow::detail::array_access::get_arrow_proxy(merged).children()[0].length(), 4);
+                for (std::size_t i = 0; i < sorted.size(); ++i)
+                {
+                    CHECK_EQ(merged[i], ar[sorted[i]]);
+                }
+            }
+
+            SUBCASE("index out of range")
+            {
+                const array ar(make_array(0, {}));
+                const std::vector<std::size_t> bad{0, 20};
+                CHECK_THROWS_AS(std::ignore = compute::take(ar, bad), std::out_of_range);
+            }
+        }
+
+        TEST_CASE("filter")
+        {
+            SUBCASE("primitive")
+            {
+                const dynamic_bitset<std::uint8_t> mask = compute::greater(make_array(0, {3, 14}), 6);
+                const array ar(make_array(0, {3, 14}));
+                std::vector<std::size_t> selected;
+                for (std::size_t i = 0; i < mask.size(); ++i)
+                {
+                    if (mask.test(i))
+                    {
+                        selected.push_back(i);
+                    }
+                }
+                const array result = compute::filter(ar, mask);
+                REQUIRE_EQ(result.size(), selected.size());
+                CHECK_EQ(result, compute::take(ar, selected));
+            }
+
+            SUBCASE("long mask")
+            {
+                std::vector<std::int64_t> values(200);
+                std::iota(values.begin(), values.end(), 0);
+                const array ar = array(primitive_array<std::int64_t>(values)).slice(3, 200);
+                std::vector<bool> bits(197, false);
+                std::vector<std::size_t> selected;
+                for (std::size_t i = 0; i < bits.size(); ++i)
+                {
+                    if (i % 7 != 0 && (i < 64 || i > 130))
+                    {
+                        bits[i] = true;
+                        selected.push_back(i);
+                    }
+                }
+                const dynamic_bitset<std::uint8_t> mask(bits, std::allocator<std::uint8_t>());
+                const array result = compute::filter(ar, mask);
+                REQUIRE_EQ(result.size(), selected.size());
+                for (std::size_t i = 0; i < selected.size(); ++i)
+                {
+                    CHECK_EQ(result[i], ar[selected[i]]);
+                }
+            }
+
+            SUBCASE("strings")
+            {
+                const std::vector<std::string> words{"a", "bb", "ccc", "dddd", "eeeee"};
+                const array ar(string_array(words, std::vector<std::size_t>{1}));
+                const dynamic_bitset<std::uint8_t> mask(
+                    std::vector<bool>{true, true, false, false, true},
+                    std::allocator<std::uint8_t>()
+                );
+                const array result = compute::filter(ar, mask);
+                REQUIRE_EQ(result.size(), 3);
+                CHECK_EQ(result[0], ar[0]);
+                CHECK_EQ(result[1], ar[1]);
+                CHECK_EQ(result[2], ar[4]);
+            }
+
+            SUBCASE("record_batch")
+            {
+                const record_batch rb(
+                    std::vector<std::string>{"a", "b"},
+                    std::vector<array>{array(make_array(0, {})), array(string_array(std::vector<std::string>(20, "xyz")))}
+                );
+                const dynamic_bitset<std::uint8_t> mask = compute::less(make_array(0, {}), 5);
+                const record_batch result = compute::filter(rb, mask);
+                CHECK_EQ(result.nb_rows(), 5);
+                CHECK_EQ(result.get_column(0), compute::take(rb.get_column(0), std::vector<std::size_t>{0, 1, 2, 3, 4}));
+            }
+
+            SUBCASE("size mismatch")
+            {
+                const array ar(make_array(0, {}));
+                const dynamic_bitset<std::uint8_t> mask(std::vector<bool>(19, true), std::allocator<std::uint8_t>());
+                CHECK_THROWS_AS(std::ignore = compute::filter(ar, mask), std::invalid_argument);
+            }
+        }
+
+        TEST_CASE("hash")
+        {
+            SUBCASE("primitive")
+            {
+                const array ar(primitive_array<std::int32_t>(
+                    std::vector<std::int32_t>{4, 7, 4, 0, 7, 1},
+                    std::vector<std::size_t>{3, 5}
+                ));
+                const primitive_array<std::uint64_t> hashes = compute::hash(ar);
+                REQUIRE_EQ(hashes.size(), 6);
+                CHECK_EQ(hashes.null_count(), 0);
+                CHECK_EQ(hashes[0].value(), hashes[2].value());
+                CHECK_EQ(hashes[1].value(), hashes[4].value());
+                CHECK_NE(hashes[0].value(), hashes[1].value());
+                CHECK_EQ(hashes[3].value(), hashes[5].value());
+                CHECK_NE(hashes[0].value(), hashes[3].value());
+            }
+
+            SUBCASE("sliced strings")
+            {
+                const std::vector<std::string> words{"x", "apple", "pear", "apple", "pear", "plum"};
+                const array ar = array(string_array(words)).slice(1, 6);
+                const primitive_array<std::uint64_t> hashes = compute::hash(ar);
+                REQUIRE_EQ(hashes.size(), 5);
+                CHECK_EQ(hashes[0].value(), hashes[2].value());
+                CHECK_EQ(hashes[1].value(), hashes[3].value());
+                CHECK_NE(hashes[0].value(), hashes[4].value());
+            }
+
+            SUBCASE("dictionary")
+            {
+                const array ar(make_array(0, {2, 11}));
+                const primitive_array<std::uint64_t> plain = compute::hash(ar);
+                const primitive_array<std::uint64_t> encoded = compute::hash(compute::dictionary_encode(ar));
+                CHECK_EQ(plain, encoded);
+            }
+
+            SUBCASE("list")
+            {
+                const array ar(list_array(
+                    array(primitive_array<std::int32_t>(std::vector<std::int32_t>{1, 2, 1, 2, 1})),
+                    list_array::offset_from_sizes(std::vector<std::size_t>{2, 2, 1}),
+                    std::vector<std::size_t>{}
+                ));
+                const primitive_array<std::uint64_t> hashes = compute::hash(ar);
+                CHECK_EQ(hashes[0].value(), hashes[1].value());
+                CHECK_NE(hashes[0].value(), hashes[2].value());
+            }
+
+            SUBCASE("record_batch")
+            {
+                const record_batch rb(
+                    std::vector<std::string>{"a", "b"},
+                    std::vector<array>{
+                        array(primitive_array<std::int32_t>(std::vector<std::int32_t>{1, 1, 2})),
+                        array(string_array(std::vector<std::string>{"u", "v", "u"}))
+                    }
+                );
+                const std::vector<std::string> both{"a", "b"};
+                const std::vector<std::string> only_a{"a"};
+                const primitive_array<std::uint64_t> hashes = compute::hash(rb, both);
+                CHECK_NE(hashes[0].value(), hashes[1].value());
+                const primitive_array<std::uint64_t> a_hashes = compute::hash(rb, only_a);
+                CHECK_EQ(a_hashes[0].value(), a_hashes[1].value());
+                const std::vector<std::string> unknown{"c"};
+                CHECK_THROWS_AS(std::ignore = compute::hash(rb, unknown), std::out_of_range);
+            }
+        }
+
+        TEST_CASE("equals")
+        {
+            SUBCASE("dense primitive")
+            {
+                std::vector<std::int64_t> lhs(37);
+                std::iota(lhs.begin(), lhs.end(), 0);
+                std::vector<std::int64_t> rhs = lhs;
+                rhs[3] = -1;
+                rhs[36] = -1;
+                const dynamic_bitset<std::uint8_t> mask = compute::equals(
+                    array(primitive_array<std::int64_t>(lhs)),
+                    array(primitive_array<std::int64_t>(rhs))
+                );
+                REQUIRE_EQ(mask.size(), 37);
+                CHECK_EQ(mask.null_count(), 2);
+                CHECK_FALSE(mask.test(3));
+                CHECK_FALSE(mask.test(36));
+                CHECK(mask.test(35));
+            }
+
+            SUBCASE("nulls")
+            {
+                const array lhs(make_array(0, {1, 2}));
+                const array rhs(make_array(0, {2, 4}));
+                const dynamic_bitset<std::uint8_t> mask = compute::equals(lhs, rhs);
+                CHECK(mask.test(0));
+                CHECK_FALSE(mask.test(1));
+                CHECK(mask.test(2));
+                CHECK_FALSE(mask.test(4));
+                CHECK_EQ(mask.null_count(), 2);
+            }
+
+            SUBCASE("struct")
+            {
+                std::vector<array> lhs_children;
+                lhs_children.emplace_back(make_array(0, {}));
+                lhs_children.emplace_back(array(string_array(std::vector<std::string>(20, "a"))));
+                std::vector<array> rhs_children;
+                rhs_children.emplace_back(make_array(0, {}));
+                std::vector<std::string> words(20, "a");
+                words[7] = "b";
+                rhs_children.emplace_back(array(string_array(words)));
+                const dynamic_bitset<std::uint8_t> mask = compute::equals(
+                    array(struct_array(std::move(lhs_children))),
+                    array(struct_array(std::move(rhs_children)))
+                );
+                CHECK_EQ(mask.null_count(), 1);
+                CHECK_FALSE(mask.test(7));
+            }
+
+            SUBCASE("errors")
+            {
+                const array ar(make_array(0, {}));
+                CHECK_THROWS_AS(std::ignore = compute::equals(ar, ar.slice(1, 20)), std::invalid_argument);
+                const array other(primitive_array<std::int64_t>(std::vector<std::int64_t>(20, 0)));
+                CHECK_THROWS_AS(std::ignore = compute::equals(ar, other), std::invalid_argument);
+            }
+        }
+
+        TEST_CASE("group_by")
+        {
+            const record_batch rb(
+                std::vector<std::string>{"k", "s", "v"},
+                std::vector<array>{
+                    array(primitive_array<std::int32_t>(
+                        std::vector<std::int32_t>{1, 2, 1, 0, 2, 1, 0},
+                        std::vector<std::size_t>{3, 6}
+                    )),
+                    array(string_array(std::vector<std::string>{"a", "b", "a", "c", "b", "z", "d"})),
+                    array(make_array(0, {}).slice(0, 7))
+                }
+            );
+
+            SUBCASE("single key")
+            {
+                const std::vector<std::string> keys{"k"};
+                const compute::grouping groups = compute::group_by(rb, keys);
+                CHECK_EQ(groups.group_ids, std::vector<std::size_t>{0, 1, 0, 2, 1, 0, 2});
+                CHECK_EQ(groups.first_rows, std::vector<std::size_t>{0, 1, 3});
+            }
+
+            SUBCASE("several keys")
+            {
+                const std::vector<std::string> keys{"k", "s"};
+                const compute::grouping groups = compute::group_by(rb, keys);
+                CHECK_EQ(groups.group_ids, std::vector<std::size_t>{0, 1, 0, 2, 1, 3, 4});
+            }
+
+            SUBCASE("dedupe")
+            {
+                const std::vector<std::string> keys{"k", "s"};
+                const record_batch deduped = compute::take(rb, compute::group_by(rb, keys).first_rows);
+                CHECK_EQ(deduped.nb_rows(), 5);
+                CHECK_EQ(deduped.get_column("s")[4], rb.get_column("s")[6]);
+            }
+        }
+
+        TEST_CASE("hash_join")
+        {
+            const record_batch left(
+                std::vector<std::string>{"id", "x"},
+                std::vector<array>{
+                    array(primitive_array<std::int32_t>(
+                        std::vector<std::int32_t>{3, 1, 4, 1, 5, 0},
+                        std::vector<std::size_t>{5}
+                    )),
+                    array(make_array(0, {}).slice(0, 6))
+                }
+            );
+            const record_batch right(
+                std::vector<std::string>{"key"},
+                std::vector<array>{array(primitive_array<std::int32_t>(
+                    std::vector<std::int32_t>{1, 4, 9, 1, 0},
+                    std::vector<std::size_t>{4}
+                ))}
+            );
+            const std::vector<std::string> left_keys{"id"};
+            const std::vector<std::string> right_keys{"key"};
+
+            SUBCASE("inner join")
+            {
+                const auto pairs = compute::hash_join(left, left_keys, right, right_keys);
+                const std::vector<std::pair<std::size_t, std::size_t>> expected{{1, 0}, {1, 3}, {2, 1}, {3, 0}, {3, 3}};
+                CHECK_EQ(pairs, expected);
+            }
+
+            SUBCASE("errors")
+            {
+                const std::vector<std::string> two_keys{"id", "x"};
+                CHECK_THROWS_AS(
+                    std::ignore = compute::hash_join(left, two_keys, right, right_keys),
+                    std::invalid_argument
+                );
+                const record_batch other(
+                    std::vector<std::string>{"key"},
+                    std::vector<array>{array(string_array(std::vector<std::string>{"1"}))}
+                );
+                CHECK_THROWS_AS(
+                    std::ignore = compute::hash_join(left, left_keys, other, right_keys),
+                    std::invalid_argument
+                );
+            }
+        }
+    }
+}
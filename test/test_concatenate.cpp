@@ -0,0 +1,238 @@
+// Copyright 2024 Man Group Operations Limited
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "sparrow/concatenate.hpp"
+#include "sparrow/list_array.hpp"
+#include "sparrow/null_array.hpp"
+#include "sparrow/primitive_array.hpp"
+#include "sparrow/record_batch.hpp"
+#include "sparrow/run_end_encoded_array.hpp"
+#include "sparrow/struct_array.hpp"
+#include "sparrow/variable_size_binary_array.hpp"
+
+#include "doctest/doctest.h"
+
+namespace sparrow
+{
+    namespace
+    {
+        // Every third element is null
+        std::vector<std::size_t> make_nulls(std::size_t size)
+        {
+            std::vector<std::size_t> nulls;
+            for (std::size_t i = 0; i < size; i += 3)
+            {
+                nulls.push_back(i);
+            }
+            return nulls;
+        }
+
+        primitive_array<std::int32_t> make_int_array(std::size_t size, bool with_nulls)
+        {
+            std::vector<std::int32_t> values(size);
+            for (std::size_t i = 0; i < size; ++i)
+            {
+                values[i] = static_cast<std::int32_t>(i);
+            }
+            if (with_nulls)
+            {
+                return primitive_array<std::int32_t>(values, make_nulls(size));
+            }
+            return primitive_array<std::int32_t>(values);
+        }
+
+        std::vector<std::string> make_strings(std::size_t size)
+        {
+            std::vector<std::string> values;
+            for (std::size_t i = 0; i < size; ++i)
+            {
+                values.push_back(std::string(i % 5, static_cast<char>('a' + i % 26)));
+            }
+            return values;
+        }
+
+        // Checks that the concatenation of consecutive slices of the same array gives
+        // the values of the array between the first and the last bounds.
+        void check_slices(const array& ar, const std::vector<std::size_t>& bounds)
+        {
+            std::vector<array> slices;
+            for (std::size_t i = 0; i + 1 < bounds.size(); ++i)
+            {
+                slices.push_back(ar.slice_view(bounds[i], bounds[i + 1]));
+            }
+            const array result = concatenate(slices);
+            REQUIRE_EQ(result.size(), bounds.back() - bounds.front());
+            CHECK_EQ(result.null_count(), ar.slice(bounds.front(), bounds.back()).null_count());
+            for (std::size_t i = 0; i < result.size(); ++i)
+            {
+                CHECK_EQ(result[i], ar[bounds.front() + i]);
+            }
+        }
+    }
+
+    TEST_SUITE("concatenate")
+    {
+        TEST_CASE("primitive")
+        {
+            const array ar(make_int_array(300, true));
+
+            SUBCASE("whole arrays")
+            {
+                check_slices(ar, {0, 300});
+                const std::vector<array> arrays{ar, ar};
+                const array result = concatenate(arrays);
+                REQUIRE_EQ(result.size(), 600);
+                CHECK_EQ(result.null_count(), 2 * ar.null_count());
+                CHECK_EQ(result[300], ar[0]);
+                CHECK_EQ(result[599], ar[299]);
+            }
+
+            SUBCASE("unaligned slices")
+            {
+                check_slices(ar, {3, 8, 8, 75, 140, 141, 299});
+                check_slices(ar, {1, 66, 131, 200, 267});
+            }
+
+            SUBCASE("without nulls")
+            {
+                const array no_nulls(make_int_array(100, false));
+                const std::vector<array> arrays{no_nulls.slice_view(5, 70), ar.slice_view(7, 90)};
+                const array result = concatenate(arrays);
+                REQUIRE_EQ(result.size(), 148);
+                CHECK_EQ(result.null_count(), ar.slice(7, 90).null_count());
+                for (std::size_t i = 0; i < 65; ++i)
+                {
+                    CHECK_EQ(result[i], no_nulls[i + 5]);
+                }
+                for (std::size_t i = 0; i < 83; ++i)
+                {
+                    CHECK_EQ(result[65 + i], ar[i + 7]);
+                }
+            }
+        }
+
+        TEST_CASE("bool")
+        {
+            std::vector<bool> values(200);
+            for (std::size_t i = 0; i < values.size(); ++i)
+            {
+                values[i] = (i % 7) < 3;
+            }
+            const array ar(primitive_array<bool>(values, make_nulls(values.size())));
+            check_slices(ar, {0, 200});
+            check_slices(ar, {5, 13, 100, 101, 190});
+        }
+
+        TEST_CASE("string")
+        {
+            const auto strings = make_strings(150);
+            const array ar(string_array(strings, make_nulls(strings.size())));
+            check_slices(ar, {0, 150});
+            check_slices(ar, {2, 9, 9, 80, 149});
+
+            const array big{big_string_array(strings)};
+            check_slices(big, {4, 50, 150});
+        }
+
+        TEST_CASE("list")
+        {
+            std::vector<std::size_t> sizes;
+            std::size_t flat_size = 0;
+            for (std::size_t i = 0; i < 80; ++i)
+            {
+                sizes.push_back(i % 4);
+                flat_size += i % 4;
+            }
+            array flat(make_int_array(flat_size, true));
+            const array ar(list_array(std::move(flat), list_array::offset_from_sizes(sizes), true));
+            check_slices(ar, {0, 80});
+            check_slices(ar, {3, 10, 41, 79});
+        }
+
+        TEST_CASE("struct")
+        {
+            std::vector<array> children;
+            children.emplace_back(make_int_array(120, true));
+            children.emplace_back(string_array(make_strings(120)));
+            const array ar(struct_array(std::move(children), true));
+            check_slices(ar, {0, 120});
+            check_slices(ar, {1, 17, 64, 119});
+        }
+
+        TEST_CASE("null")
+        {
+            const std::vector<array> arrays{array(null_array(5)), array(null_array(7))};
+            const array result = concatenate(arrays);
+            CHECK_EQ(result.size(), 12);
+            CHECK_EQ(result.null_count(), 12);
+        }
+
+        TEST_CASE("errors")
+        {
+            SUBCASE("empty range")
+            {
+                CHECK_THROWS_AS(std::ignore = concatenate(std::vector<array>{}), std::invalid_argument);
+            }
+
+            SUBCASE("different formats")
+            {
+                const std::vector<array> arrays{
+                    array(make_int_array(3, false)),
+                    array(primitive_array<std::int64_t>(std::vector<std::int64_t>{1, 2}))
+                };
+                CHECK_THROWS_AS(std::ignore = concatenate(arrays), std::invalid_argument);
+            }
+
+            SUBCASE("unsupported layout")
+            {
+                primitive_array<std::int32_t> run_ends(std::vector<std::int32_t>{2, 5});
+                array ree(run_end_encoded_array(array(std::move(run_ends)), array(make_int_array(2, false))));
+                const std::vector<array> arrays{ree, ree};
+                CHECK_THROWS_AS(std::ignore = concatenate(arrays), std::invalid_argument);
+            }
+        }
+
+        TEST_CASE("record_batch")
+        {
+            record_batch rb(
+                {{"ints", array(make_int_array(100, true))},
+                 {"strings", array(string_array(make_strings(100), make_nulls(100)))}}
+            );
+
+            SUBCASE("slices")
+            {
+                const std::vector<record_batch> parts{
+                    rb.slice_view(0, 13),
+                    rb.slice_view(13, 64),
+                    rb.slice_view(64, 64),
+                    rb.slice_view(64, 100)
+                };
+                const record_batch result = concatenate(parts);
+                CHECK_EQ(result, rb);
+            }
+
+            SUBCASE("different columns")
+            {
+                record_batch other({{"ints", array(make_int_array(10, true))}});
+                const std::vector<record_batch> parts{rb, other};
+                CHECK_THROWS_AS(std::ignore = concatenate(parts), std::invalid_argument);
+            }
+        }
+    }
+}
@@ -16,6 +16,7 @@
 #include <cstddef>
 #include <cstdint>
 #include <ranges>
+#include <vector>
 
 #include "sparrow/buffer/dynamic_bitset/dynamic_bitset.hpp"
 #include "sparrow/buffer/dynamic_bitset/dynamic_bitset_view.hpp"
@@ -1163,6 +1164,88 @@ namespace sparrow
                 }
             }
 
+            SUBCASE("apply_edits")
+            {
+                const std::array<bitset_edit, 6> edits{
+                    {{bitset_edit_kind::insert, 0, 3, false},
+                     {bitset_edit_kind::erase, 0, 2},
+                     {bitset_edit_kind::assign, 5, 4, true},
+                     {bitset_edit_kind::insert, 12, 10, true},
+                     {bitset_edit_kind::erase, 12, 9},
+                     {bitset_edit_kind::insert, s_bitmap_size, 2, false}}
+                };
+
+                // Applies the edits on a std::vector<bool> to get the expected bits
+                auto apply_to_reference = [&edits](const bitmap& b)
+                {
+                    std::vector<bool> expected;
+                    std::size_t src = 0;
+                    for (const auto& edit : edits)
+                    {
+                        for (; src < edit.position; ++src)
+                        {
+                            expected.push_back(b.test(src));
+                        }
+                        if (edit.kind != bitset_edit_kind::erase)
+                        {
+                            expected.insert(expected.end(), edit.count, edit.value);
+                        }
+                        if (edit.kind != bitset_edit_kind::insert)
+                        {
+                            src += edit.count;
+                        }
+                    }
+                    for (; src < b.size(); ++src)
+                    {
+                        expected.push_back(b.test(src));
+                    }
+                    return expected;
+                };
+
+                auto check_bits = [](const bitmap& b, const std::vector<bool>& expected)
+                {
+                    REQUIRE_EQ(b.size(), expected.size());
+                    for (std::size_t i = 0; i < expected.size(); ++i)
+                    {
+                        CHECK_EQ(b.test(i), expected[i]);
+                    }
+                    CHECK_EQ(b.null_count(), static_cast<std::size_t>(std::ranges::count(expected, false)));
+                };
+
+                SUBCASE("from non null buffer")
+                {
+                    bitmap b = make_bitmap(f.get_buffer(), s_bitmap_size, std::allocator<uint8_t>());
+                    const auto expected = apply_to_reference(b);
+                    b.apply_edits(edits);
+                    check_bits(b, expected);
+                }
+                SUBCASE("from null buffer")
+                {
+                    bitmap b = make_bitmap(null_f.get_buffer(), s_bitmap_size, std::allocator<uint8_t>());
+                    const auto expected = apply_to_reference(b);
+                    b.apply_edits(edits);
+                    check_bits(b, expected);
+                }
+                SUBCASE("from null buffer with set bits only")
+                {
+                    bitmap b = make_bitmap(null_f.get_buffer(), s_bitmap_size, std::allocator<uint8_t>());
+                    const std::array<bitset_edit, 2> set_edits{
+                        {{bitset_edit_kind::insert, 3, 10, true}, {bitset_edit_kind::erase, 5, 2}}
+                    };
+                    b.apply_edits(set_edits);
+                    CHECK_EQ(b.size(), s_bitmap_size + 8);
+                    CHECK_EQ(b.null_count(), 0);
+                    CHECK_EQ(b.data(), nullptr);
+                }
+                SUBCASE("empty")
+                {
+                    bitmap b = make_bitmap(f.get_buffer(), s_bitmap_size, std::allocator<uint8_t>());
+                    b.apply_edits({});
+                    CHECK_EQ(b.size(), s_bitmap_size);
+                    CHECK_EQ(b.null_count(), m_bitmap_null_count);
+                }
+            }
+
             SUBCASE("bitset_reference")
             {
                 SUBCASE("from non null buffer")
@@ -1442,6 +1525,46 @@ namespace sparrow
             }
         }
 
+        TEST_CASE("parallel count_non_null")
+        {
+            std::vector<std::uint8_t> buffer(100003);
+            std::uint32_t state = 12345;
+            for (auto& byte : buffer)
+            {
+                state = state * 1664525u + 1013904223u;
+                byte = static_cast<std::uint8_t>(state >> 24);
+            }
+            const std::size_t bit_size = buffer.size() * 8 - 13;
+            const std::size_t expected = count_non_null(buffer.data(), bit_size, buffer.size(), 5);
+            const std::size_t expected_prefix = count_non_null(buffer.data(), 8 * 5000 + 3, buffer.size(), 0);
+
+            const parallel_count_settings previous = get_parallel_count_settings();
+            CHECK_EQ(previous.min_byte_size, 0);
+
+            SUBCASE("above the threshold")
+            {
+                set_parallel_count_settings({1024, 4});
+                CHECK_EQ(get_parallel_count_settings().num_threads, 4);
+                CHECK_EQ(count_non_null(buffer.data(), bit_size, buffer.size(), 5), expected);
+                CHECK_EQ(count_non_null(buffer.data(), 8 * 5000 + 3, buffer.size(), 0), expected_prefix);
+            }
+
+            SUBCASE("below the threshold")
+            {
+                set_parallel_count_settings({buffer.size() + 1, 4});
+                CHECK_EQ(count_non_null(buffer.data(), bit_size, buffer.size(), 5), expected);
+            }
+
+            SUBCASE("tracking null count")
+            {
+                set_parallel_count_settings({1024, 0});
+                const dynamic_bitset_view<const std::uint8_t> view(buffer.data(), bit_size, 5);
+                CHECK_EQ(view.null_count(), bit_size - expected);
+            }
+
+            set_parallel_count_settings(previous);
+        }
+
         TEST_CASE("non_tracking_null_count")
         {
             SUBCASE("operations are no-ops")
@@ -1924,6 +2047,88 @@ namespace sparrow
             }
         }
 
+        TEST_CASE("apply_edits with offset and many edits")
+        {
+            constexpr std::size_t size = 1000;
+            constexpr std::size_t offset = 3;
+            dynamic_bitset<std::uint8_t> b(size + offset, false, dynamic_bitset<std::uint8_t>::default_allocator());
+            std::vector<bool> bits(size);
+            for (std::size_t i = 0; i < size; ++i)
+            {
+                bits[i] = (i * 7) % 3 != 0;
+                b.set(i + offset, bits[i]);
+            }
+            dynamic_bitset<std::uint8_t> sliced(
+                b.extract_storage(),
+                size,
+                offset,
+                static_cast<std::size_t>(std::ranges::count(bits, false))
+            );
+
+            std::vector<bitset_edit> edits;
+            std::vector<bool> expected;
+            std::size_t src = 0;
+            for (std::size_t position = 1; position + 5 < size; position += 37)
+            {
+                const auto kind = static_cast<bitset_edit_kind>(position % 3);
+                const std::size_t count = position % 13 + 1;
+                const bool value = position % 2 == 0;
+                edits.push_back({kind, position, count, value});
+
+                expected.insert(expected.end(), bits.begin() + static_cast<std::ptrdiff_t>(src), bits.begin() + static_cast<std::ptrdiff_t>(position));
+                src = position;
+                if (kind != bitset_edit_kind::erase)
+                {
+                    expected.insert(expected.end(), count, value);
+                }
+                if (kind != bitset_edit_kind::insert)
+                {
+                    src += count;
+                }
+            }
+            expected.insert(expected.end(), bits.begin() + static_cast<std::ptrdiff_t>(src), bits.end());
+
+            sliced.apply_edits(edits);
+            REQUIRE_EQ(sliced.size(), expected.size());
+            CHECK_EQ(sliced.offset(), offset);
+            for (std::size_t i = 0; i < expected.size(); ++i)
+            {
+                CHECK_EQ(sliced.test(i), expected[i]);
+            }
+            CHECK_EQ(sliced.null_count(), static_cast<std::size_t>(std::ranges::count(expected, false)));
+        }
+
+        TEST_CASE("push_back, insert and resize with offset keep the null count")
+        {
+            constexpr std::size_t offset = 5;
+            dynamic_bitset<std::uint8_t> b(offset, false, dynamic_bitset<std::uint8_t>::default_allocator());
+            dynamic_bitset<std::uint8_t> sliced(b.extract_storage(), 0, offset, 0);
+            std::vector<bool> expected;
+            for (std::size_t i = 0; i < 200; ++i)
+            {
+                const bool value = i % 3 != 0;
+                sliced.push_back(value);
+                expected.push_back(value);
+                if (i % 10 == 0)
+                {
+                    sliced.insert(sliced.cbegin() + static_cast<std::ptrdiff_t>(i / 2), 3, !value);
+                    expected.insert(expected.begin() + static_cast<std::ptrdiff_t>(i / 2), 3, !value);
+                }
+                CHECK_EQ(sliced.null_count(), static_cast<std::size_t>(std::ranges::count(expected, false)));
+            }
+
+            sliced.resize(100);
+            expected.resize(100);
+            CHECK_EQ(sliced.null_count(), static_cast<std::size_t>(std::ranges::count(expected, false)));
+            sliced.resize(150, true);
+            expected.resize(150, true);
+            CHECK_EQ(sliced.null_count(), static_cast<std::size_t>(std::ranges::count(expected, false)));
+            for (std::size_t i = 0; i < expected.size(); ++i)
+            {
+                CHECK_EQ(sliced.test(i), expected[i]);
+            }
+        }
+
         TEST_CASE("dynamic_bitset_view - set to false with null buffer throws")
         {
             // A dynamic_bitset_view cannot allocate: setting a bit to false (null) when
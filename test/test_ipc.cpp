@@ -0,0 +1,675 @@
+// Copyright 2024 Man Group Operations Limited
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <optional>
+#include <span>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <tuple>
+#include <vector>
+
+#include "sparrow/arrow_interface/arrow_array_stream_proxy.hpp"
+#include "sparrow/dictionary_encoded_array.hpp"
+#include "sparrow/ipc/flatbuffer.hpp"
+#include "sparrow/ipc/ipc_format.hpp"
+#include "sparrow/ipc/ipc_reader.hpp"
+#include "sparrow/ipc/ipc_writer.hpp"
+#include "sparrow/ipc/memory_map.hpp"
+#include "sparrow/list_array.hpp"
+#include "sparrow/primitive_array.hpp"
+#include "sparrow/record_batch.hpp"
+#include "sparrow/variable_size_binary_array.hpp"
+
+#include "doctest/doctest.h"
+
+namespace sparrow
+{
+    namespace
+    {
+        record_batch make_batch(std::int32_t first)
+        {
+            std::vector<std::int32_t> values(10);
+            for (std::size_t i = 0; i < values.size(); ++i)
+            {
+                values[i] = first + static_cast<std::int32_t>(i);
+            }
+            primitive_array<std::int32_t> ints(values, std::vector<std::size_t>{2, 7});
+
+            std::vector<std::string> words(10);
+            for (std::size_t i = 0; i < words.size(); ++i)
+            {
+                words[i] = std::string(i % 4, 'a') + std::to_string(first);
+            }
+            string_array strings(words);
+
+            primitive_array<double> flat_values(std::vector<double>(20, static_cast<double>(first)));
+            list_array lists(array(std::move(flat_values)), list_array::offset_from_sizes(std::vector<std::size_t>(10, 2)));
+
+            return record_batch(
+                std::vector<std::string>{"ints", "strings", "lists"},
+                std::vector<array>{array(std::move(ints)), array(std::move(strings)), array(std::move(lists))},
+                "batch"
+            );
+        }
+
+        std::string write_stream(const std::vector<record_batch>& batches)
+        {
+            std::ostringstream oss;
+            ipc::stream_writer writer(oss);
+            for (const auto& batch : batches)
+            {
+                writer.write(batch);
+            }
+            writer.close();
+            return oss.str();
+        }
+
+        std::span<const std::uint8_t> as_bytes(const std::string& str)
+        {
+            return {reinterpret_cast<const std::uint8_t*>(str.data()), str.size()};
+        }
+
+        bool points_into(const void* ptr, std::span<const std::uint8_t> region)
+        {
+            const auto* p = static_cast<const std::uint8_t*>(ptr);
+            return p >= region.data() && p < region.data() + region.size();
+        }
+
+        // Written by pyarrow from the table {"i": int32 [1, null, 3], "s": utf8 ["a", "bc", null]}
+        constexpr std::uint8_t pyarrow_file[] = {
+            0x41, 0x52, 0x52, 0x4f, 0x57, 0x31, 0x00, 0x00, 0xff, 0xff, 0xff, 0xff, 0xa8, 0x00, 0x00, 0x00,
+            0x10, 0x00, 0x00, 0x00, 0x00, 0x00, 0x0a, 0x00, 0x0c, 0x00, 0x06, 0x00, 0x05, 0x00, 0x08, 0x00,
+            0x0a, 0x00, 0x00, 0x00, 0x00, 0x01, 0x04, 0x00, 0x0c, 0x00, 0x00, 0x00, 0x08, 0x00, 0x08, 0x00,
+            0x00, 0x00, 0x04, 0x00, 0x08, 0x00, 0x00, 0x00, 0x04, 0x00, 0x00, 0x00, 0x02, 0x00, 0x00, 0x00,
+            0x40, 0x00, 0x00, 0x00, 0x04, 0x00, 0x00, 0x00, 0xd8, 0xff, 0xff, 0xff, 0x00, 0x00, 0x01, 0x05,
+            0x10, 0x00, 0x00, 0x00, 0x18, 0x00, 0x00, 0x00, 0x04, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+            0x01, 0x00, 0x00, 0x00, 0x73, 0x00, 0x00, 0x00, 0x04, 0x00, 0x04, 0x00, 0x04, 0x00, 0x00, 0x00,
+            0x10, 0x00, 0x14, 0x00, 0x08, 0x00, 0x06, 0x00, 0x07, 0x00, 0x0c, 0x00, 0x00, 0x00, 0x10, 0x00,
+            0x10, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x02, 0x10, 0x00, 0x00, 0x00, 0x1c, 0x00, 0x00, 0x00,
+            0x04, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x00, 0x00, 0x00, 0x69, 0x00, 0x00, 0x00,
+            0x08, 0x00, 0x0c, 0x00, 0x08, 0x00, 0x07, 0x00, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01,
+            0x20, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xff, 0xff, 0xff, 0xff, 0xc8, 0x00, 0x00, 0x00,
+            0x14, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x0c, 0x00, 0x16, 0x00, 0x06, 0x00, 0x05, 0x00,
+            0x08, 0x00, 0x0c, 0x00, 0x0c, 0x00, 0x00, 0x00, 0x00, 0x03, 0x04, 0x00, 0x18, 0x00, 0x00, 0x00,
+            0x38, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x0a, 0x00, 0x18, 0x00, 0x0c, 0x00,
+            0x04, 0x00, 0x08, 0x00, 0x0a, 0x00, 0x00, 0x00, 0x6c, 0x00, 0x00, 0x00, 0x10, 0x00, 0x00, 0x00,
+            0x03, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x05, 0x00, 0x00, 0x00,
+            0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+            0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x0c, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+            0x18, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+            0x20, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x10, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+            0x30, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x03, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+            0x00, 0x00, 0x00, 0x00, 0x02, 0x00, 0x00, 0x00, 0x03, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+            0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x03, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+            0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x05, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+            0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x03, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+            0x03, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x00, 0x00, 0x00,
+            0x03, 0x00, 0x00, 0x00, 0x03, 0x00, 0x00, 0x00, 0x61, 0x62, 0x63, 0x00, 0x00, 0x00, 0x00, 0x00,
+            0xff, 0xff, 0xff, 0xff, 0x00, 0x00, 0x00, 0x00, 0x10, 0x00, 0x00, 0x00, 0x0c, 0x00, 0x14, 0x00,
+            0x06, 0x00, 0x08, 0x00, 0x0c, 0x00, 0x10, 0x00, 0x0c, 0x00, 0x00, 0x00, 0x00, 0x00, 0x04, 0x00,
+            0x38, 0x00, 0x00, 0x00, 0x28, 0x00, 0x00, 0x00, 0x04, 0x00, 0x00, 0x00, 0x01, 0x00, 0x00, 0x00,
+            0xb8, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xd0, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+            0x38, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+            0x08, 0x00, 0x08, 0x00, 0x00, 0x00, 0x04, 0x00, 0x08, 0x00, 0x00, 0x00, 0x04, 0x00, 0x00, 0x00,
+            0x02, 0x00, 0x00, 0x00, 0x40, 0x00, 0x00, 0x00, 0x04, 0x00, 0x00, 0x00, 0xd8, 0xff, 0xff, 0xff,
+            0x00, 0x00, 0x01, 0x05, 0x10, 0x00, 0x00, 0x00, 0x18, 0x00, 0x00, 0x00, 0x04, 0x00, 0x00, 0x00,
+            0x00, 0x00, 0x00, 0x00, 0x01, 0x00, 0x00, 0x00, 0x73, 0x00, 0x00, 0x00, 0x04, 0x00, 0x04, 0x00,
+            0x04, 0x00, 0x00, 0x00, 0x10, 0x00, 0x14, 0x00, 0x08, 0x00, 0x06, 0x00, 0x07, 0x00, 0x0c, 0x00,
+            0x00, 0x00, 0x10, 0x00, 0x10, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x02, 0x10, 0x00, 0x00, 0x00,
+            0x1c, 0x00, 0x00, 0x00, 0x04, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x00, 0x00, 0x00,
+            0x69, 0x00, 0x00, 0x00, 0x08, 0x00, 0x0c, 0x00, 0x08, 0x00, 0x07, 0x00, 0x08, 0x00, 0x00, 0x00,
+            0x00, 0x00, 0x00, 0x01, 0x20, 0x00, 0x00, 0x00, 0xd0, 0x00, 0x00, 0x00, 0x41, 0x52, 0x52, 0x4f,
+            0x57, 0x31,
+        };
+
+        constexpr std::uint8_t pyarrow_stream[] = {
+            0xff, 0xff, 0xff, 0xff, 0xa8, 0x00, 0x00, 0x00, 0x10, 0x00, 0x00, 0x00, 0x00, 0x00, 0x0a, 0x00,
+            0x0c, 0x00, 0x06, 0x00, 0x05, 0x00, 0x08, 0x00, 0x0a, 0x00, 0x00, 0x00, 0x00, 0x01, 0x04, 0x00,
+            0x0c, 0x00, 0x00, 0x00, 0x08, 0x00, 0x08, 0x00, 0x00, 0x00, 0x04, 0x00, 0x08, 0x00, 0x00, 0x00,
+            0x04, 0x00, 0x00, 0x00, 0x02, 0x00, 0x00, 0x00, 0x40, 0x00, 0x00, 0x00, 0x04, 0x00, 0x00, 0x00,
+            0xd8, 0xff, 0xff, 0xff, 0x00, 0x00, 0x01, 0x05, 0x10, 0x00, 0x00, 0x00, 0x18, 0x00, 0x00, 0x00,
+            0x04, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x00, 0x00, 0x00, 0x73, 0x00, 0x00, 0x00,
+            0x04, 0x00, 0x04, 0x00, 0x04, 0x00, 0x00, 0x00, 0x10, 0x00, 0x14, 0x00, 0x08, 0x00, 0x06, 0x00,
+            0x07, 0x00, 0x0c, 0x00, 0x00, 0x00, 0x10, 0x00, 0x10, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x02,
+            0x10, 0x00, 0x00, 0x00, 0x1c, 0x00, 0x00, 0x00, 0x04, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+            0x01, 0x00, 0x00, 0x00, 0x69, 0x00, 0x00, 0x00, 0x08, 0x00, 0x0c, 0x00, 0x08, 0x00, 0x07, 0x00,
+            0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x20, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+            0xff, 0xff, 0xff, 0xff, 0xc8, 0x00, 0x00, 0x00, 0x14, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+            0x0c, 0x00, 0x16, 0x00, 0x06, 0x00, 0x05, 0x00, 0x08, 0x00, 0x0c, 0x00, 0x0c, 0x00, 0x00, 0x00,
+            0x00, 0x03, 0x04, 0x00, 0x18, 0x00, 0x00, 0x00, 0x38, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+            0x00, 0x00, 0x0a, 0x00, 0x18, 0x00, 0x0c, 0x00, 0x04, 0x00, 0x08, 0x00, 0x0a, 0x00, 0x00, 0x00,
+            0x6c, 0x00, 0x00, 0x00, 0x10, 0x00, 0x00, 0x00, 0x03, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+            0x00, 0x00, 0x00, 0x00, 0x05, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+            0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+            0x0c, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x18, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+            0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x20, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+            0x10, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x30, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+            0x03, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02, 0x00, 0x00, 0x00,
+            0x03, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+            0x03, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+            0x05, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+            0x03, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x03, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+            0x00, 0x00, 0x00, 0x00, 0x01, 0x00, 0x00, 0x00, 0x03, 0x00, 0x00, 0x00, 0x03, 0x00, 0x00, 0x00,
+            0x61, 0x62, 0x63, 0x00, 0x00, 0x00, 0x00, 0x00, 0xff, 0xff, 0xff, 0xff, 0x00, 0x00, 0x00, 0x00,
+        };
+
+        record_batch make_pyarrow_batch()
+        {
+            primitive_array<std::int32_t> ints(std::vector<std::int32_t>{1, 0, 3}, std::vector<std::size_t>{1});
+            string_array strings(std::vector<std::string>{"a", "bc", ""}, std::vector<std::size_t>{2});
+            return record_batch({{"i", array(std::move(ints))}, {"s", array(std::move(strings))}});
+        }
+
+        void write_file(const std::filesystem::path& path, std::span<const std::uint8_t> bytes)
+        {
+            std::ofstream ofs(path, std::ios::binary);
+            ofs.write(reinterpret_cast<const char*>(bytes.data()), static_cast<std::streamsize>(bytes.size()));
+        }
+
+        record_batch make_dictionary_batch(std::vector<std::string> words)
+        {
+            using keys_type = std::uint16_t;
+            dictionary_encoded_array<keys_type> column(
+                dictionary_encoded_array<keys_type>::keys_buffer_type{2, 0, 1, 1, 2},
+                array(string_array(std::move(words))),
+                std::vector<std::size_t>{3}
+            );
+            return record_batch({{"words", array(std::move(column))}});
+        }
+
+        // Positions of the messages of a stream
+        std::vector<std::size_t> message_offsets(const std::string& data)
+        {
+            std::vector<std::size_t> res;
+            std::size_t position = 0;
+            while (true)
+            {
+                std::int32_t metadata_size = 0;
+                std::memcpy(&metadata_size, data.data() + position + 4, sizeof(metadata_size));
+                if (metadata_size == 0)
+                {
+                    return res;
+                }
+                res.push_back(position);
+                const auto metadata = as_bytes(data).subspan(position + 8, static_cast<std::size_t>(metadata_size));
+                const auto body_length = ipc::detail::flatbuffer_table_view::root(metadata).scalar<std::int64_t>(
+                    ipc::detail::fb_message::body_length,
+                    0
+                );
+                position += 8 + static_cast<std::size_t>(metadata_size) + static_cast<std::size_t>(body_length);
+            }
+        }
+
+        // The schema message written for a batch, followed by the given messages
+        std::string make_stream(const record_batch& batch, const std::vector<std::string>& messages)
+        {
+            const std::string data = write_stream({batch});
+            std::string res = data.substr(0, message_offsets(data).at(1));
+            for (const auto& message : messages)
+            {
+                res += message;
+            }
+            return res;
+        }
+
+        // A record batch message of the given length, with the given FieldNodes and
+        // Buffers as pairs of int64
+        std::string make_record_batch_message(
+            std::int64_t length,
+            const std::vector<std::int64_t>& nodes,
+            const std::vector<std::int64_t>& buffers,
+            const std::string& body
+        )
+        {
+            auto as_struct_bytes = [](const std::vector<std::int64_t>& values)
+            {
+                return std::span<const std::uint8_t>(
+                    reinterpret_cast<const std::uint8_t*>(values.data()),
+                    values.size() * sizeof(std::int64_t)
+                );
+            };
+            ipc::detail::flatbuffer_table batch;
+            batch.add_scalar(ipc::detail::fb_record_batch::length, length);
+            batch.add_vector(ipc::detail::fb_record_batch::nodes, as_struct_bytes(nodes), 16, 8);
+            batch.add_vector(ipc::detail::fb_record_batch::buffers, as_struct_bytes(buffers), 16, 8);
+
+            ipc::detail::flatbuffer_table message;
+            message.add_scalar(ipc::detail::fb_message::version, ipc::detail::metadata_version);
+            message.add_scalar(
+                ipc::detail::fb_message::header_type,
+                static_cast<std::uint8_t>(ipc::message_type::record_batch)
+            );
+            message.add_flatbuffer(ipc::detail::fb_message::header, batch.finish());
+            message.add_scalar(ipc::detail::fb_message::body_length, static_cast<std::int64_t>(body.size()));
+            const auto metadata = message.finish();
+
+            std::string res(8, '\xFF');
+            const auto metadata_size = static_cast<std::int32_t>(metadata.size());
+            std::memcpy(res.data() + 4, &metadata_size, sizeof(metadata_size));
+            res.append(reinterpret_cast<const char*>(metadata.data()), metadata.size());
+            return res + body;
+        }
+
+        template <class T>
+        std::string to_body(const std::vector<T>& values)
+        {
+            std::string res(reinterpret_cast<const char*>(values.data()), values.size() * sizeof(T));
+            res.resize((res.size() + 7) / 8 * 8, '\0');
+            return res;
+        }
+
+        void check_invalid(const std::string& data)
+        {
+            ipc::stream_reader reader(as_bytes(data));
+            CHECK_THROWS_AS(std::ignore = reader.next(), std::runtime_error);
+        }
+    }
+
+    TEST_SUITE("ipc")
+    {
+        TEST_CASE("stream round trip")
+        {
+            const std::vector<record_batch> batches = {make_batch(0), make_batch(100)};
+            const std::string data = write_stream(batches);
+
+            SUBCASE("from memory")
+            {
+                ipc::stream_reader reader(as_bytes(data));
+                REQUIRE(reader.schema() != nullptr);
+                CHECK_EQ(reader.schema()->n_children, 3);
+                for (const auto& expected : batches)
+                {
+                    auto batch = reader.next();
+                    REQUIRE(batch.has_value());
+                    CHECK_EQ(*batch, expected);
+                }
+                CHECK_FALSE(reader.next().has_value());
+            }
+
+            SUBCASE("from std::istream")
+            {
+                std::istringstream iss(data);
+                ipc::stream_reader reader(iss);
+                for (const auto& expected : batches)
+                {
+                    auto batch = reader.next();
+                    REQUIRE(batch.has_value());
+                    CHECK_EQ(*batch, expected);
+                }
+                CHECK_FALSE(reader.next().has_value());
+            }
+        }
+
+        TEST_CASE("zero-copy read")
+        {
+            auto data = std::make_shared<const std::string>(write_stream({make_batch(0)}));
+            const auto region = as_bytes(*data);
+            ipc::stream_reader reader(region, data);
+            auto batch = reader.next();
+            REQUIRE(batch.has_value());
+
+            const ArrowArray* ints = get_arrow_array(std::as_const(*batch).get_column("ints"));
+            CHECK(points_into(ints->buffers[0], region));
+            CHECK(points_into(ints->buffers[1], region));
+            const ArrowArray* lists = get_arrow_array(std::as_const(*batch).get_column("lists"));
+            CHECK(points_into(lists->children[0]->buffers[1], region));
+
+            // The batch keeps the region alive
+            const record_batch expected = make_batch(0);
+            CHECK_EQ(*batch, expected);
+            reader = ipc::stream_reader(std::span<const std::uint8_t>{});
+            data.reset();
+            CHECK_EQ(*batch, expected);
+        }
+
+        TEST_CASE("sliced columns")
+        {
+            primitive_array<std::int32_t> ints(std::vector<std::int32_t>{1, 2, 3, 4, 5, 6, 7, 8, 9, 10}, std::vector<std::size_t>{1, 8});
+            string_array strings(std::vector<std::string>{"a", "bb", "ccc", "dddd", "e", "ff", "g", "hh", "i", "jj"});
+            const record_batch batch(
+                std::vector<std::string>{"ints", "strings"},
+                std::vector<array>{array(ints.slice(3, 9)), array(strings.slice(2, 8))}
+            );
+            const std::string data = write_stream({batch});
+            ipc::stream_reader reader(as_bytes(data));
+            auto res = reader.next();
+            REQUIRE(res.has_value());
+            CHECK_EQ(*res, batch);
+        }
+
+        TEST_CASE("empty stream")
+        {
+            const std::string data = write_stream({});
+            ipc::stream_reader reader(as_bytes(data));
+            CHECK(reader.schema() == nullptr);
+            CHECK_FALSE(reader.next().has_value());
+        }
+
+        TEST_CASE("schema mismatch")
+        {
+            std::ostringstream oss;
+            ipc::stream_writer writer(oss);
+            writer.write(make_batch(0));
+            const record_batch other({{"ints", array(primitive_array<std::int64_t>(std::vector<std::int64_t>{1, 2}))}});
+            CHECK_THROWS_AS(writer.write(other), std::invalid_argument);
+            writer.close();
+            CHECK(writer.is_closed());
+            CHECK_THROWS_AS(writer.write(make_batch(0)), std::runtime_error);
+        }
+
+        TEST_CASE("invalid input")
+        {
+            const std::string data = write_stream({make_batch(0)});
+
+            SUBCASE("garbage before the stream")
+            {
+                const std::string invalid = "abcdefgh" + data;
+                CHECK_THROWS_AS(ipc::stream_reader(as_bytes(invalid)), std::runtime_error);
+            }
+
+            SUBCASE("invalid metadata")
+            {
+                std::string invalid = data;
+                invalid.replace(8, 4, "\xFF\xFF\x00\x00");
+                CHECK_THROWS_AS(ipc::stream_reader(as_bytes(invalid)), std::runtime_error);
+            }
+
+            SUBCASE("truncated body")
+            {
+                const std::string truncated = data.substr(0, data.size() - 24);
+                ipc::stream_reader reader(as_bytes(truncated));
+                CHECK_THROWS_AS(std::ignore = reader.next(), std::runtime_error);
+            }
+        }
+
+        TEST_CASE("record batch validation")
+        {
+            const record_batch ints({{"ints", array(primitive_array<std::int32_t>(std::vector<std::int32_t>{1, 2}))}});
+            const std::string body = to_body(std::vector<std::int32_t>{7, 8});
+
+            SUBCASE("valid message")
+            {
+                const std::string data = make_stream(ints, {make_record_batch_message(2, {2, 0}, {0, 0, 0, 8}, body)});
+                ipc::stream_reader reader(as_bytes(data));
+                auto batch = reader.next();
+                REQUIRE(batch.has_value());
+                const record_batch expected(
+                    {{"ints", array(primitive_array<std::int32_t>(std::vector<std::int32_t>{7, 8}))}}
+                );
+                CHECK_EQ(*batch, expected);
+            }
+
+            SUBCASE("length larger than the buffers")
+            {
+                check_invalid(make_stream(ints, {make_record_batch_message(1000000000, {1000000000, 0}, {0, 0, 0, 8}, body)}));
+            }
+
+            SUBCASE("missing data buffer")
+            {
+                check_invalid(make_stream(ints, {make_record_batch_message(2, {2, 0}, {0, 0}, body)}));
+            }
+
+            SUBCASE("missing validity bitmap")
+            {
+                check_invalid(make_stream(ints, {make_record_batch_message(2, {2, 1}, {0, 0, 0, 8}, body)}));
+            }
+
+            SUBCASE("null count larger than the length")
+            {
+                check_invalid(make_stream(ints, {make_record_batch_message(2, {2, 3}, {0, 1, 0, 8}, body)}));
+            }
+
+            SUBCASE("buffer out of the body")
+            {
+                check_invalid(make_stream(ints, {make_record_batch_message(2, {2, 0}, {0, 0, 0, 64}, body)}));
+            }
+
+            SUBCASE("misaligned buffer")
+            {
+                const std::string misaligned_body = to_body(std::vector<std::int32_t>{0, 7, 8, 0});
+                check_invalid(make_stream(ints, {make_record_batch_message(2, {2, 0}, {0, 0, 4, 8}, misaligned_body)}));
+            }
+
+            SUBCASE("column length differs from the batch length")
+            {
+                check_invalid(make_stream(ints, {make_record_batch_message(2, {1, 0}, {0, 0, 0, 8}, body)}));
+            }
+
+            SUBCASE("offsets out of the data buffer")
+            {
+                const record_batch strings({{"strings", array(string_array(std::vector<std::string>{"a", "b"}))}});
+                const std::string offsets = to_body(std::vector<std::int32_t>{0, 1, 100});
+                const std::string data = "ab" + std::string(6, '\0');
+                check_invalid(make_stream(
+                    strings,
+                    {make_record_batch_message(2, {2, 0}, {0, 0, 0, 12, 16, 2}, offsets + data)}
+                ));
+            }
+
+            SUBCASE("decreasing offsets")
+            {
+                const record_batch strings({{"strings", array(string_array(std::vector<std::string>{"a", "b"}))}});
+                const std::string offsets = to_body(std::vector<std::int32_t>{0, 2, 1});
+                const std::string data = "ab" + std::string(6, '\0');
+                check_invalid(make_stream(
+                    strings,
+                    {make_record_batch_message(2, {2, 0}, {0, 0, 0, 12, 16, 2}, offsets + data)}
+                ));
+            }
+
+            SUBCASE("list offsets out of the child")
+            {
+                primitive_array<double> flat_values(std::vector<double>{1., 2.});
+                const record_batch lists(
+                    {{"lists", array(list_array(array(std::move(flat_values)), list_array::offset_from_sizes(std::vector<std::size_t>{1, 1})))}}
+                );
+                const std::string offsets = to_body(std::vector<std::int32_t>{0, 1, 3});
+                const std::string values = to_body(std::vector<double>{1., 2.});
+                check_invalid(make_stream(
+                    lists,
+                    {make_record_batch_message(2, {2, 0, 2, 0}, {0, 0, 0, 12, 0, 0, 16, 16}, offsets + values)}
+                ));
+            }
+
+            SUBCASE("missing dictionary")
+            {
+                const record_batch words = make_dictionary_batch({"x", "y", "z"});
+                const std::string keys = to_body(std::vector<std::uint16_t>{0, 1});
+                check_invalid(make_stream(words, {make_record_batch_message(2, {2, 0}, {0, 0, 0, 4}, keys)}));
+            }
+        }
+
+        TEST_CASE("dictionaries")
+        {
+            const std::vector<record_batch> batches = {
+                make_dictionary_batch({"x", "y", "z"}),
+                make_dictionary_batch({"x", "y", "z"}),
+                make_dictionary_batch({"u", "v", "w"})
+            };
+
+            SUBCASE("stream")
+            {
+                const std::string data = write_stream(batches);
+                ipc::stream_reader reader(as_bytes(data));
+                for (const auto& expected : batches)
+                {
+                    auto batch = reader.next();
+                    REQUIRE(batch.has_value());
+                    CHECK_EQ(*batch, expected);
+                }
+                CHECK_FALSE(reader.next().has_value());
+                // Unchanged dictionaries are written once
+                CHECK_LT(data.size(), write_stream({batches[0]}).size() * 3);
+            }
+
+            SUBCASE("file")
+            {
+                std::ostringstream oss;
+                ipc::file_writer writer(oss);
+                writer.write(batches[0]);
+                writer.write(batches[1]);
+                CHECK_THROWS_AS(writer.write(batches[2]), std::invalid_argument);
+                writer.close();
+                const std::string data = oss.str();
+                ipc::file_reader reader(as_bytes(data));
+                REQUIRE_EQ(reader.nb_record_batches(), 2);
+                CHECK_EQ(reader.read(1), batches[1]);
+                CHECK_EQ(reader.read(0), batches[0]);
+            }
+
+            SUBCASE("index out of the dictionary")
+            {
+                const std::string data = write_stream({batches[0]});
+                const auto offsets = message_offsets(data);
+                REQUIRE_EQ(offsets.size(), 3);
+                // Replaces the record batch with one whose second index exceeds the dictionary
+                const std::string keys = to_body(std::vector<std::uint16_t>{0, 3});
+                check_invalid(data.substr(0, offsets[2]) + make_record_batch_message(2, {2, 0}, {0, 0, 0, 4}, keys));
+            }
+        }
+
+        TEST_CASE("file round trip")
+        {
+            const std::vector<record_batch> batches = {make_batch(0), make_batch(10), make_batch(20)};
+            std::ostringstream oss;
+            ipc::file_writer writer(oss);
+            for (const auto& batch : batches)
+            {
+                writer.write(batch);
+            }
+            writer.close();
+            const std::string data = oss.str();
+
+            ipc::file_reader reader(as_bytes(data));
+            REQUIRE_EQ(reader.nb_record_batches(), batches.size());
+            CHECK_EQ(reader.read(2), batches[2]);
+            CHECK_EQ(reader.read(0), batches[0]);
+            CHECK_EQ(reader.read(1), batches[1]);
+            CHECK_THROWS_AS(std::ignore = reader.read(3), std::out_of_range);
+
+            const std::string invalid = data.substr(0, data.size() - 1);
+            CHECK_THROWS_AS(ipc::file_reader(as_bytes(invalid)), std::runtime_error);
+        }
+
+        TEST_CASE("memory-mapped file")
+        {
+            const std::vector<record_batch> batches = {make_batch(0), make_batch(10)};
+            const auto path = std::filesystem::temp_directory_path() / "sparrow_test_ipc_mapped.arrow";
+            {
+                std::ofstream ofs(path, std::ios::binary);
+                ipc::file_writer writer(ofs);
+                for (const auto& batch : batches)
+                {
+                    writer.write(batch);
+                }
+                writer.close();
+            }
+
+            SUBCASE("file")
+            {
+                std::optional<record_batch> batch;
+                {
+                    ipc::file_reader reader = ipc::open_file(path);
+                    REQUIRE_EQ(reader.nb_record_batches(), batches.size());
+                    CHECK_EQ(reader.read(0), batches[0]);
+                    batch = reader.read(1);
+                }
+                // The batch keeps the file mapped after the reader is gone
+                CHECK_EQ(*batch, batches[1]);
+            }
+
+            SUBCASE("stream")
+            {
+                const auto stream_path = std::filesystem::temp_directory_path() / "sparrow_test_ipc_mapped.arrows";
+                {
+                    std::ofstream ofs(stream_path, std::ios::binary);
+                    ofs << write_stream(batches);
+                }
+                ipc::stream_reader reader = ipc::open_stream(stream_path);
+                for (const auto& expected : batches)
+                {
+                    auto batch = reader.next();
+                    REQUIRE(batch.has_value());
+                    CHECK_EQ(*batch, expected);
+                }
+                CHECK_FALSE(reader.next().has_value());
+                std::filesystem::remove(stream_path);
+            }
+
+            SUBCASE("file written by pyarrow")
+            {
+                const auto arrow_path = std::filesystem::temp_directory_path() / "sparrow_test_ipc_pyarrow.arrow";
+                write_file(arrow_path, pyarrow_file);
+                {
+                    ipc::file_reader reader = ipc::open_file(arrow_path);
+                    REQUIRE_EQ(reader.nb_record_batches(), 1);
+                    CHECK_EQ(reader.read(0), make_pyarrow_batch());
+                }
+                std::filesystem::remove(arrow_path);
+            }
+
+            SUBCASE("stream written by pyarrow")
+            {
+                const auto arrow_path = std::filesystem::temp_directory_path() / "sparrow_test_ipc_pyarrow.arrows";
+                write_file(arrow_path, pyarrow_stream);
+                {
+                    ipc::stream_reader reader = ipc::open_stream(arrow_path);
+                    auto batch = reader.next();
+                    REQUIRE(batch.has_value());
+                    CHECK_EQ(*batch, make_pyarrow_batch());
+                    CHECK_FALSE(reader.next().has_value());
+                }
+                std::filesystem::remove(arrow_path);
+            }
+
+            SUBCASE("missing file")
+            {
+                CHECK_THROWS_AS(std::ignore = ipc::open_file(path.string() + ".missing"), std::runtime_error);
+            }
+
+            std::filesystem::remove(path);
+        }
+
+        TEST_CASE("arrow_array_stream_proxy source and sink")
+        {
+            const std::vector<record_batch> batches = {make_batch(0), make_batch(5)};
+            const std::string data = write_stream(batches);
+
+            arrow_array_stream_proxy stream;
+            ipc::stream_reader reader(as_bytes(data));
+            reader.read_all(stream);
+
+            std::ostringstream oss;
+            ipc::stream_writer writer(oss);
+            writer.write(stream);
+            writer.close();
+            const std::string copy = oss.str();
+
+            ipc::stream_reader copy_reader(as_bytes(copy));
+            for (const auto& expected : batches)
+            {
+                auto batch = copy_reader.next();
+                REQUIRE(batch.has_value());
+                CHECK_EQ(*batch, expected);
+            }
+            CHECK_FALSE(copy_reader.next().has_value());
+        }
+    }
+}
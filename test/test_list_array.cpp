@@ -277,6 +277,16 @@ namespace sparrow
                     list_array list_arr(std::move(arr), list_array::offset_from_sizes(sizes), false);
                     test::check_array(list_arr, sizes);
                 }
+
+                SUBCASE("copy without validity buffer")
+                {
+                    const list_array list_arr(std::move(arr), list_array::offset_from_sizes(sizes));
+                    list_array list_arr2(list_arr);
+                    // The mutable access copies the shared buffers, the empty validity buffer must stay null
+                    CHECK(list_arr2[0].has_value());
+                    CHECK_EQ(get_arrow_array(list_arr2)->buffers[0], nullptr);
+                    CHECK_EQ(list_arr2, list_arr);
+                }
             }
         }
 
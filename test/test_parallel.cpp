@@ -0,0 +1,100 @@
+// Copyright 2024 Man Group Operations Limited
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <atomic>
+#include <cstddef>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "sparrow/utils/parallel.hpp"
+
+#include "doctest/doctest.h"
+
+namespace sparrow
+{
+    TEST_SUITE("parallel")
+    {
+        TEST_CASE("resolve_num_threads")
+        {
+            CHECK_EQ(resolve_num_threads(3), 3u);
+            CHECK_GE(resolve_num_threads(0), 1u);
+        }
+
+        TEST_CASE("parallel_for")
+        {
+            constexpr std::size_t count = 1000;
+
+            SUBCASE("visits each index once")
+            {
+                for (std::size_t num_threads : {std::size_t(0), std::size_t(1), std::size_t(3), count + 1})
+                {
+                    std::vector<std::atomic<int>> visits(count);
+                    parallel_for(
+                        count,
+                        num_threads,
+                        [&visits](std::size_t i)
+                        {
+                            visits[i].fetch_add(1);
+                        }
+                    );
+                    for (std::size_t i = 0; i < count; ++i)
+                    {
+                        CHECK_EQ(visits[i].load(), 1);
+                    }
+                }
+            }
+
+            SUBCASE("empty range")
+            {
+                bool called = false;
+                parallel_for(
+                    0,
+                    4,
+                    [&called](std::size_t)
+                    {
+                        called = true;
+                    }
+                );
+                CHECK_FALSE(called);
+            }
+
+            SUBCASE("rethrows the exception of the smallest index")
+            {
+                std::vector<std::atomic<int>> visits(count);
+                auto f = [&visits](std::size_t i)
+                {
+                    if (i == 100 || i == 900)
+                    {
+                        throw std::runtime_error(std::to_string(i));
+                    }
+                    visits[i].fetch_add(1);
+                };
+                try
+                {
+                    parallel_for(count, 4, f);
+                    FAIL("parallel_for should have thrown");
+                }
+                catch (const std::runtime_error& e)
+                {
+                    CHECK_EQ(std::string(e.what()), "100");
+                }
+                // The ranges without exception are fully processed
+                CHECK_EQ(visits[500].load(), 1);
+                CHECK_EQ(visits[99].load(), 1);
+                CHECK_EQ(visits[101].load(), 0);
+            }
+        }
+    }
+}
@@ -1104,5 +1104,22 @@ namespace sparrow
 #    pragma GCC diagnostic pop
 #endif
         }
+
+        TEST_CASE("bool copy shares buffers")
+        {
+            const primitive_array<bool> ar(std::vector<bool>{true, false, true, true}, std::vector<std::size_t>{1});
+            primitive_array<bool> ar_copy(ar);
+
+            const auto& proxy = detail::array_access::get_arrow_proxy(ar);
+            const auto& proxy_copy = detail::array_access::get_arrow_proxy(std::as_const(ar_copy));
+            CHECK_EQ(proxy_copy.array().buffers[0], proxy.array().buffers[0]);
+            CHECK_EQ(proxy_copy.array().buffers[1], proxy.array().buffers[1]);
+            CHECK_EQ(ar_copy, ar);
+
+            ar_copy[0] = make_nullable(false);
+            CHECK_NE(proxy_copy.array().buffers[1], proxy.array().buffers[1]);
+            CHECK_EQ(ar[0].get(), true);
+            CHECK_EQ(ar_copy[0].get(), false);
+        }
     }
 }
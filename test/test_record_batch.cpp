@@ -113,6 +113,26 @@ namespace sparrow
         return record_batch(make_name_list(), make_array_list(data_size), "");
     }
 
+    std::vector<array> make_wide_array_list(const std::size_t nb_columns, const std::size_t data_size)
+    {
+        std::vector<array> arr_list;
+        arr_list.reserve(nb_columns);
+        for (std::size_t i = 0; i < nb_columns; ++i)
+        {
+            const auto first = static_cast<std::int32_t>(i);
+            auto iota = std::ranges::iota_view{first, first + static_cast<std::int32_t>(data_size)};
+            arr_list.emplace_back(primitive_array<std::int32_t>(iota, true, "column" + std::to_string(i)));
+        }
+        return arr_list;
+    }
+
+    arrow_proxy make_wide_rb_arrow_proxy(const std::size_t nb_columns, const std::size_t data_size)
+    {
+        struct_array sa(make_wide_array_list(nb_columns, data_size), false);
+        auto [arr, sch] = extract_arrow_structures(std::move(sa));
+        return arrow_proxy(std::move(arr), std::move(sch));
+    }
+
     TEST_SUITE("record_batch")
     {
         const std::size_t col_size = 10;
@@ -193,6 +213,144 @@ namespace sparrow
             }
         }
 
+        TEST_CASE("parallel import")
+        {
+            constexpr std::size_t nb_columns = 257;
+            const record_batch record_exp(make_wide_array_list(nb_columns, col_size));
+            const record_batch_import_options options{.num_threads = 4, .min_columns_per_thread = 16};
+
+            SUBCASE("from moved Arrow C structs")
+            {
+                auto proxy = make_wide_rb_arrow_proxy(nb_columns, col_size);
+                record_batch record(proxy.extract_array(), proxy.extract_schema(), options);
+                CHECK_EQ(record, record_exp);
+            }
+
+            SUBCASE("from pointers to Arrow C structs")
+            {
+                auto proxy = make_wide_rb_arrow_proxy(nb_columns, col_size);
+                record_batch record(&(proxy.array()), &(proxy.schema()), options);
+                CHECK_EQ(record, record_exp);
+            }
+
+            SUBCASE("from const pointers to Arrow C structs")
+            {
+                const auto proxy = make_wide_rb_arrow_proxy(nb_columns, col_size);
+                record_batch record(&(proxy.array()), &(proxy.schema()), options);
+                CHECK_EQ(record, record_exp);
+            }
+
+            SUBCASE("from ArrowArray&& and ArrowSchema*")
+            {
+                auto proxy = make_wide_rb_arrow_proxy(nb_columns, col_size);
+                record_batch record(proxy.extract_array(), &(proxy.schema()), options);
+                CHECK_EQ(record, record_exp);
+                CHECK_EQ(record.get_column("column200"), record_exp.get_column(200));
+            }
+
+            SUBCASE("all hardware threads")
+            {
+                auto proxy = make_wide_rb_arrow_proxy(nb_columns, col_size);
+                record_batch record(proxy.extract_array(), &(proxy.schema()), {.num_threads = 0, .min_columns_per_thread = 1});
+                CHECK_EQ(record, record_exp);
+            }
+
+            SUBCASE("fewer columns than min_columns_per_thread")
+            {
+                auto record_exp_small = make_record_batch(col_size);
+                auto proxy = make_rb_arrow_proxy(col_size);
+                record_batch record(proxy.extract_array(), proxy.extract_schema(), options);
+                CHECK_EQ(record, record_exp_small);
+            }
+        }
+
+        TEST_CASE("lazy import")
+        {
+            constexpr std::size_t nb_columns = 257;
+            const record_batch record_exp(make_wide_array_list(nb_columns, col_size));
+            const record_batch_import_options options{.lazy = true};
+
+            SUBCASE("from moved Arrow C structs")
+            {
+                auto proxy = make_wide_rb_arrow_proxy(nb_columns, col_size);
+                record_batch record(proxy.extract_array(), proxy.extract_schema(), options);
+                CHECK_EQ(record.nb_columns(), nb_columns);
+                CHECK_EQ(record.nb_rows(), col_size);
+                CHECK_EQ(record.get_column("column200"), record_exp.get_column(200));
+                CHECK_EQ(record.get_column(3), record_exp.get_column(3));
+                CHECK_EQ(record, record_exp);
+            }
+
+            SUBCASE("from pointers to Arrow C structs")
+            {
+                auto proxy = make_wide_rb_arrow_proxy(nb_columns, col_size);
+                record_batch record(&(proxy.array()), &(proxy.schema()), options);
+                CHECK_EQ(record, record_exp);
+            }
+
+            SUBCASE("from ArrowArray&& and ArrowSchema*")
+            {
+                auto proxy = make_wide_rb_arrow_proxy(nb_columns, col_size);
+                record_batch record(proxy.extract_array(), &(proxy.schema()), options);
+                CHECK_EQ(record.get_column(100), record_exp.get_column(100));
+                CHECK_EQ(record, record_exp);
+            }
+
+            SUBCASE("concurrent accesses")
+            {
+                auto proxy = make_wide_rb_arrow_proxy(nb_columns, col_size);
+                const record_batch record(proxy.extract_array(), proxy.extract_schema(), options);
+                // Every column is accessed by several threads at once
+                parallel_for(
+                    4 * nb_columns,
+                    4,
+                    [&record](std::size_t i)
+                    {
+                        [[maybe_unused]] const array& column = record.get_column(i % nb_columns);
+                    }
+                );
+                CHECK_EQ(record, record_exp);
+            }
+
+            SUBCASE("copy and extract_struct_array")
+            {
+                auto proxy = make_wide_rb_arrow_proxy(nb_columns, col_size);
+                record_batch record(proxy.extract_array(), proxy.extract_schema(), options);
+                const record_batch copy(record);
+                CHECK_EQ(copy, record_exp);
+                const struct_array extracted = record.extract_struct_array();
+                CHECK_EQ(extracted.size(), col_size);
+                CHECK_EQ(record_batch(struct_array(extracted)), record_exp);
+            }
+
+            SUBCASE("releases the Arrow C structs once every column is imported")
+            {
+                static void (*original_release)(ArrowSchema*) = nullptr;
+                static bool released = false;
+                released = false;
+
+                auto proxy = make_wide_rb_arrow_proxy(nb_columns, col_size);
+                ArrowSchema schema = proxy.extract_schema();
+                original_release = schema.release;
+                schema.release = [](ArrowSchema* s)
+                {
+                    released = true;
+                    s->release = original_release;
+                    original_release(s);
+                };
+
+                record_batch record(proxy.extract_array(), std::move(schema), options);
+                for (std::size_t i = 0; i + 1 < nb_columns; ++i)
+                {
+                    [[maybe_unused]] const array& column = record.get_column(i);
+                }
+                CHECK_FALSE(released);
+                [[maybe_unused]] const array& last = record.get_column(nb_columns - 1);
+                CHECK(released);
+                CHECK_EQ(record, record_exp);
+            }
+        }
+
         TEST_CASE("operator==")
         {
             auto record1 = make_record_batch(col_size);
@@ -203,6 +361,26 @@ namespace sparrow
             CHECK(record1 != record3);
         }
 
+        TEST_CASE("first_difference")
+        {
+            const auto record = make_record_batch(col_size);
+            CHECK_FALSE(first_difference(record, make_record_batch(col_size)).has_value());
+
+            const auto longer = make_record_batch(col_size + 2u);
+            const auto diff = first_difference(record, longer);
+            REQUIRE(diff.has_value());
+            CHECK_EQ(diff->column, 0);
+            CHECK_EQ(diff->row, col_size);
+
+            auto columns = make_array_list(col_size);
+            columns[2] = columns[1];
+            const record_batch other(make_name_list(), std::move(columns), "");
+            const auto column_diff = first_difference(record, other);
+            REQUIRE(column_diff.has_value());
+            CHECK_EQ(column_diff->column, 2);
+            CHECK_EQ(column_diff->row, 0);
+        }
+
         TEST_CASE("copy semantic")
         {
 #ifdef SPARROW_TRACK_COPIES
@@ -363,6 +541,38 @@ namespace sparrow
             CHECK_EQ(record2, record_check);
         }
 
+        TEST_CASE("slice")
+        {
+            const auto record = make_record_batch(col_size);
+            const auto sliced = record.slice(2, 7);
+            REQUIRE_EQ(sliced.nb_columns(), record.nb_columns());
+            CHECK_EQ(sliced.nb_rows(), 5u);
+            CHECK(std::ranges::equal(sliced.names(), record.names()));
+            for (std::size_t i = 0; i < record.nb_columns(); ++i)
+            {
+                CHECK_EQ(sliced.get_column(i), record.get_column(i).slice(2, 7));
+            }
+        }
+
+        TEST_CASE("slice_view")
+        {
+            const auto record = make_record_batch(col_size);
+            const auto sliced = record.slice_view(3, 10);
+            REQUIRE_EQ(sliced.nb_columns(), record.nb_columns());
+            CHECK_EQ(sliced.nb_rows(), 7u);
+            for (std::size_t i = 0; i < record.nb_columns(); ++i)
+            {
+                CHECK_EQ(sliced.get_column(i), record.get_column(i).slice(3, 10));
+            }
+        }
+
+        TEST_CASE("concatenate")
+        {
+            const auto record = make_record_batch(col_size);
+            const std::vector<record_batch> parts{record.slice_view(0, 4), record.slice_view(4, col_size)};
+            CHECK_EQ(concatenate(parts), record);
+        }
+
         TEST_CASE("add_column_reference")
         {
             SUBCASE("add single column by reference")
@@ -17,6 +17,7 @@
 #include "sparrow/primitive_array.hpp"
 #include "sparrow/run_end_encoded_array.hpp"
 #include "sparrow/utils/nullable.hpp"
+#include "sparrow/variable_size_binary_array.hpp"
 
 #include "../test/external_array_data_creation.hpp"
 #include "doctest/doctest.h"
@@ -560,6 +561,32 @@ namespace sparrow
                 CHECK_EQ(run_ends[1].value(), 2);
             }
 
+            SUBCASE("take")
+            {
+                const auto& const_array = rle_array;
+                const std::vector<std::size_t> indices{0, 1, 2, 3, 5, 7, 7, 6, 0, 4, 2};
+                const auto values = const_array.take(indices);
+                REQUIRE_EQ(values.size(), indices.size());
+                for (std::size_t i = 0; i < indices.size(); ++i)
+                {
+                    CHECK_EQ(values[i], const_array[indices[i]]);
+                }
+                CHECK(const_array.take(std::vector<std::size_t>{}).empty());
+            }
+
+            SUBCASE("decode")
+            {
+                const array decoded = rle_array.decode();
+                REQUIRE_EQ(decoded.size(), n);
+                CHECK_EQ(decoded.data_type(), data_type::UINT64);
+                CHECK_EQ(decoded.null_count(), 3);
+                const auto& const_array = rle_array;
+                for (std::size_t i = 0; i < n; ++i)
+                {
+                    CHECK_EQ(decoded[i], const_array[i]);
+                }
+            }
+
             SUBCASE("mutation on slice is unsupported")
             {
                 run_end_encoded_array sliced(detail::array_access::get_arrow_proxy(rle_array).slice(1, 3));
@@ -587,6 +614,129 @@ namespace sparrow
 #endif
         }
 
+        TEST_CASE("run_length_encoded with many runs")
+        {
+            // Run i has length (i % 3) + 1 and value i, every 7th run is null
+            constexpr std::size_t run_count = 10000;
+            std::vector<std::int32_t> run_ends;
+            std::vector<std::uint64_t> values;
+            std::vector<std::size_t> null_runs;
+            std::vector<std::uint64_t> expanded;
+            std::vector<std::size_t> expanded_nulls;
+            std::int32_t run_end = 0;
+            for (std::size_t i = 0; i < run_count; ++i)
+            {
+                const auto run_length = static_cast<std::int32_t>(i % 3) + 1;
+                run_end += run_length;
+                run_ends.push_back(run_end);
+                values.push_back(i);
+                if (i % 7 == 0)
+                {
+                    null_runs.push_back(i);
+                    for (std::int32_t j = 0; j < run_length; ++j)
+                    {
+                        expanded_nulls.push_back(expanded.size() + static_cast<std::size_t>(j));
+                    }
+                }
+                expanded.resize(static_cast<std::size_t>(run_end), i);
+            }
+            run_end_encoded_array rle_array(
+                array(primitive_array<std::int32_t>(run_ends)),
+                array(primitive_array<std::uint64_t>(values, null_runs))
+            );
+            const array expected(primitive_array<std::uint64_t>(expanded, expanded_nulls));
+            const auto& const_array = rle_array;
+            REQUIRE_EQ(rle_array.size(), expected.size());
+
+            auto check_value = [&](std::size_t index, const array_traits::const_reference& value)
+            {
+                CHECK_EQ(value, expected[index]);
+            };
+
+            SUBCASE("operator[]")
+            {
+                for (std::size_t i = 0; i < expected.size(); i += 13)
+                {
+                    check_value(i, const_array[i]);
+                }
+                check_value(expected.size() - 1, const_array[expected.size() - 1]);
+            }
+
+            SUBCASE("take")
+            {
+                std::vector<std::size_t> indices;
+                for (std::size_t i = 0; i < expanded.size(); i += 5)
+                {
+                    indices.push_back(i);
+                }
+                for (std::size_t i = expanded.size(); i > 0; i -= std::min<std::size_t>(i, 997))
+                {
+                    indices.push_back(i - 1);
+                }
+                indices.push_back(0);
+                indices.push_back(expanded.size() - 1);
+
+                const auto taken = const_array.take(indices);
+                REQUIRE_EQ(taken.size(), indices.size());
+                for (std::size_t i = 0; i < indices.size(); ++i)
+                {
+                    check_value(indices[i], taken[i]);
+                }
+            }
+
+            SUBCASE("after mutation")
+            {
+                rle_array.push_back(test::make_u64_value(run_count));
+                REQUIRE_EQ(rle_array.size(), expected.size() + 1);
+                const array last_value(primitive_array<std::uint64_t>(std::vector<std::uint64_t>{run_count}));
+                CHECK_EQ(const_array[expected.size()], last_value[0]);
+                for (std::size_t i = 0; i < expected.size(); i += 17)
+                {
+                    check_value(i, const_array[i]);
+                }
+            }
+
+            SUBCASE("decode")
+            {
+                const array decoded = rle_array.decode();
+                REQUIRE_EQ(decoded.size(), expanded.size());
+                CHECK_EQ(decoded.null_count(), detail::array_access::get_arrow_proxy(rle_array).null_count());
+                for (std::size_t i = 0; i < expanded.size(); i += 11)
+                {
+                    CHECK_EQ(decoded[i], const_array[i]);
+                }
+            }
+        }
+
+        TEST_CASE("run_length_encoded decode strings")
+        {
+            string_array encoded_values(
+                std::vector<std::string>{"a", "", "bcd", "unused", "efgh"},
+                std::vector<std::size_t>{3}
+            );
+            primitive_array<std::int64_t> run_ends{{std::int64_t(2), std::int64_t(3), std::int64_t(6), std::int64_t(8), std::int64_t(9)}};
+            run_end_encoded_array rle_array(array(std::move(run_ends)), array(std::move(encoded_values)));
+
+            const array decoded = rle_array.decode();
+            REQUIRE_EQ(decoded.size(), 9u);
+            CHECK_EQ(decoded.data_type(), data_type::STRING);
+            CHECK_EQ(decoded.null_count(), 2);
+            const auto& const_array = rle_array;
+            for (std::size_t i = 0; i < decoded.size(); ++i)
+            {
+                CHECK_EQ(decoded[i], const_array[i]);
+            }
+        }
+
+        TEST_CASE("run_length_encoded decode unsupported values")
+        {
+            primitive_array<bool> encoded_values{{true, false}};
+            primitive_array<std::int32_t> run_ends{{std::int32_t(2), std::int32_t(5)}};
+            run_end_encoded_array rle_array(array(std::move(run_ends)), array(std::move(encoded_values)));
+
+            CHECK_THROWS_AS(std::ignore = rle_array.decode(), std::invalid_argument);
+        }
+
         TEST_CASE("run_length_encoded computes null_count when encoded child null count is unknown")
         {
             const auto rle_array = test::make_test_run_encoded_array_with_unknown_encoded_null_count();
@@ -0,0 +1,201 @@
+// Copyright 2024 Man Group Operations Limited
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "sparrow/array.hpp"
+#include "sparrow/dictionary_encoded_array.hpp"
+#include "sparrow/list_array.hpp"
+#include "sparrow/primitive_array.hpp"
+#include "sparrow/typed_visit.hpp"
+#include "sparrow/utils/nullable.hpp"
+#include "sparrow/variable_size_binary_array.hpp"
+
+#include "doctest/doctest.h"
+
+namespace sparrow
+{
+    namespace
+    {
+        array make_int_array()
+        {
+            const std::vector<nullable<std::int32_t>> values{1, {2, false}, 3, 4, {5, false}, 6};
+            return array(primitive_array<std::int32_t>(values).slice(1, 6));
+        }
+
+        array make_dictionary_array()
+        {
+            using layout_type = dictionary_encoded_array<std::uint32_t>;
+            layout_type::keys_buffer_type keys{0, 1, 2, 1, 0};
+            const std::vector<nullable<std::string>> words{"hello", {"you", false}, "world"};
+            string_array words_arr{words};
+            std::vector<std::size_t> keys_nulls{3};
+            return array(layout_type(std::move(keys), array(std::move(words_arr)), std::move(keys_nulls)));
+        }
+    }
+
+    TEST_SUITE("typed_visit")
+    {
+        TEST_CASE("visit_chunks")
+        {
+            SUBCASE("primitive")
+            {
+                const array ar = make_int_array();
+                const auto sum = visit_chunks(
+                    ar,
+                    []<class C>(const C& chunk) -> std::int64_t
+                    {
+                        std::int64_t res = 0;
+                        if constexpr (std::same_as<C, values_chunk<std::int32_t>>)
+                        {
+                            REQUIRE_EQ(chunk.size(), 5);
+                            CHECK_EQ(chunk.null_count(), 2);
+                            for (std::size_t i = 0; i < chunk.size(); ++i)
+                            {
+                                if (chunk.validity.test(i))
+                                {
+                                    res += static_cast<std::int64_t>(chunk.values[i]);
+                                }
+                            }
+                        }
+                        return res;
+                    }
+                );
+                CHECK_EQ(sum, 3 + 4 + 6);
+            }
+
+            SUBCASE("bool is passed as layout")
+            {
+                const array ar(primitive_array<bool>(std::vector<bool>{true, false, true}));
+                const bool is_layout = visit_chunks(
+                    ar,
+                    []<class C>(const C&)
+                    {
+                        return std::same_as<C, primitive_array<bool>>;
+                    }
+                );
+                CHECK(is_layout);
+            }
+
+            SUBCASE("dictionary")
+            {
+                const array ar = make_dictionary_array();
+                const auto decoded = visit_chunks(
+                    ar,
+                    []<class C>(const C& chunk)
+                    {
+                        std::vector<std::string> res;
+                        if constexpr (mpl::is_type_instance_of_v<C, dictionary_chunk>)
+                        {
+                            if constexpr (std::same_as<typename C::values_layout_type, string_array>)
+                            {
+                                for (std::size_t i = 0; i < chunk.size(); ++i)
+                                {
+                                    const auto value = chunk.values[chunk.keys.values[i]];
+                                    res.emplace_back(
+                                        chunk.keys.validity.test(i) && value.has_value() ? value.get() : "null"
+                                    );
+                                }
+                            }
+                        }
+                        return res;
+                    }
+                );
+                const std::vector<std::string> expected{"hello", "null", "world", "null", "hello"};
+                CHECK_EQ(decoded, expected);
+            }
+
+            SUBCASE("nested")
+            {
+                primitive_array<std::int32_t> flat_values{std::vector<std::int32_t>{1, 2, 3, 4, 5}};
+                const std::vector<std::size_t> sizes{2, 3};
+                const array ar(list_array(array(std::move(flat_values)), list_array::offset_from_sizes(sizes), true));
+                const auto sum = visit_chunks(
+                    ar,
+                    []<class C>(const C& layout) -> std::int64_t
+                    {
+                        std::int64_t res = 0;
+                        if constexpr (std::same_as<C, list_array>)
+                        {
+                            res = visit_chunks(
+                                *layout.raw_flat_array(),
+                                []<class D>(const D& chunk) -> std::int64_t
+                                {
+                                    std::int64_t flat_sum = 0;
+                                    if constexpr (std::same_as<D, values_chunk<std::int32_t>>)
+                                    {
+                                        for (const auto v : chunk.values)
+                                        {
+                                            flat_sum += v;
+                                        }
+                                    }
+                                    return flat_sum;
+                                }
+                            );
+                        }
+                        return res;
+                    }
+                );
+                CHECK_EQ(sum, 15);
+            }
+        }
+
+        TEST_CASE("for_each_typed")
+        {
+            SUBCASE("primitive")
+            {
+                const array ar = make_int_array();
+                std::vector<nullable<std::int32_t>> res;
+                for_each_typed(
+                    ar,
+                    [&res](const auto& value)
+                    {
+                        using value_type = std::decay_t<decltype(value)>;
+                        if constexpr (std::same_as<value_type, primitive_array<std::int32_t>::const_reference>)
+                        {
+                            res.emplace_back(value.get(), value.has_value());
+                        }
+                    }
+                );
+                REQUIRE_EQ(res.size(), 5);
+                CHECK_FALSE(res[0].has_value());
+                CHECK_EQ(res[1].value(), 3);
+                CHECK_EQ(res[2].value(), 4);
+                CHECK_FALSE(res[3].has_value());
+                CHECK_EQ(res[4].value(), 6);
+            }
+
+            SUBCASE("dictionary")
+            {
+                const array ar = make_dictionary_array();
+                std::vector<std::string> res;
+                for_each_typed(
+                    ar,
+                    [&res](const auto& value)
+                    {
+                        if constexpr (std::same_as<std::decay_t<decltype(value)>, nullable<std::string_view>>)
+                        {
+                            res.emplace_back(value.has_value() ? value.get() : "null");
+                        }
+                    }
+                );
+                const std::vector<std::string> expected{"hello", "null", "world", "null", "hello"};
+                CHECK_EQ(res, expected);
+            }
+        }
+    }
+}
@@ -0,0 +1,174 @@
+// Copyright 2024 Man Group Operations Limited
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+#include "sparrow/builder/variable_size_binary_builder.hpp"
+#include "sparrow/utils/nullable.hpp"
+
+#include "doctest/doctest.h"
+
+namespace sparrow
+{
+    namespace
+    {
+        // Values of various sizes, every fifth one is null
+        std::vector<nullable<std::string>> make_values(std::size_t size)
+        {
+            std::vector<nullable<std::string>> values;
+            for (std::size_t i = 0; i < size; ++i)
+            {
+                if (i % 5 == 3)
+                {
+                    values.emplace_back(std::string(), false);
+                }
+                else
+                {
+                    values.emplace_back(std::string(i % 23, static_cast<char>('a' + i % 26)));
+                }
+            }
+            return values;
+        }
+
+        template <class B>
+        void append_values(B& builder, const std::vector<nullable<std::string>>& values)
+        {
+            for (const auto& v : values)
+            {
+                if (v.has_value())
+                {
+                    builder.append(v.value());
+                }
+                else
+                {
+                    builder.append_null();
+                }
+            }
+        }
+
+        template <class A>
+        void check_array(const A& ar, const std::vector<nullable<std::string>>& values)
+        {
+            REQUIRE_EQ(ar.size(), values.size());
+            for (std::size_t i = 0; i < values.size(); ++i)
+            {
+                REQUIRE_EQ(ar[i].has_value(), values[i].has_value());
+                if (values[i].has_value())
+                {
+                    CHECK_EQ(std::string(ar[i].value().begin(), ar[i].value().end()), values[i].value());
+                }
+            }
+        }
+    }
+
+    TEST_SUITE("variable_size_binary_builder")
+    {
+        TEST_CASE_TEMPLATE("string arrays", B, string_builder, big_string_builder)
+        {
+            const auto values = make_values(100);
+            B builder;
+            builder.reserve(10, 20);
+            append_values(builder, values);
+            CHECK_EQ(builder.size(), values.size());
+            CHECK_EQ(builder.null_count(), 20);
+
+            const auto ar = builder.finish("name");
+            CHECK_EQ(ar.name(), "name");
+            CHECK_EQ(ar.null_count(), 20);
+            check_array(ar, values);
+
+            SUBCASE("reuse after finish")
+            {
+                CHECK_EQ(builder.size(), 0);
+                CHECK_EQ(builder.data_size(), 0);
+                builder.append("abc");
+                builder.append(std::string("de"));
+                const auto ar2 = builder.finish();
+                CHECK_EQ(ar2.null_count(), 0);
+                check_array(ar2, {std::string("abc"), std::string("de")});
+                check_array(ar, values);
+            }
+        }
+
+        TEST_CASE("binary_builder")
+        {
+            binary_builder builder;
+            const std::vector<std::byte> value{std::byte{1}, std::byte{2}, std::byte{3}};
+            builder.append(value);
+            builder.append_null();
+            builder.append(std::vector<std::byte>{});
+            const binary_array ar = builder.finish();
+            REQUIRE_EQ(ar.size(), 3);
+            CHECK_EQ(ar.null_count(), 1);
+            REQUIRE(ar[0].has_value());
+            CHECK(std::ranges::equal(ar[0].value(), value));
+            CHECK_FALSE(ar[1].has_value());
+            CHECK(ar[2].value().empty());
+        }
+
+        TEST_CASE("string_view_builder")
+        {
+            const auto values = make_values(200);
+
+            SUBCASE("default buffer size")
+            {
+                string_view_builder builder;
+                append_values(builder, values);
+                CHECK_EQ(builder.variadic_buffer_count(), 1);
+                const auto ar = builder.finish();
+                CHECK_EQ(ar.null_count(), 40);
+                check_array(ar, values);
+            }
+
+            SUBCASE("buffer roll over")
+            {
+                string_view_builder builder(64);
+                builder.reserve(200, 1000);
+                append_values(builder, values);
+                CHECK_GT(builder.variadic_buffer_count(), 10);
+                const auto ar = builder.finish();
+                check_array(ar, values);
+                CHECK_EQ(builder.size(), 0);
+                CHECK_EQ(builder.variadic_buffer_count(), 0);
+            }
+
+            SUBCASE("short values only")
+            {
+                string_view_builder builder;
+                builder.append("short");
+                builder.append_null();
+                builder.append("");
+                const auto ar = builder.finish();
+                check_array(ar, {std::string("short"), nullable<std::string>(std::string(), false), std::string()});
+            }
+        }
+
+        TEST_CASE("binary_view_builder")
+        {
+            binary_view_builder builder(16);
+            const std::vector<std::byte> long_value(40, std::byte{7});
+            builder.append(long_value);
+            builder.append(std::vector<std::byte>{std::byte{1}});
+            builder.append(long_value);
+            CHECK_EQ(builder.variadic_buffer_count(), 2);
+            const binary_view_array ar = builder.finish();
+            REQUIRE_EQ(ar.size(), 3);
+            CHECK(std::ranges::equal(ar[0].value(), long_value));
+            CHECK_EQ(ar[1].value().size(), 1);
+            CHECK(std::ranges::equal(ar[2].value(), long_value));
+        }
+    }
+}